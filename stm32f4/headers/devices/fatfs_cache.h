@@ -0,0 +1,240 @@
+/**
+ * @file fatfs_cache.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS sector cache interface 
+ * 
+ * @details Write-back cache that sits between the FatFs module and the card. FatFs
+ *          rereads and rewrites the same FAT and directory sectors over and over while a 
+ *          file is appended to, and small writes to a file turn into single sector 
+ *          writes as its window moves along. The cache keeps those sectors in RAM and 
+ *          only writes them to the card when they're evicted or flushed (CTRL_SYNC), 
+ *          with dirty sectors that follow each other written back as one multiple block 
+ *          write. 
+ * 
+ *          The cache is set associative: a sector can only be held by the 'ways' lines 
+ *          of its set (sector % sets) and the least recently used line of the set is 
+ *          replaced. The RAM used is set by the number of lines the application gives 
+ *          it (FATFS_CACHE_LINES). Only single sector accesses are cached. Multiple 
+ *          sector reads and writes are bulk file data that would push everything else 
+ *          out so they go to the card, updating any lines they overlap. 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _FATFS_CACHE_H_
+#define _FATFS_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "fatfs_driver.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define FATFS_CACHE_SEC_SIZE 512      // Sector size 
+#define FATFS_CACHE_MAX_RUN 32        // Max sectors in one write to the card 
+
+// Number of lines that fit in a RAM budget (bytes)
+#define FATFS_CACHE_LINES(ram) ((ram) / sizeof(fatfs_cache_line_t))
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+/**
+ * @brief Card read 
+ * 
+ * @param buff : buffer for the sectors 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the read 
+ */
+typedef DISK_RESULT (*fatfs_cache_read_t)(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief Card write 
+ * 
+ * @details Writes 'count' sectors starting at 'sector'. The data of each sector has its 
+ *          own buffer since cached sectors aren't next to each other in RAM. 
+ * 
+ * @param sectors : data of each sector 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the write 
+ */
+typedef DISK_RESULT (*fatfs_cache_write_t)(
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+// Cache line - one cached sector 
+typedef struct fatfs_cache_line_s 
+{
+    uint8_t data[FATFS_CACHE_SEC_SIZE]; 
+    uint32_t sector; 
+    uint32_t last_use;                 // Access stamp for finding the LRU line 
+    uint8_t valid; 
+    uint8_t dirty;                     // Changed since it was read from/written to the card 
+}
+fatfs_cache_line_t; 
+
+
+// Cache statistics 
+typedef struct fatfs_cache_stats_s 
+{
+    uint32_t hits;                     // Sectors read or written in the cache 
+    uint32_t misses;                   // Sectors that weren't in the cache 
+    uint32_t evictions;                // Lines replaced 
+    uint32_t write_backs;              // Dirty sectors written to the card 
+    uint32_t card_reads;               // Reads sent to the card 
+    uint32_t card_writes;              // Writes sent to the card 
+}
+fatfs_cache_stats_t; 
+
+
+// Sector cache (fatfs_cache_t is declared in fatfs_driver.h)
+struct fatfs_cache_s 
+{
+    fatfs_cache_line_t *lines; 
+    uint16_t sets; 
+    uint8_t ways; 
+    uint32_t clock;                    // Access stamp counter 
+
+    // Card 
+    fatfs_cache_read_t read; 
+    fatfs_cache_write_t write; 
+
+    fatfs_cache_stats_t stats; 
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Cache initialization 
+ * 
+ * @details Sets up the cache on the lines given. 'num_lines' is rounded down to a 
+ *          multiple of 'ways'. Use fatfs_cache_attach to put the cache in front of the 
+ *          SD card, in which case 'read' and 'write' can be NULL. 
+ * 
+ * @param cache : cache to initialize 
+ * @param lines : cache lines (RAM budget)
+ * @param num_lines : number of lines 
+ * @param ways : lines per set (1 for direct mapped, 'num_lines' for fully associative)
+ * @param read : card read 
+ * @param write : card write 
+ * @return DISK_RESULT : FATFS_RES_PARERR if the arguments are invalid 
+ */
+DISK_RESULT fatfs_cache_init(
+    fatfs_cache_t *cache, 
+    fatfs_cache_line_t *lines, 
+    uint16_t num_lines, 
+    uint8_t ways, 
+    fatfs_cache_read_t read, 
+    fatfs_cache_write_t write); 
+
+
+/**
+ * @brief Read sectors through the cache 
+ * 
+ * @details Cached sectors are copied from the cache and the rest are read from the card 
+ *          in as few reads as possible. A single sector that isn't cached is added to 
+ *          the cache. 
+ * 
+ * @param cache : sector cache 
+ * @param buff : buffer for the sectors 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the read 
+ */
+DISK_RESULT fatfs_cache_read(
+    fatfs_cache_t *cache, 
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief Write sectors through the cache 
+ * 
+ * @details A single sector is written to the cache and marked dirty. It's written to the 
+ *          card when it's evicted or flushed. Multiple sectors are written to the card 
+ *          right away and the lines holding any of them are updated. 
+ * 
+ * @param cache : sector cache 
+ * @param buff : data to write 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the write 
+ */
+DISK_RESULT fatfs_cache_write(
+    fatfs_cache_t *cache, 
+    const uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief Write all dirty sectors to the card 
+ * 
+ * @details Dirty sectors are written in order of sector number with sectors that follow 
+ *          each other combined into one write. 
+ * 
+ * @param cache : sector cache 
+ * @return DISK_RESULT : result of the writes 
+ */
+DISK_RESULT fatfs_cache_flush(fatfs_cache_t *cache); 
+
+
+/**
+ * @brief Drop everything in the cache 
+ * 
+ * @details Dirty sectors are lost. Used when the card is initialized again (ex. after it 
+ *          has been swapped). 
+ * 
+ * @param cache : sector cache 
+ */
+void fatfs_cache_invalidate(fatfs_cache_t *cache); 
+
+
+/**
+ * @brief Get the cache statistics 
+ * 
+ * @param cache : sector cache 
+ * @param stats : statistics 
+ */
+void fatfs_cache_stats(
+    const fatfs_cache_t *cache, 
+    fatfs_cache_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _FATFS_CACHE_H_
@@ -24,6 +24,7 @@ extern "C" {
 
 #include "stm32f411xe.h"
 #include "tools.h"
+#include "spi_comm.h"
 
 //=======================================================================================
 
@@ -103,6 +104,9 @@ typedef uint8_t DISK_STATUS;
 typedef fatfs_disk_results_t DISK_RESULT; 
 typedef fatfs_card_type_t CARD_TYPE; 
 
+// Sector cache (fatfs_cache.h) 
+typedef struct fatfs_cache_s fatfs_cache_t; 
+
 //=======================================================================================
 
 
@@ -119,6 +123,11 @@ typedef fatfs_card_type_t CARD_TYPE;
  *          through a call to this function. 
  *          
  *          This function should be called during initialization in the application code. 
+ *          
+ *          The driver sets the SPI clock itself: 400 kHz or less while the card is 
+ *          identified in fatfs_init then the fastest speed the card (CSD TRAN_SPEED) and 
+ *          the port support for data. The clock is lowered a step at a time if reads or 
+ *          writes fail. The baud rate given to spi_init doesn't matter for the card. 
  * 
  * @param spi : SPI port used by the SD card 
  * @param gpio : GPIO port used for the SD card slave select pin 
@@ -130,6 +139,62 @@ void fatfs_user_init(
     uint16_t fatfs_slave_pin);
 
 
+/**
+ * @brief FATFS DMA multi-block streaming initialization 
+ * 
+ * @details Moves sector data with the DMA engine of the SD card SPI port and leaves 
+ *          multi-block transfers open between calls from the FatFs module: 
+ *          
+ *          - Reads use CMD18 and once the requested sectors are read the next sector is 
+ *            received into a read-ahead buffer by the DMA. If the next read starts at 
+ *            that sector it's taken from the buffer and the transfer carries on. 
+ *          
+ *          - Writes use CMD25 (after an ACMD23 pre-erase on SD cards) and return without 
+ *            waiting for the card to program the last sector. A write that continues 
+ *            from the last sector keeps sending data packets. 
+ *          
+ *          Any other access, fatfs_ioctl (CTRL_SYNC from f_sync/f_close) or 
+ *          fatfs_stream_end finishes the open transfer. The card stays selected while a 
+ *          transfer is open so fatfs_stream_end must be called before other devices on 
+ *          the same SPI bus are used. 
+ *          
+ *          Call after fatfs_user_init. The engine (spi_dma_init) must be for the same SPI 
+ *          port. Passing NULL goes back to transfers that are done within each call. 
+ * 
+ * @param engine : SPI DMA engine of the SD card port 
+ */
+void fatfs_dma_init(spi_dma_t *engine); 
+
+
+/**
+ * @brief FATFS end the open multi-block transfer 
+ * 
+ * @details Stops an open read (CMD12) or write (stop token and busy wait) and deselects 
+ *          the card. Does nothing if there isn't an open transfer. 
+ * 
+ * @see fatfs_dma_init 
+ * 
+ * @return DISK_RESULT : result of stopping the transfer 
+ */
+DISK_RESULT fatfs_stream_end(void); 
+
+
+/**
+ * @brief FATFS sector cache 
+ * 
+ * @details Puts a sector cache (fatfs_cache_init) between the FatFs module and the card. 
+ *          The cache is pointed at the card and emptied. Dirty sectors are written to the 
+ *          card when they're evicted and when the FatFs module syncs (f_sync, f_close). 
+ *          Passing NULL removes the cache after writing back what's in it. 
+ * 
+ * @see fatfs_cache.h 
+ * 
+ * @param cache : initialized sector cache 
+ * @return DISK_RESULT : result of writing back the cache being replaced 
+ */
+DISK_RESULT fatfs_cache_attach(fatfs_cache_t *cache); 
+
+
 /**
  * @brief FATFS get card type 
  * 
@@ -145,7 +210,10 @@ CARD_TYPE fatfs_get_card_type(void);
  * 
  * @details Waits for the SD card DO/MISO line to go high (0xFF) which indicates that the 
  *          card is ready to receive further instructions. The function is called before 
- *          sending a command and before writing new data packets to the card. 
+ *          sending a command and before writing new data packets to the card. The wait 
+ *          is limited to the max busy time of a write (500 ms) at the current SPI clock. 
+ * 
+ * @return DISK_RESULT : FATFS_RES_OK if the card is ready, FATFS_RES_ERROR if still busy 
  */
 DISK_RESULT fatfs_ready_rec(void); 
 
@@ -0,0 +1,251 @@
+/**
+ * @file fatfs_logger.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS binary data logger interface 
+ * 
+ * @details Logs binary records (ex. IMU, GPS and control data) to files on the SD card
+ *          without the producers ever waiting on the card. Records are copied into a RAM 
+ *          ring buffer and a low priority task (fatfs_logger_task) drains the ring to the 
+ *          card in whole sector writes. Card write stalls (100+ ms on some cards) are 
+ *          absorbed by the ring and a record that doesn't fit is dropped and counted. 
+ * 
+ *          Files are preallocated as one contiguous block (f_expand) so appending to 
+ *          them never has to search the FAT, and the logger moves on to the next file 
+ *          once one is full. Requires _USE_EXPAND in ffconf.h. 
+ * 
+ *          File format: records are written back to back, each one a header followed by 
+ *          its data: 
+ *            - byte 0   : FATFS_LOGGER_SYNC 
+ *            - byte 1   : record ID (FATFS_LOGGER_ID_PAD is padding) 
+ *            - byte 2-3 : data length (little endian) 
+ *          Padding records fill the sector after a flush so writes stay sector aligned. 
+ *          The files are one stream split into pieces so a record can carry on into the 
+ *          next file - read them in order. A reader stops at the first header without 
+ *          the sync byte (end of the data in a file that wasn't closed). 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _FATFS_LOGGER_H_
+#define _FATFS_LOGGER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "tools.h" 
+#include "ff.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define FATFS_LOGGER_SEC_SIZE 512        // Sector size 
+#define FATFS_LOGGER_HDR_SIZE 4          // Record header size 
+#define FATFS_LOGGER_SYNC 0xA5           // First byte of every record 
+#define FATFS_LOGGER_ID_PAD 0xFF         // Padding record ID 
+#define FATFS_LOGGER_NAME_LEN 32         // Max file path length (including NULL)
+#define FATFS_LOGGER_PREFIX_LEN 20       // Max file prefix length (including NULL)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+/**
+ * @brief Logger status 
+ */
+typedef enum {
+    FATFS_LOGGER_OK, 
+    FATFS_LOGGER_INVALID_PARAM, 
+    FATFS_LOGGER_FULL,           // Not enough room in the ring - record dropped 
+    FATFS_LOGGER_FILE_ERROR      // FatFs error - see the stats for the result 
+} fatfs_logger_status_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+typedef fatfs_logger_status_t FATFS_LOGGER_STATUS; 
+
+
+/**
+ * @brief Time source for the latency statistics 
+ * 
+ * @details Returns a free running count (ex. microseconds). Wrap around is handled. 
+ */
+typedef uint32_t (*fatfs_logger_time_t)(void); 
+
+
+// Logger statistics 
+typedef struct fatfs_logger_stats_s 
+{
+    uint32_t records;                  // Records added to the ring 
+    uint32_t dropped;                  // Records dropped because the ring was full 
+    uint32_t bytes_written;            // Bytes written to files (including padding)
+    uint32_t writes;                   // f_write calls 
+    uint32_t max_latency;              // Longest card operation (time source counts)
+    uint32_t max_fill;                 // Most bytes held in the ring 
+    uint32_t files;                    // Files opened 
+    uint32_t not_contiguous;           // Files that couldn't be preallocated 
+    uint32_t errors;                   // FatFs errors 
+    FRESULT last_error;                // Result of the last FatFs error 
+}
+fatfs_logger_stats_t; 
+
+
+/**
+ * @brief Logger 
+ * 
+ * @details The ring is shared by all producers. Space is reserved with a compare and 
+ *          swap so producers in different interrupts/tasks don't need a lock, and the 
+ *          task only writes records that have been fully copied (sync byte set). 
+ */
+typedef struct fatfs_logger_s 
+{
+    // Ring buffer 
+    uint8_t *ring; 
+    uint32_t size;                     // Ring size (power of 2)
+    volatile uint32_t reserve;         // Producer position (free running)
+    volatile uint32_t tail;            // Task position - everything before is written 
+    uint32_t commit;                   // Task position - complete records end here 
+    uint32_t block_size;               // Bytes collected before a write 
+
+    // File 
+    FIL file; 
+    uint8_t open; 
+    char prefix[FATFS_LOGGER_PREFIX_LEN]; 
+    uint16_t index;                    // File number 
+    uint32_t file_size;                // Preallocated file size 
+    uint32_t file_pos;                 // Bytes written to the file 
+
+    fatfs_logger_time_t time; 
+    fatfs_logger_stats_t stats; 
+}
+fatfs_logger_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Logger initialization 
+ * 
+ * @details The volume must be mounted (f_mount) before the task runs. Files are named 
+ *          'prefix' followed by a 5 digit file number and ".BIN" (ex. "0:/IMU00001.BIN")
+ *          starting from 'index'. 
+ * 
+ *          The ring needs to hold everything produced during the longest card stall 
+ *          plus one block. 
+ * 
+ * @param logger : logger to initialize 
+ * @param ring : ring buffer 
+ * @param ring_size : ring size - power of 2 and a multiple of the sector size 
+ * @param block_size : bytes collected before they're written - multiple of the sector 
+ *                     size and no more than half the ring 
+ * @param prefix : file path and name prefix 
+ * @param index : first file number 
+ * @param file_size : preallocated size of each file - multiple of the sector size 
+ * @param time : time source for the latency statistics (NULL if not needed)
+ * @return FATFS_LOGGER_STATUS : status of the initialization 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_init(
+    fatfs_logger_t *logger, 
+    uint8_t *ring, 
+    uint32_t ring_size, 
+    uint32_t block_size, 
+    const char *prefix, 
+    uint16_t index, 
+    uint32_t file_size, 
+    fatfs_logger_time_t time); 
+
+
+/**
+ * @brief Log a record 
+ * 
+ * @details Copies the record into the ring and returns. Never waits on the card or other 
+ *          producers so it can be called from interrupts. 
+ * 
+ * @param logger : logger 
+ * @param id : record ID (not FATFS_LOGGER_ID_PAD)
+ * @param data : record data 
+ * @param len : data length 
+ * @return FATFS_LOGGER_STATUS : FATFS_LOGGER_FULL if the record was dropped 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_log(
+    fatfs_logger_t *logger, 
+    uint8_t id, 
+    const void *data, 
+    uint16_t len); 
+
+
+/**
+ * @brief Logger task 
+ * 
+ * @details Writes a block to the card when one has been collected and opens the next 
+ *          file when the current one is full. Call it from a low priority task or the 
+ *          main loop. This is where card stalls are spent. 
+ * 
+ * @param logger : logger 
+ * @return FATFS_LOGGER_STATUS : status of the card operations 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_task(fatfs_logger_t *logger); 
+
+
+/**
+ * @brief Write everything logged so far to the card 
+ * 
+ * @details Writes all complete records, pads the rest of the sector and syncs the file. 
+ *          Same context as fatfs_logger_task. 
+ * 
+ * @param logger : logger 
+ * @return FATFS_LOGGER_STATUS : status of the card operations 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_flush(fatfs_logger_t *logger); 
+
+
+/**
+ * @brief Close the current file 
+ * 
+ * @details Flushes the logger, cuts the unused preallocated space off the file and 
+ *          closes it. The next write opens a new file. 
+ * 
+ * @param logger : logger 
+ * @return FATFS_LOGGER_STATUS : status of the card operations 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_close(fatfs_logger_t *logger); 
+
+
+/**
+ * @brief Get the logger statistics 
+ * 
+ * @param logger : logger 
+ * @param stats : statistics 
+ */
+void fatfs_logger_stats(
+    const fatfs_logger_t *logger, 
+    fatfs_logger_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _FATFS_LOGGER_H_
@@ -0,0 +1,412 @@
+/**
+ * @file m8q_config_builder.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief SAM-M8Q GPS compile time configuration message builder 
+ * 
+ * @version 0.1 
+ * @date 2026-10-15 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _M8Q_CONFIG_BUILDER_H_
+#define _M8Q_CONFIG_BUILDER_H_
+
+//=======================================================================================
+// Notes 
+// - C++14 or newer is needed. 
+// - The functions here make configuration messages in the exact format they're sent to 
+//   the device (NMEA checksum and end sequence added, UBX in binary with its checksum). 
+//   When the result is stored in a constexpr variable all of the work is done by the 
+//   compiler and only the finished bytes end up in flash. Example: 
+// 
+//   static constexpr auto gga_off = m8q_pubx_rate("GGA", 0, 0, 0, 0, 0); 
+//   static constexpr auto nav_rate = m8q_cfg_rate(1000, 1, 1); 
+//   static constexpr m8q_raw_msg_t config[] = { gga_off.raw(), nav_rate.raw() }; 
+// 
+//   m8q_init(I2C1, NULL, 0, 0, 0); 
+//   m8q_config_raw(config, sizeof(config) / sizeof(config[0])); 
+// 
+// - Message contents are not checked against the device interface description. Only 
+//   the framing (length, checksum) is done here. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+extern "C" 
+{
+    #include "m8q_driver.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define M8Q_UBX_FRAME_LEN 8          // Sync chars, class, ID, length and checksum 
+#define M8Q_NMEA_FRAME_LEN 6         // '$', '*', checksum and end sequence 
+#define M8Q_PUBX_RATE_MAX_LEN 48     // Longest possible PUBX RATE message 
+
+// UBX classes and IDs 
+#define M8Q_UBX_CLASS_CFG 0x06 
+#define M8Q_UBX_CFG_PRT 0x00 
+#define M8Q_UBX_CFG_MSG 0x01 
+#define M8Q_UBX_CFG_RATE 0x08 
+#define M8Q_UBX_CFG_CFG 0x09 
+
+// CFG-PRT 
+#define M8Q_PRT_ID_DDC 0x00                // I2C (DDC) port ID 
+#define M8Q_PRT_DDC_MODE 0x84              // I2C address (0x42 << 1)
+#define M8Q_PRT_PROTO_UBX 0x0001           // UBX protocol mask 
+#define M8Q_PRT_PROTO_NMEA 0x0002          // NMEA protocol mask 
+#define M8Q_PRT_PROTO_RTCM 0x0004          // RTCM2 protocol mask (input only)
+#define M8Q_PRT_PROTO_RTCM3 0x0020         // RTCM3 protocol mask 
+#define M8Q_PRT_EXT_TX_TIMEOUT 0x0002      // Extended TX timeout flag 
+#define M8Q_PRT_TXR_PIN_MASK 0x1F          // TX ready pin field mask 
+#define M8Q_PRT_TXR_PIN_SHIFT 2            // TX ready pin field position 
+#define M8Q_PRT_TXR_THRES_SHIFT 7          // TX ready threshold field position 
+#define M8Q_PRT_TXR_THRES_UNIT 8           // TX ready threshold resolution (bytes)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Data types 
+
+// Ready to send message. 'size' is the number of bytes of 'data' that get sent. 
+template <uint16_t N> 
+struct M8qMsg 
+{
+    uint8_t data[N]; 
+    uint8_t size; 
+
+    // Driver message record (see m8q_config_raw)
+    constexpr m8q_raw_msg_t raw(void) const
+    {
+        return { data, size }; 
+    }
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+/**
+ * @brief Append the NMEA checksum and end sequence 
+ * 
+ * @details Works out the checksum of the first 'size' bytes of the message (not 
+ *          counting '$') and appends "*hh\r\n". 
+ * 
+ * @tparam N : message buffer size 
+ * @param msg : message with everything up to the checksum 
+ */
+template <uint16_t N> 
+constexpr void m8q_nmea_msg_end(M8qMsg<N> &msg)
+{
+    const char hex[] = "0123456789ABCDEF"; 
+    uint8_t checksum = CLEAR; 
+    uint8_t len = msg.size; 
+
+    for (uint8_t i = BYTE_1; i < len; i++)
+    {
+        checksum ^= msg.data[i]; 
+    }
+
+    msg.data[len++] = '*'; 
+    msg.data[len++] = (uint8_t)hex[checksum >> SHIFT_4]; 
+    msg.data[len++] = (uint8_t)hex[checksum & 0x0F]; 
+    msg.data[len++] = '\r'; 
+    msg.data[len++] = '\n'; 
+    msg.size = len; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Frames 
+
+/**
+ * @brief UBX message 
+ * 
+ * @details Adds the sync characters, class, ID, payload length and checksum to a 
+ *          payload. 
+ * 
+ * @tparam P : payload length 
+ * @param msg_class : message class 
+ * @param msg_id : message ID 
+ * @param payload : message payload 
+ * @return M8qMsg : ready to send message 
+ */
+template <uint16_t P> 
+constexpr M8qMsg<P + M8Q_UBX_FRAME_LEN> m8q_ubx_msg(
+    uint8_t msg_class, 
+    uint8_t msg_id, 
+    const uint8_t (&payload)[P])
+{
+    static_assert((P + M8Q_UBX_FRAME_LEN) <= HIGH_8BIT, "UBX message too long to send"); 
+
+    M8qMsg<P + M8Q_UBX_FRAME_LEN> msg = {}; 
+    uint8_t ck_a = CLEAR, ck_b = CLEAR; 
+
+    msg.data[BYTE_0] = 0xB5; 
+    msg.data[BYTE_1] = 0x62; 
+    msg.data[BYTE_2] = msg_class; 
+    msg.data[BYTE_3] = msg_id; 
+    msg.data[BYTE_4] = (uint8_t)P; 
+    msg.data[BYTE_5] = (uint8_t)(P >> SHIFT_8); 
+
+    for (uint16_t i = CLEAR; i < P; i++)
+    {
+        msg.data[BYTE_6 + i] = payload[i]; 
+    }
+
+    // The checksum covers everything between the sync characters and the checksum 
+    for (uint16_t i = BYTE_2; i < (P + BYTE_6); i++)
+    {
+        ck_a = (uint8_t)(ck_a + msg.data[i]); 
+        ck_b = (uint8_t)(ck_b + ck_a); 
+    }
+
+    msg.data[P + BYTE_6] = ck_a; 
+    msg.data[P + BYTE_7] = ck_b; 
+    msg.size = (uint8_t)(P + M8Q_UBX_FRAME_LEN); 
+
+    return msg; 
+}
+
+
+/**
+ * @brief NMEA message 
+ * 
+ * @details Adds the start character, checksum and end sequence to a message body. The 
+ *          body is everything between '$' and '*' (ex. "PUBX,00" to poll POSITION). 
+ * 
+ * @tparam N : body string size (including the null terminator)
+ * @param body : message body 
+ * @return M8qMsg : ready to send message 
+ */
+template <uint16_t N> 
+constexpr M8qMsg<N - BYTE_1 + M8Q_NMEA_FRAME_LEN> m8q_nmea_msg(const char (&body)[N])
+{
+    static_assert((N - BYTE_1 + M8Q_NMEA_FRAME_LEN) <= HIGH_8BIT, "NMEA message too long"); 
+
+    M8qMsg<N - BYTE_1 + M8Q_NMEA_FRAME_LEN> msg = {}; 
+    uint8_t len = CLEAR; 
+
+    msg.data[len++] = '$'; 
+
+    for (uint16_t i = CLEAR; (i < (N - BYTE_1)) && body[i]; i++)
+    {
+        msg.data[len++] = (uint8_t)body[i]; 
+    }
+
+    msg.size = len; 
+    m8q_nmea_msg_end(msg); 
+
+    return msg; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// UBX CFG messages 
+
+/**
+ * @brief CFG-MSG - message output rate on each port 
+ * 
+ * @details A rate of 0 disables the message on the port and a rate of n outputs the 
+ *          message every n navigation solutions. 
+ * 
+ * @param msg_class : class of the message being configured 
+ * @param msg_id : ID of the message being configured 
+ * @param ddc : I2C (DDC) rate 
+ * @param uart1 : UART1 rate 
+ * @param uart2 : UART2 rate 
+ * @param usb : USB rate 
+ * @param spi : SPI rate 
+ * @return M8qMsg : ready to send message 
+ */
+constexpr auto m8q_cfg_msg(
+    uint8_t msg_class, 
+    uint8_t msg_id, 
+    uint8_t ddc, 
+    uint8_t uart1 = CLEAR, 
+    uint8_t uart2 = CLEAR, 
+    uint8_t usb = CLEAR, 
+    uint8_t spi = CLEAR)
+{
+    const uint8_t payload[] = { msg_class, msg_id, ddc, uart1, uart2, usb, spi, CLEAR }; 
+    return m8q_ubx_msg(M8Q_UBX_CLASS_CFG, M8Q_UBX_CFG_MSG, payload); 
+}
+
+
+/**
+ * @brief CFG-RATE - navigation/measurement rate 
+ * 
+ * @param meas_rate : time between measurements (ms)
+ * @param nav_rate : number of measurements per navigation solution 
+ * @param time_ref : time system the measurements are aligned to (0: UTC, 1: GPS)
+ * @return M8qMsg : ready to send message 
+ */
+constexpr auto m8q_cfg_rate(
+    uint16_t meas_rate, 
+    uint16_t nav_rate, 
+    uint16_t time_ref)
+{
+    const uint8_t payload[] = 
+    {
+        (uint8_t)meas_rate, (uint8_t)(meas_rate >> SHIFT_8), 
+        (uint8_t)nav_rate, (uint8_t)(nav_rate >> SHIFT_8), 
+        (uint8_t)time_ref, (uint8_t)(time_ref >> SHIFT_8)
+    }; 
+    return m8q_ubx_msg(M8Q_UBX_CLASS_CFG, M8Q_UBX_CFG_RATE, payload); 
+}
+
+
+/**
+ * @brief CFG-PRT - I2C (DDC) port configuration 
+ * 
+ * @details Sets the protocols used on the I2C port and the TX ready output. TX ready 
+ *          goes active (high) once 'txr_thres' bytes are waiting in the data stream. 
+ *          A 'txr_thres' of zero disables TX ready. 
+ * 
+ * @see m8q_txr_pin_init 
+ * 
+ * @param in_proto : input protocol mask (M8Q_PRT_PROTO_x)
+ * @param out_proto : output protocol mask (M8Q_PRT_PROTO_x)
+ * @param txr_pin : device PIO used for TX ready 
+ * @param txr_thres : TX ready threshold (bytes, multiple of 8)
+ * @param flags : port flags (ex. M8Q_PRT_EXT_TX_TIMEOUT)
+ * @return M8qMsg : ready to send message 
+ */
+constexpr auto m8q_cfg_prt_ddc(
+    uint16_t in_proto, 
+    uint16_t out_proto, 
+    uint8_t txr_pin, 
+    uint16_t txr_thres, 
+    uint16_t flags)
+{
+    const uint16_t tx_ready = (!txr_thres) ? CLEAR : 
+        (uint16_t)(SET_BIT | 
+                   ((txr_pin & M8Q_PRT_TXR_PIN_MASK) << M8Q_PRT_TXR_PIN_SHIFT) | 
+                   ((txr_thres / M8Q_PRT_TXR_THRES_UNIT) << M8Q_PRT_TXR_THRES_SHIFT)); 
+
+    const uint8_t payload[] = 
+    {
+        M8Q_PRT_ID_DDC, CLEAR, 
+        (uint8_t)tx_ready, (uint8_t)(tx_ready >> SHIFT_8), 
+        M8Q_PRT_DDC_MODE, CLEAR, CLEAR, CLEAR, 
+        CLEAR, CLEAR, CLEAR, CLEAR, 
+        (uint8_t)in_proto, (uint8_t)(in_proto >> SHIFT_8), 
+        (uint8_t)out_proto, (uint8_t)(out_proto >> SHIFT_8), 
+        (uint8_t)flags, (uint8_t)(flags >> SHIFT_8), 
+        CLEAR, CLEAR 
+    }; 
+    return m8q_ubx_msg(M8Q_UBX_CLASS_CFG, M8Q_UBX_CFG_PRT, payload); 
+}
+
+
+/**
+ * @brief CFG-CFG - clear, save and load configurations 
+ * 
+ * @param clear_mask : configuration sections to clear 
+ * @param save_mask : configuration sections to save 
+ * @param load_mask : configuration sections to load 
+ * @return M8qMsg : ready to send message 
+ */
+constexpr auto m8q_cfg_cfg(
+    uint32_t clear_mask, 
+    uint32_t save_mask, 
+    uint32_t load_mask)
+{
+    const uint8_t payload[] = 
+    {
+        (uint8_t)clear_mask, (uint8_t)(clear_mask >> SHIFT_8), 
+        (uint8_t)(clear_mask >> SHIFT_16), (uint8_t)(clear_mask >> SHIFT_24), 
+        (uint8_t)save_mask, (uint8_t)(save_mask >> SHIFT_8), 
+        (uint8_t)(save_mask >> SHIFT_16), (uint8_t)(save_mask >> SHIFT_24), 
+        (uint8_t)load_mask, (uint8_t)(load_mask >> SHIFT_8), 
+        (uint8_t)(load_mask >> SHIFT_16), (uint8_t)(load_mask >> SHIFT_24)
+    }; 
+    return m8q_ubx_msg(M8Q_UBX_CLASS_CFG, M8Q_UBX_CFG_CFG, payload); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// NMEA messages 
+
+/**
+ * @brief PUBX RATE - NMEA message output rate on each port 
+ * 
+ * @details Same as CFG-MSG but for standard NMEA messages using their 3 character 
+ *          message ID (ex. "GGA"). 
+ * 
+ * @param msg_id : NMEA message ID 
+ * @param ddc : I2C (DDC) rate 
+ * @param uart1 : UART1 rate 
+ * @param uart2 : UART2 rate 
+ * @param usb : USB rate 
+ * @param spi : SPI rate 
+ * @return M8qMsg : ready to send message 
+ */
+constexpr M8qMsg<M8Q_PUBX_RATE_MAX_LEN> m8q_pubx_rate(
+    const char (&msg_id)[BYTE_4], 
+    uint8_t ddc, 
+    uint8_t uart1 = CLEAR, 
+    uint8_t uart2 = CLEAR, 
+    uint8_t usb = CLEAR, 
+    uint8_t spi = CLEAR)
+{
+    M8qMsg<M8Q_PUBX_RATE_MAX_LEN> msg = {}; 
+    const char header[] = "$PUBX,40,"; 
+    const uint8_t rates[] = { ddc, uart1, uart2, usb, spi, CLEAR }; 
+    uint8_t len = CLEAR; 
+
+    for (uint8_t i = CLEAR; header[i]; i++)
+    {
+        msg.data[len++] = (uint8_t)header[i]; 
+    }
+
+    for (uint8_t i = CLEAR; i < BYTE_3; i++)
+    {
+        msg.data[len++] = (uint8_t)msg_id[i]; 
+    }
+
+    // Rates are written in decimal without leading zeros 
+    for (uint8_t rate : rates)
+    {
+        msg.data[len++] = ','; 
+
+        if (rate >= 100)
+        {
+            msg.data[len++] = (uint8_t)('0' + (rate / 100)); 
+        }
+        if (rate >= 10)
+        {
+            msg.data[len++] = (uint8_t)('0' + ((rate / 10) % 10)); 
+        }
+        msg.data[len++] = (uint8_t)('0' + (rate % 10)); 
+    }
+
+    msg.size = len; 
+    m8q_nmea_msg_end(msg); 
+
+    return msg; 
+}
+
+//=======================================================================================
+
+
+#endif   // _M8Q_CONFIG_BUILDER_H_ 
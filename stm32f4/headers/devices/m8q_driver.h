@@ -28,6 +28,24 @@ extern "C" {
 //=======================================================================================
 
 
+//=======================================================================================
+// Macros 
+
+// Data stream read chunk size. The data stream is read and parsed in pieces of at most 
+// this size so driver memory use does not depend on how much data the device has queued. 
+#ifndef M8Q_STREAM_BUFF_SIZE 
+#define M8Q_STREAM_BUFF_SIZE 64 
+#endif 
+
+// RTCM3 frame sizes 
+#define M8Q_RTCM_HEADER_LEN 3        // Preamble and message length 
+#define M8Q_RTCM_CRC_LEN 3           // CRC-24Q 
+#define M8Q_RTCM_MAX_PAYLOAD 1023    // Largest message length field value 
+#define M8Q_RTCM_MAX_FRAME_LEN (M8Q_RTCM_HEADER_LEN + M8Q_RTCM_MAX_PAYLOAD + M8Q_RTCM_CRC_LEN) 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Enums 
 
@@ -40,7 +58,8 @@ typedef enum {
     M8Q_READ_FAULT         = 0x00000008,   // A problem occurred while reading via I2C 
     M8Q_NO_DATA_AVAILABLE  = 0x00000010,   // The data stream is empty or does not have the needed info 
     M8Q_DATA_BUFF_OVERFLOW = 0x00000020,   // Device data buffer (stream size) exceeds driver threshold 
-    M8Q_UNKNOWN_DATA       = 0x00000040    // Unknown message stream data 
+    M8Q_UNKNOWN_DATA       = 0x00000040,   // Unknown message stream data 
+    M8Q_BAD_CHECKSUM       = 0x00000080    // Message checksum doesn't match its contents 
 } m8q_status_t;
 
 
@@ -56,6 +75,57 @@ typedef enum {
     M8Q_NAVSTAT_TT = 0x5454    // Time only solution 
 } m8q_navstats_t;
 
+
+// POSITION message fields seen in the last message (see m8q_get_position_valid) 
+typedef enum {
+    M8Q_POS_VALID_TIME    = 0x00000001,   // UTC time 
+    M8Q_POS_VALID_LAT     = 0x00000002,   // Latitude 
+    M8Q_POS_VALID_NS      = 0x00000004,   // North/South indicator 
+    M8Q_POS_VALID_LON     = 0x00000008,   // Longitude 
+    M8Q_POS_VALID_EW      = 0x00000010,   // East/West indicator 
+    M8Q_POS_VALID_ALTREF  = 0x00000020,   // Altitude above user datum ellipsoid 
+    M8Q_POS_VALID_NAVSTAT = 0x00000040,   // Navigation status 
+    M8Q_POS_VALID_HACC    = 0x00000080,   // Horizontal accuracy estimate 
+    M8Q_POS_VALID_VACC    = 0x00000100,   // Vertical accuracy estimate 
+    M8Q_POS_VALID_SOG     = 0x00000200,   // Speed over ground 
+    M8Q_POS_VALID_COG     = 0x00000400,   // Course over ground 
+    M8Q_POS_VALID_VVEL    = 0x00000800,   // Vertical velocity 
+    M8Q_POS_VALID_DIFFAGE = 0x00001000,   // Age of differential corrections 
+    M8Q_POS_VALID_HDOP    = 0x00002000,   // Horizontal dilution of precision 
+    M8Q_POS_VALID_VDOP    = 0x00004000,   // Vertical dilution of precision 
+    M8Q_POS_VALID_TDOP    = 0x00008000,   // Time dilution of precision 
+    M8Q_POS_VALID_NUMSVS  = 0x00010000,   // Number of satellites used 
+    M8Q_POS_VALID_RES     = 0x00020000,   // Reserved 
+    M8Q_POS_VALID_DR      = 0x00040000    // DR used 
+} m8q_pos_valid_t; 
+
+
+// TIME message fields seen in the last message (see m8q_get_time_valid) 
+typedef enum {
+    M8Q_TIME_VALID_TIME     = 0x01,   // UTC time 
+    M8Q_TIME_VALID_DATE     = 0x02,   // UTC date 
+    M8Q_TIME_VALID_UTCTOW   = 0x04,   // UTC time of week 
+    M8Q_TIME_VALID_UTCWK    = 0x08,   // UTC week number 
+    M8Q_TIME_VALID_LEAPSEC  = 0x10,   // Leap seconds 
+    M8Q_TIME_VALID_CLKBIAS  = 0x20,   // Receiver clock bias 
+    M8Q_TIME_VALID_CLKDRIFT = 0x40,   // Receiver clock drift 
+    M8Q_TIME_VALID_TPGRAN   = 0x80    // Time pulse granularity 
+} m8q_time_valid_t; 
+
+
+// Message types that have their own stream health counters (see m8q_get_msg_stats) 
+typedef enum {
+    M8Q_STATS_POSITION,     // NMEA PUBX POSITION 
+    M8Q_STATS_TIME,         // NMEA PUBX TIME 
+    M8Q_STATS_NMEA,         // All other NMEA messages 
+    M8Q_STATS_NAV_PVT,      // UBX NAV-PVT 
+    M8Q_STATS_NAV_STATUS,   // UBX NAV-STATUS 
+    M8Q_STATS_NAV_DOP,      // UBX NAV-DOP 
+    M8Q_STATS_ACK,          // UBX ACK-ACK and ACK-NAK 
+    M8Q_STATS_UBX,          // All other UBX messages 
+    M8Q_STATS_NUM 
+} m8q_msg_stats_type_t; 
+
 //=======================================================================================
 
 
@@ -64,6 +134,121 @@ typedef enum {
 
 typedef uint32_t M8Q_STATUS; 
 
+
+// Data stream health counters for a message type 
+typedef struct m8q_msg_stats_s 
+{
+    uint32_t accepted;        // Messages with a valid checksum that were taken in 
+    uint32_t bad_checksum;    // Messages discarded because of a checksum mismatch 
+    uint32_t truncated;       // Messages cut short before their checksum 
+    uint32_t unknown;         // Messages not recognized or with an unexpected layout 
+}
+m8q_msg_stats_t; 
+
+
+// POSITION message values. Each value is converted from its field string as soon as the 
+// field is read so getters don't need to parse strings. 
+typedef struct m8q_pos_value_s 
+{
+    int32_t lat;          // Latitude (deg*10^7) 
+    int32_t lon;          // Longitude (deg*10^7) 
+    int32_t altRef;       // Altitude above user datum ellipsoid (mm) 
+    uint16_t navStat;     // Navigation status 
+    uint32_t hAcc;        // Horizontal accuracy estimate (m*10) 
+    uint32_t vAcc;        // Vertical accuracy estimate (m*10) 
+    uint32_t SOG;         // Speed over ground (km/h*1000) 
+    uint32_t COG;         // Course over ground (deg*100) 
+    int32_t vVel;         // Vertical velocity (mm/s) 
+    uint32_t valid;       // Fields seen in the last message - see m8q_pos_valid_t 
+    uint32_t seq;         // Message sequence number 
+}
+m8q_pos_value_t; 
+
+
+// TIME message values 
+typedef struct m8q_time_value_s 
+{
+    uint32_t time;        // UTC time (hhmmss*100) 
+    uint32_t date;        // UTC date (ddmmyy) 
+    uint32_t utcTow;      // UTC time of week (s*100) 
+    uint16_t utcWk;       // UTC week number 
+    uint8_t valid;        // Fields seen in the last message - see m8q_time_valid_t 
+    uint32_t seq;         // Message sequence number 
+}
+m8q_time_value_t; 
+
+
+// UBX NAV message fields (NAV-PVT, NAV-STATUS and NAV-DOP). Values are stored in the 
+// units the device sends them in so no conversion is needed when they're read. 
+typedef struct m8q_ubx_nav_s
+{
+    uint32_t iTOW;       // GPS time of week of the navigation solution (ms) 
+    uint8_t fixType;     // GNSS fix type 
+    uint8_t flags;       // Fix status flags 
+    uint8_t numSV;       // Number of satellites used in the navigation solution 
+    int32_t lon;         // Longitude (deg*10^7) 
+    int32_t lat;         // Latitude (deg*10^7) 
+    int32_t height;      // Height above ellipsoid (mm) 
+    int32_t hMSL;        // Height above mean sea level (mm) 
+    uint32_t hAcc;       // Horizontal accuracy estimate (mm) 
+    uint32_t vAcc;       // Vertical accuracy estimate (mm) 
+    int32_t velN;        // NED north velocity (mm/s) 
+    int32_t velE;        // NED east velocity (mm/s) 
+    int32_t velD;        // NED down velocity (mm/s) 
+    int32_t gSpeed;      // Ground speed (mm/s) 
+    int32_t headMot;     // Heading of motion (deg*10^5) 
+    uint32_t sAcc;       // Speed accuracy estimate (mm/s) 
+    uint16_t pDOP;       // Position DOP (*0.01) 
+    uint16_t vDOP;       // Vertical DOP (*0.01) 
+    uint16_t hDOP;       // Horizontal DOP (*0.01) 
+    uint32_t ttff;       // Time to first fix (ms) 
+    uint32_t msss;       // Time since startup/reset (ms) 
+}
+m8q_ubx_nav_t; 
+
+
+// Consistent copy of the latest position, time and accuracy data (see m8q_get_snapshot) 
+typedef struct m8q_snapshot_s 
+{
+    uint32_t seq;              // Snapshot sequence number - increments with each update 
+    m8q_pos_value_t pos;       // POSITION message values 
+    m8q_time_value_t time;     // TIME message values 
+    m8q_ubx_nav_t nav;         // NAV-PVT, NAV-STATUS and NAV-DOP values 
+}
+m8q_snapshot_t; 
+
+
+// New fix callback (see m8q_set_fix_callback) 
+typedef void (*m8q_fix_callback_t)(const m8q_snapshot_t *snapshot); 
+
+
+// Ready to send message - no format checks or conversion needed (see m8q_config_raw) 
+typedef struct m8q_raw_msg_s 
+{
+    const uint8_t *msg;   // Message bytes exactly as they're sent to the device 
+    uint8_t msg_size;     // Number of bytes in msg 
+}
+m8q_raw_msg_t; 
+
+
+// RTCM3 correction passthrough record (see m8q_rtcm_forward). One is needed for each 
+// link that corrections come in on. 
+typedef struct m8q_rtcm_s 
+{
+    // Frame detector 
+    uint16_t scan;          // Circular buffer index of the next byte to check 
+    uint16_t frame_start;   // Circular buffer index of the current frame preamble 
+    uint16_t frame_len;     // Length of the current frame (header, payload and CRC) 
+    uint16_t frame_count;   // Bytes of the current frame seen (0 if not in a frame) 
+    uint32_t crc;           // CRC-24Q of the current frame bytes seen 
+
+    // Counters 
+    uint32_t frames;        // Frames with a valid CRC sent to the device 
+    uint32_t bad_crc;       // Frames dropped because of a CRC mismatch 
+    uint32_t skipped;       // Bytes dropped because they weren't part of a frame 
+}
+m8q_rtcm_t; 
+
 //=======================================================================================
 
 
@@ -94,20 +279,26 @@ typedef uint32_t M8Q_STATUS;
  *          of the device, which is what the messages passed to this function are 
  *          intended to do. 
  *          
- *          The 'data_buff_limit' argument is used to set the max buffer size the driver 
- *          is allowed to allocate when reading the device data stream. If the data 
- *          stream is larger than the max buffer size and a read is attempted, then 
- *          the driver will be forced to flush the data stream without recording any 
- *          data and an overflow status will be indicated. If this argument is set to 
- *          zero then there will be no limit set. 
+ *          The 'data_buff_limit' argument is used to set the max data stream size the 
+ *          driver will read and sort in one call to m8q_read_data. The stream is read in 
+ *          chunks of M8Q_STREAM_BUFF_SIZE so this limit does not change driver memory 
+ *          use. If the data stream is larger than the limit and a read is attempted, 
+ *          then the driver will flush the data stream without recording any data and an 
+ *          overflow status will be indicated. If this argument is set to zero then there 
+ *          will be no limit set. 
+ *          
+ *          If the configuration messages are already in their sent format (ex. made by 
+ *          m8q_config_builder.h) then make 'msg_num' zero ('config_msgs' can then be 
+ *          NULL) and send them with m8q_config_raw after this function. 
  * 
  * @see m8q_send_msg 
+ * @see m8q_config_raw 
  * 
  * @param i2c : I2C port used for communicating with the device 
  * @param config_msgs : buffer that contains the configuration messages 
  * @param msg_num : number of configuration messages 
  * @param max_msg_size : max possible config message size in config_msgs 
- * @param data_buff_limit : max buffer size that can be allocated to read data stream 
+ * @param data_buff_limit : max data stream size that can be read in one call 
  * @return M8Q_STATUS : status of the initialization 
  */
 M8Q_STATUS m8q_init(
@@ -156,6 +347,34 @@ M8Q_STATUS m8q_txr_pin_init(
     GPIO_TypeDef *gpio, 
     pin_selector_t tx_ready_pin); 
 
+
+/**
+ * @brief M8Q UBX NAV message configuration 
+ * 
+ * @details Sets the device up to output the UBX NAV-PVT, NAV-STATUS and NAV-DOP 
+ *          messages on every navigation solution and optionally sets the navigation 
+ *          measurement rate. These binary messages are decoded directly into integer 
+ *          values as they're read so the NAV getters are simple loads with no string 
+ *          parsing. This is the faster alternative to reading position from the PUBX 
+ *          POSITION message and allows the device to be run at higher rates (ex. 10Hz). 
+ *          
+ *          The messages are sent as CFG messages so the device must ACK each one. If a 
+ *          message is not acknowledged then an invalid config status is returned. This 
+ *          function does not turn off any NMEA messages - if they're not needed then 
+ *          they should be turned off using config messages passed to m8q_init so the 
+ *          data stream stays small. 
+ *          
+ *          This function must be called after m8q_init. The NAV messages are decoded 
+ *          whenever they're seen in the data stream so calling this function is not 
+ *          needed if the messages are already enabled through m8q_init. 
+ * 
+ * @see m8q_init 
+ * 
+ * @param meas_rate : time between measurements (ms) - zero leaves the rate unchanged 
+ * @return M8Q_STATUS : status of the configuration 
+ */
+M8Q_STATUS m8q_nav_config(uint16_t meas_rate); 
+
 //=======================================================================================
 
 
@@ -170,17 +389,20 @@ M8Q_STATUS m8q_txr_pin_init(
  *           - NMEA messages: 
  *             - Standard: None 
  *             - PUBX : POSITION, TIME 
- *           - UBX messages: None 
+ *           - UBX messages: NAV-PVT, NAV-STATUS, NAV-DOP 
  *          
  *          This function first reads the size of the data stream. If it's not zero and 
  *          the stream isn't greater than the max buffer size then the data stream is read 
- *          in its entirety. The messages read get either stored in the driver or 
- *          discarded, and if they're stored, their data can be accessed through the 
- *          getter functions. If the data stream size is greater than the max buffer size 
+ *          in its entirety, M8Q_STREAM_BUFF_SIZE bytes at a time, and each piece is 
+ *          passed to the stream parser. The messages read get either stored in the driver 
+ *          or discarded, and if they're stored, their data can be accessed through the 
+ *          getter functions. A message that is split across two reads is completed on 
+ *          the next read. If the data stream size is greater than the max buffer size 
  *          then the stream gets cleared without storing data and an overflow status is 
  *          returned. If there is no data then a no data status is returned. 
  * 
  * @see m8q_init 
+ * @see m8q_parse_data 
  * 
  * @return M8Q_STATUS : status of read attempt 
  */
@@ -218,6 +440,39 @@ M8Q_STATUS m8q_read_ds(
 M8Q_STATUS m8q_read_ds_size(uint16_t *data_size); 
 
 
+/**
+ * @brief Parse device data stream bytes 
+ * 
+ * @details Passes data stream bytes through the driver message parser. The parser works 
+ *          one byte at a time and keeps its place within a message between calls so 
+ *          'data_buff' can hold any amount of the stream, including part of a message. 
+ *          Messages that have a data record are stored the same way as in 
+ *          m8q_read_data. m8q_read_data uses this function for the data it reads from 
+ *          the device, but it can also be used to feed the driver stream data that was 
+ *          read some other way (ex. recorded device output). 
+ *          
+ *          If bytes are seen that don't belong to a known message then an unknown data 
+ *          status is returned and the parser moves on to the next message start. 
+ *          
+ *          The NMEA (*hh) and UBX (CK_A, CK_B) checksum of each message is worked out 
+ *          as the message bytes are parsed. Stored messages are only copied to the data 
+ *          record once their checksum has been verified, so a corrupted or cut short 
+ *          message can't overwrite good data. A bad checksum status is returned if a 
+ *          checksum doesn't match. Each message seen is counted in the stream health 
+ *          counters (see m8q_get_msg_stats). 
+ * 
+ * @see m8q_read_data 
+ * @see m8q_get_msg_stats 
+ * 
+ * @param data_buff : buffer that contains data stream bytes 
+ * @param data_size : number of bytes in data_buff 
+ * @return M8Q_STATUS : status of the parse 
+ */
+M8Q_STATUS m8q_parse_data(
+    const uint8_t *data_buff, 
+    uint16_t data_size); 
+
+
 /**
  * @brief ACK/NAK message counter status 
  * 
@@ -240,6 +495,33 @@ M8Q_STATUS m8q_read_ds_size(uint16_t *data_size);
 uint16_t m8q_get_ack_status(void); 
 
 
+/**
+ * @brief Get data stream health counters 
+ * 
+ * @details Returns the accepted, bad checksum, truncated and unknown message counts for 
+ *          a message type. Counters start from zero in m8q_init and are updated as the 
+ *          data stream is parsed. These can be used to gauge the quality of the link to 
+ *          the device. Note that a UBX message that's cut short can't be told apart from 
+ *          a corrupted one so it's counted as a bad checksum. 
+ * 
+ * @see m8q_clear_msg_stats 
+ * 
+ * @param type : message type - see m8q_msg_stats_type_t 
+ * @return m8q_msg_stats_t : counters of the message type (all zero for an invalid type) 
+ */
+m8q_msg_stats_t m8q_get_msg_stats(m8q_msg_stats_type_t type); 
+
+
+/**
+ * @brief Clear data stream health counters 
+ * 
+ * @details Sets the counters of all message types to zero. 
+ * 
+ * @see m8q_get_msg_stats 
+ */
+void m8q_clear_msg_stats(void); 
+
+
 /**
  * @brief Write a message to the device 
  * 
@@ -284,6 +566,50 @@ M8Q_STATUS m8q_send_msg(
     uint8_t max_msg_size); 
 
 
+/**
+ * @brief Write a ready to send message to the device 
+ * 
+ * @details Sends a message that's already in the format the device reads (NMEA 
+ *          checksum and end sequence included, UBX in binary with its checksum). No 
+ *          checks or conversions are done so this is a single I2C write. Messages in 
+ *          this format can be made at compile time with m8q_config_builder.h. 
+ * 
+ * @see m8q_config_raw 
+ * 
+ * @param msg : buffer that contains the message to be sent to the device 
+ * @param msg_size : size of the message being sent 
+ * @return M8Q_STATUS : status of the write attempt 
+ */
+M8Q_STATUS m8q_send_raw_msg(
+    const uint8_t *msg, 
+    uint8_t msg_size); 
+
+
+/**
+ * @brief Send ready to send configuration messages 
+ * 
+ * @details Does the same as the configuration part of m8q_init but for messages that 
+ *          are already in their sent format. Each message is written with 
+ *          m8q_send_raw_msg and UBX CFG messages wait for an ACK. If a message fails to 
+ *          send or gets no ACK then the remaining messages are not sent and the status 
+ *          is returned. 
+ *          
+ *          Since the messages don't need to be checked or converted they can be stored 
+ *          in flash and sent as they are, which saves the boot time and stack used by 
+ *          the ASCII message format of m8q_init. 
+ * 
+ * @see m8q_send_raw_msg 
+ * @see m8q_init 
+ * 
+ * @param config_msgs : list of configuration messages 
+ * @param msg_num : number of configuration messages 
+ * @return M8Q_STATUS : status of the configuration 
+ */
+M8Q_STATUS m8q_config_raw(
+    const m8q_raw_msg_t *config_msgs, 
+    uint8_t msg_num); 
+
+
 /**
  * @brief Get TX ready status 
  * 
@@ -295,6 +621,66 @@ M8Q_STATUS m8q_send_msg(
 GPIO_STATE m8q_get_tx_ready(void); 
 
 
+/**
+ * @brief TX ready interrupt 
+ * 
+ * @details Call from the EXTI interrupt handler of the TX ready pin to tell the driver 
+ *          that the device has data to be read. This only sets a flag so it's quick and 
+ *          safe to call from an interrupt. The data is read later by m8q_txr_read from 
+ *          a task. 
+ *          
+ *          The application sets up the EXTI line of the TX ready pin (rising edge, see 
+ *          exti_config and nvic_config) and the device must have TX ready enabled on its 
+ *          I2C (DDC) port (CFG-PRT txReady). 
+ * 
+ * @see m8q_txr_pin_init 
+ * @see m8q_txr_read 
+ */
+void m8q_txr_irq(void); 
+
+
+/**
+ * @brief Read the data stream after a TX ready interrupt 
+ * 
+ * @details If m8q_txr_irq has been called since the last read then the available data 
+ *          stream size is read and exactly that many bytes are read and parsed the same 
+ *          as m8q_read_data. If there hasn't been an interrupt then the function returns 
+ *          right away without using the I2C bus, so there are no wasted polls of an 
+ *          empty data stream. If the TX ready pin is still high after the read (more 
+ *          data came in during the read) then the next call reads again. 
+ *          
+ *          Call this from task (thread) context, ex. a task woken by a notification from 
+ *          the EXTI handler, and not from the handler itself. The read is a blocking I2C 
+ *          transfer and the data is parsed and the fix callback is called before it 
+ *          returns. m8q_txr_pin_init must be called first. 
+ * 
+ * @see m8q_txr_pin_init 
+ * @see m8q_txr_irq 
+ * @see m8q_read_data 
+ * @see m8q_set_fix_callback 
+ * 
+ * @return M8Q_STATUS : status of the read, no data available status if there was no 
+ *                      TX ready interrupt, invalid pointer status if the TX ready pin 
+ *                      hasn't been initialized 
+ */
+M8Q_STATUS m8q_txr_read(void); 
+
+
+/**
+ * @brief Set the new fix callback 
+ * 
+ * @details The callback is called each time a POSITION or NAV-PVT message is accepted 
+ *          and published to the snapshot (see m8q_get_snapshot). The callback is given 
+ *          the new snapshot and is called from the context that's parsing data (i.e. 
+ *          m8q_read_data, m8q_txr_read or m8q_parse_data) so it should be short, for 
+ *          example copying the snapshot or signaling a task. Passing NULL disables the 
+ *          callback. 
+ * 
+ * @param callback : function to call when a new fix is published 
+ */
+void m8q_set_fix_callback(m8q_fix_callback_t callback); 
+
+
 /**
  * @brief Enter low power mode 
  * 
@@ -320,6 +706,40 @@ void m8q_clear_low_pwr(void);
 //=======================================================================================
 // POSITION (PUBX,00) message
 
+// Numeric POSITION values are converted once as each field of the message is read so 
+// the numeric getters below don't parse strings. String getters return the field text 
+// exactly as it was read from the device. 
+
+/**
+ * @brief Get the number of POSITION messages read 
+ * 
+ * @details Returns a counter that increments each time a complete POSITION message is 
+ *          read. The application can compare this against the last value it saw to 
+ *          know if there is a new position without comparing data. The counter rolls 
+ *          over and is reset by m8q_init. 
+ * 
+ * @see m8q_read_data 
+ * 
+ * @return uint32_t : POSITION message sequence number 
+ */
+uint32_t m8q_get_position_seq(void); 
+
+
+/**
+ * @brief Get the POSITION fields seen in the last message 
+ * 
+ * @details Returns a bitmask of the fields that were not empty in the last complete 
+ *          POSITION message. The device leaves fields empty when it has no value for 
+ *          them (ex. no fix) and the numeric value of an empty field reads as zero. See 
+ *          m8q_pos_valid_t for the field bits. 
+ * 
+ * @see m8q_pos_valid_t 
+ * 
+ * @return uint32_t : bitmask of fields seen in the last POSITION message 
+ */
+uint32_t m8q_get_position_valid(void); 
+
+
 /**
  * @brief Get the floating point latitude coordinate (degrees) 
  * 
@@ -697,6 +1117,76 @@ int32_t m8q_get_position_vvelI(void);
 //=======================================================================================
 // TIME (PUBX,04) message 
 
+/**
+ * @brief Get the number of TIME messages read 
+ * 
+ * @details Returns a counter that increments each time a complete TIME message is read. 
+ *          The counter rolls over and is reset by m8q_init. 
+ * 
+ * @return uint32_t : TIME message sequence number 
+ */
+uint32_t m8q_get_time_seq(void); 
+
+
+/**
+ * @brief Get the TIME fields seen in the last message 
+ * 
+ * @details Returns a bitmask of the fields that were not empty in the last complete TIME 
+ *          message. See m8q_time_valid_t for the field bits. 
+ * 
+ * @see m8q_time_valid_t 
+ * 
+ * @return uint8_t : bitmask of fields seen in the last TIME message 
+ */
+uint8_t m8q_get_time_valid(void); 
+
+
+/**
+ * @brief Get UTC time as a scaled integer 
+ * 
+ * @details Get the UTC time read from the TIME PUBX NMEA message as an integer of the 
+ *          form hhmmss*100 + hundredths of a second (ex. "073731.00" --> 7373100). 
+ *          
+ *          This value is only updated if new TIME messages are read. 
+ * 
+ * @return uint32_t : UTC time (hhmmss*100) 
+ */
+uint32_t m8q_get_time_utc_timeI(void); 
+
+
+/**
+ * @brief Get UTC date as an integer 
+ * 
+ * @details Get the UTC date read from the TIME PUBX NMEA message as an integer of the 
+ *          form ddmmyy (ex. "091202" --> 91202). 
+ *          
+ *          This value is only updated if new TIME messages are read. 
+ * 
+ * @return uint32_t : UTC date (ddmmyy) 
+ */
+uint32_t m8q_get_time_utc_dateI(void); 
+
+
+/**
+ * @brief Get UTC time of week as a scaled integer 
+ * 
+ * @details This value is only updated if new TIME messages are read. 
+ * 
+ * @return uint32_t : UTC time of week (s*100) 
+ */
+uint32_t m8q_get_time_utc_towI(void); 
+
+
+/**
+ * @brief Get UTC week number 
+ * 
+ * @details This value is only updated if new TIME messages are read. 
+ * 
+ * @return uint16_t : UTC week number 
+ */
+uint16_t m8q_get_time_utc_wk(void); 
+
+
 /**
  * @brief Get UTC time 
  * 
@@ -734,6 +1224,341 @@ M8Q_STATUS m8q_get_time_utc_date(
 
 //=======================================================================================
 
+
+//=======================================================================================
+// NAV (UBX NAV-PVT, NAV-STATUS, NAV-DOP) messages 
+
+/**
+ * @brief Get GPS time of week of the navigation solution (ms) 
+ * 
+ * @details Returns iTOW from the NAV-PVT message. iTOW is the same for all NAV messages 
+ *          of the same navigation solution so it can be used to check that data from 
+ *          different messages belongs together. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @see m8q_nav_config 
+ * 
+ * @return uint32_t : GPS time of week (ms) 
+ */
+uint32_t m8q_get_nav_itow(void); 
+
+
+/**
+ * @brief Get the GNSS fix type 
+ * 
+ * @details Returns the fix type from the NAV-PVT message: 0 - no fix, 1 - dead 
+ *          reckoning only, 2 - 2D fix, 3 - 3D fix, 4 - GNSS + dead reckoning, 5 - time 
+ *          only fix. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return uint8_t : fix type 
+ */
+uint8_t m8q_get_nav_fix_type(void); 
+
+
+/**
+ * @brief Get acceptable navigation status 
+ * 
+ * @details Returns true if the NAV-PVT message reports a valid fix (gnssFixOK) and the 
+ *          fix type is 2D, 3D or GNSS + dead reckoning. This is the NAV-PVT equivalent 
+ *          of m8q_get_position_navstat_lock. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @see m8q_get_position_navstat_lock 
+ * 
+ * @return uint8_t : true if there is a position lock, false otherwise 
+ */
+uint8_t m8q_get_nav_fix_lock(void); 
+
+
+/**
+ * @brief Get the number of satellites used in the navigation solution 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return uint8_t : number of satellites used 
+ */
+uint8_t m8q_get_nav_num_sv(void); 
+
+
+/**
+ * @brief Get latitude (degrees*10^7) 
+ * 
+ * @details Returns latitude from the NAV-PVT message as a scaled integer in the range 
+ *          of +/-900000000 degrees*10^7. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : latitude (degrees*10^7) 
+ */
+int32_t m8q_get_nav_lat(void); 
+
+
+/**
+ * @brief Get longitude (degrees*10^7) 
+ * 
+ * @details Returns longitude from the NAV-PVT message as a scaled integer in the range 
+ *          of +/-1800000000 degrees*10^7. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : longitude (degrees*10^7) 
+ */
+int32_t m8q_get_nav_lon(void); 
+
+
+/**
+ * @brief Get height above the ellipsoid (mm) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : height above the ellipsoid (mm) 
+ */
+int32_t m8q_get_nav_height(void); 
+
+
+/**
+ * @brief Get height above mean sea level (mm) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : height above mean sea level (mm) 
+ */
+int32_t m8q_get_nav_hmsl(void); 
+
+
+/**
+ * @brief Get horizontal accuracy estimate (mm) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return uint32_t : horizontal accuracy estimate (mm) 
+ */
+uint32_t m8q_get_nav_hacc(void); 
+
+
+/**
+ * @brief Get vertical accuracy estimate (mm) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return uint32_t : vertical accuracy estimate (mm) 
+ */
+uint32_t m8q_get_nav_vacc(void); 
+
+
+/**
+ * @brief Get NED north velocity (mm/s) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : north velocity (mm/s) 
+ */
+int32_t m8q_get_nav_vel_n(void); 
+
+
+/**
+ * @brief Get NED east velocity (mm/s) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : east velocity (mm/s) 
+ */
+int32_t m8q_get_nav_vel_e(void); 
+
+
+/**
+ * @brief Get NED down velocity (mm/s) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : down velocity (mm/s) 
+ */
+int32_t m8q_get_nav_vel_d(void); 
+
+
+/**
+ * @brief Get ground speed (mm/s) 
+ * 
+ * @details Returns the 2D ground speed from the NAV-PVT message. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : ground speed (mm/s) 
+ */
+int32_t m8q_get_nav_gspeed(void); 
+
+
+/**
+ * @brief Get heading of motion (degrees*10^5) 
+ * 
+ * @details Returns the 2D heading of motion from the NAV-PVT message. 
+ *          
+ *          This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return int32_t : heading of motion (degrees*10^5) 
+ */
+int32_t m8q_get_nav_head_mot(void); 
+
+
+/**
+ * @brief Get speed accuracy estimate (mm/s) 
+ * 
+ * @details This value is only updated if new NAV-PVT messages are read. 
+ * 
+ * @return uint32_t : speed accuracy estimate (mm/s) 
+ */
+uint32_t m8q_get_nav_sacc(void); 
+
+
+/**
+ * @brief Get position DOP (*0.01) 
+ * 
+ * @details This value is updated when new NAV-PVT or NAV-DOP messages are read. 
+ * 
+ * @return uint16_t : position DOP (*0.01) 
+ */
+uint16_t m8q_get_nav_pdop(void); 
+
+
+/**
+ * @brief Get horizontal DOP (*0.01) 
+ * 
+ * @details This value is only updated if new NAV-DOP messages are read. 
+ * 
+ * @return uint16_t : horizontal DOP (*0.01) 
+ */
+uint16_t m8q_get_nav_hdop(void); 
+
+
+/**
+ * @brief Get vertical DOP (*0.01) 
+ * 
+ * @details This value is only updated if new NAV-DOP messages are read. 
+ * 
+ * @return uint16_t : vertical DOP (*0.01) 
+ */
+uint16_t m8q_get_nav_vdop(void); 
+
+
+/**
+ * @brief Get time to first fix (ms) 
+ * 
+ * @details This value is only updated if new NAV-STATUS messages are read. 
+ * 
+ * @return uint32_t : time to first fix (ms) 
+ */
+uint32_t m8q_get_nav_ttff(void); 
+
+
+/**
+ * @brief Get milliseconds since startup/reset 
+ * 
+ * @details This value is only updated if new NAV-STATUS messages are read. 
+ * 
+ * @return uint32_t : time since startup/reset (ms) 
+ */
+uint32_t m8q_get_nav_msss(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Snapshot 
+
+/**
+ * @brief Get a consistent copy of the latest position, time and accuracy data 
+ * 
+ * @details Copies the latest POSITION, TIME and NAV values into 'snapshot' in one call. 
+ *          The individual getters above each read one value, so when another task is 
+ *          in m8q_read_data at the same time a set of getter calls can mix values from 
+ *          different messages. The snapshot is instead double buffered: the parser fills 
+ *          a back buffer each time a stored message is accepted and then publishes it, 
+ *          and this function copies the published buffer. If the parser publishes again 
+ *          during the copy then the copy is retried. Neither side takes a lock so the 
+ *          task reading the device and tasks reading the snapshot never block each 
+ *          other. 
+ *          
+ *          snapshot->seq increments with each update so the application can tell if 
+ *          there is new data. Each message's own sequence number and valid fields are 
+ *          also included (ex. snapshot->pos.seq). 
+ * 
+ * @see m8q_read_data 
+ * 
+ * @param snapshot : buffer to store the snapshot 
+ * @return M8Q_STATUS : invalid pointer status if snapshot is NULL 
+ */
+M8Q_STATUS m8q_get_snapshot(m8q_snapshot_t *snapshot); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// RTCM corrections 
+
+/**
+ * @brief RTCM3 passthrough initialization 
+ * 
+ * @details Clears the frame detector and counters of an RTCM passthrough record and 
+ *          starts the detector at the current tail of the circular buffer the 
+ *          corrections are received into. 
+ * 
+ * @see m8q_rtcm_forward 
+ * 
+ * @param rtcm : RTCM passthrough record 
+ * @param cb_index : circular buffer indexing info of the correction data 
+ * @return M8Q_STATUS : invalid pointer status if either argument is NULL 
+ */
+M8Q_STATUS m8q_rtcm_init(
+    m8q_rtcm_t *rtcm, 
+    const cb_index_t *cb_index); 
+
+
+/**
+ * @brief Forward RTCM3 correction frames to the device 
+ * 
+ * @details Checks the bytes of a circular buffer from where the last call stopped up to 
+ *          the head index for RTCM3 frames (0xD3 preamble, 10-bit length, payload and 
+ *          CRC-24Q). Each frame with a valid CRC is written to the device straight from 
+ *          the circular buffer (no copy) in I2C writes of at most 'max_chunk' bytes. A 
+ *          frame that wraps around the end of the buffer is split there. No write is 
+ *          shorter than 2 bytes since the device takes a 1 byte write as a register 
+ *          address and drops it. Frames with a bad CRC and bytes that aren't part of a 
+ *          frame are dropped and counted in the record. After a bad frame the search for 
+ *          the next frame starts again from the byte after its preamble so a real frame 
+ *          that was inside it isn't lost. 
+ *          
+ *          This is meant for corrections that arrive on another link, such as a SiK 
+ *          radio UART received into a circular buffer by DMA (see dma_cb_index and 
+ *          uart_dma_input_cb_index_t). The application updates the head index as data 
+ *          comes in and calls this function. The tail index is set to the first byte 
+ *          that is still needed (the start of a partly received frame) so the 
+ *          application can tell how much of the buffer is free. The circular buffer must 
+ *          be able to hold the largest frame (M8Q_RTCM_MAX_FRAME_LEN) along with the 
+ *          data that comes in between calls. 
+ *          
+ *          The device I2C port must have RTCM3 enabled as an input protocol (CFG-PRT). 
+ * 
+ * @see m8q_rtcm_init 
+ * 
+ * @param rtcm : RTCM passthrough record 
+ * @param circular_buff : circular buffer that holds the correction data 
+ * @param cb_index : circular buffer indexing info of the correction data 
+ * @param max_chunk : max bytes per I2C write (0 for the max write size, 3 at least) 
+ * @return M8Q_STATUS : status of the forwarding - bad checksum and unknown data 
+ *                      statuses show data was dropped 
+ */
+M8Q_STATUS m8q_rtcm_forward(
+    m8q_rtcm_t *rtcm, 
+    const uint8_t *circular_buff, 
+    cb_index_t *cb_index, 
+    uint8_t max_chunk); 
+
+//=======================================================================================
+
 #ifdef __cplusplus
 }
 #endif
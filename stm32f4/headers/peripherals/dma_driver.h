@@ -415,6 +415,22 @@ uint8_t dma_get_tc_status(
     DMA_TypeDef *dma, 
     DMA_Stream_TypeDef* dma_stream); 
 
+
+/**
+ * @brief Clear the interrupt flags of one stream 
+ * 
+ * @details Clears the FIFO error, direct mode error, transfer error, half transfer and 
+ *          transfer complete flags of the stream without touching the other streams on 
+ *          the DMA port. The flags of a stream must be clear before it's enabled for a 
+ *          new transfer. 
+ * 
+ * @param dma : DMA port of the stream 
+ * @param dma_stream : DMA stream to clear 
+ */
+void dma_clear_stream_flags(
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef* dma_stream); 
+
 //=======================================================================================
 
 
@@ -464,6 +480,82 @@ void dma_stream_disable(DMA_Stream_TypeDef *dma_stream);
  */
 uint8_t dma_stream_status(DMA_Stream_TypeDef *dma_stream); 
 
+
+/**
+ * @brief Memory address increment 
+ * 
+ * @details Defines the behavior of the memory address after transfers. This can either be 
+ *          defined as fixed, meaning the memory address doesn't change after a transfer, or 
+ *          it can be defined as increment, meaning the address will be incremented after 
+ *          each transfer. <br> 
+ *          
+ *          As an example, in peripheral-to-memory transfers such as ADC scan 
+ *          mode using DMA, you want to store more than one conversion in memory to prevent 
+ *          a loss of data. This can be done by getting the DMA to increment to the next address 
+ *          in a buffer automatically using increment mode. 
+ * 
+ * @see dma_addr_inc_mode_t
+ * 
+ * @param dma_stream : pointer to DMA port stream being configured 
+ * @param minc : memory address increment configuration 
+ */
+void dma_minc(
+    DMA_Stream_TypeDef *dma_stream, 
+    dma_addr_inc_mode_t minc); 
+
+
+/**
+ * @brief Memory data size 
+ * 
+ * @details Tells the stream the size of the data being transferred from memory. It is 
+ *          recommended to make the memory and peripheral data sizes the same. The memory 
+ *          can act as either the source or the destination. 
+ * 
+ * @see dma_data_size_t
+ * 
+ * @param dma_stream : pointer to DMA port stream being configured 
+ * @param msize : memory data size configuration 
+ */
+void dma_msize(
+    DMA_Stream_TypeDef *dma_stream, 
+    dma_data_size_t msize); 
+
+
+/**
+ * @brief Peripheral data size 
+ * 
+ * @details Tells the stream the size of the data being transferred from the peripheral. It is 
+ *          recommended to make the memory and peripheral data sizes the same. The peripheral 
+ *          can act as either the source or the destination. In memory-to-memory transfers, this 
+ *          peripheral configuration acts as the destination memory configuration. 
+ * 
+ * @see dma_data_size_t
+ * 
+ * @param dma_stream : pointer to DMA port stream being configured 
+ * @param psize : peripheral data size configuration 
+ */
+void dma_psize(
+    DMA_Stream_TypeDef *dma_stream, 
+    dma_data_size_t psize); 
+
+
+/**
+ * @brief Peripheral address increment 
+ * 
+ * @details Defines the behavior of the peripheral address after transfers. This can either be 
+ *          defined as fixed, meaning the peripheral address doesn't change after a transfer, or 
+ *          it can be defined as increment, meaning the address will be incremented after 
+ *          each transfer. 
+ * 
+ * @see dma_addr_inc_mode_t
+ * 
+ * @param dma_stream : pointer to DMA port stream being configured 
+ * @param pinc : peripheral address increment configuration 
+ */
+void dma_pinc(
+    DMA_Stream_TypeDef *dma_stream, 
+    dma_addr_inc_mode_t pinc); 
+
 //=======================================================================================
 
 
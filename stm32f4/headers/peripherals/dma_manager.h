@@ -0,0 +1,321 @@
+/**
+ * @file dma_manager.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief DMA stream allocator and interrupt dispatcher interface 
+ * 
+ * @details Keeps track of which DMA streams are in use so drivers sharing the DMA ports
+ *          can't be set up on top of each other. Drivers ask for a peripheral request 
+ *          (ex. USART1 RX) and get a stream/channel pair from the STM32F411 request 
+ *          mapping tables (RM0383 tables 27 and 28). The stream interrupts are passed to 
+ *          the manager which clears the flags of the stream and calls the half transfer, 
+ *          transfer complete and error callbacks of its owner. 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _DMA_MANAGER_H_
+#define _DMA_MANAGER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "dma_driver.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DMA_MGR_PORTS 2            // DMA1 and DMA2 
+#define DMA_MGR_STREAMS 8          // Streams per port 
+
+// Stream interrupt flags (same order as the LISR/HISR bits of a stream)
+#define DMA_MGR_FLAG_FE 0x01       // FIFO error 
+#define DMA_MGR_FLAG_DME 0x04      // Direct mode error 
+#define DMA_MGR_FLAG_TE 0x08       // Transfer error 
+#define DMA_MGR_FLAG_HT 0x10       // Half transfer 
+#define DMA_MGR_FLAG_TC 0x20       // Transfer complete 
+#define DMA_MGR_FLAG_ERRORS (DMA_MGR_FLAG_FE | DMA_MGR_FLAG_DME | DMA_MGR_FLAG_TE)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+/**
+ * @brief DMA requests 
+ * 
+ * @details Peripheral requests that can be routed to a DMA stream. Memory to memory 
+ *          transfers can only be done by DMA2 and can use any of its streams. 
+ */
+typedef enum {
+    DMA_REQ_SPI1_RX, 
+    DMA_REQ_SPI1_TX, 
+    DMA_REQ_SPI2_RX, 
+    DMA_REQ_SPI2_TX, 
+    DMA_REQ_SPI3_RX, 
+    DMA_REQ_SPI3_TX, 
+    DMA_REQ_SPI4_RX, 
+    DMA_REQ_SPI4_TX, 
+    DMA_REQ_SPI5_RX, 
+    DMA_REQ_SPI5_TX, 
+    DMA_REQ_I2C1_RX, 
+    DMA_REQ_I2C1_TX, 
+    DMA_REQ_I2C2_RX, 
+    DMA_REQ_I2C2_TX, 
+    DMA_REQ_I2C3_RX, 
+    DMA_REQ_I2C3_TX, 
+    DMA_REQ_USART1_RX, 
+    DMA_REQ_USART1_TX, 
+    DMA_REQ_USART2_RX, 
+    DMA_REQ_USART2_TX, 
+    DMA_REQ_USART6_RX, 
+    DMA_REQ_USART6_TX, 
+    DMA_REQ_ADC1, 
+    DMA_REQ_SDIO, 
+    DMA_REQ_TIM1_UP, 
+    DMA_REQ_TIM1_CH1, 
+    DMA_REQ_TIM1_CH2, 
+    DMA_REQ_TIM1_CH3, 
+    DMA_REQ_TIM1_CH4, 
+    DMA_REQ_TIM2_UP, 
+    DMA_REQ_TIM2_CH1, 
+    DMA_REQ_TIM2_CH2, 
+    DMA_REQ_TIM2_CH3, 
+    DMA_REQ_TIM2_CH4, 
+    DMA_REQ_TIM3_UP, 
+    DMA_REQ_TIM3_CH1, 
+    DMA_REQ_TIM3_CH2, 
+    DMA_REQ_TIM3_CH3, 
+    DMA_REQ_TIM3_CH4, 
+    DMA_REQ_TIM4_UP, 
+    DMA_REQ_TIM4_CH1, 
+    DMA_REQ_TIM4_CH2, 
+    DMA_REQ_TIM4_CH3, 
+    DMA_REQ_TIM5_UP, 
+    DMA_REQ_TIM5_CH1, 
+    DMA_REQ_TIM5_CH2, 
+    DMA_REQ_TIM5_CH3, 
+    DMA_REQ_TIM5_CH4, 
+    DMA_REQ_MEM2MEM, 
+    DMA_REQ_COUNT 
+} dma_request_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+typedef struct dma_mgr_stream_s dma_mgr_stream_t; 
+
+
+/**
+ * @brief Stream event callback 
+ * 
+ * @details Called from the stream interrupt (dma_mgr_irq). 'flags' are the 
+ *          DMA_MGR_FLAG_x bits that caused the call. 
+ */
+typedef void (*dma_mgr_callback_t)(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags, 
+    void *context); 
+
+
+/**
+ * @brief Allocated stream 
+ * 
+ * @details Handed out by dma_mgr_alloc and dma_mgr_claim. 'dma', 'stream' and 'channel' 
+ *          are what dma_stream_init needs for the request. The manager owns the rest. 
+ */
+struct dma_mgr_stream_s 
+{
+    DMA_TypeDef *dma;                 // DMA port 
+    DMA_Stream_TypeDef *stream;       // DMA stream 
+    dma_channel_t channel;            // Channel of the request on this stream 
+    dma_stream_t stream_num;          // Stream number 
+    uint8_t port;                     // DMA port index (0 = DMA1, 1 = DMA2)
+    uint8_t in_use; 
+    dma_request_t request; 
+
+    // Callbacks 
+    dma_mgr_callback_t half;          // Half transfer 
+    dma_mgr_callback_t complete;      // Transfer complete 
+    dma_mgr_callback_t error;         // Transfer, direct mode or FIFO error 
+    void *context; 
+
+    // Statistics 
+    uint32_t half_count; 
+    uint32_t complete_count; 
+    uint32_t error_count; 
+};
+
+
+// DMA usage statistics 
+typedef struct dma_mgr_stats_s 
+{
+    uint8_t streams_in_use; 
+    uint32_t allocs;                  // Successful allocations 
+    uint32_t alloc_fails;             // Requests with no free stream 
+    uint32_t half; 
+    uint32_t complete; 
+    uint32_t errors; 
+}
+dma_mgr_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Allocate a stream for a request 
+ * 
+ * @details Takes the first free stream that can serve the request according to the 
+ *          request mapping tables. Allocation isn't interrupt safe so do it during setup. 
+ *          The stream still has to be initialized with dma_stream_init using the 
+ *          returned 'dma', 'stream' and 'channel'. 
+ * 
+ * @param request : peripheral request 
+ * @return dma_mgr_stream_t* : allocated stream, NULL if all streams for the request are 
+ *                             in use 
+ */
+dma_mgr_stream_t *dma_mgr_alloc(dma_request_t request); 
+
+
+/**
+ * @brief Allocate a specific stream for a request 
+ * 
+ * @details Same as dma_mgr_alloc but for when the stream is already decided (ex. a board 
+ *          where another driver needs the other stream of the request). 
+ * 
+ * @param request : peripheral request 
+ * @param dma : DMA port (DMA1 or DMA2)
+ * @param stream_num : stream number 
+ * @return dma_mgr_stream_t* : allocated stream, NULL if the stream can't serve the 
+ *                             request or is in use 
+ */
+dma_mgr_stream_t *dma_mgr_claim(
+    dma_request_t request, 
+    DMA_TypeDef *dma, 
+    dma_stream_t stream_num); 
+
+
+/**
+ * @brief Free an allocated stream 
+ * 
+ * @details The stream must be stopped (dma_stream_disable) before it's freed. The 
+ *          callbacks are removed and the stream can be allocated again. 
+ * 
+ * @param stream : allocated stream 
+ */
+void dma_mgr_free(dma_mgr_stream_t *stream); 
+
+
+/**
+ * @brief Set the event callbacks of a stream 
+ * 
+ * @details Any of the callbacks can be NULL. The matching interrupts still need to be 
+ *          enabled with dma_int_config. 
+ * 
+ * @param stream : allocated stream 
+ * @param half : half transfer callback 
+ * @param complete : transfer complete callback 
+ * @param error : error callback 
+ * @param context : passed to the callbacks 
+ */
+void dma_mgr_set_callbacks(
+    dma_mgr_stream_t *stream, 
+    dma_mgr_callback_t half, 
+    dma_mgr_callback_t complete, 
+    dma_mgr_callback_t error, 
+    void *context); 
+
+
+/**
+ * @brief Stream interrupt handler 
+ * 
+ * @details Reads and clears the interrupt flags of the stream then dispatches the ones 
+ *          with their interrupt enabled. Call from the DMAx_Streamy_IRQHandler of each 
+ *          stream the manager owns. 
+ * 
+ * @param dma : DMA port (DMA1 or DMA2)
+ * @param stream_num : stream number 
+ */
+void dma_mgr_irq(
+    DMA_TypeDef *dma, 
+    dma_stream_t stream_num); 
+
+
+/**
+ * @brief Dispatch stream events 
+ * 
+ * @details Updates the statistics and calls the callbacks for the events in 'flags'. 
+ *          Used by dma_mgr_irq after the flags are read from the hardware. 
+ * 
+ * @param stream : allocated stream 
+ * @param flags : DMA_MGR_FLAG_x events 
+ */
+void dma_mgr_dispatch(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags); 
+
+
+/**
+ * @brief Interrupt number of a stream 
+ * 
+ * @details For enabling the stream interrupt with nvic_config. 
+ * 
+ * @param stream : allocated stream 
+ * @return IRQn_Type : interrupt number 
+ */
+IRQn_Type dma_mgr_irqn(const dma_mgr_stream_t *stream); 
+
+
+/**
+ * @brief Check if a stream is free 
+ * 
+ * @param dma : DMA port (DMA1 or DMA2)
+ * @param stream_num : stream number 
+ * @return uint8_t : TRUE if the stream is free, FALSE if it's in use or doesn't exist 
+ */
+uint8_t dma_mgr_free_status(
+    DMA_TypeDef *dma, 
+    dma_stream_t stream_num); 
+
+
+/**
+ * @brief Get the usage statistics 
+ * 
+ * @param stats : statistics 
+ */
+void dma_mgr_stats(dma_mgr_stats_t *stats); 
+
+
+/**
+ * @brief Free all streams and clear the statistics 
+ * 
+ * @details For startup and unit tests. None of the streams can be running. 
+ */
+void dma_mgr_reset(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _DMA_MANAGER_H_
@@ -0,0 +1,214 @@
+/**
+ * @file dma_mem.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief DMA memory copy and fill interface 
+ * 
+ * @details Moves large blocks of memory (ex. encoded WS2812 frames, log blocks and SD
+ *          sector staging) with a DMA2 memory-to-memory stream instead of the CPU. DMA2 
+ *          is the only controller that can do memory-to-memory transfers. Short blocks 
+ *          are copied by the CPU since the stream setup and completion interrupt cost more 
+ *          than the copy - see dma_mem_benchmark_utest for where DMA_MEM_MIN_LEN comes 
+ *          from. Transfers are asynchronous and the callback is run when the block is 
+ *          done, from the stream interrupt for DMA transfers or before returning for CPU 
+ *          copies. 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _DMA_MEM_H_
+#define _DMA_MEM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "dma_manager.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DMA_MEM_MIN_LEN 256        // Shorter blocks are copied by the CPU 
+#define DMA_MEM_MAX_ITEMS 0xFFFF   // Max data items (NDTR) in one DMA transfer 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+/**
+ * @brief DMA memory transfer status 
+ */
+typedef enum {
+    DMA_MEM_OK, 
+    DMA_MEM_INVALID_PTR, 
+    DMA_MEM_BUSY,           // A DMA transfer is in progress 
+    DMA_MEM_ERROR           // The DMA reported a transfer error 
+} dma_mem_status_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+typedef dma_mem_status_t DMA_MEM_STATUS; 
+
+
+/**
+ * @brief Transfer done callback 
+ * 
+ * @details Called from the stream interrupt when a DMA transfer finishes or before 
+ *          dma_memcpy/dma_memset return when the CPU did the copy. 
+ */
+typedef void (*dma_mem_callback_t)(
+    DMA_MEM_STATUS status, 
+    void *context); 
+
+
+/**
+ * @brief DMA memory transfer engine 
+ * 
+ * @details One per memory-to-memory stream. Blocks larger than one transfer 
+ *          (DMA_MEM_MAX_ITEMS data items) are split and the next part is started from the 
+ *          transfer complete interrupt. Word transfers are used when the addresses and 
+ *          length allow it. 
+ */
+typedef struct dma_mem_s 
+{
+    dma_mgr_stream_t *stream;          // Memory-to-memory stream 
+    uint32_t fill;                     // Fill value source for dma_memset 
+
+    // Transfer in progress 
+    uint8_t *dst; 
+    const uint8_t *src; 
+    uint32_t remaining;                // Bytes left to start 
+    uint8_t src_inc;                   // Source address increments (FALSE for fills)
+    volatile uint8_t busy; 
+    volatile DMA_MEM_STATUS status;    // Status of the last transfer 
+    dma_mem_callback_t callback; 
+    void *context; 
+
+    // Statistics 
+    uint32_t dma_bytes;                // Bytes moved by the DMA 
+    uint32_t cpu_bytes;                // Bytes moved by the CPU 
+    uint32_t dma_transfers;            // Stream transfers started 
+}
+dma_mem_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief DMA memory engine initialization 
+ * 
+ * @details Takes a stream allocated for DMA_REQ_MEM2MEM (dma_mgr_alloc) that's been 
+ *          initialized with dma_stream_init as a memory-to-memory transfer (DMA_DIR_MM, 
+ *          no circular or double buffer mode). FIFO mode is turned on (required for 
+ *          memory-to-memory) along with the transfer complete and transfer error 
+ *          interrupts. The application enables the stream interrupt in the NVIC 
+ *          (nvic_config with dma_mgr_irqn) and calls dma_mgr_irq from it. 
+ * 
+ * @param engine : engine to initialize 
+ * @param stream : memory-to-memory stream 
+ * @return DMA_MEM_STATUS : status of the initialization 
+ */
+DMA_MEM_STATUS dma_mem_init(
+    dma_mem_t *engine, 
+    dma_mgr_stream_t *stream); 
+
+
+/**
+ * @brief Copy memory 
+ * 
+ * @details Same as memcpy but done by the DMA when the block is at least 
+ *          DMA_MEM_MIN_LEN bytes. The blocks can't overlap and neither can be touched 
+ *          until the callback is run (or dma_mem_busy returns FALSE). 'engine' can be NULL 
+ *          to always use the CPU. 
+ * 
+ * @param engine : DMA memory engine 
+ * @param dst : destination 
+ * @param src : source 
+ * @param len : number of bytes 
+ * @param callback : run when the copy is done (NULL if not needed)
+ * @param context : passed to the callback 
+ * @return DMA_MEM_STATUS : DMA_MEM_OK if the copy is started (or done), DMA_MEM_BUSY if 
+ *                          the engine is in use 
+ */
+DMA_MEM_STATUS dma_memcpy(
+    dma_mem_t *engine, 
+    void *dst, 
+    const void *src, 
+    uint32_t len, 
+    dma_mem_callback_t callback, 
+    void *context); 
+
+
+/**
+ * @brief Fill memory 
+ * 
+ * @details Same as memset but done by the DMA when the block is at least 
+ *          DMA_MEM_MIN_LEN bytes. 
+ * 
+ * @see dma_memcpy 
+ * 
+ * @param engine : DMA memory engine 
+ * @param dst : destination 
+ * @param value : fill value 
+ * @param len : number of bytes 
+ * @param callback : run when the fill is done (NULL if not needed)
+ * @param context : passed to the callback 
+ * @return DMA_MEM_STATUS : DMA_MEM_OK if the fill is started (or done), DMA_MEM_BUSY if 
+ *                          the engine is in use 
+ */
+DMA_MEM_STATUS dma_memset(
+    dma_mem_t *engine, 
+    void *dst, 
+    uint8_t value, 
+    uint32_t len, 
+    dma_mem_callback_t callback, 
+    void *context); 
+
+
+/**
+ * @brief DMA memory engine busy status 
+ * 
+ * @param engine : DMA memory engine 
+ * @return uint8_t : TRUE if a DMA transfer is in progress 
+ */
+uint8_t dma_mem_busy(const dma_mem_t *engine); 
+
+
+/**
+ * @brief Wait for the DMA memory engine 
+ * 
+ * @details Blocks until the transfer in progress is done. The stream interrupt must be 
+ *          able to run. 
+ * 
+ * @param engine : DMA memory engine 
+ * @return DMA_MEM_STATUS : status of the last transfer 
+ */
+DMA_MEM_STATUS dma_mem_wait(const dma_mem_t *engine); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _DMA_MEM_H_
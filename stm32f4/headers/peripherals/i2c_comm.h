@@ -24,6 +24,7 @@ extern "C" {
 
 #include "tools.h" 
 #include "gpio_driver.h" 
+#include "dma_driver.h" 
 
 //=======================================================================================
 
@@ -45,11 +46,19 @@ typedef enum {
 
 /**
  * @brief I2C operation status 
+ * 
+ * @details Each status is its own bit so the results of several calls can be OR'd 
+ *          together and still be told apart. 
  */
 typedef enum {
-    I2C_OK, 
-    I2C_TIMEOUT, 
-    I2C_NULL_PTR 
+    I2C_OK        = 0x00, 
+    I2C_TIMEOUT   = 0x01, 
+    I2C_NULL_PTR  = 0x02, 
+    I2C_NACK      = 0x04,     // Address or data not acknowledged (asynchronous) 
+    I2C_BUS_ERROR = 0x08,     // Misplaced start or stop (asynchronous) 
+    I2C_ARB_LOST  = 0x10,     // Arbitration lost (asynchronous) 
+    I2C_OVERRUN   = 0x20,     // Overrun/underrun (asynchronous) 
+    I2C_BUSY      = 0x40      // Already queued or in progress 
 } i2c_status_t; 
 
 
@@ -128,6 +137,20 @@ typedef enum {
     I2C_TRISE_1000_42 = 43
 } i2c_trise_setpoint_t;
 
+
+
+/**
+ * @brief I2C asynchronous engine state 
+ * 
+ * @details Tracks which phase of the active transaction the engine is in so the event 
+ *          interrupt knows how to respond to the status flags. 
+ */
+typedef enum {
+    I2C_ASYNC_IDLE, 
+    I2C_ASYNC_WRITE,     // Start/address/data phase of the write 
+    I2C_ASYNC_READ       // (Repeated) start/address/data phase of the read 
+} i2c_async_state_t; 
+
 //=======================================================================================
 
 
@@ -136,6 +159,73 @@ typedef enum {
 
 typedef i2c_status_t I2C_STATUS; 
 
+typedef struct i2c_txn_s i2c_txn_t; 
+
+/**
+ * @brief Transaction completion callback 
+ * 
+ * @details Called from interrupt context once a transaction finishes. The result is in 
+ *          the transactions 'status' field. The transaction can be resubmitted from 
+ *          within the callback. 
+ */
+typedef void (*i2c_txn_callback_t)(i2c_txn_t *txn); 
+
+
+/**
+ * @brief I2C asynchronous transaction 
+ * 
+ * @details Describes one bus transaction: 'tx_len' bytes are written to the device, then 
+ *          if 'rx_len' is non-zero a repeated start is generated and 'rx_len' bytes are 
+ *          read back. A register read is a one byte write of the register address 
+ *          followed by the read. Either length can be zero but not both. 
+ *          
+ *          The transaction is owned by the caller and must remain valid until its 
+ *          callback runs. 'address' follows the rest of the driver and is the 7-bit 
+ *          address already shifted into bits 1-7 (the R/W bit is added by the engine). 
+ */
+struct i2c_txn_s 
+{
+    // Transaction description 
+    uint8_t address;                 // Device address (R/W bit clear) 
+    const uint8_t *tx_data;          // Data written first - ex. register address 
+    uint8_t tx_len;                  // Number of bytes to write 
+    uint8_t *rx_data;                // Buffer for data read after the repeated start 
+    uint16_t rx_len;                 // Number of bytes to read 
+    uint8_t retries;                 // Times to restart the transaction after a NACK 
+    i2c_txn_callback_t callback;     // Completion callback (optional) 
+    void *context;                   // Caller data for the callback 
+
+    // Engine owned 
+    I2C_STATUS status;               // I2C_BUSY while queued, result once complete 
+    i2c_txn_t *next;                 // Next transaction in the queue 
+}; 
+
+
+/**
+ * @brief I2C asynchronous engine 
+ * 
+ * @details Holds the transaction queue and state for one I2C port. The DMA streams are 
+ *          optional. When a stream is provided it must already be initialized 
+ *          (dma_stream_init) on the I2C channel in the correct direction with the 
+ *          transfer complete interrupt enabled. Without streams, data is moved by the 
+ *          TxE/RxNE interrupts. 
+ */
+typedef struct i2c_async_s 
+{
+    I2C_TypeDef *i2c;                // I2C port 
+    DMA_Stream_TypeDef *dma_tx;      // DMA stream for writes (NULL to use interrupts) 
+    DMA_Stream_TypeDef *dma_rx;      // DMA stream for reads (NULL to use interrupts) 
+    i2c_txn_t *head;                 // Active transaction 
+    i2c_txn_t *tail;                 // Last queued transaction 
+    i2c_async_state_t state;         // Active transaction phase 
+    uint16_t count;                  // Bytes transferred in the current phase 
+    uint8_t attempts;                // Restarts used by the active transaction 
+
+    // Statistics 
+    uint32_t completed;              // Transactions finished successfully 
+    uint32_t errors;                 // Transactions finished with an error 
+} i2c_async_t; 
+
 //=======================================================================================
 
 
@@ -354,6 +444,141 @@ I2C_STATUS i2c_read_to_len(
 
 //=======================================================================================
 
+
+//=======================================================================================
+// Asynchronous transactions 
+
+/**
+ * @brief Asynchronous engine initialization 
+ * 
+ * @details Sets up the engine for an I2C port that has already been configured with 
+ *          i2c_init. The application owns the interrupt handlers and must enable the 
+ *          ports event and error interrupts in the NVIC and call i2c_async_ev_irq and 
+ *          i2c_async_er_irq from them. If 'dma_rx' is used then i2c_async_dma_rx_irq must 
+ *          be called from the DMA streams transfer complete interrupt. The engine only 
+ *          enables the I2C interrupts (CR2) while transactions are queued. 
+ * 
+ * @param engine : engine to initialize 
+ * @param i2c : pointer to the I2C port 
+ * @param dma_tx : DMA stream used for writes (NULL for interrupt driven writes) 
+ * @param dma_rx : DMA stream used for reads (NULL for interrupt driven reads) 
+ */
+void i2c_async_init(
+    i2c_async_t *engine, 
+    I2C_TypeDef *i2c, 
+    DMA_Stream_TypeDef *dma_tx, 
+    DMA_Stream_TypeDef *dma_rx); 
+
+
+/**
+ * @brief Submit a transaction 
+ * 
+ * @details Adds the transaction to the end of the queue and starts it immediately if the 
+ *          bus is idle. Transactions run in the order they're submitted. The call returns 
+ *          right away and the transactions callback runs once it's done. Safe to call 
+ *          from the main loop or from a completion callback. 
+ * 
+ * @see i2c_txn_t
+ * 
+ * @param engine : engine of the I2C port to use 
+ * @param txn : transaction to queue 
+ * @return I2C_STATUS : I2C_OK if queued, I2C_BUSY if the transaction is already queued, 
+ *                      I2C_NULL_PTR if the transaction is invalid 
+ */
+I2C_STATUS i2c_async_submit(
+    i2c_async_t *engine, 
+    i2c_txn_t *txn); 
+
+
+/**
+ * @brief Event interrupt handler 
+ * 
+ * @details Advances the active transaction based on the SR1 event flags (SB, ADDR, TxE, 
+ *          BTF and RxNE). Call from the I2Cx_EV_IRQHandler of the engines port. 
+ * 
+ * @param engine : engine of the interrupting I2C port 
+ */
+void i2c_async_ev_irq(i2c_async_t *engine); 
+
+
+/**
+ * @brief Error interrupt handler 
+ * 
+ * @details Clears the error flags, releases the bus and finishes the active transaction 
+ *          with the matching status. A NACK restarts the transaction if it has retries 
+ *          left. The rest of the queue then continues. Call from the I2Cx_ER_IRQHandler 
+ *          of the engines port. 
+ * 
+ * @param engine : engine of the interrupting I2C port 
+ */
+void i2c_async_er_irq(i2c_async_t *engine); 
+
+
+/**
+ * @brief DMA read complete handler 
+ * 
+ * @details Generates the stop condition and finishes the active read. Call from the 
+ *          transfer complete interrupt of the 'dma_rx' stream after clearing the DMA 
+ *          interrupt flags. 
+ * 
+ * @param engine : engine that owns the DMA stream 
+ */
+void i2c_async_dma_rx_irq(i2c_async_t *engine); 
+
+
+/**
+ * @brief Abort the active transaction 
+ * 
+ * @details Stops the active transaction and finishes it with I2C_TIMEOUT then moves on to 
+ *          the rest of the queue. Meant to be called by the application if a transaction 
+ *          hasn't finished within its expected time (ex. a device holding the bus). 
+ * 
+ * @param engine : engine of the I2C port 
+ */
+void i2c_async_abort(i2c_async_t *engine); 
+
+
+/**
+ * @brief Engine busy status 
+ * 
+ * @param engine : engine of the I2C port 
+ * @return uint8_t : TRUE if a transaction is active or queued, FALSE otherwise 
+ */
+uint8_t i2c_async_busy(const i2c_async_t *engine); 
+
+
+/**
+ * @brief Mask the engines interrupts 
+ * 
+ * @details Masks every interrupt that can finish a transaction: the ports event and 
+ *          error interrupts (ITEVTEN and ITERREN) and the transfer complete interrupt 
+ *          (TCIE) of 'dma_rx'. Used around changes to the queue (or anything else the 
+ *          completion callbacks use) from outside the engines interrupts. A transfer 
+ *          that finishes while masked keeps its flag set so its interrupt runs once the 
+ *          mask is restored. Calls can be nested. 
+ *          
+ *          Code that calls into the engine from other interrupts (ex. i2c_async_abort 
+ *          from a timer) isn't covered and needs to run at the same priority as the 
+ *          engines interrupts. 
+ * 
+ * @param engine : engine of the I2C port 
+ * @return uint32_t : interrupt enable bits to restore with i2c_async_unlock 
+ */
+uint32_t i2c_async_lock(i2c_async_t *engine); 
+
+
+/**
+ * @brief Restore the engines interrupts 
+ * 
+ * @param engine : engine of the I2C port 
+ * @param irq_mask : interrupt enable bits from i2c_async_lock 
+ */
+void i2c_async_unlock(
+    i2c_async_t *engine, 
+    uint32_t irq_mask); 
+
+//=======================================================================================
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,222 @@
+/**
+ * @file i2c_sched.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C shared bus scheduler interface 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _I2C_SCHED_H_
+#define _I2C_SCHED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "i2c_comm.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define I2C_SCHED_MAX_DEVICES 8      // Number of devices statistics are kept for 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+typedef struct i2c_sched_s i2c_sched_t; 
+typedef struct i2c_sched_slot_s i2c_sched_slot_t; 
+
+/**
+ * @brief Slot completion callback 
+ * 
+ * @details Called from interrupt context once the slots transfer finishes. The transfer 
+ *          result is in the slots 'txn.status'. A one-shot slot can be requested again 
+ *          from within the callback. 
+ */
+typedef void (*i2c_sched_callback_t)(i2c_sched_slot_t *slot); 
+
+
+/**
+ * @brief Time source 
+ * 
+ * @details Returns a free running time in microseconds. Wrap around is handled. 
+ */
+typedef uint32_t (*i2c_sched_time_t)(void); 
+
+
+/**
+ * @brief Scheduled transfer 
+ * 
+ * @details A transfer a device registers with the scheduler. Periodic slots (period 
+ *          non-zero) are released automatically every period. One-shot slots (period 
+ *          zero) are released by i2c_sched_request. A released slot is dispatched when 
+ *          the bus is free and no higher priority periodic slot would be released 
+ *          before it's estimated to finish. Transfers that can't fit between the 
+ *          releases of higher priority slots must be split by the owner (ex. one LCD 
+ *          character per transfer). 
+ * 
+ *          The transfer is described in 'txn' the same way as any other asynchronous 
+ *          transaction except the transactions callback and context belong to the 
+ *          scheduler. The slot is owned by the caller and must stay valid while it's 
+ *          registered. 
+ */
+struct i2c_sched_slot_s 
+{
+    // Transfer description 
+    i2c_txn_t txn;                   // Address, data, lengths and retries 
+    uint8_t device;                  // Device index for statistics 
+    uint8_t priority;                // Priority - 0 is the highest 
+    uint32_t period;                 // Release period (us) - 0 for one-shot 
+    uint32_t deadline;               // Time after release to finish by (us) - 0 for period 
+    i2c_sched_callback_t callback;   // Completion callback (optional)
+    void *context;                   // Caller data for the callback 
+
+    // Scheduler owned 
+    i2c_sched_t *sched;              // Scheduler the slot is registered with 
+    i2c_sched_slot_t *next;          // Next registered slot (priority order)
+    uint32_t release;                // Time of the pending release 
+    uint32_t next_release;           // Time of the next periodic release 
+    uint32_t cost;                   // Estimated bus time (us)
+    uint8_t pending;                 // Released and waiting for or using the bus 
+    uint8_t late;                    // Pending release already counted as missed 
+};
+
+
+/**
+ * @brief Per device bus statistics 
+ */
+typedef struct i2c_sched_stats_s 
+{
+    uint32_t bus_time;               // Time spent on the bus (us)
+    uint32_t transfers;              // Transfers completed 
+    uint32_t errors;                 // Transfers that finished with an error 
+    uint32_t missed;                 // Deadlines missed and periodic releases overrun 
+    uint32_t latency_max;            // Longest release to completion time (us)
+}
+i2c_sched_stats_t; 
+
+
+/**
+ * @brief I2C bus scheduler 
+ */
+struct i2c_sched_s 
+{
+    i2c_async_t *engine;             // Asynchronous engine of the shared I2C port 
+    i2c_sched_time_t time;           // Time source 
+    uint32_t bus_hz;                 // SCL frequency used to estimate transfer time 
+    i2c_sched_slot_t *slots;         // Registered slots in priority order 
+    i2c_sched_slot_t *active;        // Slot using the bus 
+    uint32_t start;                  // Dispatch time of the active slot 
+    uint32_t window;                 // Start of the statistics window 
+    i2c_sched_stats_t stats[I2C_SCHED_MAX_DEVICES]; 
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Scheduler functions 
+
+/**
+ * @brief Scheduler initialization 
+ * 
+ * @details The asynchronous engine must already be initialized (i2c_async_init). All bus 
+ *          access for the devices sharing the port should then go through the scheduler 
+ *          so it can pack transfers back to back. 
+ * 
+ * @param sched : scheduler to initialize 
+ * @param engine : asynchronous engine of the shared I2C port 
+ * @param time : time source in microseconds 
+ * @param bus_hz : SCL frequency (ex. 400000)
+ */
+void i2c_sched_init(
+    i2c_sched_t *sched, 
+    i2c_async_t *engine, 
+    i2c_sched_time_t time, 
+    uint32_t bus_hz); 
+
+
+/**
+ * @brief Register a slot 
+ * 
+ * @details Periodic slots are released for the first time right away. 
+ * 
+ * @param sched : scheduler of the shared port 
+ * @param slot : slot to register 
+ * @return I2C_STATUS : I2C_OK if registered, I2C_NULL_PTR if the slot is invalid, 
+ *                      I2C_BUSY if it's already registered 
+ */
+I2C_STATUS i2c_sched_add(
+    i2c_sched_t *sched, 
+    i2c_sched_slot_t *slot); 
+
+
+/**
+ * @brief Release a one-shot slot 
+ * 
+ * @details The slot is dispatched as soon as the bus and higher priority slots allow. 
+ *          Periodic slots can also be released early with this. 
+ * 
+ * @param slot : registered slot to release 
+ * @return I2C_STATUS : I2C_OK if released, I2C_BUSY if the slot is still pending, 
+ *                      I2C_NULL_PTR if the slot isn't registered 
+ */
+I2C_STATUS i2c_sched_request(i2c_sched_slot_t *slot); 
+
+
+/**
+ * @brief Run the scheduler 
+ * 
+ * @details Releases periodic slots that are due, tracks missed deadlines and dispatches 
+ *          the next transfer if the bus is free. Transfers are also dispatched back to 
+ *          back from the completion interrupt, so this only needs to be called often 
+ *          enough to catch the periodic releases (ex. from the main loop or a timer). 
+ * 
+ * @param sched : scheduler of the shared port 
+ */
+void i2c_sched_run(i2c_sched_t *sched); 
+
+
+/**
+ * @brief Device bus utilization 
+ * 
+ * @param sched : scheduler of the shared port 
+ * @param device : device index 
+ * @return float : percent of the statistics window the device spent on the bus 
+ */
+float i2c_sched_utilization(
+    i2c_sched_t *sched, 
+    uint8_t device); 
+
+
+/**
+ * @brief Reset the statistics 
+ * 
+ * @details Clears the statistics of all devices and starts a new window. 
+ * 
+ * @param sched : scheduler of the shared port 
+ */
+void i2c_sched_stats_reset(i2c_sched_t *sched); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _I2C_SCHED_H_
@@ -24,6 +24,8 @@ extern "C" {
 
 #include "tools.h"
 #include "gpio_driver.h" 
+#include "dma_driver.h" 
+#include "stm32f411xe_custom.h" 
 
 //=======================================================================================
 
@@ -37,6 +39,10 @@ extern "C" {
 // Data 
 #define SPI_DUMMY 0xFF             // Dummy write data for write-read operations 
 
+// DMA 
+#define SPI_DMA_PORTS 3            // Ports that can have a DMA engine (SPI1-SPI3) 
+#define SPI_DMA_MIN_LEN 16         // Shorter spi_transfer calls are polled 
+
 //=======================================================================================
 
 
@@ -90,7 +96,8 @@ typedef enum {
 typedef enum {
     SPI_OK, 
     SPI_TIMEOUT, 
-    SPI_NULL_PTR 
+    SPI_NULL_PTR, 
+    SPI_BUSY 
 } spi_com_status_t; 
 
 //=======================================================================================
@@ -101,6 +108,61 @@ typedef enum {
 
 typedef spi_com_status_t SPI_STATUS; 
 
+typedef struct spi_dma_s spi_dma_t; 
+
+/**
+ * @brief DMA transfer completion callback 
+ * 
+ * @details Called from the RX streams transfer complete interrupt (or from spi_transfer 
+ *          when the interrupt isn't used) once the transfer is done. A new transfer can 
+ *          be started from within the callback. 
+ */
+typedef void (*spi_dma_callback_t)(
+    spi_dma_t *engine, 
+    SPI_STATUS status, 
+    void *context); 
+
+
+/**
+ * @brief Wait hook for blocking DMA transfers 
+ * 
+ * @details Called repeatedly by spi_transfer while the DMA moves the data so the CPU can 
+ *          be given to something else. Under FreeRTOS this can be taskYIELD (or 
+ *          osThreadYield). 
+ */
+typedef void (*spi_yield_t)(void); 
+
+
+/**
+ * @brief SPI DMA engine 
+ * 
+ * @details Holds the DMA streams and transfer state for one SPI port. Both streams must 
+ *          already be initialized (dma_stream_init) on the SPI channel: 'dma_tx' memory to 
+ *          peripheral and 'dma_rx' peripheral to memory, byte data sizes, fixed peripheral 
+ *          address and direct mode. The memory increment mode is set for each transfer. 
+ *          If the transfer complete interrupt of 'dma_rx' is enabled then spi_dma_rx_irq 
+ *          must be called from it, otherwise spi_transfer finishes transfers by polling. 
+ */
+struct spi_dma_s 
+{
+    SPI_TypeDef *spi;                // SPI port 
+    DMA_TypeDef *dma;                // DMA port of the streams 
+    DMA_Stream_TypeDef *dma_tx;      // Stream feeding the data register 
+    DMA_Stream_TypeDef *dma_rx;      // Stream emptying the data register 
+    spi_yield_t yield;               // Wait hook for spi_transfer (NULL to spin) 
+
+    // Active transfer 
+    volatile uint8_t busy;           // Transfer in progress 
+    uint8_t fill;                    // Byte sent when there's no TX buffer 
+    uint8_t sink;                    // Received bytes land here when there's no RX buffer 
+    spi_dma_callback_t callback;     // Completion callback (optional) 
+    void *context;                   // Caller data for the callback 
+
+    // Statistics 
+    uint32_t transfers;              // Transfers finished successfully 
+    uint32_t errors;                 // Transfers that timed out 
+}; 
+
 //=======================================================================================
 
 
@@ -147,6 +209,55 @@ void spi_ss_init(
 //=======================================================================================
 
 
+//=======================================================================================
+// Clock functions 
+
+/**
+ * @brief SPI baud rate control for a clock frequency 
+ * 
+ * @details Finds the smallest divider that keeps the SPI clock at or below 'max_freq'. 
+ *          Used by drivers that choose their own clock speed (ex. slow SD card 
+ *          initialization then fast data transfers). 
+ * 
+ * @param pclk : APB clock frequency of the SPI port (Hz) 
+ * @param max_freq : highest allowed SPI clock frequency (Hz) 
+ * @return spi_baud_rate_ctrl_t : baud rate control - SPI_BR_FPCLK_256 if no divider 
+ *                                gets the clock low enough 
+ */
+spi_baud_rate_ctrl_t spi_baud_select(
+    uint32_t pclk, 
+    uint32_t max_freq); 
+
+
+/**
+ * @brief SPI port clock frequency 
+ * 
+ * @details Frequency of the APB clock the port runs from. SPI2 and SPI3 are on APB1 and 
+ *          the other ports are on APB2. 
+ * 
+ * @param spi : pointer to SPI port 
+ * @return uint32_t : APB clock frequency (Hz) 
+ */
+uint32_t spi_get_pclk(const SPI_TypeDef *spi); 
+
+
+/**
+ * @brief SPI set baud rate 
+ * 
+ * @details Waits for the port to finish what it's sending then changes the baud rate 
+ *          control. The port is disabled while the change is made. Don't call while a 
+ *          DMA transfer is running. 
+ * 
+ * @param spi : pointer to SPI port 
+ * @param baud_rate_ctrl : new baud rate control 
+ */
+void spi_set_baud(
+    SPI_TypeDef *spi, 
+    spi_baud_rate_ctrl_t baud_rate_ctrl); 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // SPI register functions 
 
@@ -227,6 +338,135 @@ SPI_STATUS spi_write_read(
     uint8_t *read_data, 
     uint32_t data_len);
 
+
+/**
+ * @brief SPI full-duplex transfer 
+ * 
+ * @details Clocks 'data_len' bytes out of 'write_data' while storing the bytes clocked 
+ *          in to 'read_data'. If 'write_data' is NULL then 'fill' is sent for every byte 
+ *          (ex. SPI_DUMMY for reads) and if 'read_data' is NULL the received bytes are 
+ *          discarded. 
+ *          
+ *          If a DMA engine has been set up for the port (spi_dma_init) and the transfer 
+ *          is at least SPI_DMA_MIN_LEN bytes long then the data is moved by DMA and the 
+ *          engines yield hook is called while waiting. Otherwise the transfer is polled 
+ *          the same as spi_write and spi_write_read. Either way the function returns once 
+ *          the transfer is done. 
+ *          
+ *          Note that the slave device must be selected before calling this function or else 
+ *          communication may fail. 
+ * 
+ * @param spi : pointer to SPI port 
+ * @param write_data : data to send (NULL to send 'fill') 
+ * @param read_data : buffer to store the read data (NULL to discard it) 
+ * @param fill : byte sent when there's no write data 
+ * @param data_len : length of the transfer (bytes) 
+ * @return SPI_STATUS : SPI status 
+ */
+SPI_STATUS spi_transfer(
+    SPI_TypeDef *spi, 
+    const uint8_t *write_data, 
+    uint8_t *read_data, 
+    uint8_t fill, 
+    uint32_t data_len); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// DMA transfers 
+
+/**
+ * @brief SPI DMA engine initialization 
+ * 
+ * @details Sets up the engine for an SPI port that has already been configured with 
+ *          spi_init and registers it so spi_transfer uses DMA on that port. The engine 
+ *          must remain valid for as long as the port is used. 
+ * 
+ * @see spi_dma_t
+ * 
+ * @param engine : engine to initialize 
+ * @param spi : pointer to SPI port (SPI1-SPI3) 
+ * @param dma : DMA port of the streams 
+ * @param dma_tx : stream used to send data 
+ * @param dma_rx : stream used to receive data 
+ * @param yield : wait hook used by spi_transfer (NULL to spin) 
+ */
+void spi_dma_init(
+    spi_dma_t *engine, 
+    SPI_TypeDef *spi, 
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef *dma_tx, 
+    DMA_Stream_TypeDef *dma_rx, 
+    spi_yield_t yield); 
+
+
+/**
+ * @brief Start a DMA full-duplex transfer 
+ * 
+ * @details Starts the transfer and returns right away. 'write_data', 'read_data' and 
+ *          'fill' work the same as spi_transfer. The buffers must remain valid until the 
+ *          callback runs. Completion is signalled by the RX stream so the callback needs 
+ *          the streams transfer complete interrupt to be enabled and to call 
+ *          spi_dma_rx_irq. 
+ *          
+ *          Note that the slave device must be selected before calling this function and 
+ *          must stay selected until the transfer is done. 
+ * 
+ * @param engine : engine of the SPI port to use 
+ * @param write_data : data to send (NULL to send 'fill') 
+ * @param read_data : buffer to store the read data (NULL to discard it) 
+ * @param fill : byte sent when there's no write data 
+ * @param data_len : length of the transfer (1-65535 bytes) 
+ * @param callback : completion callback (optional) 
+ * @param context : caller data passed to the callback 
+ * @return SPI_STATUS : SPI_OK if started, SPI_BUSY if a transfer is in progress, 
+ *                      SPI_NULL_PTR if the arguments are invalid 
+ */
+SPI_STATUS spi_transfer_dma(
+    spi_dma_t *engine, 
+    const uint8_t *write_data, 
+    uint8_t *read_data, 
+    uint8_t fill, 
+    uint32_t data_len, 
+    spi_dma_callback_t callback, 
+    void *context); 
+
+
+/**
+ * @brief DMA receive complete handler 
+ * 
+ * @details Finishes the active transfer. Call from the transfer complete interrupt of the 
+ *          'dma_rx' stream after clearing the DMA interrupt flags. 
+ * 
+ * @param engine : engine that owns the DMA stream 
+ */
+void spi_dma_rx_irq(spi_dma_t *engine); 
+
+
+/**
+ * @brief Wait for the active DMA transfer 
+ * 
+ * @details Blocks until the transfer started by spi_transfer_dma is done, calling the 
+ *          engines yield hook while waiting. Transfers are finished here by polling the 
+ *          RX stream if its transfer complete interrupt isn't used. Returns right away if 
+ *          nothing is in progress. 
+ * 
+ * @param engine : engine of the SPI port 
+ * @return SPI_STATUS : SPI_OK once the transfer is done, SPI_TIMEOUT if it didn't finish 
+ *                      in time (the streams are stopped) 
+ */
+SPI_STATUS spi_dma_wait(spi_dma_t *engine); 
+
+
+/**
+ * @brief Engine busy status 
+ * 
+ * @param engine : engine of the SPI port 
+ * @return uint8_t : TRUE if a transfer is in progress, FALSE otherwise 
+ */
+uint8_t spi_dma_busy(const spi_dma_t *engine); 
+
 //=======================================================================================
 
 #ifdef __cplusplus
@@ -26,6 +26,15 @@ extern "C" {
 #include "tools.h" 
 #include "gpio_driver.h" 
 #include "dma_driver.h" 
+#include "stm32f411xe_custom.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_TX_PORTS 3            // Ports that can have a transmit buffer 
 
 //=======================================================================================
 
@@ -185,6 +194,19 @@ typedef enum {
     UART_CURSOR_LEFT       // 68 == 'D' 
 } uart_cursor_move_t; 
 
+
+/**
+ * @brief Transmit buffer overflow policy 
+ * 
+ * @details What a send function does when the transmit buffer doesn't have room for 
+ *          the data. 
+ */
+typedef enum {
+    UART_TX_DROP,          // Discard the new data 
+    UART_TX_BLOCK,         // Wait for room - the data is sent by polling if needed 
+    UART_TX_OVERWRITE      // Discard the oldest unsent data to make room 
+} uart_tx_policy_t; 
+
 //=======================================================================================
 
 
@@ -193,12 +215,45 @@ typedef enum {
 
 typedef uart_status_t UART_STATUS; 
 
+typedef struct uart_rx_stream_s uart_rx_stream_t; 
+
+/**
+ * @brief Receive stream data callback 
+ * 
+ * @details Called from uart_rx_stream_irq when new data has arrived (ex. to wake the task 
+ *          that consumes the stream). 
+ */
+typedef void (*uart_rx_stream_callback_t)(
+    uart_rx_stream_t *stream, 
+    void *context); 
+
+
+/**
+ * @brief Wait hook for DMA transmit 
+ * 
+ * @details Called repeatedly while a DMA transmit function waits for a buffer to free up 
+ *          so the CPU can be given to something else. Under FreeRTOS this can be 
+ *          taskYIELD (or osThreadYield). 
+ */
+typedef void (*uart_yield_t)(void); 
+
 //=======================================================================================
 
 
 //=======================================================================================
 // Structures 
 
+// UART baud rate setting found by uart_baud_calc 
+typedef struct uart_baud_s 
+{
+    uint32_t baud;                    // Achieved baud rate (bps) 
+    int32_t error_ppm;                // Achieved vs requested rate (parts per million) 
+    uint16_t brr;                     // USART_BRR value 
+    uint8_t over8;                    // Oversampling by 8 (OVER8 bit) 
+}
+uart_baud_t; 
+
+
 // UART DMA input circular buffer indexing info 
 typedef struct uart_dma_input_cb_index_s 
 {
@@ -210,6 +265,98 @@ typedef struct uart_dma_input_cb_index_s
 }
 uart_dma_input_cb_index_t;
 
+
+
+/**
+ * @brief UART transmit buffer 
+ * 
+ * @details Ring buffer drained by the TXE interrupt. The storage is owned by the caller 
+ *          and one byte of it is always left empty to tell a full buffer from an empty 
+ *          one. 'head' is only written by the send functions and 'tail' by the interrupt 
+ *          (and the overwrite policy with TXEIE masked) so a single sender doesn't need 
+ *          any other locking. 
+ */
+typedef struct uart_tx_buff_s 
+{
+    USART_TypeDef *uart;              // UART port 
+    uint8_t *buff;                    // Buffer storage 
+    uint16_t size;                    // Buffer size (bytes) 
+    volatile uint16_t head;           // Next free position 
+    volatile uint16_t tail;           // Next byte to send 
+    uart_tx_policy_t policy;          // Overflow policy 
+    uint32_t dropped;                 // Bytes discarded by the overflow policy 
+}
+uart_tx_buff_t; 
+
+
+
+/**
+ * @brief Contiguous section of received data 
+ * 
+ * @details Points straight into the receive stream buffer. 
+ */
+typedef struct uart_rx_span_s 
+{
+    const uint8_t *data;              // Start of the data 
+    uint16_t size;                    // Number of bytes 
+}
+uart_rx_span_t; 
+
+
+/**
+ * @brief UART DMA receive stream 
+ * 
+ * @details The DMA writes received data into a circular buffer and the consumer reads it 
+ *          in place (uart_rx_stream_peek) then releases it (uart_rx_stream_commit). The 
+ *          write position is updated by the half transfer, transfer complete and IDLE line 
+ *          interrupts so a frame becomes available as soon as the line goes idle. The 
+ *          consumer must keep up to within a buffer of data or unread data is lost. 
+ */
+struct uart_rx_stream_s 
+{
+    USART_TypeDef *uart;              // UART port 
+    DMA_TypeDef *dma;                 // DMA port of the stream 
+    DMA_Stream_TypeDef *dma_stream;   // Stream writing the buffer 
+    const uint8_t *buff;              // Buffer the DMA writes to 
+    uint16_t size;                    // Buffer size (bytes) 
+    uart_rx_stream_callback_t callback;   // New data callback (optional) 
+    void *context;                    // Caller data for the callback 
+
+    volatile uint16_t head;           // Position the DMA has written up to 
+    volatile uint32_t received;       // Total bytes written by the DMA 
+    uint16_t tail;                    // First byte not yet committed 
+    uint32_t consumed;                // Total bytes committed 
+    uint32_t overruns;                // Times unread data was overwritten 
+}; 
+
+
+
+/**
+ * @brief UART DMA double-buffered transmit 
+ * 
+ * @details Two caller owned buffers take turns: the application fills one while the DMA 
+ *          sends the other and they swap when the fill buffer is sent. If the DMA is 
+ *          still busy when the fill buffer is sent then it's queued and the transfer 
+ *          complete interrupt starts it. 'fill', 'fill_len', 'busy' and 'pending' are 
+ *          owned by the driver. 
+ */
+typedef struct uart_dma_tx_s 
+{
+    USART_TypeDef *uart;              // UART port 
+    DMA_TypeDef *dma;                 // DMA port of the stream 
+    DMA_Stream_TypeDef *dma_stream;   // Stream feeding the data register 
+    uint8_t *buff[BYTE_2];            // Double buffers 
+    uint16_t size;                    // Size of each buffer (bytes) 
+    uart_yield_t yield;               // Wait hook (NULL to spin) 
+
+    uint8_t fill;                     // Index of the buffer being filled 
+    uint16_t fill_len;                // Bytes in the buffer being filled 
+    volatile uint8_t busy;            // DMA is sending the other buffer 
+    volatile uint8_t pending;         // Fill buffer is queued behind the DMA transfer 
+    uint32_t bytes;                   // Bytes handed to the DMA 
+}
+uart_dma_tx_t; 
+
 //=======================================================================================
 
 
@@ -268,6 +415,51 @@ void uart_data_frame_config(
     uart_mantissa_baud_t baud_mant); 
 
 
+/**
+ * @brief Calculate the baud rate register setting 
+ * 
+ * @details Works out USART_BRR for any baud rate from the peripheral clock instead of the 
+ *          uart_fractional_baud_t/uart_mantissa_baud_t pairs. USARTDIV is rounded to the 
+ *          nearest 1/16 (or 1/8 with OVER8) so the achieved rate is pclk / (pclk / baud) 
+ *          in both modes. Oversampling by 16 is used when possible since it tolerates 
+ *          more clock deviation. Oversampling by 8 is used for rates above pclk/16 (up to 
+ *          pclk/8, ex. 10.5 Mbaud at 84 MHz). The caller decides if the error is 
+ *          acceptable - keep it within about 2% (20000 ppm) for a reliable link. 
+ * 
+ * @param pclk : clock of the UARTs APB bus (Hz) 
+ * @param baud : requested baud rate (bps) 
+ * @param setting : register setting, achieved rate and error 
+ * @return UART_STATUS : UART_OK, UART_INVALID_PTR or UART_BAD_DATA if the rate can't be 
+ *                       made from the clock 
+ */
+UART_STATUS uart_baud_calc(
+    uint32_t pclk, 
+    uint32_t baud, 
+    uart_baud_t *setting); 
+
+
+/**
+ * @brief Set the baud rate 
+ * 
+ * @details Calculates the baud rate register setting (uart_baud_calc) from the current 
+ *          APB clock of the port and writes it. The port is disabled while OVER8 and 
+ *          USART_BRR are changed so this waits for any transmission in progress to 
+ *          finish first. Can be used after uart_init to replace the enum baud rate. 
+ * 
+ * @see uart_baud_calc 
+ * 
+ * @param uart : UART port to use (USART1, USART2 or USART6) 
+ * @param baud : requested baud rate (bps) 
+ * @param setting : achieved rate and error (NULL if not needed) 
+ * @return UART_STATUS : status of the baud rate change - the port is left unchanged if 
+ *                       the rate can't be made 
+ */
+UART_STATUS uart_set_baud(
+    USART_TypeDef *uart, 
+    uint32_t baud, 
+    uart_baud_t *setting); 
+
+
 /**
  * @brief UART interrupt initialization 
  * 
@@ -330,7 +522,10 @@ void uart_clear_dr(USART_TypeDef *uart);
  * 
  * @details Takes a single character and writes it to the data register of the specified 
  *          UART. Waits until the Transmission Complete (TC) bit (bit 6) in the status
- *          register (USART_SR) is set before exiting the function.
+ *          register (USART_SR) is set before exiting the function. If the port has a 
+ *          transmit buffer (uart_tx_buff_init) then the character is added to the buffer 
+ *          instead and the function returns right away. The same goes for the rest of the 
+ *          send functions. 
  * 
  * @param uart : UART port to use 
  * @param character : character written to data register 
@@ -447,6 +642,271 @@ void uart_cursor_move(
 //=======================================================================================
 
 
+//=======================================================================================
+// Transmit buffer 
+
+/**
+ * @brief UART transmit buffer initialization 
+ * 
+ * @details Sets up a transmit buffer for a UART port that has already been initialized 
+ *          and registers it so all the send functions for the port copy their data into 
+ *          the buffer and return instead of waiting on each byte. The buffer is sent in 
+ *          the background by the TXE interrupt so the USARTs interrupt must be enabled 
+ *          in the NVIC and uart_tx_buff_irq called from its handler. If the port already 
+ *          had a buffer then it's flushed and replaced. 
+ *          
+ *          Only one task/context should send on a buffered port at a time. 
+ * 
+ * @see uart_tx_buff_t
+ * @see uart_tx_policy_t
+ * 
+ * @param tx_buff : transmit buffer to initialize 
+ * @param uart : UART port to use 
+ * @param buff : buffer storage 
+ * @param size : size of the buffer storage (at least 2 bytes) 
+ * @param policy : what to do when the data doesn't fit 
+ * @return UART_STATUS : status of the initialization 
+ */
+UART_STATUS uart_tx_buff_init(
+    uart_tx_buff_t *tx_buff, 
+    USART_TypeDef *uart, 
+    uint8_t *buff, 
+    uint16_t size, 
+    uart_tx_policy_t policy); 
+
+
+/**
+ * @brief UART transmit interrupt handler 
+ * 
+ * @details Loads the next byte from the transmit buffer into the data register and 
+ *          disables the TXE interrupt once the buffer is empty. Call from the 
+ *          USARTx_IRQHandler of the buffers port. Does nothing if the TXE interrupt isn't 
+ *          enabled so it can share the handler with receive interrupts. 
+ * 
+ * @param tx_buff : transmit buffer of the interrupting port 
+ */
+void uart_tx_buff_irq(uart_tx_buff_t *tx_buff); 
+
+
+/**
+ * @brief UART transmit flush 
+ * 
+ * @details Waits until all the buffered data of the port has been sent and the last 
+ *          byte has left the shift register (TC). Data still in the buffer is sent by 
+ *          polling so this works even when the interrupt isn't running (ex. before a 
+ *          reset). Returns right away for a port without a transmit buffer once TC is 
+ *          set. 
+ * 
+ * @param uart : UART port to flush 
+ */
+void uart_tx_flush(USART_TypeDef *uart); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Receive stream 
+
+/**
+ * @brief UART DMA receive stream initialization 
+ * 
+ * @details Points the DMA stream at the UART data register and the buffer, enables the 
+ *          half transfer and transfer complete interrupts of the stream and the IDLE line 
+ *          interrupt of the UART, then starts reception. The stream must already be 
+ *          initialized (dma_stream_init) on the UARTs RX channel as a peripheral to memory 
+ *          transfer in circular mode with memory increment and byte data sizes. The 
+ *          application enables both interrupts in the NVIC and calls uart_rx_stream_irq 
+ *          from them. 
+ * 
+ * @see uart_rx_stream_t
+ * 
+ * @param stream : receive stream to initialize 
+ * @param uart : UART port to receive from (already initialized) 
+ * @param dma : DMA port of the stream 
+ * @param dma_stream : DMA stream on the UARTs RX channel 
+ * @param buff : buffer the DMA writes to 
+ * @param size : size of the buffer (at least 2 bytes) 
+ * @param callback : new data callback (optional) 
+ * @param context : caller data passed to the callback 
+ * @return UART_STATUS : status of the initialization 
+ */
+UART_STATUS uart_rx_stream_init(
+    uart_rx_stream_t *stream, 
+    USART_TypeDef *uart, 
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef *dma_stream, 
+    uint8_t *buff, 
+    uint16_t size, 
+    uart_rx_stream_callback_t callback, 
+    void *context); 
+
+
+/**
+ * @brief Receive stream interrupt handler 
+ * 
+ * @details Clears the IDLE line flag if it's set and updates the write position from 
+ *          the DMA stream, then runs the callback if there's new data. Call from the 
+ *          USARTx_IRQHandler and from the DMA stream interrupt after clearing the DMA 
+ *          interrupt flags. It can instead be polled from the main loop if the interrupts 
+ *          aren't used, as long as it's called at least once per half buffer of data. 
+ * 
+ * @param stream : receive stream of the interrupting port 
+ */
+void uart_rx_stream_irq(uart_rx_stream_t *stream); 
+
+
+/**
+ * @brief Get the received data without copying it 
+ * 
+ * @details Describes the data that hasn't been committed yet as up to two spans in the 
+ *          buffer. The second span is only used when the data wraps around the end of the 
+ *          buffer (its size is 0 otherwise). The spans stay valid until they're committed 
+ *          as long as the consumer keeps up. If the DMA has overwritten unread data then 
+ *          the unread data is dropped, 'overruns' is incremented and 0 is returned. 
+ * 
+ * @param stream : receive stream to read 
+ * @param spans : two spans to fill in 
+ * @return uint16_t : total bytes available in the spans 
+ */
+uint16_t uart_rx_stream_peek(
+    uart_rx_stream_t *stream, 
+    uart_rx_span_t *spans); 
+
+
+/**
+ * @brief Release received data 
+ * 
+ * @details Marks data returned by uart_rx_stream_peek as consumed so the DMA can reuse 
+ *          its space. Data can be committed in parts. 
+ * 
+ * @param stream : receive stream 
+ * @param size : number of bytes to release (limited to the bytes available) 
+ */
+void uart_rx_stream_commit(
+    uart_rx_stream_t *stream, 
+    uint16_t size); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// DMA transmit 
+
+/**
+ * @brief UART DMA transmit initialization 
+ * 
+ * @details Points the DMA stream at the UART data register, enables its transfer complete 
+ *          interrupt and sets the DMAT bit (same as the 'tx_dma' option of uart_init). The 
+ *          stream must already be initialized (dma_stream_init) on the UARTs TX channel as 
+ *          a memory to peripheral transfer in normal (not circular) mode with memory 
+ *          increment and byte data sizes. The application enables the streams interrupt in 
+ *          the NVIC and calls uart_dma_tx_irq from it. 
+ * 
+ * @see uart_dma_tx_t
+ * 
+ * @param tx : DMA transmit to initialize 
+ * @param uart : UART port to send on (already initialized) 
+ * @param dma : DMA port of the stream 
+ * @param dma_stream : DMA stream on the UARTs TX channel 
+ * @param buff_a : first buffer 
+ * @param buff_b : second buffer 
+ * @param size : size of each buffer (bytes) 
+ * @param yield : wait hook (NULL to spin) 
+ * @return UART_STATUS : status of the initialization 
+ */
+UART_STATUS uart_dma_tx_init(
+    uart_dma_tx_t *tx, 
+    USART_TypeDef *uart, 
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef *dma_stream, 
+    uint8_t *buff_a, 
+    uint8_t *buff_b, 
+    uint16_t size, 
+    uart_yield_t yield); 
+
+
+/**
+ * @brief Reserve space in the fill buffer 
+ * 
+ * @details Returns where the next 'data_len' bytes of the fill buffer start so a frame 
+ *          can be built in place (ex. packing a MAVLink message) then added with 
+ *          uart_dma_tx_commit. If the fill buffer doesn't have room then it's sent first, 
+ *          which waits for the DMA if both buffers are in use. 
+ * 
+ * @param tx : DMA transmit 
+ * @param data_len : bytes needed 
+ * @return uint8_t* : space in the fill buffer, NULL if the length is 0 or larger than 
+ *                    a buffer 
+ */
+uint8_t *uart_dma_tx_reserve(
+    uart_dma_tx_t *tx, 
+    uint16_t data_len); 
+
+
+/**
+ * @brief Add reserved data to the fill buffer 
+ * 
+ * @param tx : DMA transmit 
+ * @param data_len : bytes written to the space from uart_dma_tx_reserve 
+ */
+void uart_dma_tx_commit(
+    uart_dma_tx_t *tx, 
+    uint16_t data_len); 
+
+
+/**
+ * @brief Copy data into the fill buffer 
+ * 
+ * @details Same as uart_dma_tx_reserve followed by a copy and uart_dma_tx_commit. The data 
+ *          isn't sent until uart_dma_tx_send is called or the fill buffer runs out of room. 
+ * 
+ * @param tx : DMA transmit 
+ * @param data : data to add 
+ * @param data_len : length of the data (up to the buffer size) 
+ * @return UART_STATUS : UART_OK, UART_INVALID_PTR or UART_BAD_DATA if the data is larger 
+ *                       than a buffer 
+ */
+UART_STATUS uart_dma_tx_write(
+    uart_dma_tx_t *tx, 
+    const uint8_t *data, 
+    uint16_t data_len); 
+
+
+/**
+ * @brief Send the fill buffer 
+ * 
+ * @details Starts the DMA on the fill buffer and swaps buffers. If the DMA is still 
+ *          sending the other buffer then the fill buffer is queued and sent from the 
+ *          transfer complete interrupt. Returns right away either way. 
+ * 
+ * @param tx : DMA transmit 
+ */
+void uart_dma_tx_send(uart_dma_tx_t *tx); 
+
+
+/**
+ * @brief DMA transmit complete handler 
+ * 
+ * @details Frees the buffer that was sent and starts the queued buffer if there is one. 
+ *          Call from the transfer complete interrupt of the stream after clearing the DMA 
+ *          interrupt flags. 
+ * 
+ * @param tx : DMA transmit that owns the stream 
+ */
+void uart_dma_tx_irq(uart_dma_tx_t *tx); 
+
+
+/**
+ * @brief DMA transmit busy status 
+ * 
+ * @param tx : DMA transmit 
+ * @return uint8_t : TRUE if the DMA is sending or a buffer is queued, FALSE otherwise 
+ */
+uint8_t uart_dma_tx_busy(const uart_dma_tx_t *tx); 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Read Functions
 
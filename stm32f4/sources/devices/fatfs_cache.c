@@ -0,0 +1,483 @@
+/**
+ * @file fatfs_cache.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS sector cache 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "fatfs_cache.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Find the line holding a sector 
+ * 
+ * @param cache : sector cache 
+ * @param sector : sector number 
+ * @return fatfs_cache_line_t* : line holding the sector, NULL if it's not cached 
+ */
+fatfs_cache_line_t *fatfs_cache_lookup(
+    fatfs_cache_t *cache, 
+    uint32_t sector); 
+
+
+/**
+ * @brief Get a line for a sector that isn't cached 
+ * 
+ * @details Takes a free line of the sectors set or replaces the least recently used one, 
+ *          writing it back first if it's dirty. 
+ * 
+ * @param cache : sector cache 
+ * @param sector : sector number 
+ * @return fatfs_cache_line_t* : line for the sector, NULL if the write back failed 
+ */
+fatfs_cache_line_t *fatfs_cache_alloc(
+    fatfs_cache_t *cache, 
+    uint32_t sector); 
+
+
+/**
+ * @brief Write back the dirty sectors around a sector 
+ * 
+ * @details Writes the run of consecutive dirty sectors that contains 'sector' (up to 
+ *          FATFS_CACHE_MAX_RUN) in one write and marks them clean. 
+ * 
+ * @param cache : sector cache 
+ * @param sector : dirty sector number 
+ * @return DISK_RESULT : result of the write 
+ */
+DISK_RESULT fatfs_cache_write_back(
+    fatfs_cache_t *cache, 
+    uint32_t sector); 
+
+
+/**
+ * @brief Mark a line as used 
+ * 
+ * @param cache : sector cache 
+ * @param line : line accessed 
+ */
+void fatfs_cache_touch(
+    fatfs_cache_t *cache, 
+    fatfs_cache_line_t *line); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Cache initialization 
+DISK_RESULT fatfs_cache_init(
+    fatfs_cache_t *cache, 
+    fatfs_cache_line_t *lines, 
+    uint16_t num_lines, 
+    uint8_t ways, 
+    fatfs_cache_read_t read, 
+    fatfs_cache_write_t write)
+{
+    if ((cache == NULL) || (lines == NULL) || !ways || (num_lines < ways))
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    memset((void *)cache, CLEAR, sizeof(fatfs_cache_t)); 
+    cache->lines = lines; 
+    cache->sets = num_lines / ways; 
+    cache->ways = ways; 
+    cache->read = read; 
+    cache->write = write; 
+
+    fatfs_cache_invalidate(cache); 
+
+    return FATFS_RES_OK; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Cache access 
+
+// Read sectors through the cache 
+DISK_RESULT fatfs_cache_read(
+    fatfs_cache_t *cache, 
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    fatfs_cache_line_t *line; 
+    uint16_t run; 
+
+    if ((cache == NULL) || (buff == NULL) || (cache->read == NULL))
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    for (uint16_t i = CLEAR; i < count; i += run)
+    {
+        line = fatfs_cache_lookup(cache, sector + i); 
+        run = BYTE_1; 
+
+        if (line != NULL)
+        {
+            memcpy((void *)&buff[i * FATFS_CACHE_SEC_SIZE], (void *)line->data, 
+                   FATFS_CACHE_SEC_SIZE); 
+            fatfs_cache_touch(cache, line); 
+            cache->stats.hits++; 
+            continue; 
+        }
+
+        // Read the sectors up to the next cached one together 
+        while (((i + run) < count) && (fatfs_cache_lookup(cache, sector + i + run) == NULL))
+        {
+            run++; 
+        }
+
+        cache->stats.misses += run; 
+        cache->stats.card_reads++; 
+
+        DISK_RESULT result = cache->read(&buff[i * FATFS_CACHE_SEC_SIZE], sector + i, run); 
+
+        if (result != FATFS_RES_OK)
+        {
+            return result; 
+        }
+
+        // Single sector reads are FAT, directory and file window sectors. If a line can't 
+        // be freed up the read is still good, the sector just isn't cached. 
+        if (count == BYTE_1)
+        {
+            line = fatfs_cache_alloc(cache, sector); 
+
+            if (line != NULL)
+            {
+                memcpy((void *)line->data, (void *)buff, FATFS_CACHE_SEC_SIZE); 
+            }
+        }
+    }
+
+    return FATFS_RES_OK; 
+}
+
+
+// Write sectors through the cache 
+DISK_RESULT fatfs_cache_write(
+    fatfs_cache_t *cache, 
+    const uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    const uint8_t *sectors[FATFS_CACHE_MAX_RUN]; 
+    fatfs_cache_line_t *line; 
+    uint16_t run; 
+
+    if ((cache == NULL) || (buff == NULL) || (cache->write == NULL))
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    // Single sectors stay in the cache until they're evicted or flushed 
+    if (count == BYTE_1)
+    {
+        line = fatfs_cache_lookup(cache, sector); 
+
+        if (line != NULL)
+        {
+            cache->stats.hits++; 
+        }
+        else 
+        {
+            cache->stats.misses++; 
+            line = fatfs_cache_alloc(cache, sector); 
+
+            if (line == NULL)
+            {
+                return FATFS_RES_ERROR; 
+            }
+        }
+
+        memcpy((void *)line->data, (void *)buff, FATFS_CACHE_SEC_SIZE); 
+        line->dirty = TRUE; 
+        fatfs_cache_touch(cache, line); 
+
+        return FATFS_RES_OK; 
+    }
+
+    // Multiple sectors go straight to the card. Lines holding any of them get the new 
+    // data and are clean once it's written. 
+    for (uint16_t i = CLEAR; i < count; i += run)
+    {
+        run = ((count - i) < FATFS_CACHE_MAX_RUN) ? (count - i) : FATFS_CACHE_MAX_RUN; 
+
+        for (uint16_t j = CLEAR; j < run; j++)
+        {
+            sectors[j] = &buff[(i + j) * FATFS_CACHE_SEC_SIZE]; 
+            line = fatfs_cache_lookup(cache, sector + i + j); 
+
+            // Stays dirty if the write fails since the card may not have the new data 
+            if (line != NULL)
+            {
+                memcpy((void *)line->data, (void *)sectors[j], FATFS_CACHE_SEC_SIZE); 
+                line->dirty = TRUE; 
+                cache->stats.hits++; 
+            }
+            else 
+            {
+                cache->stats.misses++; 
+            }
+        }
+
+        cache->stats.card_writes++; 
+
+        DISK_RESULT result = cache->write(sectors, sector + i, run); 
+
+        if (result != FATFS_RES_OK)
+        {
+            return result; 
+        }
+
+        for (uint16_t j = CLEAR; j < run; j++)
+        {
+            line = fatfs_cache_lookup(cache, sector + i + j); 
+
+            if (line != NULL)
+            {
+                line->dirty = FALSE; 
+            }
+        }
+    }
+
+    return FATFS_RES_OK; 
+}
+
+
+// Write all dirty sectors to the card 
+DISK_RESULT fatfs_cache_flush(fatfs_cache_t *cache)
+{
+    uint16_t num_lines; 
+    fatfs_cache_line_t *first; 
+
+    if (cache == NULL)
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    num_lines = cache->sets * cache->ways; 
+
+    // Write back from the lowest dirty sector up so each run is as long as it can be 
+    while (TRUE)
+    {
+        first = NULL; 
+
+        for (uint16_t i = CLEAR; i < num_lines; i++)
+        {
+            fatfs_cache_line_t *line = &cache->lines[i]; 
+
+            if (line->valid && line->dirty && 
+                ((first == NULL) || (line->sector < first->sector)))
+            {
+                first = line; 
+            }
+        }
+
+        if (first == NULL)
+        {
+            return FATFS_RES_OK; 
+        }
+
+        DISK_RESULT result = fatfs_cache_write_back(cache, first->sector); 
+
+        if (result != FATFS_RES_OK)
+        {
+            return result; 
+        }
+    }
+}
+
+
+// Drop everything in the cache 
+void fatfs_cache_invalidate(fatfs_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return; 
+    }
+
+    for (uint16_t i = CLEAR; i < (cache->sets * cache->ways); i++)
+    {
+        cache->lines[i].valid = FALSE; 
+        cache->lines[i].dirty = FALSE; 
+        cache->lines[i].last_use = CLEAR; 
+    }
+
+    cache->clock = CLEAR; 
+}
+
+
+// Get the cache statistics 
+void fatfs_cache_stats(
+    const fatfs_cache_t *cache, 
+    fatfs_cache_stats_t *stats)
+{
+    if ((cache == NULL) || (stats == NULL))
+    {
+        return; 
+    }
+
+    *stats = cache->stats; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Find the line holding a sector 
+fatfs_cache_line_t *fatfs_cache_lookup(
+    fatfs_cache_t *cache, 
+    uint32_t sector)
+{
+    fatfs_cache_line_t *line = &cache->lines[(sector % cache->sets) * cache->ways]; 
+
+    for (uint8_t i = CLEAR; i < cache->ways; i++, line++)
+    {
+        if (line->valid && (line->sector == sector))
+        {
+            return line; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Get a line for a sector that isn't cached 
+fatfs_cache_line_t *fatfs_cache_alloc(
+    fatfs_cache_t *cache, 
+    uint32_t sector)
+{
+    fatfs_cache_line_t *line = &cache->lines[(sector % cache->sets) * cache->ways]; 
+    fatfs_cache_line_t *victim = line; 
+
+    // A free line or else the least recently used one 
+    for (uint8_t i = CLEAR; i < cache->ways; i++, line++)
+    {
+        if (!line->valid)
+        {
+            victim = line; 
+            break; 
+        }
+
+        if (line->last_use < victim->last_use)
+        {
+            victim = line; 
+        }
+    }
+
+    if (victim->valid)
+    {
+        if (victim->dirty && (fatfs_cache_write_back(cache, victim->sector) != FATFS_RES_OK))
+        {
+            return NULL; 
+        }
+
+        cache->stats.evictions++; 
+    }
+
+    victim->sector = sector; 
+    victim->valid = TRUE; 
+    victim->dirty = FALSE; 
+    fatfs_cache_touch(cache, victim); 
+
+    return victim; 
+}
+
+
+// Write back the dirty sectors around a sector 
+DISK_RESULT fatfs_cache_write_back(
+    fatfs_cache_t *cache, 
+    uint32_t sector)
+{
+    const uint8_t *sectors[FATFS_CACHE_MAX_RUN]; 
+    fatfs_cache_line_t *lines[FATFS_CACHE_MAX_RUN]; 
+    fatfs_cache_line_t *line; 
+    uint32_t first = sector; 
+    uint16_t run = CLEAR; 
+
+    // Back up to the start of the run 
+    while (first && ((sector - first) < (FATFS_CACHE_MAX_RUN - BYTE_1)))
+    {
+        line = fatfs_cache_lookup(cache, first - BYTE_1); 
+
+        if ((line == NULL) || !line->dirty)
+        {
+            break; 
+        }
+
+        first--; 
+    }
+
+    // Collect the run 
+    while (run < FATFS_CACHE_MAX_RUN)
+    {
+        line = fatfs_cache_lookup(cache, first + run); 
+
+        if ((line == NULL) || !line->dirty)
+        {
+            break; 
+        }
+
+        sectors[run] = line->data; 
+        lines[run++] = line; 
+    }
+
+    if (!run)
+    {
+        return FATFS_RES_OK; 
+    }
+
+    cache->stats.card_writes++; 
+
+    DISK_RESULT result = cache->write(sectors, first, run); 
+
+    if (result != FATFS_RES_OK)
+    {
+        return result; 
+    }
+
+    for (uint16_t i = CLEAR; i < run; i++)
+    {
+        lines[i]->dirty = FALSE; 
+    }
+
+    cache->stats.write_backs += run; 
+
+    return FATFS_RES_OK; 
+}
+
+
+// Mark a line as used 
+void fatfs_cache_touch(
+    fatfs_cache_t *cache, 
+    fatfs_cache_line_t *line)
+{
+    line->last_use = ++cache->clock; 
+}
+
+//=======================================================================================
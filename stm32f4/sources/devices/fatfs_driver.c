@@ -16,6 +16,7 @@
 // Includes 
 
 #include "fatfs_driver.h"
+#include "fatfs_cache.h"
 
 // Drivers 
 #include "timers_driver.h"
@@ -40,7 +41,8 @@
 #define FATFS_PWR_ON_COUNTER     10      // General counter for the fatfs_power_on function 
 #define FATFS_PWR_ON_RES_CNT     0x1FFF  // R1 response counter during power on sequence 
 #define FATFS_R1_RESP_COUNT      10      // Max num of times to read R1 until appropriate response
-#define FATFS_DT_RESP_COUNT      1000    // Max number of times to check the data token 
+#define FATFS_READ_TIMEOUT       100     // Max read access time - data token wait (ms) 
+#define FATFS_BUSY_TIMEOUT       500     // Max busy time - 250 ms SDHC, 500 ms SDXC writes (ms) 
 
 // Data information 
 #define FATFS_DATA_HIGH          0xFF    // DI/MOSI setpoint and DO/MISO response value 
@@ -50,6 +52,14 @@
 #define FATFS_CSD_REG_LEN        16      // CSD register length 
 #define FATFS_CID_REG_LEN        16      // CID register length 
 
+// Clock 
+#define FATFS_INIT_CLK_FREQ      400000    // Max SPI clock during card identification (Hz) 
+#define FATFS_MAX_CLK_FREQ       25000000  // Max SPI clock in default speed mode (Hz) 
+#define FATFS_TRAN_SPEED_UNIT    0x07      // TRAN_SPEED rate unit bits 
+#define FATFS_TRAN_SPEED_UNITS   4         // Defined TRAN_SPEED rate units 
+#define FATFS_TRAN_SPEED_VALUE   0x0F      // TRAN_SPEED time value bits (after shifting) 
+#define FATFS_BYTE_MS            8000      // Bits per byte * ms per s - clock (Hz) to bytes/ms 
+
 // Responses and filters values
 #define FATFS_READY_STATE        0x00    // Drive is ready to send and receive information 
 #define FATFS_IDLE_STATE         0x01    // Drive is in the idle state - after software reset 
@@ -59,6 +69,7 @@
 #define FATFS_CSD_FILTER         0x03    // Isolate the CSD register version number 
 #define FATFS_INIT_SUCCESS       0xFE    // Filter to clear the FATFS_STATUS_NOINIT flag 
 #define FATFS_DR_FILTER          0x1F    // Data response filter for write operations 
+#define FATFS_DE_FILTER          0xF0    // Data error token (read error) has these bits clear 
 
 // IO Control 
 #define FATFS_LBA_OFFSET         1       // Used in sector size calculation for all cards 
@@ -246,6 +257,23 @@ typedef enum {
     FATFS_CSD_V3    // Version 3.0 
 } fatfs_csd_version_t;
 
+
+/**
+ * @brief FATFS multi-block stream 
+ * 
+ * @details Multi-block transfer (CMD18 or CMD25) left open between calls to fatfs_read 
+ *          and fatfs_write when a DMA engine is used. A read or write that continues from 
+ *          the last sector carries on with the open transfer instead of sending a new 
+ *          command. Anything else ends it first. 
+ * 
+ * @see fatfs_dma_init 
+ */
+typedef enum {
+    FATFS_STREAM_NONE,    // No open transfer - card deselected 
+    FATFS_STREAM_READ,    // CMD18 open - next sector being read into the read-ahead buffer 
+    FATFS_STREAM_WRITE    // CMD25 open - card may still be programming the last sector 
+} fatfs_stream_t;
+
 //=======================================================================================
 
 
@@ -333,6 +361,19 @@ void fatfs_send_cmd(
     uint8_t *resp);
 
 
+/**
+ * @brief FATFS read data token 
+ * 
+ * @details Reads the DO/MISO line until the data token that starts a read data packet 
+ *          is received or until the max read access time (100 ms) has passed. A data 
+ *          error token (the card couldn't read the data, ex. address out of range) ends 
+ *          the wait early. A missing or bad token is flagged as a transfer error. 
+ * 
+ * @return DISK_RESULT : FATFS_RES_OK if the token was received 
+ */
+DISK_RESULT fatfs_read_data_token(void); 
+
+
 /**
  * @brief FATFS read data packet 
  * 
@@ -359,7 +400,8 @@ DISK_RESULT fatfs_read_data_packet(
  * @details Sends a data token to the card to indicate the write operation then proceeds 
  *          to write the data packet to the card. The functions writes a single data packet 
  *          so if multiple packets are needed then the functionis called repeatedly. The 
- *          function is used by fatfs_write. 
+ *          function is used by fatfs_write. The packet isn't sent if the card is still 
+ *          busy with the last one after the max busy time. 
  * 
  * @see fatfs_write 
  * 
@@ -463,6 +505,215 @@ DISK_RESULT fatfs_ioctl_get_cid(void *buff);
  */
 DISK_RESULT fatfs_ioctl_get_ocr(void *buff);
 
+
+/**
+ * @brief FATFS data transfer clock 
+ * 
+ * @details Reads the max transfer rate (TRAN_SPEED) from the CSD register and sets the 
+ *          SPI clock to the fastest speed at or below it that the port can make. The 
+ *          rate is capped at 25 MHz since the card isn't switched to high speed mode. If 
+ *          the CSD can't be read the clock stays at the identification speed. Called once 
+ *          the card is initialized. 
+ */
+void fatfs_data_clock(void); 
+
+
+/**
+ * @brief FATFS slow the clock after an error 
+ * 
+ * @details Ends any open transfer and moves the SPI clock down one divider step so a 
+ *          failed read or write can be tried again. Marginal wiring or cards that don't 
+ *          cope with the TRAN_SPEED clock end up at a speed that works. Only used after 
+ *          transfer errors (bad or missing data token, rejected data) since the step is 
+ *          kept until the card is initialized again. Command errors (ex. an address out 
+ *          of range or no card) aren't fixed by a slower clock. 
+ * 
+ * @return uint8_t : TRUE if the clock was slowed, FALSE if it's already at the 
+ *                   identification speed 
+ */
+uint8_t fatfs_clock_fallback(void); 
+
+
+/**
+ * @brief FATFS set the SPI clock 
+ * 
+ * @details Sets the SPI baud rate control and the number of bytes clocked per ms at that 
+ *          speed. The card timeouts are given in ms (spec limits) and turned into a number 
+ *          of bytes to read with this so they last as long at any clock speed. 
+ * 
+ * @param baud : SPI baud rate control 
+ */
+void fatfs_set_clock(spi_baud_rate_ctrl_t baud); 
+
+
+/**
+ * @brief FATFS card address of a sector 
+ * 
+ * @details Block addressed cards (SDC V2 with CCS set) take the sector number and all 
+ *          other cards take a byte address. 
+ * 
+ * @param sector : sector number 
+ * @return uint32_t : read/write command argument 
+ */
+uint32_t fatfs_sector_address(uint32_t sector); 
+
+
+/**
+ * @brief FATFS pre-erase for multiple block writes 
+ * 
+ * @details Sends ACMD23 (SET_WR_BLK_ERASE_COUNT) so SD cards can erase the blocks before 
+ *          they're written which speeds up the write. The command is only a hint so the 
+ *          response isn't checked. MMC cards don't support it. 
+ * 
+ * @param count : number of sectors about to be written 
+ */
+void fatfs_pre_erase(uint16_t count); 
+
+
+/**
+ * @brief FATFS card read 
+ * 
+ * @details Reads sectors from the card, with or without the DMA, and retries at a slower 
+ *          clock if the data transfer fails. The sector cache reads the card through this. 
+ * 
+ * @param buff : buffer to store the sectors 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the read operation 
+ */
+DISK_RESULT fatfs_disk_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief FATFS card write 
+ * 
+ * @details Write version of fatfs_disk_read. The data is either one buffer or a buffer 
+ *          per sector (sector cache write backs). 
+ * 
+ * @param buff : data to write (when 'sectors' is NULL) 
+ * @param sectors : data of each sector (NULL to use 'buff') 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the write operation 
+ */
+DISK_RESULT fatfs_disk_write(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief FATFS card write for the sector cache 
+ * 
+ * @see fatfs_cache_write_t 
+ */
+DISK_RESULT fatfs_cache_write_card(
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief FATFS data of a sector being written 
+ * 
+ * @param buff : data to write (when 'sectors' is NULL) 
+ * @param sectors : data of each sector (NULL to use 'buff') 
+ * @param index : sector index within the write 
+ * @return const uint8_t* : sector data 
+ */
+const uint8_t *fatfs_sector_data(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint16_t index); 
+
+
+/**
+ * @brief FATFS read within one call 
+ * 
+ * @details Reads the sectors with CMD17 or CMD18 and ends the transfer before returning. 
+ *          Used when there's no DMA engine. 
+ * 
+ * @see fatfs_read 
+ * 
+ * @param buff : buffer to store the sectors 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the read operation 
+ */
+DISK_RESULT fatfs_read_blocks(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief FATFS write within one call 
+ * 
+ * @details Writes the sectors with CMD24 or CMD25 and waits for the card to finish 
+ *          before returning. Used when there's no DMA engine. 
+ * 
+ * @see fatfs_write 
+ * 
+ * @param buff : data to write (when 'sectors' is NULL) 
+ * @param sectors : data of each sector (NULL to use 'buff') 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the write operation 
+ */
+DISK_RESULT fatfs_write_blocks(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief FATFS multi-block read with DMA 
+ * 
+ * @details Reads the sectors within an open CMD18 transfer. If the first sector is the 
+ *          one held in the read-ahead buffer then it's taken from there, otherwise a new 
+ *          transfer is started. Once the requested sectors are read the DMA is started on 
+ *          the next sector so it's received while the FatFs module works on this data. 
+ * 
+ * @see fatfs_read 
+ * 
+ * @param buff : buffer to store the sectors 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the read operation 
+ */
+DISK_RESULT fatfs_read_stream(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+/**
+ * @brief FATFS multi-block write with DMA 
+ * 
+ * @details Writes the sectors within an open CMD25 transfer, starting a new transfer 
+ *          (with a pre-erase) if the first sector doesn't continue the open one. The 
+ *          function returns without waiting for the card to finish programming the last 
+ *          sector so the card is busy while the FatFs module prepares the next data. 
+ * 
+ * @see fatfs_write 
+ * 
+ * @param buff : data to write (when 'sectors' is NULL) 
+ * @param sectors : data of each sector (NULL to use 'buff') 
+ * @param sector : first sector number 
+ * @param count : number of sectors 
+ * @return DISK_RESULT : result of the write operation 
+ */
+DISK_RESULT fatfs_write_stream(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
 //=======================================================================================
 
 
@@ -483,6 +734,22 @@ typedef struct
 
     // Pins 
     uint16_t ss_pin;                    // Slave select pin for the card (GPIO pin for SPI) 
+
+    // Clock 
+    spi_baud_rate_ctrl_t init_baud;     // SPI clock for card identification 
+    spi_baud_rate_ctrl_t baud;          // SPI clock for data transfers 
+    uint32_t byte_rate;                 // Bytes clocked per ms at the current clock 
+
+    // Multi-block streaming 
+    spi_dma_t *dma;                     // SPI DMA engine - NULL for single transfers 
+    fatfs_stream_t stream;              // Open multi-block transfer 
+    uint32_t stream_sector;             // Sector the open transfer continues from 
+    uint8_t read_ahead[FATFS_SEC_SIZE]; // Next sector of an open read 
+
+    uint8_t xfer_error;                 // Bad data token or data response seen 
+
+    // Sector cache 
+    fatfs_cache_t *cache;               // NULL when sectors go straight to the card 
 } 
 fatfs_disk_info_t;
 
@@ -513,6 +780,95 @@ void fatfs_user_init(
 
     // Pins 
     sd_card.ss_pin = fatfs_slave_pin;
+
+    // Clock - set by fatfs_init 
+    sd_card.init_baud = SPI_BR_FPCLK_256; 
+    sd_card.baud = SPI_BR_FPCLK_256; 
+    sd_card.byte_rate = FATFS_INIT_CLK_FREQ / FATFS_BYTE_MS; 
+    sd_card.xfer_error = FALSE; 
+
+    // Multi-block streaming 
+    sd_card.dma = NULL; 
+    sd_card.stream = FATFS_STREAM_NONE; 
+    sd_card.stream_sector = CLEAR; 
+
+    // Sector cache 
+    sd_card.cache = NULL; 
+}
+
+
+// FATFS sector cache 
+DISK_RESULT fatfs_cache_attach(fatfs_cache_t *cache)
+{
+    DISK_RESULT result = FATFS_RES_OK; 
+
+    // Anything still in the old cache goes to the card first 
+    if ((sd_card.cache != NULL) && (sd_card.disk_status != FATFS_STATUS_NOINIT))
+    {
+        result = fatfs_cache_flush(sd_card.cache); 
+    }
+
+    if (cache != NULL)
+    {
+        cache->read = fatfs_disk_read; 
+        cache->write = fatfs_cache_write_card; 
+        fatfs_cache_invalidate(cache); 
+    }
+
+    sd_card.cache = cache; 
+
+    return result; 
+}
+
+
+// FATFS DMA multi-block streaming initialization 
+void fatfs_dma_init(spi_dma_t *engine)
+{
+    fatfs_stream_end(); 
+    sd_card.dma = engine; 
+}
+
+
+// FATFS end the open multi-block transfer 
+DISK_RESULT fatfs_stream_end(void)
+{
+    DISK_RESULT result = FATFS_RES_OK; 
+    uint8_t do_resp; 
+    uint8_t stop_trans = FATFS_DT_ONE; 
+
+    switch (sd_card.stream)
+    {
+        case FATFS_STREAM_READ:  // Drop the read-ahead sector and stop the read 
+            if (spi_dma_wait(sd_card.dma) != SPI_OK)
+            {
+                result = FATFS_RES_ERROR; 
+            }
+
+            fatfs_send_cmd(FATFS_CMD12, FATFS_ARG_NONE, FATFS_CRC_CMDX, &do_resp);
+
+            if (do_resp != FATFS_READY_STATE)
+            {
+                result = FATFS_RES_ERROR; 
+            }
+            break; 
+
+        case FATFS_STREAM_WRITE:  // Wait for the last sector then send the stop token 
+            fatfs_ready_rec(); 
+            spi_write(sd_card.spi, &stop_trans, FATFS_SINGLE_BYTE);
+            result = fatfs_ready_rec(); 
+            break; 
+
+        default:  // Nothing open 
+            return FATFS_RES_OK; 
+    }
+
+    sd_card.stream = FATFS_STREAM_NONE; 
+    spi_slave_deselect(sd_card.gpio, sd_card.ss_pin); 
+
+    // Dummy read 
+    spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
+
+    return result; 
 }
 
 
@@ -527,14 +883,22 @@ CARD_TYPE fatfs_get_card_type(void)
 DISK_RESULT fatfs_ready_rec(void)
 {
     uint8_t resp; 
-    uint16_t timer = FATFS_PWR_ON_RES_CNT; 
+    uint32_t timer = sd_card.byte_rate * FATFS_BUSY_TIMEOUT; 
 
-    // Read DO/MISO continuously until it is ready to receive commands 
-    do 
+    // Read DO/MISO continuously until it is ready to receive commands. The card can be 
+    // busy programming for a while after a write so the CPU is given up while waiting if 
+    // the DMA engine has a yield hook. 
+    spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &resp, BYTE_1); 
+
+    while ((resp != FATFS_DATA_HIGH) && --timer)
     {
+        if ((sd_card.dma != NULL) && (sd_card.dma->yield != NULL))
+        {
+            sd_card.dma->yield(); 
+        }
+
         spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &resp, BYTE_1); 
     }
-    while (resp != FATFS_DATA_HIGH && --timer); 
 
     if (timer)
     {
@@ -548,6 +912,7 @@ DISK_RESULT fatfs_ready_rec(void)
 // Check if the card is present 
 DISK_RESULT fatfs_get_existance(void)
 {
+    fatfs_stream_end(); 
     spi_slave_select(sd_card.gpio, sd_card.ss_pin);
     DISK_RESULT exist = fatfs_ready_rec();
     spi_slave_deselect(sd_card.gpio, sd_card.ss_pin);
@@ -574,6 +939,16 @@ DISK_STATUS fatfs_init(uint8_t pdrv)
         return FATFS_STATUS_NOINIT; 
     }
 
+    fatfs_stream_end(); 
+
+    // The card may have been swapped 
+    fatfs_cache_invalidate(sd_card.cache); 
+
+    // The card is identified at 400 kHz or less. The data transfer clock is set once the 
+    // card is ready. 
+    sd_card.init_baud = spi_baud_select(spi_get_pclk(sd_card.spi), FATFS_INIT_CLK_FREQ); 
+    fatfs_set_clock(sd_card.init_baud); 
+
     //===================================================
     // Power ON or card insertion and software reset 
 
@@ -721,6 +1096,9 @@ DISK_STATUS fatfs_init(uint8_t pdrv)
     {
         // Clear no init flag 
         sd_card.disk_status = (FATFS_STATUS_NOINIT & FATFS_INIT_SUCCESS); 
+
+        // Speed up for data transfers 
+        fatfs_data_clock(); 
     }
 
     return sd_card.disk_status;
@@ -748,9 +1126,6 @@ DISK_RESULT fatfs_read(
     uint32_t sector,
     uint16_t count)
 {
-    DISK_RESULT read_resp;
-    uint8_t do_resp = 255;
-
     if (buff == NULL)
     {
         return FATFS_RES_ERROR;
@@ -768,74 +1143,12 @@ DISK_RESULT fatfs_read(
         return FATFS_RES_NOTRDY;
     }
 
-    // Convert the sector number to byte address if it's not SDC V2 (byte address)
-    // Is this needed for all SDC V2 cards or just block address ones? 
-    if (sd_card.card_type & FATFS_CT_SDC2_BYTE)
-    {
-        sector *= FATFS_SEC_SIZE;
-    }
-
-    // Select the slave device 
-    spi_slave_select(sd_card.gpio, sd_card.ss_pin);
-
-    // Determine the read operation 
-    if (count == FATFS_SINGLE_BYTE)   // Read one data packet if count == 1
-    {
-        // Send CMD17 with an arg that specifies the address to start to read 
-        fatfs_send_cmd(FATFS_CMD17, sector, FATFS_CRC_CMDX, &do_resp);
-
-        // Read the R1 response 
-        if (do_resp == FATFS_READY_STATE)
-        {
-            // CMD17 successful - Read initiated 
-            read_resp = fatfs_read_data_packet(buff, FATFS_SEC_SIZE);
-        } 
-        else
-        {
-            // Unsuccessful CMD17 
-            read_resp = FATFS_RES_ERROR;
-        }
-    }
-    else   // Read multiple data packets if count > 1
+    if (sd_card.cache != NULL)
     {
-        // Send CMD18 with an arg that specifies the address to start a sequential read 
-        fatfs_send_cmd(FATFS_CMD18, sector, FATFS_CRC_CMDX, &do_resp);
-
-        // Read the R1 response 
-        if (do_resp == FATFS_READY_STATE)
-        {
-            // CMD18 successfull - read initiated 
-            do 
-            {
-                read_resp = fatfs_read_data_packet(buff, FATFS_SEC_SIZE);
-                buff += FATFS_SEC_SIZE; 
-            }
-            while (--count && (read_resp != FATFS_RES_ERROR));
-
-            // Send CMD12 to terminate the read transaction 
-            fatfs_send_cmd(FATFS_CMD12, FATFS_ARG_NONE, FATFS_CRC_CMDX, &do_resp);
-
-            if (do_resp != FATFS_READY_STATE)
-            {
-                // CMD12 unsuccessfull 
-                read_resp = FATFS_RES_ERROR;
-            }
-        }
-        else
-        {
-            // Unsuccessful CMD18
-            read_resp = FATFS_RES_ERROR;
-        }
+        return fatfs_cache_read(sd_card.cache, buff, sector, count); 
     }
 
-    // Deselect the slave device 
-    spi_slave_deselect(sd_card.gpio, sd_card.ss_pin);
-
-    // Dummy read 
-    spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
-
-    // Return the result 
-    return read_resp;
+    return fatfs_disk_read(buff, sector, count); 
 }
 
 
@@ -846,10 +1159,6 @@ DISK_RESULT fatfs_write(
     uint32_t sector,
     uint16_t count)
 {
-    DISK_RESULT write_resp; 
-    uint8_t do_resp; 
-    uint8_t stop_trans = FATFS_DT_ONE;
-
     if (buff == NULL)
     {
         return FATFS_RES_ERROR;
@@ -873,102 +1182,47 @@ DISK_RESULT fatfs_write(
         return FATFS_RES_WRPRT;
     }
 
-    // Convert the sector number to byte address if it's not SDC V2 (byte address) 
-    if (sd_card.card_type != FATFS_CT_SDC2_BYTE)
+    if (sd_card.cache != NULL)
     {
-        sector *= FATFS_SEC_SIZE;
+        return fatfs_cache_write(sd_card.cache, buff, sector, count); 
     }
 
-    // Select the slave device 
-    spi_slave_select(sd_card.gpio, sd_card.ss_pin);
+    return fatfs_disk_write(buff, NULL, sector, count); 
+}
 
-    // Wait until the card is no longer busy before sending a CMD 
-    fatfs_ready_rec();
 
-    // Determine the write operation 
-    if (count ==  FATFS_SINGLE_BYTE)  // Send one data packet if count == 1
+// FATFS IO control 
+DISK_RESULT fatfs_ioctl(
+    uint8_t pdrv, 
+    uint8_t cmd, 
+    void    *buff)
+{
+    DISK_RESULT result; 
+
+    // Check that the drive number is zero 
+    if (pdrv)
     {
-        // Send CMD24 with an arg that specifies the address to start to write 
-        fatfs_send_cmd(FATFS_CMD24, sector, FATFS_CRC_CMDX, &do_resp);
+        return FATFS_RES_PARERR;
+    }
 
-        // Check the R1 response 
-        if (do_resp == FATFS_READY_STATE)
-        {
-            // Successfull CMD24 - Write data packet to card 
-            write_resp = fatfs_write_data_packet(buff, FATFS_SEC_SIZE, FATFS_DT_TWO);
-        }
-        else
-        {
-            // Unsuccessfull CMD24 
-            write_resp = FATFS_RES_ERROR;
-        }
-    }
-    else  // Send multiple data packets if count > 1
+    // Check the init status 
+    if ((sd_card.disk_status == FATFS_STATUS_NOINIT) && (cmd != FATFS_CTRL_POWER))
     {
-        // Specify the number of sectors to pre-erase to optimize write performance - no 
-        // error condition in place. Also unclear if it's only SDCV1. 
-        if (sd_card.card_type == FATFS_CT_SDC1)
-        {
-            fatfs_send_cmd(FATFS_CMD55, FATFS_ARG_NONE, FATFS_CRC_CMDX, &do_resp);
-            fatfs_send_cmd(FATFS_CMD23, count, FATFS_CRC_CMDX, &do_resp);
-        }
-
-        // Send CMD25 that specifies the address to start to write 
-        fatfs_send_cmd(FATFS_CMD25, sector, FATFS_CRC_CMDX, &do_resp);
-
-        // Check the R1 response 
-        if (do_resp == FATFS_READY_STATE)
-        {
-            // CMD25 successful - Write all the sectors or until there is an error 
-            do 
-            {
-                write_resp = fatfs_write_data_packet(buff, FATFS_SEC_SIZE, FATFS_DT_ZERO);
-                buff += FATFS_SEC_SIZE; 
-            }
-            while (--count && (write_resp != FATFS_RES_ERROR)); 
-
-            // Wait on busy flag to clear 
-            fatfs_ready_rec();
-
-            // Send stop token 
-            spi_write(sd_card.spi, &stop_trans, FATFS_SINGLE_BYTE);
-        }
-        else
-        {
-            // Unsuccessfull CMD25 
-            write_resp = FATFS_RES_ERROR;
-        }
+        return FATFS_RES_NOTRDY;
     }
 
-    // Wait on busy flag to clear 
-    fatfs_ready_rec();
-
-    // Deselect the slave device
-    spi_slave_deselect(sd_card.gpio, sd_card.ss_pin); 
-
-    // Return the write opration status 
-    return write_resp; 
-}
-
-
-// FATFS IO control 
-DISK_RESULT fatfs_ioctl(
-    uint8_t pdrv, 
-    uint8_t cmd, 
-    void    *buff)
-{
-    DISK_RESULT result; 
-
-    // Check that the drive number is zero 
-    if (pdrv)
+    // Write the dirty cached sectors and finish any open multi-block transfer. For 
+    // CTRL_SYNC this is what makes sure the written data is on the card. 
+    if ((cmd == FATFS_CTRL_SYNC) && (sd_card.cache != NULL) && 
+        (fatfs_cache_flush(sd_card.cache) != FATFS_RES_OK))
     {
-        return FATFS_RES_PARERR;
+        fatfs_stream_end(); 
+        return FATFS_RES_ERROR; 
     }
 
-    // Check the init status 
-    if ((sd_card.disk_status == FATFS_STATUS_NOINIT) && (cmd != FATFS_CTRL_POWER))
+    if ((fatfs_stream_end() != FATFS_RES_OK) && (cmd == FATFS_CTRL_SYNC))
     {
-        return FATFS_RES_NOTRDY;
+        return FATFS_RES_ERROR; 
     }
 
     // Select the slave card 
@@ -1241,27 +1495,47 @@ void fatfs_send_cmd(
 }
 
 
-// FATFS read data packet 
-DISK_RESULT fatfs_read_data_packet(
-    uint8_t *buff,
-    uint32_t sector_size)
+// FATFS read data token 
+DISK_RESULT fatfs_read_data_token(void)
 {
-    DISK_RESULT read_resp;
-    uint8_t do_resp = 200; 
-    uint16_t num_read = FATFS_DT_RESP_COUNT; 
+    uint8_t do_resp; 
+    uint32_t num_read = sd_card.byte_rate * FATFS_READ_TIMEOUT; 
 
-    // Read the data token 
     do 
     {
         spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
     }
-    while ((do_resp != FATFS_DT_TWO) && --num_read); 
+    while ((do_resp != FATFS_DT_TWO) && (do_resp & FATFS_DE_FILTER) && --num_read); 
 
-    // Check the R1 response 
     if (do_resp == FATFS_DT_TWO)
     {
-        // Valid data token is detected - read the data packet 
-        spi_write_read(sd_card.spi, FATFS_DATA_HIGH, buff, sector_size);
+        return FATFS_RES_OK; 
+    }
+
+    // A data error token is the card rejecting the read, not a transfer problem 
+    if ((do_resp & FATFS_DE_FILTER) || !do_resp)
+    {
+        sd_card.xfer_error = TRUE; 
+    }
+
+    return FATFS_RES_ERROR; 
+}
+
+
+// FATFS read data packet 
+DISK_RESULT fatfs_read_data_packet(
+    uint8_t *buff,
+    uint32_t sector_size)
+{
+    DISK_RESULT read_resp;
+    uint8_t do_resp; 
+
+    // Check the data token 
+    if (fatfs_read_data_token() == FATFS_RES_OK)
+    {
+        // Valid data token is detected - read the data packet. This uses DMA if it's 
+        // been set up for the SPI port. 
+        spi_transfer(sd_card.spi, NULL, buff, FATFS_DATA_HIGH, sector_size);
 
         // Discard the two CRC bytes 
         spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE);
@@ -1291,14 +1565,18 @@ DISK_RESULT fatfs_write_data_packet(
     uint8_t do_resp; 
     uint8_t crc = FATFS_CRC_CMDX; 
 
-    // Wait until the card is no longer busy before sending a CMD 
-    fatfs_ready_rec();
+    // Wait until the card is no longer busy. A card that's still busy would ignore the 
+    // packet so it isn't sent. 
+    if (fatfs_ready_rec() != FATFS_RES_OK)
+    {
+        return FATFS_RES_ERROR; 
+    }
 
     // Send data token 
     spi_write(sd_card.spi, &data_token, FATFS_SINGLE_BYTE);
 
     // Send data block 
-    spi_write(sd_card.spi, buff, sector_size); 
+    spi_transfer(sd_card.spi, buff, NULL, FATFS_DATA_HIGH, sector_size); 
 
     // Send CRC 
     spi_write(sd_card.spi, &crc, FATFS_SINGLE_BYTE);
@@ -1317,6 +1595,7 @@ DISK_RESULT fatfs_write_data_packet(
     {
         // Data rejected duw to write error or CRC error 
         write_resp = FATFS_RES_ERROR; 
+        sd_card.xfer_error = TRUE; 
     }
 
     // Return the response 
@@ -1324,6 +1603,441 @@ DISK_RESULT fatfs_write_data_packet(
 }
 
 
+// FATFS data transfer clock 
+void fatfs_data_clock(void)
+{
+    // TRAN_SPEED rate units (bits/s) and time values (x10) - SD physical layer spec 
+    static const uint32_t rate_unit[FATFS_TRAN_SPEED_UNITS] = 
+        { 100000, 1000000, 10000000, 100000000 }; 
+    static const uint8_t time_value[FATFS_TRAN_SPEED_VALUE + 1] = 
+        { 0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80 }; 
+
+    DISK_RESULT result; 
+    uint8_t do_resp; 
+    uint8_t csd[FATFS_CSD_REG_LEN]; 
+
+    spi_slave_select(sd_card.gpio, sd_card.ss_pin);
+    result = fatfs_ioctl_get_csd(csd); 
+    spi_slave_deselect(sd_card.gpio, sd_card.ss_pin);
+    spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
+
+    uint8_t unit = csd[BYTE_3] & FATFS_TRAN_SPEED_UNIT; 
+    uint8_t value = (csd[BYTE_3] >> SHIFT_3) & FATFS_TRAN_SPEED_VALUE; 
+
+    if ((result != FATFS_RES_OK) || (unit >= FATFS_TRAN_SPEED_UNITS) || !value)
+    {
+        return; 
+    }
+
+    uint32_t freq = (rate_unit[unit] / 10) * time_value[value]; 
+
+    if (freq > FATFS_MAX_CLK_FREQ)
+    {
+        freq = FATFS_MAX_CLK_FREQ; 
+    }
+
+    fatfs_set_clock(spi_baud_select(spi_get_pclk(sd_card.spi), freq)); 
+}
+
+
+// FATFS slow the clock after an error 
+uint8_t fatfs_clock_fallback(void)
+{
+    if (sd_card.baud >= sd_card.init_baud)
+    {
+        return FALSE; 
+    }
+
+    fatfs_stream_end(); 
+    fatfs_set_clock(sd_card.baud + 1); 
+
+    return TRUE; 
+}
+
+
+// FATFS set the SPI clock 
+void fatfs_set_clock(spi_baud_rate_ctrl_t baud)
+{
+    sd_card.baud = baud; 
+    spi_set_baud(sd_card.spi, baud); 
+
+    // SPI clock = PCLK/2^(baud + 1) 
+    sd_card.byte_rate = (spi_get_pclk(sd_card.spi) >> (baud + 1)) / FATFS_BYTE_MS; 
+
+    if (!sd_card.byte_rate)
+    {
+        sd_card.byte_rate = BYTE_1; 
+    }
+}
+
+
+// FATFS card address of a sector 
+uint32_t fatfs_sector_address(uint32_t sector)
+{
+    if (sd_card.card_type == FATFS_CT_SDC2_BLOCK)
+    {
+        return sector; 
+    }
+
+    return sector * FATFS_SEC_SIZE; 
+}
+
+
+// FATFS pre-erase for multiple block writes 
+void fatfs_pre_erase(uint16_t count)
+{
+    uint8_t do_resp; 
+
+    if (sd_card.card_type & (FATFS_CT_SDC1 | FATFS_CT_SDC2_BYTE))
+    {
+        fatfs_send_cmd(FATFS_CMD55, FATFS_ARG_NONE, FATFS_CRC_CMDX, &do_resp);
+        fatfs_send_cmd(FATFS_CMD23, count, FATFS_CRC_CMDX, &do_resp);
+    }
+}
+
+
+// FATFS card read 
+DISK_RESULT fatfs_disk_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    DISK_RESULT read_resp; 
+
+    // Multi-block transfers are left open between calls when the DMA is used. If the 
+    // data transfer fails then it's tried again at a slower clock. 
+    do 
+    {
+        sd_card.xfer_error = FALSE; 
+        read_resp = (sd_card.dma != NULL) ? fatfs_read_stream(buff, sector, count) : 
+                                            fatfs_read_blocks(buff, sector, count); 
+    }
+    while ((read_resp == FATFS_RES_ERROR) && sd_card.xfer_error && fatfs_clock_fallback()); 
+
+    return read_resp; 
+}
+
+
+// FATFS card write 
+DISK_RESULT fatfs_disk_write(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    DISK_RESULT write_resp; 
+
+    // Same as fatfs_disk_read 
+    do 
+    {
+        sd_card.xfer_error = FALSE; 
+        write_resp = (sd_card.dma != NULL) ? 
+                     fatfs_write_stream(buff, sectors, sector, count) : 
+                     fatfs_write_blocks(buff, sectors, sector, count); 
+    }
+    while ((write_resp == FATFS_RES_ERROR) && sd_card.xfer_error && fatfs_clock_fallback()); 
+
+    return write_resp; 
+}
+
+
+// FATFS card write for the sector cache 
+DISK_RESULT fatfs_cache_write_card(
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    return fatfs_disk_write(NULL, sectors, sector, count); 
+}
+
+
+// FATFS data of a sector being written 
+const uint8_t *fatfs_sector_data(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint16_t index)
+{
+    return (sectors != NULL) ? sectors[index] : &buff[index * FATFS_SEC_SIZE]; 
+}
+
+
+// FATFS read within one call 
+DISK_RESULT fatfs_read_blocks(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    DISK_RESULT read_resp;
+    uint8_t do_resp;
+
+    sector = fatfs_sector_address(sector); 
+
+    // Select the slave device 
+    spi_slave_select(sd_card.gpio, sd_card.ss_pin);
+
+    // Determine the read operation 
+    if (count == FATFS_SINGLE_BYTE)   // Read one data packet if count == 1
+    {
+        // Send CMD17 with an arg that specifies the address to start to read 
+        fatfs_send_cmd(FATFS_CMD17, sector, FATFS_CRC_CMDX, &do_resp);
+
+        // Read the R1 response 
+        if (do_resp == FATFS_READY_STATE)
+        {
+            // CMD17 successful - Read initiated 
+            read_resp = fatfs_read_data_packet(buff, FATFS_SEC_SIZE);
+        } 
+        else
+        {
+            // Unsuccessful CMD17 
+            read_resp = FATFS_RES_ERROR;
+        }
+    }
+    else   // Read multiple data packets if count > 1
+    {
+        // Send CMD18 with an arg that specifies the address to start a sequential read 
+        fatfs_send_cmd(FATFS_CMD18, sector, FATFS_CRC_CMDX, &do_resp);
+
+        // Read the R1 response 
+        if (do_resp == FATFS_READY_STATE)
+        {
+            // CMD18 successfull - read initiated 
+            do 
+            {
+                read_resp = fatfs_read_data_packet(buff, FATFS_SEC_SIZE);
+                buff += FATFS_SEC_SIZE; 
+            }
+            while (--count && (read_resp != FATFS_RES_ERROR));
+
+            // Send CMD12 to terminate the read transaction 
+            fatfs_send_cmd(FATFS_CMD12, FATFS_ARG_NONE, FATFS_CRC_CMDX, &do_resp);
+
+            if (do_resp != FATFS_READY_STATE)
+            {
+                // CMD12 unsuccessfull 
+                read_resp = FATFS_RES_ERROR;
+            }
+        }
+        else
+        {
+            // Unsuccessful CMD18
+            read_resp = FATFS_RES_ERROR;
+        }
+    }
+
+    // Deselect the slave device 
+    spi_slave_deselect(sd_card.gpio, sd_card.ss_pin);
+
+    // Dummy read 
+    spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
+
+    // Return the result 
+    return read_resp;
+}
+
+
+// FATFS write within one call 
+DISK_RESULT fatfs_write_blocks(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    DISK_RESULT write_resp; 
+    uint8_t do_resp; 
+    uint8_t stop_trans = FATFS_DT_ONE;
+    uint16_t index = CLEAR; 
+
+    sector = fatfs_sector_address(sector); 
+
+    // Select the slave device 
+    spi_slave_select(sd_card.gpio, sd_card.ss_pin);
+
+    // Wait until the card is no longer busy before sending a CMD 
+    fatfs_ready_rec();
+
+    // Determine the write operation 
+    if (count ==  FATFS_SINGLE_BYTE)  // Send one data packet if count == 1
+    {
+        // Send CMD24 with an arg that specifies the address to start to write 
+        fatfs_send_cmd(FATFS_CMD24, sector, FATFS_CRC_CMDX, &do_resp);
+
+        // Check the R1 response 
+        if (do_resp == FATFS_READY_STATE)
+        {
+            // Successfull CMD24 - Write data packet to card 
+            write_resp = fatfs_write_data_packet(fatfs_sector_data(buff, sectors, index), 
+                                                 FATFS_SEC_SIZE, FATFS_DT_TWO);
+        }
+        else
+        {
+            // Unsuccessfull CMD24 
+            write_resp = FATFS_RES_ERROR;
+        }
+    }
+    else  // Send multiple data packets if count > 1
+    {
+        // Specify the number of sectors to pre-erase to optimize write performance 
+        fatfs_pre_erase(count); 
+
+        // Send CMD25 that specifies the address to start to write 
+        fatfs_send_cmd(FATFS_CMD25, sector, FATFS_CRC_CMDX, &do_resp);
+
+        // Check the R1 response 
+        if (do_resp == FATFS_READY_STATE)
+        {
+            // CMD25 successful - Write all the sectors or until there is an error 
+            do 
+            {
+                write_resp = fatfs_write_data_packet(fatfs_sector_data(buff, sectors, index), 
+                                                     FATFS_SEC_SIZE, FATFS_DT_ZERO);
+            }
+            while ((++index < count) && (write_resp != FATFS_RES_ERROR)); 
+
+            // Wait on busy flag to clear 
+            fatfs_ready_rec();
+
+            // Send stop token 
+            spi_write(sd_card.spi, &stop_trans, FATFS_SINGLE_BYTE);
+        }
+        else
+        {
+            // Unsuccessfull CMD25 
+            write_resp = FATFS_RES_ERROR;
+        }
+    }
+
+    // Wait on busy flag to clear 
+    fatfs_ready_rec();
+
+    // Deselect the slave device
+    spi_slave_deselect(sd_card.gpio, sd_card.ss_pin); 
+
+    // Return the write opration status 
+    return write_resp; 
+}
+
+
+// FATFS multi-block read with DMA 
+DISK_RESULT fatfs_read_stream(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    DISK_RESULT read_resp = FATFS_RES_OK; 
+    uint8_t do_resp; 
+
+    // Take the first sector from the read-ahead buffer if the read continues the open one 
+    if ((sd_card.stream == FATFS_STREAM_READ) && (sector == sd_card.stream_sector) && 
+        (spi_dma_wait(sd_card.dma) == SPI_OK))
+    {
+        // Discard the two CRC bytes 
+        spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE);
+        spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE);
+
+        memcpy((void *)buff, (void *)sd_card.read_ahead, FATFS_SEC_SIZE); 
+        buff += FATFS_SEC_SIZE; 
+        sector++; 
+        count--; 
+    }
+    else 
+    {
+        fatfs_stream_end(); 
+
+        // Select the slave device 
+        spi_slave_select(sd_card.gpio, sd_card.ss_pin);
+
+        // Send CMD18 even for one sector so the following sectors can be read ahead 
+        fatfs_send_cmd(FATFS_CMD18, fatfs_sector_address(sector), FATFS_CRC_CMDX, &do_resp);
+
+        if (do_resp != FATFS_READY_STATE)
+        {
+            // Unsuccessful CMD18 
+            spi_slave_deselect(sd_card.gpio, sd_card.ss_pin);
+            spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
+            return FATFS_RES_ERROR; 
+        }
+
+        sd_card.stream = FATFS_STREAM_READ; 
+    }
+
+    // Read the rest of the sectors 
+    while (count && (read_resp == FATFS_RES_OK))
+    {
+        read_resp = fatfs_read_data_packet(buff, FATFS_SEC_SIZE);
+        buff += FATFS_SEC_SIZE; 
+        sector++; 
+        count--; 
+    }
+
+    sd_card.stream_sector = sector; 
+
+    // Receive the next sector while the FatFs module uses this data. If it can't be 
+    // started then the transfer is ended and the next read sends a new command. 
+    if ((read_resp != FATFS_RES_OK) || 
+        (fatfs_read_data_token() != FATFS_RES_OK) || 
+        (spi_transfer_dma(sd_card.dma, NULL, sd_card.read_ahead, FATFS_DATA_HIGH, 
+                          FATFS_SEC_SIZE, NULL, NULL) != SPI_OK))
+    {
+        fatfs_stream_end(); 
+    }
+
+    return read_resp; 
+}
+
+
+// FATFS multi-block write with DMA 
+DISK_RESULT fatfs_write_stream(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    DISK_RESULT write_resp = FATFS_RES_OK; 
+    uint8_t do_resp; 
+
+    // Start a new transfer if this doesn't continue the open one 
+    if ((sd_card.stream != FATFS_STREAM_WRITE) || (sector != sd_card.stream_sector))
+    {
+        fatfs_stream_end(); 
+
+        // Select the slave device 
+        spi_slave_select(sd_card.gpio, sd_card.ss_pin);
+
+        // Pre-erase then send CMD25 even for one sector so following writes can continue 
+        fatfs_pre_erase(count); 
+        fatfs_send_cmd(FATFS_CMD25, fatfs_sector_address(sector), FATFS_CRC_CMDX, &do_resp);
+
+        if (do_resp != FATFS_READY_STATE)
+        {
+            // Unsuccessful CMD25 
+            fatfs_ready_rec(); 
+            spi_slave_deselect(sd_card.gpio, sd_card.ss_pin);
+            spi_write_read(sd_card.spi, FATFS_DATA_HIGH, &do_resp, FATFS_SINGLE_BYTE); 
+            return FATFS_RES_ERROR; 
+        }
+
+        sd_card.stream = FATFS_STREAM_WRITE; 
+    }
+
+    // Each packet waits for the card to finish the one before it 
+    for (uint16_t i = CLEAR; (i < count) && (write_resp == FATFS_RES_OK); i++)
+    {
+        write_resp = fatfs_write_data_packet(fatfs_sector_data(buff, sectors, i), 
+                                             FATFS_SEC_SIZE, FATFS_DT_ZERO);
+    }
+
+    sd_card.stream_sector = sector + count; 
+
+    if (write_resp != FATFS_RES_OK)
+    {
+        fatfs_stream_end(); 
+    }
+
+    return write_resp; 
+}
+
+
 // FATFS IO Control - Get Sector Count 
 DISK_RESULT fatfs_ioctl_get_sector_count(void *buff)
 {
@@ -0,0 +1,632 @@
+/**
+ * @file fatfs_logger.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS binary data logger 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "fatfs_logger.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define FATFS_LOGGER_SEC_MASK (FATFS_LOGGER_SEC_SIZE - 1)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Reserve space in the ring 
+ * 
+ * @param logger : logger 
+ * @param size : bytes to reserve 
+ * @param pad : TRUE to reserve up to the end of the sector instead of 'size' bytes 
+ * @param pos : start of the reserved space (ring position)
+ * @return uint32_t : bytes reserved, 0 if there isn't enough room 
+ */
+uint32_t fatfs_logger_reserve(
+    fatfs_logger_t *logger, 
+    uint32_t size, 
+    uint8_t pad, 
+    uint32_t *pos); 
+
+
+/**
+ * @brief Copy data into the ring 
+ * 
+ * @param logger : logger 
+ * @param pos : ring position 
+ * @param data : data to copy 
+ * @param len : data length 
+ */
+void fatfs_logger_copy(
+    fatfs_logger_t *logger, 
+    uint32_t pos, 
+    const void *data, 
+    uint32_t len); 
+
+
+/**
+ * @brief Complete a record 
+ * 
+ * @details Writes the header. The sync byte is written last since it's what tells the 
+ *          task the record is complete. 
+ * 
+ * @param logger : logger 
+ * @param pos : ring position of the record 
+ * @param id : record ID 
+ * @param len : data length 
+ */
+void fatfs_logger_commit(
+    fatfs_logger_t *logger, 
+    uint32_t pos, 
+    uint8_t id, 
+    uint16_t len); 
+
+
+/**
+ * @brief Find the end of the complete records 
+ * 
+ * @param logger : logger 
+ * @return uint32_t : bytes of complete records not yet written 
+ */
+uint32_t fatfs_logger_scan(fatfs_logger_t *logger); 
+
+
+/**
+ * @brief Write bytes from the ring to the files 
+ * 
+ * @param logger : logger 
+ * @param len : bytes to write (multiple of the sector size)
+ * @return FATFS_LOGGER_STATUS : status of the card operations 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_write(
+    fatfs_logger_t *logger, 
+    uint32_t len); 
+
+
+/**
+ * @brief Open the next file and preallocate it 
+ * 
+ * @param logger : logger 
+ * @return FATFS_LOGGER_STATUS : status of the card operations 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_open(fatfs_logger_t *logger); 
+
+
+/**
+ * @brief Record a FatFs error 
+ * 
+ * @details The file is closed and the next write continues in a new file. 
+ * 
+ * @param logger : logger 
+ * @param result : FatFs result 
+ * @return FATFS_LOGGER_STATUS : FATFS_LOGGER_FILE_ERROR 
+ */
+FATFS_LOGGER_STATUS fatfs_logger_error(
+    fatfs_logger_t *logger, 
+    FRESULT result); 
+
+
+/**
+ * @brief Get the time source count 
+ * 
+ * @param logger : logger 
+ * @return uint32_t : time source count (0 if there's no time source)
+ */
+uint32_t fatfs_logger_now(const fatfs_logger_t *logger); 
+
+
+/**
+ * @brief Update the max card operation latency 
+ * 
+ * @param logger : logger 
+ * @param start : time source count when the operation started 
+ */
+void fatfs_logger_latency(
+    fatfs_logger_t *logger, 
+    uint32_t start); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Logger initialization 
+FATFS_LOGGER_STATUS fatfs_logger_init(
+    fatfs_logger_t *logger, 
+    uint8_t *ring, 
+    uint32_t ring_size, 
+    uint32_t block_size, 
+    const char *prefix, 
+    uint16_t index, 
+    uint32_t file_size, 
+    fatfs_logger_time_t time)
+{
+    if ((logger == NULL) || (ring == NULL) || (prefix == NULL) || 
+        (strlen(prefix) >= FATFS_LOGGER_PREFIX_LEN) || 
+        (ring_size < FATFS_LOGGER_SEC_SIZE) || (ring_size & (ring_size - 1)) || 
+        !block_size || (block_size & FATFS_LOGGER_SEC_MASK) || 
+        (block_size > (ring_size >> SHIFT_1)) || 
+        !file_size || (file_size & FATFS_LOGGER_SEC_MASK))
+    {
+        return FATFS_LOGGER_INVALID_PARAM; 
+    }
+
+    memset((void *)logger, CLEAR, sizeof(fatfs_logger_t)); 
+    logger->ring = ring; 
+    logger->size = ring_size; 
+    logger->block_size = block_size; 
+    strcpy(logger->prefix, prefix); 
+    logger->index = index; 
+    logger->file_size = file_size; 
+    logger->time = time; 
+
+    // A record is complete once its sync byte is set so the ring starts cleared 
+    memset((void *)ring, CLEAR, ring_size); 
+
+    return FATFS_LOGGER_OK; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Producers 
+
+// Log a record 
+FATFS_LOGGER_STATUS fatfs_logger_log(
+    fatfs_logger_t *logger, 
+    uint8_t id, 
+    const void *data, 
+    uint16_t len)
+{
+    uint32_t pos; 
+
+    if ((logger == NULL) || ((data == NULL) && len) || (id == FATFS_LOGGER_ID_PAD))
+    {
+        return FATFS_LOGGER_INVALID_PARAM; 
+    }
+
+    if (!fatfs_logger_reserve(logger, FATFS_LOGGER_HDR_SIZE + len, FALSE, &pos))
+    {
+        __atomic_fetch_add(&logger->stats.dropped, BYTE_1, __ATOMIC_RELAXED); 
+        return FATFS_LOGGER_FULL; 
+    }
+
+    fatfs_logger_copy(logger, pos + FATFS_LOGGER_HDR_SIZE, data, len); 
+    fatfs_logger_commit(logger, pos, id, len); 
+    __atomic_fetch_add(&logger->stats.records, BYTE_1, __ATOMIC_RELAXED); 
+
+    return FATFS_LOGGER_OK; 
+}
+
+
+// Reserve space in the ring 
+uint32_t fatfs_logger_reserve(
+    fatfs_logger_t *logger, 
+    uint32_t size, 
+    uint8_t pad, 
+    uint32_t *pos)
+{
+    uint32_t head = __atomic_load_n(&logger->reserve, __ATOMIC_RELAXED); 
+    uint32_t fill; 
+
+    // Retried only if another producer reserved space in between so this never waits 
+    do 
+    {
+        if (pad)
+        {
+            // Padding record to the end of the sector (or the next one if the header 
+            // doesn't fit)
+            size = FATFS_LOGGER_SEC_SIZE - (head & FATFS_LOGGER_SEC_MASK); 
+
+            if (size < FATFS_LOGGER_HDR_SIZE)
+            {
+                size += FATFS_LOGGER_SEC_SIZE; 
+            }
+        }
+
+        fill = head + size - __atomic_load_n(&logger->tail, __ATOMIC_ACQUIRE); 
+
+        if (fill > logger->size)
+        {
+            return CLEAR; 
+        }
+    }
+    while (!__atomic_compare_exchange_n(&logger->reserve, &head, head + size, FALSE, 
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)); 
+
+    // Statistics only - a race here can only miss a new max by one record 
+    if (fill > logger->stats.max_fill)
+    {
+        logger->stats.max_fill = fill; 
+    }
+
+    *pos = head; 
+
+    return size; 
+}
+
+
+// Copy data into the ring 
+void fatfs_logger_copy(
+    fatfs_logger_t *logger, 
+    uint32_t pos, 
+    const void *data, 
+    uint32_t len)
+{
+    uint32_t index = pos & (logger->size - 1); 
+    uint32_t first = logger->size - index; 
+
+    if (len <= first)
+    {
+        memcpy((void *)&logger->ring[index], data, len); 
+    }
+    else 
+    {
+        memcpy((void *)&logger->ring[index], data, first); 
+        memcpy((void *)logger->ring, (const uint8_t *)data + first, len - first); 
+    }
+}
+
+
+// Complete a record 
+void fatfs_logger_commit(
+    fatfs_logger_t *logger, 
+    uint32_t pos, 
+    uint8_t id, 
+    uint16_t len)
+{
+    uint32_t mask = logger->size - 1; 
+
+    logger->ring[(pos + BYTE_1) & mask] = id; 
+    logger->ring[(pos + BYTE_2) & mask] = (uint8_t)len; 
+    logger->ring[(pos + BYTE_3) & mask] = (uint8_t)(len >> SHIFT_8); 
+    __atomic_store_n(&logger->ring[pos & mask], FATFS_LOGGER_SYNC, __ATOMIC_RELEASE); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Logger task 
+
+// Logger task 
+FATFS_LOGGER_STATUS fatfs_logger_task(fatfs_logger_t *logger)
+{
+    uint32_t pending; 
+
+    if (logger == NULL)
+    {
+        return FATFS_LOGGER_INVALID_PARAM; 
+    }
+
+    pending = fatfs_logger_scan(logger); 
+
+    if (pending < logger->block_size)
+    {
+        return FATFS_LOGGER_OK; 
+    }
+
+    // Whole blocks only. Anything left waits for the next block or a flush. 
+    return fatfs_logger_write(logger, pending - (pending % logger->block_size)); 
+}
+
+
+// Write everything logged so far to the card 
+FATFS_LOGGER_STATUS fatfs_logger_flush(fatfs_logger_t *logger)
+{
+    FATFS_LOGGER_STATUS status = FATFS_LOGGER_OK; 
+    uint32_t pending; 
+    uint32_t pos; 
+    uint32_t pad; 
+    uint32_t start; 
+    FRESULT result; 
+
+    if (logger == NULL)
+    {
+        return FATFS_LOGGER_INVALID_PARAM; 
+    }
+
+    // Padding goes through the ring like a record so the ring and the files stay 
+    // sector aligned with each other. If there's no room for it then only the full 
+    // sectors are written. 
+    if (__atomic_load_n(&logger->reserve, __ATOMIC_ACQUIRE) & FATFS_LOGGER_SEC_MASK)
+    {
+        pad = fatfs_logger_reserve(logger, CLEAR, TRUE, &pos); 
+
+        if (pad)
+        {
+            fatfs_logger_commit(logger, pos, FATFS_LOGGER_ID_PAD, 
+                                (uint16_t)(pad - FATFS_LOGGER_HDR_SIZE)); 
+        }
+        else 
+        {
+            status = FATFS_LOGGER_FULL; 
+        }
+    }
+
+    pending = fatfs_logger_scan(logger) & ~FATFS_LOGGER_SEC_MASK; 
+
+    if (pending)
+    {
+        FATFS_LOGGER_STATUS write_status = fatfs_logger_write(logger, pending); 
+
+        if (write_status != FATFS_LOGGER_OK)
+        {
+            return write_status; 
+        }
+    }
+
+    if (logger->open)
+    {
+        start = fatfs_logger_now(logger); 
+        result = f_sync(&logger->file); 
+        fatfs_logger_latency(logger, start); 
+
+        if (result != FR_OK)
+        {
+            return fatfs_logger_error(logger, result); 
+        }
+    }
+
+    return status; 
+}
+
+
+// Close the current file 
+FATFS_LOGGER_STATUS fatfs_logger_close(fatfs_logger_t *logger)
+{
+    FATFS_LOGGER_STATUS status; 
+    FRESULT result = FR_OK; 
+    uint32_t start; 
+
+    status = fatfs_logger_flush(logger); 
+
+    if ((status == FATFS_LOGGER_INVALID_PARAM) || !logger->open)
+    {
+        return status; 
+    }
+
+    start = fatfs_logger_now(logger); 
+
+    // The file pointer is at the end of the data 
+    if (logger->file_pos < logger->file_size)
+    {
+        result = f_truncate(&logger->file); 
+    }
+
+    if (result == FR_OK)
+    {
+        result = f_close(&logger->file); 
+    }
+
+    fatfs_logger_latency(logger, start); 
+    logger->open = FALSE; 
+
+    if (result != FR_OK)
+    {
+        return fatfs_logger_error(logger, result); 
+    }
+
+    return status; 
+}
+
+
+// Get the logger statistics 
+void fatfs_logger_stats(
+    const fatfs_logger_t *logger, 
+    fatfs_logger_stats_t *stats)
+{
+    if ((logger == NULL) || (stats == NULL))
+    {
+        return; 
+    }
+
+    *stats = logger->stats; 
+}
+
+
+// Find the end of the complete records 
+uint32_t fatfs_logger_scan(fatfs_logger_t *logger)
+{
+    uint32_t reserve = __atomic_load_n(&logger->reserve, __ATOMIC_ACQUIRE); 
+    uint32_t mask = logger->size - 1; 
+    uint8_t *ring = logger->ring; 
+
+    // Stops at a record that a producer is still copying 
+    while ((logger->commit != reserve) && 
+           (__atomic_load_n(&ring[logger->commit & mask], __ATOMIC_ACQUIRE) == 
+            FATFS_LOGGER_SYNC))
+    {
+        logger->commit += FATFS_LOGGER_HDR_SIZE + 
+                          (ring[(logger->commit + BYTE_2) & mask] | 
+                           (ring[(logger->commit + BYTE_3) & mask] << SHIFT_8)); 
+    }
+
+    return logger->commit - logger->tail; 
+}
+
+
+// Write bytes from the ring to the files 
+FATFS_LOGGER_STATUS fatfs_logger_write(
+    fatfs_logger_t *logger, 
+    uint32_t len)
+{
+    FATFS_LOGGER_STATUS status; 
+    FRESULT result; 
+    uint32_t index, chunk, start; 
+    UINT written; 
+
+    while (len)
+    {
+        if (!logger->open)
+        {
+            status = fatfs_logger_open(logger); 
+
+            if (status != FATFS_LOGGER_OK)
+            {
+                return status; 
+            }
+        }
+
+        // Up to the end of the ring or the file, whichever comes first. Both are 
+        // sector multiples so every write is too. 
+        index = logger->tail & (logger->size - 1); 
+        chunk = len; 
+
+        if (chunk > (logger->size - index))
+        {
+            chunk = logger->size - index; 
+        }
+
+        if (chunk > (logger->file_size - logger->file_pos))
+        {
+            chunk = logger->file_size - logger->file_pos; 
+        }
+
+        start = fatfs_logger_now(logger); 
+        result = f_write(&logger->file, &logger->ring[index], chunk, &written); 
+        fatfs_logger_latency(logger, start); 
+        logger->stats.writes++; 
+
+        // Written space is cleared before producers can have it back 
+        memset((void *)&logger->ring[index], CLEAR, written); 
+        __atomic_store_n(&logger->tail, logger->tail + written, __ATOMIC_RELEASE); 
+        logger->file_pos += written; 
+        logger->stats.bytes_written += written; 
+        len -= written; 
+
+        if (result != FR_OK)
+        {
+            return fatfs_logger_error(logger, result); 
+        }
+
+        // Volume full 
+        if (written < chunk)
+        {
+            return fatfs_logger_error(logger, FR_DENIED); 
+        }
+
+        // Full files are closed and the next write opens the next one 
+        if (logger->file_pos == logger->file_size)
+        {
+            start = fatfs_logger_now(logger); 
+            result = f_close(&logger->file); 
+            fatfs_logger_latency(logger, start); 
+            logger->open = FALSE; 
+
+            if (result != FR_OK)
+            {
+                return fatfs_logger_error(logger, result); 
+            }
+        }
+    }
+
+    return FATFS_LOGGER_OK; 
+}
+
+
+// Open the next file and preallocate it 
+FATFS_LOGGER_STATUS fatfs_logger_open(fatfs_logger_t *logger)
+{
+    char name[FATFS_LOGGER_NAME_LEN]; 
+    FRESULT result; 
+    uint32_t start; 
+
+    snprintf(name, FATFS_LOGGER_NAME_LEN, "%s%05u.BIN", 
+             logger->prefix, (unsigned int)logger->index++); 
+
+    start = fatfs_logger_now(logger); 
+    result = f_open(&logger->file, name, FA_CREATE_ALWAYS | FA_WRITE); 
+
+    if (result != FR_OK)
+    {
+        fatfs_logger_latency(logger, start); 
+        logger->stats.errors++; 
+        logger->stats.last_error = result; 
+        return FATFS_LOGGER_FILE_ERROR; 
+    }
+
+    // The whole file is allocated now as one block of clusters. If there isn't a block 
+    // that big the file grows as it's written like any other. 
+    result = f_expand(&logger->file, (FSIZE_t)logger->file_size, BYTE_1); 
+    fatfs_logger_latency(logger, start); 
+
+    if (result == FR_DENIED)
+    {
+        logger->stats.not_contiguous++; 
+    }
+    else if (result != FR_OK)
+    {
+        f_close(&logger->file); 
+        logger->stats.errors++; 
+        logger->stats.last_error = result; 
+        return FATFS_LOGGER_FILE_ERROR; 
+    }
+
+    logger->open = TRUE; 
+    logger->file_pos = CLEAR; 
+    logger->stats.files++; 
+
+    return FATFS_LOGGER_OK; 
+}
+
+
+// Record a FatFs error 
+FATFS_LOGGER_STATUS fatfs_logger_error(
+    fatfs_logger_t *logger, 
+    FRESULT result)
+{
+    logger->stats.errors++; 
+    logger->stats.last_error = result; 
+
+    if (logger->open)
+    {
+        f_close(&logger->file); 
+        logger->open = FALSE; 
+    }
+
+    return FATFS_LOGGER_FILE_ERROR; 
+}
+
+
+// Get the time source count 
+uint32_t fatfs_logger_now(const fatfs_logger_t *logger)
+{
+    return (logger->time != NULL) ? logger->time() : CLEAR; 
+}
+
+
+// Update the max card operation latency 
+void fatfs_logger_latency(
+    fatfs_logger_t *logger, 
+    uint32_t start)
+{
+    uint32_t latency = fatfs_logger_now(logger) - start; 
+
+    if (latency > logger->stats.max_latency)
+    {
+        logger->stats.max_latency = latency; 
+    }
+}
+
+//=======================================================================================
@@ -57,6 +57,19 @@ void hd44780u_send_instruc(uint8_t hd44780u_cmd);
  */
 void hd44780u_send_data(uint8_t hd44780u_data); 
 
+/**
+ * @brief HD44780U send the high nibble of an instruction 
+ * 
+ * @details Used for the function set instructions at the start of initialization. The 
+ *          screen is still in 8-bit mode (or in an unknown mode) at that point so each 
+ *          enable pulse is one instruction. Sending the low nibble as well would be read 
+ *          as another instruction and leave the screen a nibble out of step once it's 
+ *          in 4-bit mode. 
+ * 
+ * @param hd44780u_cmd : instruction whose high nibble is sent 
+ */
+void hd44780u_send_nibble(uint8_t hd44780u_cmd); 
+
 
 /**
  * @brief Send data to screen 
@@ -66,10 +79,12 @@ void hd44780u_send_data(uint8_t hd44780u_data);
  * 
  * @param i2c : pointer to I2C port used 
  * @param data : pointer to data to send 
+ * @param data_size : number of bytes to send 
  */
 void hd44780u_send(
     I2C_TypeDef *i2c, 
-    uint8_t *data); 
+    uint8_t *data, 
+    uint8_t data_size); 
 
 //=======================================================================================
 
@@ -156,20 +171,20 @@ void hd44780u_init(
     // mode specified and the fourth time specifying 4-bit mode 
 
     // Send 1: Function set - Wait for more than 4.1 ms afterwards 
-    hd44780u_send_instruc(HD44780U_FUNCTION_SET | HD44780U_8BIT_MODE); 
+    hd44780u_send_nibble(HD44780U_FUNCTION_SET | HD44780U_8BIT_MODE); 
     tim_delay_ms(hd44780u_data_record.tim, DELAY_100MS); 
 
     // Send 2: Function set - Wait for more than 100 us afterwards 
-    hd44780u_send_instruc(HD44780U_FUNCTION_SET | HD44780U_8BIT_MODE); 
+    hd44780u_send_nibble(HD44780U_FUNCTION_SET | HD44780U_8BIT_MODE); 
     tim_delay_ms(hd44780u_data_record.tim, DELAY_100MS); 
 
     // Send 3: Function set - No specified wait time 
-    hd44780u_send_instruc(HD44780U_FUNCTION_SET | HD44780U_8BIT_MODE); 
+    hd44780u_send_nibble(HD44780U_FUNCTION_SET | HD44780U_8BIT_MODE); 
     tim_delay_ms(hd44780u_data_record.tim, DELAY_100MS); 
 
     // Send 4: Function set - Choose 4-bit mode 
     // DL = 0 -> 4-bit data length 
-    hd44780u_send_instruc(HD44780U_FUNCTION_SET); 
+    hd44780u_send_nibble(HD44780U_FUNCTION_SET); 
     tim_delay_ms(hd44780u_data_record.tim, DELAY_100MS); 
 
 
@@ -250,7 +265,7 @@ void hd44780u_send_instruc(uint8_t hd44780u_cmd)
     lcd_instruction[3] = ((hd44780u_cmd << SHIFT_4) & HD44780U_4BIT_MASK) | mask; 
 
     // Send the command to the screen 
-    hd44780u_send(hd44780u_data_record.i2c, lcd_instruction); 
+    hd44780u_send(hd44780u_data_record.i2c, lcd_instruction, HD44780U_MSG_PER_CMD); 
 }
 
 
@@ -267,14 +282,29 @@ void hd44780u_send_data(uint8_t hd44780u_data)
     lcd_display_data[3] = ((hd44780u_data << SHIFT_4) & HD44780U_4BIT_MASK) | mask; 
 
     // Send the data to the screen 
-    hd44780u_send(hd44780u_data_record.i2c, lcd_display_data); 
+    hd44780u_send(hd44780u_data_record.i2c, lcd_display_data, HD44780U_MSG_PER_CMD); 
+}
+
+
+// Send the high nibble of an instruction 
+void hd44780u_send_nibble(uint8_t hd44780u_cmd)
+{
+    uint8_t lcd_instruction[BYTE_2]; 
+    uint8_t mask = hd44780u_data_record.backlight; 
+
+    // One enable pulse 
+    lcd_instruction[0] = (hd44780u_cmd & HD44780U_4BIT_MASK) | mask | HD44780U_EN; 
+    lcd_instruction[1] = (hd44780u_cmd & HD44780U_4BIT_MASK) | mask; 
+
+    hd44780u_send(hd44780u_data_record.i2c, lcd_instruction, BYTE_2); 
 }
 
 
 // Send information to screen 
 void hd44780u_send(
     I2C_TypeDef *i2c, 
-    uint8_t *data)
+    uint8_t *data, 
+    uint8_t data_size)
 {
     I2C_STATUS i2c_status = I2C_OK; 
 
@@ -286,7 +316,7 @@ void hd44780u_send(
     i2c_clear_addr(i2c);
 
     // Send data over I2C
-    i2c_status |= i2c_write(i2c, data, HD44780U_MSG_PER_CMD); 
+    i2c_status |= i2c_write(i2c, data, data_size); 
 
     // Create a stop condition
     i2c_stop(i2c); 
@@ -33,26 +33,60 @@
 
 // NMEA message format 
 #define NMEA_START 0x24           // '$' --> NMEA protocol start character 
-#define NMEA_PUBX_NUM_MSGS 5      // Number of NMEA PUBX messages 
-#define NMEA_STD_ID_NUM 5         // Number of standard NMEA message IDs 
-#define NMEA_STD_ID_LEN 3         // Maximum length of a standard NMEA message ID 
-#define NMEA_STD_NUM_MSGS 19      // Number of standard NMEA formatters 
-#define NMEA_MSG_FORMAT_LEN 4     // Maximum length of an NMEA message formatter 
 #define M8Q_NMEA_END_MSG 6        // Length of string to append to NMEA message after payload 
+#define NMEA_ID_MAX_LEN 9         // Max length of an NMEA address field ("$PUBX,00,") 
 
 // UBX message format 
-#define UBX_CLASS_NUM 14          // Number of UBX classes 
-#define UBX_CLASS_LEN 3           // Maximum length of a UBX class 
-#define UBX_CFG_INDEX 4           // Location of CFG message info in ubx_msg_class 
+#define UBX_SYNC_CHAR_1 0xB5      // UBX protocol first sync character 
+#define UBX_SYNC_CHAR_2 0x62      // UBX protocol second sync character 
+#define UBX_HEADER_LEN 6          // Sync characters, class, ID and payload length 
+#define UBX_CHECKSUM_LEN 2        // CK_A and CK_B 
+#define UBX_MAX_PAYLOAD_LEN 1024  // Largest expected UBX payload (NAV-SAT with 84 SVs is 1016) 
+
+// Message ID keys. Message IDs are packed into an integer (first character in the most 
+// significant byte) so they can be identified with a switch instead of string compares. 
+#define MSG_KEY2(c0, c1) (((uint32_t)(c0) << SHIFT_8) | (uint32_t)(c1)) 
+#define MSG_KEY3(c0, c1, c2) ((MSG_KEY2(c0, c1) << SHIFT_8) | (uint32_t)(c2)) 
+#define MSG_KEY4(c0, c1, c2, c3) ((MSG_KEY3(c0, c1, c2) << SHIFT_8) | (uint32_t)(c3)) 
+#define NMEA_PUBX_KEY MSG_KEY4('P', 'U', 'B', 'X')   // U-Blox defined NMEA message ID 
+#define UBX_SYNC_KEY MSG_KEY4('B', '5', '6', '2')    // UBX config message string start 
 
 // UBX ACK class message 
 #define ACK_ACK 0x0501            // ACK-ACK message class and ID 
 #define ACK_NAK 0x0500            // ACK-NAK message class and ID 
 #define ACK_TIMEOUT 10            // ACK message check counter before timeout 
 
+// UBX NAV class messages 
+#define NAV_PVT 0x0107            // NAV-PVT message class and ID 
+#define NAV_STATUS 0x0103         // NAV-STATUS message class and ID 
+#define NAV_DOP 0x0104            // NAV-DOP message class and ID 
+#define NAV_PVT_LEN 92            // NAV-PVT payload length 
+#define NAV_STATUS_LEN 16         // NAV-STATUS payload length 
+#define NAV_DOP_LEN 18            // NAV-DOP payload length 
+#define NAV_NUM_CFG_MSGS 3        // Number of NAV messages enabled by m8q_nav_config 
+#define NAV_CFG_MSG_LEN 32        // Max length of NAV config message strings 
+#define NAV_FIX_OK 0x01           // NAV-PVT flags - valid fix (gnssFixOK) 
+
+// RTCM3 message format 
+#define RTCM_PREAMBLE 0xD3        // RTCM3 frame start byte 
+#define RTCM_RESERVED 0xFC        // Reserved bits of the second header byte (always 0) 
+#define RTCM_LEN_HI 0x03          // Message length high bits of the second header byte 
+#define RTCM_CRC_MASK 0xFFFFFF    // CRC-24Q size 
+#define RTCM_CRC_SHIFT 16         // CRC-24Q table index position 
+#define RTCM_MIN_WRITE 2          // Fewest bytes per write (1 byte sets the register address) 
+#define RTCM_MIN_CHUNK 3          // Smallest max write size that never leaves a 1 byte write 
+
 // Other 
 #define EOM_BYTE 1                // End of memory byte - helps find size of message fields 
-#define MIN_TO_DEG 60.0f          // Coordinate minutes to degrees conversion 
+#define MIN_TO_DEG 60             // Coordinate minutes to degrees conversion 
+#define DEG_SCALE 10000000        // Scaled integer coordinate degrees (deg*10^7) 
+#define COORD_MIN_LEN 8           // Length of coordinate minutes ("MM.MMMMM") 
+#define COORD_MIN_SCALE 10000000  // Scaled integer coordinate minutes (MM.MMMMM*10^5) 
+#define NUM_SNAPSHOT_BUFFS 2      // Number of snapshot buffers (published and back) 
+
+// Compiler memory barrier. The parser and snapshot readers run on the same core so the 
+// compiler only has to be kept from reordering snapshot buffer accesses. 
+#define M8Q_MEMORY_BARRIER() __asm volatile ("" ::: "memory") 
 
 //=======================================================================================
 
@@ -69,6 +103,112 @@ typedef enum {
 } m8q_msg_type_t; 
 
 
+// Data stream parser state 
+typedef enum {
+    M8Q_PARSE_START,          // Looking for the start of a message 
+    M8Q_PARSE_NMEA_ID,        // Reading the NMEA address field 
+    M8Q_PARSE_NMEA_FIELDS,    // Storing NMEA payload fields 
+    M8Q_PARSE_NMEA_SKIP,      // Skipping NMEA payload fields that aren't stored 
+    M8Q_PARSE_NMEA_CHECKSUM,  // Reading the NMEA checksum characters 
+    M8Q_PARSE_NMEA_END,       // Skipping to the end of the NMEA message 
+    M8Q_PARSE_UBX_SYNC,       // Checking the second UBX sync character 
+    M8Q_PARSE_UBX_HEADER,     // Reading the UBX class, ID and length 
+    M8Q_PARSE_UBX_PAYLOAD     // Storing or skipping the UBX payload and checksum 
+} m8q_parse_state_t; 
+
+
+// NMEA PUBX messages 
+typedef enum {
+    NMEA_PUBX_POSITION, 
+    NMEA_PUBX_SVSTATUS, 
+    NMEA_PUBX_TIME, 
+    NMEA_PUBX_RATE, 
+    NMEA_PUBX_CONFIG, 
+    NMEA_PUBX_NUM_MSGS 
+} nmea_pubx_msg_t; 
+
+
+// NMEA standard messages 
+typedef enum {
+    NMEA_STD_DTM, 
+    NMEA_STD_GBQ, 
+    NMEA_STD_GBS, 
+    NMEA_STD_GGA, 
+    NMEA_STD_GLL, 
+    NMEA_STD_GLQ, 
+    NMEA_STD_GNQ, 
+    NMEA_STD_GNS, 
+    NMEA_STD_GPQ, 
+    NMEA_STD_GRS, 
+    NMEA_STD_GSA, 
+    NMEA_STD_GST, 
+    NMEA_STD_GSV, 
+    NMEA_STD_RMC, 
+    NMEA_STD_THS, 
+    NMEA_STD_TXT, 
+    NMEA_STD_VLW, 
+    NMEA_STD_VTG, 
+    NMEA_STD_ZDA, 
+    NMEA_STD_NUM_MSGS 
+} nmea_std_msg_t; 
+
+
+// UBX message classes 
+typedef enum {
+    UBX_CLASS_NAV = 0x01, 
+    UBX_CLASS_RXM = 0x02, 
+    UBX_CLASS_INF = 0x04, 
+    UBX_CLASS_ACK = 0x05, 
+    UBX_CLASS_CFG = 0x06, 
+    UBX_CLASS_UPD = 0x09, 
+    UBX_CLASS_MON = 0x0A, 
+    UBX_CLASS_AID = 0x0B, 
+    UBX_CLASS_TIM = 0x0D, 
+    UBX_CLASS_ESF = 0x10, 
+    UBX_CLASS_MGA = 0x13, 
+    UBX_CLASS_LOG = 0x21, 
+    UBX_CLASS_SEC = 0x27, 
+    UBX_CLASS_HNR = 0x28 
+} ubx_msg_class_t; 
+
+
+// NAV-PVT payload field offsets 
+typedef enum {
+    NAV_PVT_ITOW = 0, 
+    NAV_PVT_FIX_TYPE = 20, 
+    NAV_PVT_FLAGS = 21, 
+    NAV_PVT_NUM_SV = 23, 
+    NAV_PVT_LON = 24, 
+    NAV_PVT_LAT = 28, 
+    NAV_PVT_HEIGHT = 32, 
+    NAV_PVT_HMSL = 36, 
+    NAV_PVT_HACC = 40, 
+    NAV_PVT_VACC = 44, 
+    NAV_PVT_VEL_N = 48, 
+    NAV_PVT_VEL_E = 52, 
+    NAV_PVT_VEL_D = 56, 
+    NAV_PVT_GSPEED = 60, 
+    NAV_PVT_HEAD_MOT = 64, 
+    NAV_PVT_SACC = 68, 
+    NAV_PVT_PDOP = 76 
+} nav_pvt_offset_t; 
+
+
+// NAV-STATUS payload field offsets 
+typedef enum {
+    NAV_STATUS_TTFF = 8, 
+    NAV_STATUS_MSSS = 12 
+} nav_status_offset_t; 
+
+
+// NAV-DOP payload field offsets 
+typedef enum {
+    NAV_DOP_PDOP = 6, 
+    NAV_DOP_VDOP = 10, 
+    NAV_DOP_HDOP = 12 
+} nav_dop_offset_t; 
+
+
 // Number of fields in an NMEA message 
 typedef enum {
     NMEA_NUM_FIELDS_POSITION = 19, 
@@ -97,6 +237,32 @@ typedef enum {
     NMEA_NUM_FIELDS_ZDA = 6 
 } nmea_num_fields_t; 
 
+
+// POSITION message field index 
+typedef enum {
+    POS_FIELD_TIME, 
+    POS_FIELD_LAT, 
+    POS_FIELD_NS, 
+    POS_FIELD_LON, 
+    POS_FIELD_EW, 
+    POS_FIELD_ALTREF, 
+    POS_FIELD_NAVSTAT, 
+    POS_FIELD_HACC, 
+    POS_FIELD_VACC, 
+    POS_FIELD_SOG, 
+    POS_FIELD_COG, 
+    POS_FIELD_VVEL 
+} nmea_pos_field_t; 
+
+
+// TIME message field index 
+typedef enum {
+    TIME_FIELD_TIME, 
+    TIME_FIELD_DATE, 
+    TIME_FIELD_UTCTOW, 
+    TIME_FIELD_UTCWK 
+} nmea_time_field_t; 
+
 //=======================================================================================
 
 
@@ -145,12 +311,72 @@ typedef struct m8q_nmea_time_s
 } 
 m8q_nmea_time_t;
 
+
+// Staged NMEA message fields. A stored NMEA message is read into here and is only copied 
+// to the data record once the message checksum has been verified. 
+typedef union m8q_nmea_stage_u 
+{
+    m8q_nmea_pos_t pos; 
+    m8q_nmea_time_t time; 
+}
+m8q_nmea_stage_t; 
+
+
+// Staged NMEA message values 
+typedef union m8q_value_stage_u 
+{
+    m8q_pos_value_t pos; 
+    m8q_time_value_t time; 
+}
+m8q_value_stage_t; 
+
+
+// Snapshot buffer. The write count is odd while the buffer is being written so a reader 
+// can tell if its copy may be torn. 
+typedef struct m8q_snapshot_buff_s 
+{
+    volatile uint32_t write_count; 
+    m8q_snapshot_t data; 
+}
+m8q_snapshot_buff_t; 
+
 //=======================================================================================
 
 
 //=======================================================================================
 // Data record 
 
+// Data stream parser record. Holds the position within the current message so a message 
+// can be split across any number of reads. 
+typedef struct m8q_stream_parse_s 
+{
+    m8q_parse_state_t state;                        // Parser state 
+    uint8_t id_buff[NMEA_ID_MAX_LEN + EOM_BYTE];    // Message address/header bytes 
+    uint8_t id_index;                               // id_buff index 
+    uint8_t num_param;                              // Number of NMEA fields to store 
+    uint8_t **msg_data;                             // NMEA message data record 
+    uint8_t data_index;                             // NMEA field index 
+    uint8_t param_index;                            // NMEA field byte index 
+    uint8_t param_len;                              // NMEA field storage size 
+    uint8_t *field_buff;                            // NMEA field storage in nmea_stage 
+    uint8_t stage_len;                              // Bytes of nmea_stage to copy 
+    uint32_t field_valid;                           // NMEA fields seen in the message 
+    m8q_nmea_stage_t nmea_stage;                    // Staged NMEA message fields 
+    m8q_value_stage_t value_stage;                  // Staged NMEA message values 
+    uint16_t ubx_count;                             // Remaining UBX payload bytes 
+    uint16_t ubx_msg;                               // UBX message class and ID 
+    uint8_t ubx_store;                              // UBX payload stored flag 
+    uint8_t ubx_index;                              // ubx_payload index 
+    uint8_t ubx_payload[NAV_PVT_LEN];               // Stored UBX message payload 
+    uint8_t ck_a;                                   // NMEA XOR checksum or UBX CK_A 
+    uint8_t ck_b;                                   // UBX CK_B 
+    uint8_t ck_rx;                                  // Received checksum (or CK_A match) 
+    uint8_t ck_index;                               // Received checksum character index 
+    m8q_msg_stats_type_t stats_type;                // Health counter of the message 
+}
+m8q_stream_parse_t; 
+
+
 // Driver data record 
 typedef struct m8q_driver_data_s
 {
@@ -166,8 +392,24 @@ typedef struct m8q_driver_data_s
     // Messages 
     m8q_nmea_pos_t pos_data;       // POSITION message 
     m8q_nmea_time_t time_data;     // TIME message 
+    m8q_pos_value_t pos_value;     // POSITION message values 
+    m8q_time_value_t time_value;   // TIME message values 
+    m8q_ubx_nav_t nav_data;        // NAV-PVT, NAV-STATUS and NAV-DOP messages 
     uint8_t ack_msg_count;         // ACK-ACK message counter 
     uint8_t nak_msg_count;         // ACK-NAK message counter 
+    m8q_msg_stats_t msg_stats[M8Q_STATS_NUM];   // Data stream health counters 
+
+    // Snapshots 
+    m8q_snapshot_buff_t snapshot[NUM_SNAPSHOT_BUFFS];   // Published and back buffers 
+    volatile uint8_t snapshot_index;                   // Published buffer index 
+    m8q_fix_callback_t fix_callback;                   // Called when a fix is published 
+
+    // TX ready 
+    volatile uint8_t txr_pending;   // TX ready interrupt seen and data not yet read 
+
+    // Data stream 
+    m8q_stream_parse_t parse;                     // Stream parser record 
+    uint8_t stream_buff[M8Q_STREAM_BUFF_SIZE];    // Stream read buffer 
 
     // Other 
     uint16_t data_buff_limit; 
@@ -241,104 +483,102 @@ nmea_msg_data_t;
 
 static nmea_msg_data_t nmea_msg_target; 
 
-
-// NMEA message format 
-typedef struct nmea_msg_format_s 
-{
-    char nmea_msg_format[NMEA_MSG_FORMAT_LEN]; 
-    nmea_msg_data_t nmea_msg_data; 
-}
-nmea_msg_format_t; 
-
-
-// UBX message class data 
-typedef struct ubx_msg_class_s 
-{
-    char ubx_msg_class_str[UBX_CLASS_LEN]; 
-    uint8_t ubc_msg_class_data[2]; 
-}
-ubx_msg_class_t; 
-
 //==================================================
 
 //==================================================
-// NMEA message address 
-
-// Start character of all NMEA messages 
-static const char nmea_msg_start = NMEA_START; 
-
-// U-Blox defined NMEA message ID 
-static const char nmea_pubx_msg_id[] = "PUBX"; 
+// NMEA message address. These tables hold the data record of each message and are 
+// indexed by the message ID lookups (see m8q_nmea_pubx_lookup and m8q_nmea_std_lookup). 
 
 // NMEA PUBX messages 
-static const nmea_msg_format_t nmea_pubx_msgs[NMEA_PUBX_NUM_MSGS] =   
+static const nmea_msg_data_t nmea_pubx_msgs[NMEA_PUBX_NUM_MSGS] =   
 {
-    {"00", {NMEA_NUM_FIELDS_POSITION, position}},   // POSITION 
-    {"03", {NMEA_NUM_FIELDS_SVSTATUS, NULL}},       // SVSTATUS 
-    {"04", {NMEA_NUM_FIELDS_TIME, time}},           // TIME 
-    {"40", {NMEA_NUM_FIELDS_RATE, NULL}},           // RATE 
-    {"41", {NMEA_NUM_FIELDS_CONFIG, NULL}}          // CONFIG 
+    {NMEA_NUM_FIELDS_POSITION, position},   // 00 - POSITION 
+    {NMEA_NUM_FIELDS_SVSTATUS, NULL},       // 03 - SVSTATUS 
+    {NMEA_NUM_FIELDS_TIME, time},           // 04 - TIME 
+    {NMEA_NUM_FIELDS_RATE, NULL},           // 40 - RATE 
+    {NMEA_NUM_FIELDS_CONFIG, NULL}          // 41 - CONFIG 
 }; 
 
-// NMEA talker IDs 
-static const char nmea_std_msg_id[NMEA_STD_ID_NUM][NMEA_STD_ID_LEN] = 
-{
-    "GP",   // GPS, SBAS, QZSS 
-    "GL",   // GLONASS 
-    "GA",   // Galileo 
-    "GB",   // BeiDou 
-    "GN"    // Any combination of GNSS 
+// NMEA standard messages 
+static const nmea_msg_data_t nmea_std_msgs[NMEA_STD_NUM_MSGS] =   
+{
+    {NMEA_NUM_FIELDS_DTM, NULL},   // Datum reference 
+    {NMEA_NUM_FIELDS_GBQ, NULL},   // Poll a standard message (Talker ID GB) 
+    {NMEA_NUM_FIELDS_GBS, NULL},   // GNSS satellite fault detection 
+    {NMEA_NUM_FIELDS_GGA, NULL},   // Global positioning system fix data 
+    {NMEA_NUM_FIELDS_GLL, NULL},   // Lat and long, with time of position fix and status 
+    {NMEA_NUM_FIELDS_GLQ, NULL},   // Poll a standard message (Talker ID GL) 
+    {NMEA_NUM_FIELDS_GNQ, NULL},   // Poll a standard message (Talker ID GN) 
+    {NMEA_NUM_FIELDS_GNS, NULL},   // GNSS fix data 
+    {NMEA_NUM_FIELDS_GPQ, NULL},   // Poll a standard message (Talker ID GP) 
+    {NMEA_NUM_FIELDS_GRS, NULL},   // GNSS range residuals 
+    {NMEA_NUM_FIELDS_GSA, NULL},   // GNSS DOP and active satellites 
+    {NMEA_NUM_FIELDS_GST, NULL},   // GNSS pseudorange error statistics 
+    {NMEA_NUM_FIELDS_GSV, NULL},   // GNSS satellites in view 
+    {NMEA_NUM_FIELDS_RMC, NULL},   // Recommended minimum data 
+    {NMEA_NUM_FIELDS_THS, NULL},   // True heading and status 
+    {NMEA_NUM_FIELDS_TXT, NULL},   // Text transmission 
+    {NMEA_NUM_FIELDS_VLW, NULL},   // Dual ground/water distance 
+    {NMEA_NUM_FIELDS_VTG, NULL},   // Course over ground and ground speed 
+    {NMEA_NUM_FIELDS_ZDA, NULL}    // Time and data 
 }; 
 
-// NMEA standard messages 
-static const nmea_msg_format_t nmea_std_msgs[NMEA_STD_NUM_MSGS] =   
-{
-    {"DTM", {NMEA_NUM_FIELDS_DTM, NULL}},   // Datum reference 
-    {"GBQ", {NMEA_NUM_FIELDS_GBQ, NULL}},   // Poll a standard message (Talker ID GB) 
-    {"GBS", {NMEA_NUM_FIELDS_GBS, NULL}},   // GNSS satellite fault detection 
-    {"GGA", {NMEA_NUM_FIELDS_GGA, NULL}},   // Global positioning system fix data 
-    {"GLL", {NMEA_NUM_FIELDS_GLL, NULL}},   // Lat and long, with time of position fix and status 
-    {"GLQ", {NMEA_NUM_FIELDS_GLQ, NULL}},   // Poll a standard message (Talker ID GL) 
-    {"GNQ", {NMEA_NUM_FIELDS_GNQ, NULL}},   // Poll a standard message (Talker ID GN) 
-    {"GNS", {NMEA_NUM_FIELDS_GNS, NULL}},   // GNSS fix data 
-    {"GPQ", {NMEA_NUM_FIELDS_GPQ, NULL}},   // Poll a standard message (Talker ID GP) 
-    {"GRS", {NMEA_NUM_FIELDS_GRS, NULL}},   // GNSS range residuals 
-    {"GSA", {NMEA_NUM_FIELDS_GSA, NULL}},   // GNSS DOP and active satellites 
-    {"GST", {NMEA_NUM_FIELDS_GST, NULL}},   // GNSS pseudorange error statistics 
-    {"GSV", {NMEA_NUM_FIELDS_GSV, NULL}},   // GNSS satellites in view 
-    {"RMC", {NMEA_NUM_FIELDS_RMC, NULL}},   // Recommended minimum data 
-    {"THS", {NMEA_NUM_FIELDS_THS, NULL}},   // True heading and status 
-    {"TXT", {NMEA_NUM_FIELDS_TXT, NULL}},   // Text transmission 
-    {"VLW", {NMEA_NUM_FIELDS_VLW, NULL}},   // Dual ground/water distance 
-    {"VTG", {NMEA_NUM_FIELDS_VTG, NULL}},   // Course over ground and ground speed 
-    {"ZDA", {NMEA_NUM_FIELDS_ZDA, NULL}}    // Time and data 
+//==================================================
+
+//==================================================
+// UBX NAV message configuration 
+
+// CFG-MSG messages that output NAV-PVT, NAV-STATUS and NAV-DOP once per solution 
+static const char ubx_nav_cfg_msgs[NAV_NUM_CFG_MSGS][NAV_CFG_MSG_LEN] = 
+{
+    "B562,06,01,0300,01,07,01*",   // NAV-PVT 
+    "B562,06,01,0300,01,03,01*",   // NAV-STATUS 
+    "B562,06,01,0300,01,04,01*"    // NAV-DOP 
 }; 
 
+// CFG-RATE message format - measurement rate, 1 measurement per solution, GPS time 
+static const char ubx_nav_rate_msg[] = "B562,06,08,0600,%02X%02X,0100,0100*"; 
+
 //==================================================
 
 //==================================================
-// UBX sync characters and class 
-
-static const char ubx_msg_sync_str[] = "B562"; 
-
-static const uint8_t ubx_msg_sync_data[] = { 0xB5, 0x62 , NULL_CHAR}; 
-
-static const ubx_msg_class_t ubx_msg_class[UBX_CLASS_NUM] = 
-{
-    {"01", {0x01, NULL_CHAR}},   // NAV 
-    {"02", {0x02, NULL_CHAR}},   // RXM 
-    {"04", {0x04, NULL_CHAR}},   // INF 
-    {"05", {0x05, NULL_CHAR}},   // ACK 
-    {"06", {0x06, NULL_CHAR}},   // CFG 
-    {"09", {0x09, NULL_CHAR}},   // UPD 
-    {"0A", {0x0A, NULL_CHAR}},   // MON 
-    {"0B", {0x0B, NULL_CHAR}},   // AID 
-    {"0D", {0x0D, NULL_CHAR}},   // TIM 
-    {"10", {0x10, NULL_CHAR}},   // ESF 
-    {"13", {0x13, NULL_CHAR}},   // MGA 
-    {"21", {0x21, NULL_CHAR}},   // LOG 
-    {"27", {0x27, NULL_CHAR}},   // SEC 
-    {"28", {0x28, NULL_CHAR}}    // HNR 
+// RTCM3 frame check 
+
+// CRC-24Q (polynomial 0x1864CFB) of each byte value 
+static const uint32_t rtcm_crc24q_table[] = 
+{
+    0x000000, 0x864CFB, 0x8AD50D, 0x0C99F6, 0x93E6E1, 0x15AA1A, 0x1933EC, 0x9F7F17, 
+    0xA18139, 0x27CDC2, 0x2B5434, 0xAD18CF, 0x3267D8, 0xB42B23, 0xB8B2D5, 0x3EFE2E, 
+    0xC54E89, 0x430272, 0x4F9B84, 0xC9D77F, 0x56A868, 0xD0E493, 0xDC7D65, 0x5A319E, 
+    0x64CFB0, 0xE2834B, 0xEE1ABD, 0x685646, 0xF72951, 0x7165AA, 0x7DFC5C, 0xFBB0A7, 
+    0x0CD1E9, 0x8A9D12, 0x8604E4, 0x00481F, 0x9F3708, 0x197BF3, 0x15E205, 0x93AEFE, 
+    0xAD50D0, 0x2B1C2B, 0x2785DD, 0xA1C926, 0x3EB631, 0xB8FACA, 0xB4633C, 0x322FC7, 
+    0xC99F60, 0x4FD39B, 0x434A6D, 0xC50696, 0x5A7981, 0xDC357A, 0xD0AC8C, 0x56E077, 
+    0x681E59, 0xEE52A2, 0xE2CB54, 0x6487AF, 0xFBF8B8, 0x7DB443, 0x712DB5, 0xF7614E, 
+    0x19A3D2, 0x9FEF29, 0x9376DF, 0x153A24, 0x8A4533, 0x0C09C8, 0x00903E, 0x86DCC5, 
+    0xB822EB, 0x3E6E10, 0x32F7E6, 0xB4BB1D, 0x2BC40A, 0xAD88F1, 0xA11107, 0x275DFC, 
+    0xDCED5B, 0x5AA1A0, 0x563856, 0xD074AD, 0x4F0BBA, 0xC94741, 0xC5DEB7, 0x43924C, 
+    0x7D6C62, 0xFB2099, 0xF7B96F, 0x71F594, 0xEE8A83, 0x68C678, 0x645F8E, 0xE21375, 
+    0x15723B, 0x933EC0, 0x9FA736, 0x19EBCD, 0x8694DA, 0x00D821, 0x0C41D7, 0x8A0D2C, 
+    0xB4F302, 0x32BFF9, 0x3E260F, 0xB86AF4, 0x2715E3, 0xA15918, 0xADC0EE, 0x2B8C15, 
+    0xD03CB2, 0x567049, 0x5AE9BF, 0xDCA544, 0x43DA53, 0xC596A8, 0xC90F5E, 0x4F43A5, 
+    0x71BD8B, 0xF7F170, 0xFB6886, 0x7D247D, 0xE25B6A, 0x641791, 0x688E67, 0xEEC29C, 
+    0x3347A4, 0xB50B5F, 0xB992A9, 0x3FDE52, 0xA0A145, 0x26EDBE, 0x2A7448, 0xAC38B3, 
+    0x92C69D, 0x148A66, 0x181390, 0x9E5F6B, 0x01207C, 0x876C87, 0x8BF571, 0x0DB98A, 
+    0xF6092D, 0x7045D6, 0x7CDC20, 0xFA90DB, 0x65EFCC, 0xE3A337, 0xEF3AC1, 0x69763A, 
+    0x578814, 0xD1C4EF, 0xDD5D19, 0x5B11E2, 0xC46EF5, 0x42220E, 0x4EBBF8, 0xC8F703, 
+    0x3F964D, 0xB9DAB6, 0xB54340, 0x330FBB, 0xAC70AC, 0x2A3C57, 0x26A5A1, 0xA0E95A, 
+    0x9E1774, 0x185B8F, 0x14C279, 0x928E82, 0x0DF195, 0x8BBD6E, 0x872498, 0x016863, 
+    0xFAD8C4, 0x7C943F, 0x700DC9, 0xF64132, 0x693E25, 0xEF72DE, 0xE3EB28, 0x65A7D3, 
+    0x5B59FD, 0xDD1506, 0xD18CF0, 0x57C00B, 0xC8BF1C, 0x4EF3E7, 0x426A11, 0xC426EA, 
+    0x2AE476, 0xACA88D, 0xA0317B, 0x267D80, 0xB90297, 0x3F4E6C, 0x33D79A, 0xB59B61, 
+    0x8B654F, 0x0D29B4, 0x01B042, 0x87FCB9, 0x1883AE, 0x9ECF55, 0x9256A3, 0x141A58, 
+    0xEFAAFF, 0x69E604, 0x657FF2, 0xE33309, 0x7C4C1E, 0xFA00E5, 0xF69913, 0x70D5E8, 
+    0x4E2BC6, 0xC8673D, 0xC4FECB, 0x42B230, 0xDDCD27, 0x5B81DC, 0x57182A, 0xD154D1, 
+    0x26359F, 0xA07964, 0xACE092, 0x2AAC69, 0xB5D37E, 0x339F85, 0x3F0673, 0xB94A88, 
+    0x87B4A6, 0x01F85D, 0x0D61AB, 0x8B2D50, 0x145247, 0x921EBC, 0x9E874A, 0x18CBB1, 
+    0xE37B16, 0x6537ED, 0x69AE1B, 0xEFE2E0, 0x709DF7, 0xF6D10C, 0xFA48FA, 0x7C0401, 
+    0x42FA2F, 0xC4B6D4, 0xC82F22, 0x4E63D9, 0xD11CCE, 0x575035, 0x5BC9C3, 0xDD8538 
 }; 
 
 //==================================================
@@ -358,47 +598,21 @@ typedef uint8_t M8Q_MSG_TYPE;
 // Prototypes 
 
 /**
- * @brief Convert the latitude string to a number 
- * 
- * @details Takes the latitude string formatted as "DDMM.MMMMM" and converts it into two 
- *          numbers: 
- *          1. deg_integer --> integer portion of degrees ("DD" --> DD*10^scale) 
- *          2. min_scaled --> minutes as a scaled integer ("MM.MMMMM" --> MMMMMMM)
- *          
- *          This is used to return both scaled integer and floating point degree values 
- *          for latitude. The 'scale' parameter indicates how to scale the degree integer 
- *          portion. 
- * 
- * @param deg_integer : integer portion of degrees 
- * @param min_scaled : scaled integer value of minutes 
- * @param scale : magnitude to scale deg_integer 
- */
-void m8q_lat_str_convert(
-    int32_t *deg_integer, 
-    int32_t *min_scaled, 
-    uint8_t scale); 
-
-
-/**
- * @brief Convert the longitude string to a number 
+ * @brief Convert a coordinate string to scaled integer degrees 
  * 
- * @details Takes the longitude string formatted as "DDDMM.MMMMM" and converts it into 
- *          two numbers: 
- *          1. deg_integer --> integer portion of degrees ("DDD" --> DDD*10^scale) 
- *          2. min_scaled --> minutes as a scaled integer ("MM.MMMMM" --> MMMMMMM)
- *          
- *          This is used to return both scaled integer and floating point degree values 
- *          for longitude. The 'scale' parameter indicates how to scale the degree 
- *          integer portion. 
+ * @details Takes a coordinate string formatted as "DDMM.MMMMM" (latitude) or 
+ *          "DDDMM.MMMMM" (longitude) and converts it to degrees*10^7. The minutes are 
+ *          converted to the fractional part of the degrees using integer math only. The 
+ *          returned value is always positive - the hemisphere indicator is applied when 
+ *          it's read. Digits missing from a short string are read as zero. 
  * 
- * @param deg_integer : integer portion of degrees 
- * @param min_scaled : scaled integer value of minutes 
- * @param scale : magnitude to scale deg_integer 
+ * @param coord_str : coordinate string 
+ * @param deg_digits : number of degree digits (2 for latitude, 3 for longitude) 
+ * @return int32_t : absolute coordinate value (degrees*10^7) 
  */
-void m8q_lon_str_convert(
-    int32_t *deg_integer, 
-    int32_t *min_scaled, 
-    uint8_t scale);
+int32_t m8q_coord_str_convert(
+    const uint8_t *coord_str, 
+    uint8_t deg_digits); 
 
 
 /**
@@ -407,7 +621,8 @@ void m8q_lon_str_convert(
  * @details Takes an NMEA message string containing a numeric value and converts it to a 
  *          scaled integer. Integer getters can return this value and float getters can 
  *          convert the number to a floating point value before returning it using the 
- *          buffer indicating the number of decimal places the value contains. 
+ *          buffer indicating the number of decimal places the value contains. Only 
+ *          integer math is used so it's cheap enough to call while messages are decoded. 
  * 
  * @param data_buff : NMEA message string containing the numeric value 
  * @param data_buff_size : size of the NMEA message string buffer 
@@ -442,25 +657,56 @@ int32_t m8q_nmea_num_parse(
 M8Q_STATUS m8q_flush_ds(uint16_t stream_len); 
 
 
+/**
+ * @brief Send a configuration message and check for an ACK 
+ * 
+ * @details Sends a configuration message to the device using m8q_send_msg. If the 
+ *          message is a UBX CFG message and it's sent successfully then the data stream 
+ *          is read until an ACK or NAK is seen. A NAK or no response within ACK_TIMEOUT 
+ *          reads is considered an invalid config. 
+ * 
+ * @see m8q_send_msg 
+ * 
+ * @param config_msg : buffer that contains the configuration message 
+ * @param max_msg_size : max possible size of the configuration message 
+ * @return M8Q_STATUS : status of the configuration 
+ */
+M8Q_STATUS m8q_config_msg(
+    const char *config_msg, 
+    uint8_t max_msg_size); 
+
+
+/**
+ * @brief Wait for a configuration message ACK 
+ * 
+ * @details Reads the data stream until an ACK or NAK is seen. A NAK or no response 
+ *          within ACK_TIMEOUT reads is considered an invalid config. Called after a UBX 
+ *          CFG message is sent. 
+ * 
+ * @see m8q_config_msg 
+ * @see m8q_config_raw 
+ * 
+ * @return M8Q_STATUS : status of the configuration 
+ */
+M8Q_STATUS m8q_config_ack(void); 
+
+
 /**
  * @brief Read the M8Q data stream and store the data 
  * 
- * @details This function reads the whole data stream from the device, then identifies 
- *          each message in the stream and calls the appropriate message parsing function 
- *          as needed. If the message does not match any known message types then the 
- *          function returns an unknown data status. This function is called by 
- *          m8q_read_data if the data stream size is within the maximum allowed buffer 
- *          size. 
+ * @details This function reads the whole data stream from the device in pieces of at 
+ *          most M8Q_STREAM_BUFF_SIZE bytes and passes each piece to the stream parser. 
+ *          The parser identifies each message and stores its data as needed. If a 
+ *          message does not match any known message types then the function returns an 
+ *          unknown data status. This function is called by m8q_read_data if the data 
+ *          stream size is within the maximum allowed buffer size. 
  *          
- *          This function is separate from m8q_read_data because a stack allocated buffer 
- *          the size of the data stream needs to be created but can only be done once the 
- *          data stream size is known. m8q_read_data reads the stream size and passes it 
- *          to this function which can then create the buffer. 
+ *          The stream is read using a fixed size driver buffer instead of a buffer the 
+ *          size of the data stream. The parser holds its place within a message between 
+ *          pieces so messages split across reads are not lost. 
  * 
  * @see m8q_read_data 
- * @see m8q_msg_id 
- * @see m8q_nmea_msg_parse 
- * @see m8q_ubx_msg_parse 
+ * @see m8q_parse_data 
  * 
  * @param stream_len : length of the data stream 
  * @return M8Q_STATUS : status of the read operation 
@@ -557,94 +803,330 @@ M8Q_MSG_TYPE m8q_msg_id(
 
 
 /**
- * @brief Message identification helper function 
+ * @brief Pack message characters into a message ID key 
  * 
- * @details Used exclusively by m8q_msg_id to help compare a message against message 
- *          types. If a match is found then this function returns true. 
+ * @details Reads up to num_chars characters of msg into an integer key in the same 
+ *          format as the MSG_KEY macros. Reading stops at a null character so the key 
+ *          of a message that's shorter than num_chars can't match a full length key and 
+ *          the end of the buffer isn't read past. 
  * 
  * @see m8q_msg_id 
  * 
- * @param msg : buffer that contains the messages 
- * @param ref_msg : buffer that stores the message type to check the message against 
- * @param num_compare : number of message types to check 
- * @param max_size : size of the data type that stores ref_msg - used for incrementing 
- * @param offset : point in the message at which to start the comparison (bytes) 
- * @param msg_index : index of the reference message where a match was found 
- * @return uint8_t : returns true for match, false otherwise 
+ * @param msg : buffer that contains the message ID 
+ * @param num_chars : number of characters to pack (4 max) 
+ * @return uint32_t : message ID key 
  */
-uint8_t m8q_msg_id_check(
+uint32_t m8q_msg_key(
     const char *msg, 
-    const void *ref_msg, 
-    uint8_t num_compare, 
-    uint8_t max_size, 
-    uint8_t offset, 
-    uint8_t *msg_index); 
+    uint8_t num_chars); 
+
+
+/**
+ * @brief NMEA PUBX message lookup 
+ * 
+ * @see m8q_msg_id 
+ * 
+ * @param msg_key : PUBX message ID key (ex. "00" --> MSG_KEY2('0', '0')) 
+ * @return const nmea_msg_data_t* : message data record info, NULL if not a PUBX message 
+ */
+const nmea_msg_data_t *m8q_nmea_pubx_lookup(uint32_t msg_key); 
+
+
+/**
+ * @brief NMEA talker ID check 
+ * 
+ * @see m8q_msg_id 
+ * 
+ * @param talker_key : talker ID key (ex. "GN" --> MSG_KEY2('G', 'N')) 
+ * @return uint8_t : true if the talker ID is valid, false otherwise 
+ */
+uint8_t m8q_nmea_talker_check(uint32_t talker_key); 
+
+
+/**
+ * @brief NMEA standard message lookup 
+ * 
+ * @see m8q_msg_id 
+ * 
+ * @param msg_key : formatter key (ex. "GGA" --> MSG_KEY3('G', 'G', 'A')) 
+ * @return const nmea_msg_data_t* : message data record info, NULL if not a standard 
+ *                                  message 
+ */
+const nmea_msg_data_t *m8q_nmea_std_lookup(uint32_t msg_key); 
+
+
+/**
+ * @brief UBX message class check 
+ * 
+ * @see m8q_msg_id 
+ * 
+ * @param msg_class : UBX class byte 
+ * @return uint8_t : true if the class is valid, false otherwise 
+ */
+uint8_t m8q_ubx_class_check(uint8_t msg_class); 
+
+
+/**
+ * @brief Parse a single data stream byte 
+ * 
+ * @details Passes one byte of the data stream through the parser state machine. The 
+ *          parser state is kept in the driver data record so parsing can stop and 
+ *          resume at any byte of a message. Called by m8q_parse_data for each byte it's 
+ *          given. 
+ * 
+ * @see m8q_parse_data 
+ * 
+ * @param msg_byte : data stream byte 
+ * @return M8Q_STATUS : status of the parse 
+ */
+M8Q_STATUS m8q_parse_byte(uint8_t msg_byte); 
+
+
+/**
+ * @brief Look for the start of a message 
+ * 
+ * @details Checks if a byte is the start of an NMEA or UBX message and if so, sets up the 
+ *          parser to read the message address/header. Bytes seen between messages that 
+ *          are not the start of a message are reported as unknown data. 
+ * 
+ * @param msg_byte : data stream byte 
+ * @return M8Q_STATUS : unknown data status if the byte is not the start of a message 
+ */
+M8Q_STATUS m8q_msg_start(uint8_t msg_byte); 
+
+
+/**
+ * @brief Incoming NMEA message identification 
+ * 
+ * @details Collects the address field of an incoming NMEA message one byte at a time. 
+ *          Each time a comma is seen the collected bytes are checked using m8q_msg_id. 
+ *          Once the message is identified the parser moves on to the message payload. If 
+ *          the address field grows longer than any known message address then the 
+ *          message is treated as unknown data. 
+ * 
+ * @see m8q_msg_id 
+ * 
+ * @param msg_byte : data stream byte 
+ * @return M8Q_STATUS : unknown data status if the message can't be identified 
+ */
+M8Q_STATUS m8q_nmea_msg_id(uint8_t msg_byte); 
 
 
 /**
  * @brief Incoming NMEA message parse 
  * 
  * @details If an incoming NMEA message is identified in the data stream then this 
- *          function is called to process the message. If the message does not have a 
- *          data record within the driver then no processing is done but the message 
- *          length is counted to update the data stream index. If there is a data 
- *          record then the message payload is sorted and stored in the record 
- *          so it can be used by the driver getter functions. 
- * 
- * @see m8q_read_sort_ds 
- * @see m8q_nmea_msg_count 
- * 
- * @param nmea_msg : buffer for the data stream that points to the NMEA message 
- * @param msg_index : data stream index - gets updated with processing 
- * @param stream_len : max length of the data stream 
- * @param arg_num : number of message payload parameters 
- * @param data : pointer to the data record buffer that can store message data 
+ *          function is called for each payload byte of the message up to the checksum. 
+ *          Every byte is added to the message checksum. If the message does not have a 
+ *          data record within the driver then the payload is skipped. If there is a data 
+ *          record then the message payload is sorted and stored in the staging buffer 
+ *          until the checksum can be checked. 
+ * 
+ * @see m8q_nmea_msg_id 
+ * @see m8q_nmea_msg_checksum 
+ * 
+ * @param msg_byte : data stream byte 
+ */
+void m8q_nmea_msg_parse(uint8_t msg_byte); 
+
+
+/**
+ * @brief Incoming NMEA message checksum 
+ * 
+ * @details Reads the two hexadecimal checksum characters that follow the '*' at the end 
+ *          of an NMEA message payload and compares them against the checksum worked out 
+ *          while the message was parsed. A stored message is only copied to the data 
+ *          record if the two match. 
+ * 
+ * @see m8q_nmea_msg_end 
+ * 
+ * @param msg_byte : data stream byte 
+ * @return M8Q_STATUS : bad checksum status if the checksum doesn't match 
  */
-void m8q_nmea_msg_parse(
-    const uint8_t *nmea_msg, 
-    uint16_t *stream_index, 
-    uint16_t stream_len, 
-    uint8_t arg_num, 
-    uint8_t **data); 
+M8Q_STATUS m8q_nmea_msg_checksum(uint8_t msg_byte); 
 
 
 /**
- * @brief Incoming NMEA message counter 
+ * @brief End of an NMEA message field 
  * 
- * @details Counts the remaining length of the NMEA message being processed so the 
- *          data stream index can be updated to the next message. Used only by 
- *          m8q_nmea_msg_parse to count a message with no data record or count 
- *          the remaining bytes after the payload of a message with a data record. 
+ * @details Called when the end of a stored NMEA message field is seen. The staged field 
+ *          string is terminated if there is room, the field is marked as seen if it's not 
+ *          empty and the field is converted to its numeric value if the message has one. 
  * 
  * @see m8q_nmea_msg_parse 
+ */
+void m8q_nmea_field_end(void); 
+
+
+/**
+ * @brief End of a stored NMEA message 
+ * 
+ * @details Called once the checksum of a stored NMEA message has been verified. The 
+ *          staged fields and values are copied to the data record, the fields seen in 
+ *          the message are saved and the message sequence number is incremented. 
+ * 
+ * @see m8q_nmea_msg_checksum 
+ */
+void m8q_nmea_msg_end(void); 
+
+
+/**
+ * @brief POSITION message field decode 
+ * 
+ * @details Converts a staged POSITION message field string into its numeric value. 
+ *          Latitude and longitude are stored as absolute values and the sign is applied 
+ *          when the hemisphere indicator that follows them is read. Empty fields are read 
+ *          as zero. 
+ * 
+ * @param field : POSITION message field index 
+ */
+void m8q_pos_field_decode(uint8_t field); 
+
+
+/**
+ * @brief TIME message field decode 
+ * 
+ * @details Converts a staged TIME message field string into its numeric value. Empty 
+ *          fields are read as zero. 
+ * 
+ * @param field : TIME message field index 
+ */
+void m8q_time_field_decode(uint8_t field); 
+
+
+/**
+ * @brief Incoming UBX message identification 
  * 
- * @param nmea_msg : buffer for the data stream that points to the NMEA message 
- * @param stream_index : data stream index 
- * @param stream_len : max length of the data stream 
+ * @details Collects the header of an incoming UBX message one byte at a time. Once the 
+ *          class, ID and payload length are known the message class is checked and the 
+ *          header is added to the message checksum. NAV messages with a data record are 
+ *          set up to have their payload stored. The payload of all other UBX messages is 
+ *          skipped. 
+ * 
+ * @see m8q_msg_id 
+ * 
+ * @param msg_byte : data stream byte 
+ * @return M8Q_STATUS : unknown data status if the message class is unknown 
  */
-void m8q_nmea_msg_count(
-    const uint8_t *nmea_msg, 
-    uint16_t *stream_index, 
-    uint16_t stream_len); 
+M8Q_STATUS m8q_ubx_msg_id(uint8_t msg_byte); 
 
 
 /**
  * @brief Incoming UBX message parse 
  * 
- * @details If an incoming UBX message is identified in the data stream then this 
- *          function is called to process the message. Right now the only processing 
- *          done by this function is checking if the message is an ACK or NAK message 
- *          as a confirmation of CFG messages sent to the device. All UBX messages 
- *          have their length counted so the data stream index can be updated. 
+ * @details Called for each payload and checksum byte of an incoming UBX message. Payload 
+ *          bytes are added to the message checksum. If the message has a data record in 
+ *          the driver then the payload is stored as it's read. All other UBX message 
+ *          payloads are skipped. Once the checksum bytes have been read and verified the 
+ *          message is finished with m8q_ubx_msg_end. 
+ * 
+ * @see m8q_ubx_msg_id 
+ * @see m8q_ubx_msg_end 
+ * 
+ * @param msg_byte : data stream byte 
+ * @return M8Q_STATUS : bad checksum status if the checksum doesn't match 
+ */
+M8Q_STATUS m8q_ubx_msg_parse(uint8_t msg_byte); 
+
+
+/**
+ * @brief End of a UBX message 
+ * 
+ * @details Called once the checksum of a UBX message has been verified. ACK and NAK 
+ *          messages are counted as a confirmation of CFG messages sent to the device and 
+ *          stored NAV messages are decoded. 
+ * 
+ * @see m8q_ubx_msg_parse 
+ * @see m8q_ubx_nav_decode 
+ */
+void m8q_ubx_msg_end(void); 
+
+
+/**
+ * @brief Add a byte to the UBX message checksum 
+ * 
+ * @details UBX messages use an 8-bit Fletcher checksum over the class, ID, length and 
+ *          payload bytes. 
+ * 
+ * @param msg_byte : UBX message byte 
+ */
+void m8q_ubx_checksum_add(uint8_t msg_byte); 
+
+
+/**
+ * @brief Publish a snapshot 
+ * 
+ * @details Copies the current POSITION, TIME and NAV values into the snapshot buffer 
+ *          that isn't published, then makes it the published buffer. Readers copying 
+ *          the published buffer are never written over unless the parser publishes again 
+ *          while a copy is in progress, in which case m8q_get_snapshot sees the write 
+ *          count change and copies again. Called each time a stored message is accepted. 
+ *          If the message has a new fix then the fix callback is called. 
+ * 
+ * @see m8q_get_snapshot 
+ * @see m8q_set_fix_callback 
  * 
- * @param ubx_msg : buffer for the data stream that points to the UBX message 
- * @param stream_index : data stream index 
- * @param stream_len : max length of the data stream 
+ * @param new_fix : true if the message has a new fix (POSITION or NAV-PVT) 
  */
-void m8q_ubx_msg_parse(
-    const uint8_t *ubx_msg, 
-    uint16_t *stream_index, 
-    uint16_t stream_len); 
+void m8q_snapshot_publish(uint8_t new_fix); 
+
+
+/**
+ * @brief Write an RTCM3 frame to the device 
+ * 
+ * @details Writes a frame from a circular buffer to the device in pieces of at most 
+ *          'max_chunk' bytes. The frame is split where it wraps around the end of the 
+ *          buffer. A write is never less than 2 bytes because the device takes a 1 byte 
+ *          write as a register address and drops it. If a split would leave 1 byte then 
+ *          the write before it is made a byte shorter, and if less than 2 bytes are left 
+ *          before the buffer end then they're copied to a small buffer along with the 
+ *          bytes after it and written together. 
+ * 
+ * @see m8q_rtcm_forward 
+ * 
+ * @param circular_buff : circular buffer that holds the frame 
+ * @param cb_size : size of the circular buffer 
+ * @param frame_start : circular buffer index of the frame preamble 
+ * @param frame_len : length of the frame 
+ * @param max_chunk : max bytes per I2C write (at least RTCM_MIN_CHUNK) 
+ * @return M8Q_STATUS : status of the write operation 
+ */
+M8Q_STATUS m8q_rtcm_write(
+    const uint8_t *circular_buff, 
+    uint16_t cb_size, 
+    uint16_t frame_start, 
+    uint16_t frame_len, 
+    uint8_t max_chunk); 
+
+
+/**
+ * @brief UBX NAV message decode 
+ * 
+ * @details Copies the fields of a stored NAV-PVT, NAV-STATUS or NAV-DOP payload into the 
+ *          NAV data record. UBX messages are little endian binary so the fields are 
+ *          assembled from bytes directly and no string parsing is needed. 
+ * 
+ * @see m8q_ubx_msg_end 
+ */
+void m8q_ubx_nav_decode(void); 
+
+
+/**
+ * @brief Read a little endian 16-bit UBX value 
+ * 
+ * @param data : buffer that contains the value 
+ * @return uint16_t : value 
+ */
+uint16_t m8q_ubx_u16(const uint8_t *data); 
+
+
+/**
+ * @brief Read a little endian 32-bit UBX value 
+ * 
+ * @param data : buffer that contains the value 
+ * @return uint32_t : value 
+ */
+uint32_t m8q_ubx_u32(const uint8_t *data); 
 
 
 /**
@@ -863,14 +1345,12 @@ M8Q_STATUS m8q_init(
     uint8_t max_msg_size, 
     uint16_t data_buff_limit)
 {
-    if ((i2c == NULL) || (config_msgs == NULL))
+    if ((i2c == NULL) || ((config_msgs == NULL) && msg_num))
     {
         return M8Q_INVALID_PTR; 
     }
 
     M8Q_STATUS init_status = M8Q_OK; 
-    uint16_t ack_status; 
-    uint8_t ack_timeout; 
 
     // Initialize driver data 
     memset((void *)&m8q_driver_data.pos_data, CLEAR, sizeof(m8q_driver_data.pos_data)); 
@@ -879,9 +1359,18 @@ M8Q_STATUS m8q_init(
     memset((void *)&m8q_driver_data.pos_data.lon, ZERO_CHAR, 
            sizeof(m8q_driver_data.pos_data.lon)); 
     memset((void *)&m8q_driver_data.time_data, CLEAR, sizeof(m8q_driver_data.time_data)); 
+    memset((void *)&m8q_driver_data.pos_value, CLEAR, sizeof(m8q_driver_data.pos_value)); 
+    memset((void *)&m8q_driver_data.time_value, CLEAR, sizeof(m8q_driver_data.time_value)); 
+    memset((void *)&m8q_driver_data.nav_data, CLEAR, sizeof(m8q_driver_data.nav_data)); 
+    m8q_clear_msg_stats(); 
+    memset((void *)m8q_driver_data.snapshot, CLEAR, sizeof(m8q_driver_data.snapshot)); 
+    m8q_driver_data.snapshot_index = CLEAR; 
+    m8q_driver_data.txr_pending = FALSE; 
     m8q_driver_data.i2c = i2c; 
     m8q_driver_data.data_buff_limit = (!data_buff_limit) ? HIGH_16BIT : data_buff_limit; 
     memset((void *)&nmea_msg_target, CLEAR, sizeof(nmea_msg_data_t)); 
+    memset((void *)&m8q_driver_data.parse, CLEAR, sizeof(m8q_driver_data.parse)); 
+    m8q_driver_data.parse.state = M8Q_PARSE_START; 
 
     // Check, format and write each message to the device. If there is a problem with a 
     // message then the operation is aborted and the status is returned. If the message 
@@ -889,39 +1378,13 @@ M8Q_STATUS m8q_init(
     // code looks for an ACK response. 
     for (uint8_t i = CLEAR; i < msg_num; i++)
     {
-        init_status = m8q_send_msg(config_msgs, max_msg_size); 
+        init_status = m8q_config_msg(config_msgs, max_msg_size); 
 
         if (init_status)
         {
             break; 
         }
 
-        if (*(config_msgs + BYTE_6) == 
-            *(ubx_msg_class[UBX_CFG_INDEX].ubx_msg_class_str + BYTE_1))
-        {
-            ack_timeout = ACK_TIMEOUT; 
-
-            do
-            {
-                if (!m8q_read_data())
-                {
-                    ack_status = m8q_get_ack_status(); 
-
-                    if (ack_status && (ack_status <= HIGH_8BIT))
-                    {
-                        break; 
-                    }
-                }
-            }
-            while (--ack_timeout); 
-
-            if (!ack_timeout)
-            {
-                init_status = M8Q_INVALID_CONFIG; 
-                break; 
-            }
-        }
-
         config_msgs += max_msg_size; 
     }
 
@@ -973,6 +1436,30 @@ M8Q_STATUS m8q_txr_pin_init(
     return M8Q_OK; 
 }
 
+
+// UBX NAV message configuration 
+M8Q_STATUS m8q_nav_config(uint16_t meas_rate)
+{
+    M8Q_STATUS config_status = M8Q_OK; 
+    char rate_msg[NAV_CFG_MSG_LEN]; 
+
+    // Enable each NAV message. The device must ACK each message before moving on. 
+    for (uint8_t i = CLEAR; (i < NAV_NUM_CFG_MSGS) && (config_status == M8Q_OK); i++)
+    {
+        config_status = m8q_config_msg(&ubx_nav_cfg_msgs[i][0], NAV_CFG_MSG_LEN); 
+    }
+
+    // Set the measurement rate if requested. UBX payloads are little endian so the low 
+    // byte of the rate is written first. 
+    if (meas_rate && (config_status == M8Q_OK))
+    {
+        sprintf(rate_msg, ubx_nav_rate_msg, meas_rate & HIGH_8BIT, meas_rate >> SHIFT_8); 
+        config_status = m8q_config_msg(rate_msg, NAV_CFG_MSG_LEN); 
+    }
+
+    return config_status; 
+}
+
 //=======================================================================================
 
 
@@ -1074,6 +1561,27 @@ M8Q_STATUS m8q_read_ds_size(uint16_t *data_size)
 }
 
 
+// Parse device data stream bytes 
+M8Q_STATUS m8q_parse_data(
+    const uint8_t *data_buff, 
+    uint16_t data_size)
+{
+    if (data_buff == NULL)
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    M8Q_STATUS parse_status = M8Q_OK; 
+
+    while (data_size--)
+    {
+        parse_status |= m8q_parse_byte(*data_buff++); 
+    }
+
+    return parse_status; 
+}
+
+
 // Return the ACK/NAK message counter status 
 uint16_t m8q_get_ack_status(void)
 {
@@ -1083,9 +1591,30 @@ uint16_t m8q_get_ack_status(void)
 }
 
 
-// Send a message to the device 
-M8Q_STATUS m8q_send_msg(
-    const char *write_msg, 
+// Get data stream health counters 
+m8q_msg_stats_t m8q_get_msg_stats(m8q_msg_stats_type_t type)
+{
+    m8q_msg_stats_t stats = { CLEAR, CLEAR, CLEAR, CLEAR }; 
+
+    if (type < M8Q_STATS_NUM)
+    {
+        stats = m8q_driver_data.msg_stats[type]; 
+    }
+
+    return stats; 
+}
+
+
+// Clear data stream health counters 
+void m8q_clear_msg_stats(void)
+{
+    memset((void *)m8q_driver_data.msg_stats, CLEAR, sizeof(m8q_driver_data.msg_stats)); 
+}
+
+
+// Send a message to the device 
+M8Q_STATUS m8q_send_msg(
+    const char *write_msg, 
     uint8_t max_msg_size)
 {
     if (write_msg == NULL)
@@ -1121,6 +1650,63 @@ M8Q_STATUS m8q_send_msg(
 }
 
 
+// Send a ready to send message to the device 
+M8Q_STATUS m8q_send_raw_msg(
+    const uint8_t *msg, 
+    uint8_t msg_size)
+{
+    if (msg == NULL)
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    if (!msg_size)
+    {
+        return M8Q_INVALID_CONFIG; 
+    }
+
+    return m8q_write_msg((void *)msg, msg_size); 
+}
+
+
+// Send ready to send configuration messages 
+M8Q_STATUS m8q_config_raw(
+    const m8q_raw_msg_t *config_msgs, 
+    uint8_t msg_num)
+{
+    if ((config_msgs == NULL) && msg_num)
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    M8Q_STATUS config_status = M8Q_OK; 
+    const uint8_t *msg; 
+
+    for (uint8_t i = CLEAR; i < msg_num; i++)
+    {
+        msg = config_msgs[i].msg; 
+        config_status = m8q_send_raw_msg(msg, config_msgs[i].msg_size); 
+
+        // Only UBX CFG messages get an ACK response 
+        if (!config_status && 
+            (config_msgs[i].msg_size > UBX_HEADER_LEN) && 
+            (msg[BYTE_0] == UBX_SYNC_CHAR_1) && 
+            (msg[BYTE_1] == UBX_SYNC_CHAR_2) && 
+            (msg[BYTE_2] == UBX_CLASS_CFG))
+        {
+            config_status = m8q_config_ack(); 
+        }
+
+        if (config_status)
+        {
+            break; 
+        }
+    }
+
+    return config_status; 
+}
+
+
 // Get TX ready status 
 GPIO_STATE m8q_get_tx_ready(void)
 {
@@ -1128,6 +1714,50 @@ GPIO_STATE m8q_get_tx_ready(void)
 }
 
 
+// TX ready interrupt 
+void m8q_txr_irq(void)
+{
+    m8q_driver_data.txr_pending = TRUE; 
+}
+
+
+// Read the data stream after a TX ready interrupt 
+M8Q_STATUS m8q_txr_read(void)
+{
+    M8Q_STATUS read_status; 
+
+    // The pin is checked after the read so it must be set up first 
+    if (m8q_driver_data.tx_ready_gpio == NULL)
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    if (!m8q_driver_data.txr_pending)
+    {
+        return M8Q_NO_DATA_AVAILABLE; 
+    }
+
+    // The flag is cleared before reading so an interrupt during the read isn't lost 
+    m8q_driver_data.txr_pending = FALSE; 
+    read_status = m8q_read_data(); 
+
+    // The pin is only edge triggered so check if data came in during the read 
+    if (m8q_get_tx_ready() == GPIO_HIGH)
+    {
+        m8q_driver_data.txr_pending = TRUE; 
+    }
+
+    return read_status; 
+}
+
+
+// Set the new fix callback 
+void m8q_set_fix_callback(m8q_fix_callback_t callback)
+{
+    m8q_driver_data.fix_callback = callback; 
+}
+
+
 // Enter low power mode 
 void m8q_set_low_pwr(void)
 {
@@ -1147,79 +1777,34 @@ void m8q_clear_low_pwr(void)
 //=======================================================================================
 // POSITION (PUBX,00) message
 
-// Get the floating point latitude coordinate (degrees) 
-float m8q_get_position_lat(void)
+// Get the number of POSITION messages read 
+uint32_t m8q_get_position_seq(void)
 {
-    int32_t deg_int = CLEAR, min_scaled = CLEAR; 
-    m8q_lat_str_convert(&deg_int, &min_scaled, CLEAR); 
-
-    // Calculate and return the final degree value. This requires changing the scaled 
-    // minutes value into a fractional/decimal degrees value. 
-    return ((float)deg_int) + (((float)min_scaled) / (SCALE_1E5F*MIN_TO_DEG)); 
+    return m8q_driver_data.pos_value.seq; 
 }
 
 
-// Get the scaled integer latitude coordinate (degrees*10^7) 
-int32_t m8q_get_position_latI(void)
+// Get the POSITION fields seen in the last message 
+uint32_t m8q_get_position_valid(void)
 {
-    int32_t deg_int = CLEAR, min_scaled = CLEAR; 
-    m8q_lat_str_convert(&deg_int, &min_scaled, SET_7); 
-
-    // Calculate and return the scaled integer degree value. The minutes get converted to
-    // the fractional part of degrees and scaled so all decimal places are accounted for.  
-    return deg_int + (min_scaled * SCALE_100 / MIN_TO_DEG); 
+    return m8q_driver_data.pos_value.valid; 
 }
 
 
-// Convert the latitude string to a number 
-void m8q_lat_str_convert(
-    int32_t *deg_integer, 
-    int32_t *min_scaled, 
-    uint8_t scale)
+// Get the floating point latitude coordinate (degrees) 
+float m8q_get_position_lat(void)
 {
-    // Latitude is formatted as a string with the following characters: DDMM.MMMMM - where 
-    // 'D' is a degrees digit and 'M' is a minutes digit. This function converts the string 
-    // to a double in degrees only. The below conversion is based on the number of digits 
-    // for each part of the coordinate. Based on the format above, there are two digits each 
-    // for the integer portion of degrees and minutes, a decimal point, and five digits for 
-    // the fractional part of the minutes. Since the final product is a double expressed 
-    // in degrees, 'deg_integer' holds the conversion of the first two digits and 'min_scaled' 
-    // holds the conversion of the minutes which makes up the fractional/decimal part of 
-    // the degrees. 
-
-    uint8_t lat_index = CLEAR; 
-    scale += BYTE_1; 
-
-    // Convert the integer portion of the degrees and minutes, both of which are two 
-    // digit/characters in length. The minutes get converted to a scaled value to 
-    // prepare for adding the fractional/decimal part of the minute. 
-    do
-    {
-        *deg_integer += (int32_t)char_to_int(m8q_driver_data.pos_data.lat[lat_index], scale - lat_index); 
-        *min_scaled +=  (int32_t)char_to_int(m8q_driver_data.pos_data.lat[lat_index + BYTE_2], BYTE_6 - lat_index); 
-    }
-    while (++lat_index < BYTE_2); 
-
-    // Bypass the decimal point character 
-    lat_index += BYTE_3; 
+    // The integer and fractional degrees are converted separately so no precision is 
+    // lost converting the whole scaled value to a float. 
+    int32_t lat = m8q_driver_data.pos_value.lat; 
+    return (float)(lat / DEG_SCALE) + ((float)(lat % DEG_SCALE) / SCALE_1E7F); 
+}
 
-    // Convert the fractional part of the minute and add it to the scaled value of minutes. 
-    // The latitude string contains 10 bytes so that is where the conversion stops. The 
-    // fractional part of the minute is 5 characters in length. 
-    do
-    {
-        *min_scaled += (int32_t)char_to_int(m8q_driver_data.pos_data.lat[lat_index], BYTE_9 - lat_index); 
-    }
-    while (++lat_index < BYTE_10); 
 
-    // If the latitude coordinate is in the southern hemisphere then change the sign on the 
-    // value. The returned value is meant to be interpretted without needing the N/S 
-    // indicator. 
-    if (m8q_get_position_NS() == S_UP_CHAR) 
-    {
-        *deg_integer = -(*deg_integer); 
-        *min_scaled = -(*min_scaled); 
-    }
+// Get the scaled integer latitude coordinate (degrees*10^7) 
+int32_t m8q_get_position_latI(void)
+{
+    return m8q_driver_data.pos_value.lat; 
 }
 
 
@@ -1248,78 +1833,15 @@ uint8_t m8q_get_position_NS(void)
 // Get the floating point longitude coordinate (degrees) 
 float m8q_get_position_lon(void)
 {
-    int32_t deg_int = CLEAR, min_scaled = CLEAR; 
-    m8q_lon_str_convert(&deg_int, &min_scaled, CLEAR); 
-
-    // Calculate and return the final degree value. This requires changing the scaled 
-    // minutes value into a fractional/decimal degrees value. 
-    return ((float)deg_int) + (((float)min_scaled) / (SCALE_1E5F*MIN_TO_DEG)); 
+    int32_t lon = m8q_driver_data.pos_value.lon; 
+    return (float)(lon / DEG_SCALE) + ((float)(lon % DEG_SCALE) / SCALE_1E7F); 
 }
 
 
 // Get the scaled integer longitude coordinate (degrees*10^7) 
 int32_t m8q_get_position_lonI(void)
 {
-    int32_t deg_int = CLEAR, min_scaled = CLEAR; 
-    m8q_lon_str_convert(&deg_int, &min_scaled, SET_7); 
-
-    // Calculate and return the scaled integer degree value. The minutes get converted to
-    // the fractional part of degrees and scaled so all decimal places are accounted for.  
-    return deg_int + (min_scaled * SCALE_100 / MIN_TO_DEG); 
-}
-
-
-// Convert the longitude string to a number 
-void m8q_lon_str_convert(
-    int32_t *deg_integer, 
-    int32_t *min_scaled, 
-    uint8_t scale)
-{
-    // Longitude is formatted as a string with the following characters: DDDMM.MMMMM - where 
-    // 'D' is a degrees digit and 'M' is a minutes digit. This function converts the string 
-    // to a double in degrees only. The below conversion is based on the number of digits 
-    // for each part of the coordinate. Based on the format above, there are three digits 
-    // each for the integer portion of degrees and two for minutes, a decimal point, and 
-    // five digits for the fractional part of the minutes. Since the final product is a 
-    // double expressed in degrees, 'deg_int' holds the conversion of the first three digits 
-    // and 'deg_frac' holds the conversion of the minutes which makes up the 
-    // fractional/decimal part of the degrees. 
-    
-    uint8_t lon_index = CLEAR; 
-    scale += BYTE_2; 
-
-    // Convert the integer portion of the degrees (3 digits) and minutes (2 digits). The 
-    // minutes get converted to a scaled value to prepare for adding the fractional part 
-    // of the minute. Since the degree integer portion is one digit larger, an extra 
-    // conversion is added. 
-    *deg_integer += (int32_t)char_to_int(m8q_driver_data.pos_data.lon[lon_index], scale - lon_index); 
-    
-    while (++lon_index < BYTE_3)
-    {
-        *deg_integer += (int32_t)char_to_int(m8q_driver_data.pos_data.lon[lon_index], scale - lon_index); 
-        *min_scaled +=  (int32_t)char_to_int(m8q_driver_data.pos_data.lon[lon_index + BYTE_2], BYTE_7 - lon_index); 
-    }
-
-    // Bypass the decimal point character 
-    lon_index += BYTE_3; 
-
-    // Convert the fractional part of the minute and add it to the scaled value of minutes. 
-    // The latitude string contains 10 bytes so that is where the conversion stops. The 
-    // fractional part of the minute is 5 characters in length. 
-    do
-    {
-        *min_scaled += (int32_t)char_to_int(m8q_driver_data.pos_data.lon[lon_index], BYTE_10 - lon_index); 
-    }
-    while (++lon_index < BYTE_11); 
-
-    // If the longitude coordinate is in the western hemisphere then change the sign on the 
-    // value. The returned value is meant to be interpretted without needing the E/W 
-    // indicator. 
-    if (m8q_get_position_EW() == W_UP_CHAR) 
-    {
-        *deg_integer = -(*deg_integer); 
-        *min_scaled = -(*min_scaled); 
-    }
+    return m8q_driver_data.pos_value.lon; 
 }
 
 
@@ -1355,15 +1877,14 @@ float m8q_get_position_altref(void)
 // Get the integer WGS84 altitude (mm) 
 int32_t m8q_get_position_altrefI(void)
 {
-    return m8q_nmea_num_parse(m8q_driver_data.pos_data.altRef, sizeof(m8q_driver_data.pos_data.altRef));
+    return m8q_driver_data.pos_value.altRef; 
 }
 
 
 // Get navigation status 
 uint16_t m8q_get_position_navstat(void)
 {
-    return (m8q_driver_data.pos_data.navStat[BYTE_0] << SHIFT_8) | 
-            m8q_driver_data.pos_data.navStat[BYTE_1]; 
+    return m8q_driver_data.pos_value.navStat; 
 }
 
 
@@ -1396,7 +1917,7 @@ float m8q_get_position_hacc(void)
 // Get horizontal accuracy estimate (hAcc) as a scaled integer 
 uint32_t m8q_get_position_haccI(void)
 {
-    return m8q_nmea_num_parse(m8q_driver_data.pos_data.SOG, sizeof(m8q_driver_data.pos_data.SOG));
+    return m8q_driver_data.pos_value.hAcc; 
 }
 
 
@@ -1410,7 +1931,7 @@ float m8q_get_position_vacc(void)
 // Get vertical accuracy estimate (vAcc) as a scaled integer 
 uint32_t m8q_get_position_vaccI(void)
 {
-    return m8q_nmea_num_parse(m8q_driver_data.pos_data.SOG, sizeof(m8q_driver_data.pos_data.SOG));
+    return m8q_driver_data.pos_value.vAcc; 
 }
 
 
@@ -1424,7 +1945,7 @@ float m8q_get_position_sog(void)
 // Get speed over ground (SOG) as a scaled integer 
 uint32_t m8q_get_position_sogI(void)
 {
-    return m8q_nmea_num_parse(m8q_driver_data.pos_data.SOG, sizeof(m8q_driver_data.pos_data.SOG));
+    return m8q_driver_data.pos_value.SOG; 
 }
 
 
@@ -1455,7 +1976,7 @@ float m8q_get_position_cog(void)
 // Get course over ground (COG) as a scaled integer 
 uint32_t m8q_get_position_cogI(void)
 {
-    return m8q_nmea_num_parse(m8q_driver_data.pos_data.COG,sizeof(m8q_driver_data.pos_data.COG));
+    return m8q_driver_data.pos_value.COG; 
 }
 
 
@@ -1469,7 +1990,7 @@ float m8q_get_position_vvel(void)
 // Get vertical velocity (vVel) as a scaled integer 
 int32_t m8q_get_position_vvelI(void)
 {
-    return m8q_nmea_num_parse(m8q_driver_data.pos_data.vVel, sizeof(m8q_driver_data.pos_data.vVel));
+    return m8q_driver_data.pos_value.vVel; 
 }
 
 //=======================================================================================
@@ -1478,6 +1999,20 @@ int32_t m8q_get_position_vvelI(void)
 //=======================================================================================
 // TIME (PUBX,04) message 
 
+// Get the number of TIME messages read 
+uint32_t m8q_get_time_seq(void)
+{
+    return m8q_driver_data.time_value.seq; 
+}
+
+
+// Get the TIME fields seen in the last message 
+uint8_t m8q_get_time_valid(void)
+{
+    return m8q_driver_data.time_value.valid; 
+}
+
+
 // Get UTC time 
 M8Q_STATUS m8q_get_time_utc_time(
     uint8_t *utc_time, 
@@ -1507,457 +2042,1527 @@ M8Q_STATUS m8q_get_time_utc_date(
     return M8Q_OK; 
 }
 
-//=======================================================================================
-
-
-//=======================================================================================
-// NMEA message helper functions 
 
-// Parse a numeric value from NMEA messages 
-int32_t m8q_nmea_num_parse(
-    uint8_t *data_buff,
-    uint8_t data_buff_size)
+// Get UTC time as a scaled integer 
+uint32_t m8q_get_time_utc_timeI(void)
 {
-    uint8_t index = CLEAR, data_size = CLEAR, digit_index = CLEAR, sign = CLEAR_BIT;
-    int32_t integer = CLEAR;
-
-    // Determine the format of the provided data 
-    while ((index < data_buff_size) && (data_buff != NULL) && (data_buff[index] != NULL_CHAR))
-    {
-        switch (data_buff[index++])
-        {
-            case MINUS_CHAR:
-                sign = SET_BIT;
-                break;
+    return m8q_driver_data.time_value.time; 
+}
 
-            case PERIOD_CHAR:
-                break;
 
-            default:
-                data_size++;
-                break;
-        }
-    }
+// Get UTC date as an integer 
+uint32_t m8q_get_time_utc_dateI(void)
+{
+    return m8q_driver_data.time_value.date; 
+}
 
-    index = CLEAR;
 
-    while (digit_index < data_size)
-    {
-        if ((data_buff[index] != MINUS_CHAR) && (data_buff[index] != PERIOD_CHAR))
-        {
-            integer += (int32_t)char_to_int(data_buff[index], data_size - ++digit_index);
-        }
-        index++;
-    }
+// Get UTC time of week as a scaled integer 
+uint32_t m8q_get_time_utc_towI(void)
+{
+    return m8q_driver_data.time_value.utcTow; 
+}
 
-    if (sign == SET_BIT)
-    {
-        integer = -integer;
-    }
 
-    return integer;
+// Get UTC week number 
+uint16_t m8q_get_time_utc_wk(void)
+{
+    return m8q_driver_data.time_value.utcWk; 
 }
 
 //=======================================================================================
 
 
 //=======================================================================================
-// Read and write 
+// NAV (UBX NAV-PVT, NAV-STATUS, NAV-DOP) messages 
 
-// Flush/clear the M8Q data stream 
-M8Q_STATUS m8q_flush_ds(uint16_t stream_len)
+// Get GPS time of week of the navigation solution (ms) 
+uint32_t m8q_get_nav_itow(void)
 {
-    I2C_STATUS i2c_status = I2C_OK; 
-
-    // Initiate the transmission then get the data stream without storing any data 
-    i2c_status |= m8q_start_trans(I2C_R_OFFSET); 
-    i2c_status |= i2c_clear(m8q_driver_data.i2c, stream_len); 
+    return m8q_driver_data.nav_data.iTOW; 
+}
 
-    if (i2c_status)
-    {
-        return M8Q_READ_FAULT; 
-    }
 
-    return M8Q_DATA_BUFF_OVERFLOW; 
+// Get the GNSS fix type 
+uint8_t m8q_get_nav_fix_type(void)
+{
+    return m8q_driver_data.nav_data.fixType; 
 }
 
 
-// Read the M8Q data stream and store the data 
-M8Q_STATUS m8q_read_sort_ds(uint16_t stream_len)
+// Get acceptable navigation status 
+uint8_t m8q_get_nav_fix_lock(void)
 {
-    I2C_STATUS i2c_status; 
-    uint8_t stream_data[stream_len]; 
-    M8Q_MSG_TYPE msg_type = M8Q_MSG_INVALID; 
-    uint16_t stream_index = CLEAR; 
-    uint8_t msg_offset = CLEAR; 
-
-    // Read the whole data stream 
-    i2c_status = m8q_read(stream_data, stream_len); 
+    // Fix types 2 (2D), 3 (3D) and 4 (GNSS + dead reckoning) are position fixes 
+    uint8_t fix_type = m8q_driver_data.nav_data.fixType; 
 
-    if (i2c_status)
+    if (!(m8q_driver_data.nav_data.flags & NAV_FIX_OK) || (fix_type < BYTE_2) || 
+        (fix_type > BYTE_4))
     {
-        return M8Q_READ_FAULT; 
+        return FALSE; 
     }
 
-    while (stream_index < stream_len)
-    {
-        // Identify the message type 
-        msg_type = m8q_msg_id((char *)&stream_data[stream_index], &msg_offset); 
-
-        // Sort the message data as needed 
-        if (msg_type == M8Q_MSG_NMEA)
-        {
-            stream_index += msg_offset + BYTE_1; 
-
-            m8q_nmea_msg_parse(
-                &stream_data[stream_index], 
-                &stream_index, 
-                stream_len, 
-                nmea_msg_target.num_param, 
-                nmea_msg_target.msg_data); 
-        }
-        else if (msg_type == M8Q_MSG_UBX)
-        {
-            stream_index += BYTE_2; 
+    return TRUE; 
+}
 
-            m8q_ubx_msg_parse(
-                &stream_data[stream_index], 
-                &stream_index, 
-                stream_len); 
-        }
-        else 
-        {
-            return M8Q_UNKNOWN_DATA; 
-        }
-    }
 
-    return M8Q_OK; 
+// Get the number of satellites used in the navigation solution 
+uint8_t m8q_get_nav_num_sv(void)
+{
+    return m8q_driver_data.nav_data.numSV; 
 }
 
 
-// Read data from the device 
-I2C_STATUS m8q_read(
-    uint8_t *data_buff, 
-    uint16_t data_size)
+// Get latitude (degrees*10^7) 
+int32_t m8q_get_nav_lat(void)
 {
-    I2C_STATUS i2c_status = I2C_OK; 
+    return m8q_driver_data.nav_data.lat; 
+}
 
-    // Initiate the transmission then read the data 
-    i2c_status |= m8q_start_trans(I2C_R_OFFSET); 
-    i2c_status |= i2c_read(m8q_driver_data.i2c, data_buff, data_size); 
 
-    return i2c_status; 
+// Get longitude (degrees*10^7) 
+int32_t m8q_get_nav_lon(void)
+{
+    return m8q_driver_data.nav_data.lon; 
 }
 
 
-// Send a formatted message to the device 
-M8Q_STATUS m8q_write_msg(
-    const void *msg, 
-    uint8_t msg_size)
+// Get height above the ellipsoid (mm) 
+int32_t m8q_get_nav_height(void)
 {
-    I2C_STATUS i2c_status = I2C_OK; 
+    return m8q_driver_data.nav_data.height; 
+}
 
-    // Send the message to the device and generate a stop condition when done. 
-    i2c_status |= m8q_write((uint8_t *)msg, msg_size); 
-    i2c_stop(m8q_driver_data.i2c); 
 
-    if (i2c_status)
-    {
-        return M8Q_WRITE_FAULT; 
-    }
+// Get height above mean sea level (mm) 
+int32_t m8q_get_nav_hmsl(void)
+{
+    return m8q_driver_data.nav_data.hMSL; 
+}
 
-    return M8Q_OK; 
+
+// Get horizontal accuracy estimate (mm) 
+uint32_t m8q_get_nav_hacc(void)
+{
+    return m8q_driver_data.nav_data.hAcc; 
 }
 
 
-// Write data to the device 
-I2C_STATUS m8q_write(
-    const uint8_t *data, 
-    uint8_t data_size)
+// Get vertical accuracy estimate (mm) 
+uint32_t m8q_get_nav_vacc(void)
 {
-    I2C_STATUS i2c_status = I2C_OK; 
+    return m8q_driver_data.nav_data.vAcc; 
+}
 
-    // Initiate the transmission and send the data 
-    i2c_status |= m8q_start_trans(I2C_W_OFFSET); 
-    i2c_status |= i2c_write(m8q_driver_data.i2c, data, data_size); 
 
-    return i2c_status; 
+// Get NED north velocity (mm/s) 
+int32_t m8q_get_nav_vel_n(void)
+{
+    return m8q_driver_data.nav_data.velN; 
 }
 
 
-// Start an I2C transmission 
-I2C_STATUS m8q_start_trans(i2c_rw_offset_t offset)
+// Get NED east velocity (mm/s) 
+int32_t m8q_get_nav_vel_e(void)
 {
-    I2C_STATUS i2c_status = I2C_OK; 
+    return m8q_driver_data.nav_data.velE; 
+}
 
-    // Generate a start condition then send the device address with a read or write 
-    // offset. 
-    i2c_status |= i2c_start(m8q_driver_data.i2c); 
-    i2c_status |= i2c_write_addr(m8q_driver_data.i2c, M8Q_I2C_8_BIT_ADDR + offset); 
-    i2c_clear_addr(m8q_driver_data.i2c); 
 
-    return i2c_status;  
+// Get NED down velocity (mm/s) 
+int32_t m8q_get_nav_vel_d(void)
+{
+    return m8q_driver_data.nav_data.velD; 
 }
 
-//=======================================================================================
 
+// Get ground speed (mm/s) 
+int32_t m8q_get_nav_gspeed(void)
+{
+    return m8q_driver_data.nav_data.gSpeed; 
+}
 
-//=======================================================================================
-// Message processing 
 
-// Message identification 
+// Get heading of motion (degrees*10^5) 
+int32_t m8q_get_nav_head_mot(void)
+{
+    return m8q_driver_data.nav_data.headMot; 
+}
+
+
+// Get speed accuracy estimate (mm/s) 
+uint32_t m8q_get_nav_sacc(void)
+{
+    return m8q_driver_data.nav_data.sAcc; 
+}
+
+
+// Get position DOP (*0.01) 
+uint16_t m8q_get_nav_pdop(void)
+{
+    return m8q_driver_data.nav_data.pDOP; 
+}
+
+
+// Get horizontal DOP (*0.01) 
+uint16_t m8q_get_nav_hdop(void)
+{
+    return m8q_driver_data.nav_data.hDOP; 
+}
+
+
+// Get vertical DOP (*0.01) 
+uint16_t m8q_get_nav_vdop(void)
+{
+    return m8q_driver_data.nav_data.vDOP; 
+}
+
+
+// Get time to first fix (ms) 
+uint32_t m8q_get_nav_ttff(void)
+{
+    return m8q_driver_data.nav_data.ttff; 
+}
+
+
+// Get milliseconds since startup/reset 
+uint32_t m8q_get_nav_msss(void)
+{
+    return m8q_driver_data.nav_data.msss; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Snapshot 
+
+// Get a consistent copy of the latest position, time and accuracy data 
+M8Q_STATUS m8q_get_snapshot(m8q_snapshot_t *snapshot)
+{
+    if (snapshot == NULL)
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    const m8q_snapshot_buff_t *buff; 
+    uint32_t write_count; 
+
+    // Copy again if the buffer was being written or was written during the copy 
+    do
+    {
+        buff = &m8q_driver_data.snapshot[m8q_driver_data.snapshot_index]; 
+        write_count = buff->write_count; 
+        M8Q_MEMORY_BARRIER(); 
+        *snapshot = buff->data; 
+        M8Q_MEMORY_BARRIER(); 
+    }
+    while ((write_count & SET_BIT) || (write_count != buff->write_count)); 
+
+    return M8Q_OK; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// RTCM corrections 
+
+// RTCM3 passthrough initialization 
+M8Q_STATUS m8q_rtcm_init(
+    m8q_rtcm_t *rtcm, 
+    const cb_index_t *cb_index)
+{
+    if ((rtcm == NULL) || (cb_index == NULL))
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    memset((void *)rtcm, CLEAR, sizeof(m8q_rtcm_t)); 
+    rtcm->scan = cb_index->tail; 
+
+    return M8Q_OK; 
+}
+
+
+// Forward RTCM3 correction frames to the device 
+M8Q_STATUS m8q_rtcm_forward(
+    m8q_rtcm_t *rtcm, 
+    const uint8_t *circular_buff, 
+    cb_index_t *cb_index, 
+    uint8_t max_chunk)
+{
+    if ((rtcm == NULL) || (circular_buff == NULL) || (cb_index == NULL))
+    {
+        return M8Q_INVALID_PTR; 
+    }
+
+    if ((cb_index->head >= cb_index->cb_size) || (rtcm->scan >= cb_index->cb_size))
+    {
+        return M8Q_INVALID_CONFIG; 
+    }
+
+    M8Q_STATUS forward_status = M8Q_OK; 
+    uint8_t rtcm_byte; 
+
+    max_chunk = (!max_chunk) ? HIGH_8BIT : max_chunk; 
+    max_chunk = (max_chunk < RTCM_MIN_CHUNK) ? RTCM_MIN_CHUNK : max_chunk; 
+
+    while (rtcm->scan != cb_index->head)
+    {
+        rtcm_byte = circular_buff[rtcm->scan]; 
+
+        if (++rtcm->scan >= cb_index->cb_size)
+        {
+            rtcm->scan = CLEAR; 
+        }
+
+        // Look for the start of a frame 
+        if (!rtcm->frame_count)
+        {
+            if (rtcm_byte == RTCM_PREAMBLE)
+            {
+                rtcm->frame_start = (rtcm->scan) ? (rtcm->scan - BYTE_1) : 
+                                                   (cb_index->cb_size - BYTE_1); 
+                rtcm->frame_count = BYTE_1; 
+                rtcm->crc = rtcm_crc24q_table[rtcm_byte]; 
+            }
+            else 
+            {
+                rtcm->skipped++; 
+                forward_status |= M8Q_UNKNOWN_DATA; 
+            }
+            continue; 
+        }
+
+        // The CRC of a frame that includes its own CRC bytes is zero if it's valid 
+        rtcm->crc = ((rtcm->crc << SHIFT_8) ^ 
+                     rtcm_crc24q_table[((rtcm->crc >> RTCM_CRC_SHIFT) ^ rtcm_byte) & 
+                                       HIGH_8BIT]) & RTCM_CRC_MASK; 
+        rtcm->frame_count++; 
+
+        if (rtcm->frame_count == BYTE_2)
+        {
+            // Reserved bits that aren't zero mean the preamble was just a data byte 
+            if (rtcm_byte & RTCM_RESERVED)
+            {
+                rtcm->skipped++; 
+                rtcm->frame_count = CLEAR; 
+                rtcm->scan = rtcm->frame_start; 
+                forward_status |= M8Q_UNKNOWN_DATA; 
+
+                if (++rtcm->scan >= cb_index->cb_size)
+                {
+                    rtcm->scan = CLEAR; 
+                }
+                continue; 
+            }
+
+            rtcm->frame_len = (uint16_t)(rtcm_byte & RTCM_LEN_HI) << SHIFT_8; 
+        }
+        else if (rtcm->frame_count == M8Q_RTCM_HEADER_LEN)
+        {
+            rtcm->frame_len = (rtcm->frame_len | rtcm_byte) + 
+                              M8Q_RTCM_HEADER_LEN + M8Q_RTCM_CRC_LEN; 
+        }
+        else if (rtcm->frame_count == rtcm->frame_len)
+        {
+            rtcm->frame_count = CLEAR; 
+
+            if (!rtcm->crc)
+            {
+                rtcm->frames++; 
+                forward_status |= m8q_rtcm_write(circular_buff, cb_index->cb_size, 
+                                                 rtcm->frame_start, rtcm->frame_len, 
+                                                 max_chunk); 
+            }
+            else 
+            {
+                // Search again from the byte after the bad frame preamble 
+                rtcm->bad_crc++; 
+                rtcm->scan = rtcm->frame_start; 
+                forward_status |= M8Q_BAD_CHECKSUM; 
+
+                if (++rtcm->scan >= cb_index->cb_size)
+                {
+                    rtcm->scan = CLEAR; 
+                }
+            }
+        }
+    }
+
+    // Bytes of a partly received frame are still needed 
+    cb_index->tail = (rtcm->frame_count) ? rtcm->frame_start : rtcm->scan; 
+
+    return forward_status; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// NMEA message helper functions 
+
+// Convert a coordinate string to scaled integer degrees 
+int32_t m8q_coord_str_convert(
+    const uint8_t *coord_str, 
+    uint8_t deg_digits)
+{
+    // Coordinates are formatted as D..DMM.MMMMM where 'D' is a degrees digit and 'M' is 
+    // a minutes digit. All the digits are read into one number (D..DMMMMMMM) which is 
+    // then split into degrees and scaled minutes. The minutes get converted to the 
+    // fractional part of the degrees and scaled so all decimal places are accounted for. 
+    int32_t coord = CLEAR; 
+    uint8_t str_end = FALSE; 
+
+    for (uint8_t i = CLEAR; i < (deg_digits + COORD_MIN_LEN); i++)
+    {
+        // Bypass the decimal point character 
+        if (i == (deg_digits + BYTE_2))
+        {
+            continue; 
+        }
+
+        if (coord_str[i] == NULL_CHAR)
+        {
+            str_end = TRUE; 
+        }
+
+        coord = coord*SCALE_10 + (str_end ? CLEAR : (int32_t)(coord_str[i] - NUM_TO_CHAR_OFFSET)); 
+    }
+
+    return (coord / COORD_MIN_SCALE)*DEG_SCALE + 
+           (coord % COORD_MIN_SCALE)*SCALE_100 / MIN_TO_DEG; 
+}
+
+
+// Parse a numeric value from NMEA messages 
+int32_t m8q_nmea_num_parse(
+    uint8_t *data_buff,
+    uint8_t data_buff_size)
+{
+    uint8_t index = CLEAR, num_char, sign = CLEAR_BIT;
+    int32_t integer = CLEAR;
+
+    if (data_buff == NULL)
+    {
+        return integer; 
+    }
+
+    // Digits are accumulated as they're read. The decimal point is skipped so the value 
+    // keeps its decimal places as an implied scale (ex. "12.34" --> 1234). 
+    while ((index < data_buff_size) && (data_buff[index] != NULL_CHAR))
+    {
+        num_char = data_buff[index++]; 
+
+        switch (num_char)
+        {
+            case MINUS_CHAR:
+                sign = SET_BIT;
+                break;
+
+            case PERIOD_CHAR:
+                break;
+
+            default:
+                integer = integer*SCALE_10 + (int32_t)(num_char - NUM_TO_CHAR_OFFSET);
+                break;
+        }
+    }
+
+    if (sign == SET_BIT)
+    {
+        integer = -integer;
+    }
+
+    return integer;
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Read and write 
+
+// Flush/clear the M8Q data stream 
+M8Q_STATUS m8q_flush_ds(uint16_t stream_len)
+{
+    I2C_STATUS i2c_status = I2C_OK; 
+
+    // Initiate the transmission then get the data stream without storing any data 
+    i2c_status |= m8q_start_trans(I2C_R_OFFSET); 
+    i2c_status |= i2c_clear(m8q_driver_data.i2c, stream_len); 
+
+    if (i2c_status)
+    {
+        return M8Q_READ_FAULT; 
+    }
+
+    return M8Q_DATA_BUFF_OVERFLOW; 
+}
+
+
+// Send a configuration message and check for an ACK 
+M8Q_STATUS m8q_config_msg(
+    const char *config_msg, 
+    uint8_t max_msg_size)
+{
+    M8Q_STATUS config_status; 
+
+    config_status = m8q_send_msg(config_msg, max_msg_size); 
+
+    // Only UBX CFG messages get an ACK response. m8q_send_msg has already checked the 
+    // message format so the class characters are valid. 
+    if (config_status || 
+        (m8q_msg_key(config_msg, BYTE_4) != UBX_SYNC_KEY) || 
+        (ubx_config_byte_convert(config_msg + BYTE_5) != UBX_CLASS_CFG))
+    {
+        return config_status; 
+    }
+
+    return m8q_config_ack(); 
+}
+
+
+// Wait for a configuration message ACK 
+M8Q_STATUS m8q_config_ack(void)
+{
+    uint16_t ack_status; 
+    uint8_t ack_timeout = ACK_TIMEOUT; 
+
+    do
+    {
+        if (!m8q_read_data())
+        {
+            ack_status = m8q_get_ack_status(); 
+
+            if (ack_status && (ack_status <= HIGH_8BIT))
+            {
+                return M8Q_OK; 
+            }
+        }
+    }
+    while (--ack_timeout); 
+
+    return M8Q_INVALID_CONFIG; 
+}
+
+
+// Read the M8Q data stream and store the data 
+M8Q_STATUS m8q_read_sort_ds(uint16_t stream_len)
+{
+    M8Q_STATUS read_status = M8Q_OK; 
+    uint16_t read_len; 
+
+    // Read the data stream in pieces that fit in the stream buffer and parse each piece. 
+    // The device continues the stream from where the last read stopped. 
+    while (stream_len)
+    {
+        read_len = (stream_len > M8Q_STREAM_BUFF_SIZE) ? M8Q_STREAM_BUFF_SIZE : stream_len; 
+
+        if (m8q_read(m8q_driver_data.stream_buff, read_len))
+        {
+            return read_status | M8Q_READ_FAULT; 
+        }
+
+        read_status |= m8q_parse_data(m8q_driver_data.stream_buff, read_len); 
+        stream_len -= read_len; 
+    }
+
+    return read_status; 
+}
+
+
+// Read data from the device 
+I2C_STATUS m8q_read(
+    uint8_t *data_buff, 
+    uint16_t data_size)
+{
+    I2C_STATUS i2c_status = I2C_OK; 
+
+    // Initiate the transmission then read the data 
+    i2c_status |= m8q_start_trans(I2C_R_OFFSET); 
+    i2c_status |= i2c_read(m8q_driver_data.i2c, data_buff, data_size); 
+
+    return i2c_status; 
+}
+
+
+// Send a formatted message to the device 
+M8Q_STATUS m8q_write_msg(
+    const void *msg, 
+    uint8_t msg_size)
+{
+    I2C_STATUS i2c_status = I2C_OK; 
+
+    // Send the message to the device and generate a stop condition when done. 
+    i2c_status |= m8q_write((uint8_t *)msg, msg_size); 
+    i2c_stop(m8q_driver_data.i2c); 
+
+    if (i2c_status)
+    {
+        return M8Q_WRITE_FAULT; 
+    }
+
+    return M8Q_OK; 
+}
+
+
+// Write data to the device 
+I2C_STATUS m8q_write(
+    const uint8_t *data, 
+    uint8_t data_size)
+{
+    I2C_STATUS i2c_status = I2C_OK; 
+
+    // Initiate the transmission and send the data 
+    i2c_status |= m8q_start_trans(I2C_W_OFFSET); 
+    i2c_status |= i2c_write(m8q_driver_data.i2c, data, data_size); 
+
+    return i2c_status; 
+}
+
+
+// Start an I2C transmission 
+I2C_STATUS m8q_start_trans(i2c_rw_offset_t offset)
+{
+    I2C_STATUS i2c_status = I2C_OK; 
+
+    // Generate a start condition then send the device address with a read or write 
+    // offset. 
+    i2c_status |= i2c_start(m8q_driver_data.i2c); 
+    i2c_status |= i2c_write_addr(m8q_driver_data.i2c, M8Q_I2C_8_BIT_ADDR + offset); 
+    i2c_clear_addr(m8q_driver_data.i2c); 
+
+    return i2c_status;  
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Message processing 
+
+// Message identification 
 M8Q_MSG_TYPE m8q_msg_id(
     const char *msg, 
     uint8_t *msg_offset)
 {
-    uint8_t msg_index = CLEAR; 
-    uint8_t id_check_status = CLEAR; 
+    const nmea_msg_data_t *msg_data = NULL; 
+
+    // Check for the start of an NMEA message 
+    if (*msg == NMEA_START)
+    {
+        // Check for a PUBX message ID then the PUBX message format, otherwise check for 
+        // a standard NMEA talker ID then the standard message formatter. 
+        if (m8q_msg_key(msg + BYTE_1, BYTE_4) == NMEA_PUBX_KEY)
+        {
+            msg_data = m8q_nmea_pubx_lookup(m8q_msg_key(msg + BYTE_6, BYTE_2)); 
+            *msg_offset = BYTE_8; 
+        }
+        else if (m8q_nmea_talker_check(m8q_msg_key(msg + BYTE_1, BYTE_2)))
+        {
+            msg_data = m8q_nmea_std_lookup(m8q_msg_key(msg + BYTE_3, BYTE_3)); 
+            *msg_offset = BYTE_6; 
+        }
+
+        if (msg_data != NULL)
+        {
+            nmea_msg_target = *msg_data; 
+            return M8Q_MSG_NMEA; 
+        }
+    }
+    // Check for the start of a UBX config message and a valid UBX class string 
+    else if (m8q_msg_key(msg, BYTE_4) == UBX_SYNC_KEY)
+    {
+        if (ubx_config_valid_char(*(msg + BYTE_5)) && 
+            ubx_config_valid_char(*(msg + BYTE_6)) && 
+            m8q_ubx_class_check(ubx_config_byte_convert(msg + BYTE_5)))
+        {
+            return M8Q_MSG_UBX; 
+        }
+    }
+    // Check for the start of a received UBX message and a valid UBX class byte 
+    else if (((uint8_t)*msg == UBX_SYNC_CHAR_1) && ((uint8_t)*(msg + BYTE_1) == UBX_SYNC_CHAR_2))
+    {
+        if (m8q_ubx_class_check((uint8_t)*(msg + BYTE_2)))
+        {
+            return M8Q_MSG_UBX; 
+        }
+    }
+
+    return M8Q_MSG_INVALID; 
+}
+
+
+// Pack message characters into a message ID key 
+uint32_t m8q_msg_key(
+    const char *msg, 
+    uint8_t num_chars)
+{
+    uint32_t msg_key = CLEAR; 
+
+    while (num_chars--)
+    {
+        msg_key <<= SHIFT_8; 
+
+        if (*msg != NULL_CHAR)
+        {
+            msg_key |= (uint8_t)*msg++; 
+        }
+    }
+
+    return msg_key; 
+}
+
+
+// NMEA PUBX message lookup 
+const nmea_msg_data_t *m8q_nmea_pubx_lookup(uint32_t msg_key)
+{
+    switch (msg_key)
+    {
+        case MSG_KEY2('0', '0'): 
+            return &nmea_pubx_msgs[NMEA_PUBX_POSITION]; 
+        case MSG_KEY2('0', '3'): 
+            return &nmea_pubx_msgs[NMEA_PUBX_SVSTATUS]; 
+        case MSG_KEY2('0', '4'): 
+            return &nmea_pubx_msgs[NMEA_PUBX_TIME]; 
+        case MSG_KEY2('4', '0'): 
+            return &nmea_pubx_msgs[NMEA_PUBX_RATE]; 
+        case MSG_KEY2('4', '1'): 
+            return &nmea_pubx_msgs[NMEA_PUBX_CONFIG]; 
+        default: 
+            return NULL; 
+    }
+}
+
+
+// NMEA talker ID check 
+uint8_t m8q_nmea_talker_check(uint32_t talker_key)
+{
+    switch (talker_key)
+    {
+        case MSG_KEY2('G', 'P'):   // GPS, SBAS, QZSS 
+        case MSG_KEY2('G', 'L'):   // GLONASS 
+        case MSG_KEY2('G', 'A'):   // Galileo 
+        case MSG_KEY2('G', 'B'):   // BeiDou 
+        case MSG_KEY2('G', 'N'):   // Any combination of GNSS 
+            return TRUE; 
+        default: 
+            return FALSE; 
+    }
+}
+
+
+// NMEA standard message lookup 
+const nmea_msg_data_t *m8q_nmea_std_lookup(uint32_t msg_key)
+{
+    nmea_std_msg_t msg_index; 
+
+    switch (msg_key)
+    {
+        case MSG_KEY3('D', 'T', 'M'): msg_index = NMEA_STD_DTM; break; 
+        case MSG_KEY3('G', 'B', 'Q'): msg_index = NMEA_STD_GBQ; break; 
+        case MSG_KEY3('G', 'B', 'S'): msg_index = NMEA_STD_GBS; break; 
+        case MSG_KEY3('G', 'G', 'A'): msg_index = NMEA_STD_GGA; break; 
+        case MSG_KEY3('G', 'L', 'L'): msg_index = NMEA_STD_GLL; break; 
+        case MSG_KEY3('G', 'L', 'Q'): msg_index = NMEA_STD_GLQ; break; 
+        case MSG_KEY3('G', 'N', 'Q'): msg_index = NMEA_STD_GNQ; break; 
+        case MSG_KEY3('G', 'N', 'S'): msg_index = NMEA_STD_GNS; break; 
+        case MSG_KEY3('G', 'P', 'Q'): msg_index = NMEA_STD_GPQ; break; 
+        case MSG_KEY3('G', 'R', 'S'): msg_index = NMEA_STD_GRS; break; 
+        case MSG_KEY3('G', 'S', 'A'): msg_index = NMEA_STD_GSA; break; 
+        case MSG_KEY3('G', 'S', 'T'): msg_index = NMEA_STD_GST; break; 
+        case MSG_KEY3('G', 'S', 'V'): msg_index = NMEA_STD_GSV; break; 
+        case MSG_KEY3('R', 'M', 'C'): msg_index = NMEA_STD_RMC; break; 
+        case MSG_KEY3('T', 'H', 'S'): msg_index = NMEA_STD_THS; break; 
+        case MSG_KEY3('T', 'X', 'T'): msg_index = NMEA_STD_TXT; break; 
+        case MSG_KEY3('V', 'L', 'W'): msg_index = NMEA_STD_VLW; break; 
+        case MSG_KEY3('V', 'T', 'G'): msg_index = NMEA_STD_VTG; break; 
+        case MSG_KEY3('Z', 'D', 'A'): msg_index = NMEA_STD_ZDA; break; 
+        default: 
+            return NULL; 
+    }
+
+    return &nmea_std_msgs[msg_index]; 
+}
+
+
+// UBX message class check 
+uint8_t m8q_ubx_class_check(uint8_t msg_class)
+{
+    switch (msg_class)
+    {
+        case UBX_CLASS_NAV: 
+        case UBX_CLASS_RXM: 
+        case UBX_CLASS_INF: 
+        case UBX_CLASS_ACK: 
+        case UBX_CLASS_CFG: 
+        case UBX_CLASS_UPD: 
+        case UBX_CLASS_MON: 
+        case UBX_CLASS_AID: 
+        case UBX_CLASS_TIM: 
+        case UBX_CLASS_ESF: 
+        case UBX_CLASS_MGA: 
+        case UBX_CLASS_LOG: 
+        case UBX_CLASS_SEC: 
+        case UBX_CLASS_HNR: 
+            return TRUE; 
+        default: 
+            return FALSE; 
+    }
+}
+
+
+// Parse a single data stream byte 
+M8Q_STATUS m8q_parse_byte(uint8_t msg_byte)
+{
+    M8Q_STATUS parse_status = M8Q_OK; 
+
+    switch (m8q_driver_data.parse.state)
+    {
+        case M8Q_PARSE_NMEA_ID: 
+            parse_status = m8q_nmea_msg_id(msg_byte); 
+            break; 
+
+        case M8Q_PARSE_NMEA_FIELDS: 
+        case M8Q_PARSE_NMEA_SKIP: 
+            // A new message start means the current message was cut short 
+            if (msg_byte == NMEA_START)
+            {
+                m8q_driver_data.msg_stats[m8q_driver_data.parse.stats_type].truncated++; 
+                parse_status = m8q_msg_start(msg_byte); 
+            }
+            else 
+            {
+                m8q_nmea_msg_parse(msg_byte); 
+            }
+            break; 
+
+        case M8Q_PARSE_NMEA_CHECKSUM: 
+            parse_status = m8q_nmea_msg_checksum(msg_byte); 
+            break; 
+
+        case M8Q_PARSE_NMEA_END: 
+            // The message is done once the line feed character is seen 
+            if (msg_byte == NL_CHAR)
+            {
+                m8q_driver_data.parse.state = M8Q_PARSE_START; 
+            }
+            else if (msg_byte == NMEA_START)
+            {
+                parse_status = m8q_msg_start(msg_byte); 
+            }
+            break; 
+
+        case M8Q_PARSE_UBX_SYNC: 
+            if (msg_byte == UBX_SYNC_CHAR_2)
+            {
+                m8q_driver_data.parse.id_buff[m8q_driver_data.parse.id_index++] = msg_byte; 
+                m8q_driver_data.parse.state = M8Q_PARSE_UBX_HEADER; 
+            }
+            else 
+            {
+                // Not a UBX message - the byte could still be the start of a message 
+                m8q_driver_data.parse.state = M8Q_PARSE_START; 
+                parse_status = M8Q_UNKNOWN_DATA | m8q_msg_start(msg_byte); 
+            }
+            break; 
+
+        case M8Q_PARSE_UBX_HEADER: 
+            parse_status = m8q_ubx_msg_id(msg_byte); 
+            break; 
+
+        case M8Q_PARSE_UBX_PAYLOAD: 
+            parse_status = m8q_ubx_msg_parse(msg_byte); 
+            break; 
+
+        default: 
+            parse_status = m8q_msg_start(msg_byte); 
+            break; 
+    }
+
+    return parse_status; 
+}
+
+
+// Look for the start of a message 
+M8Q_STATUS m8q_msg_start(uint8_t msg_byte)
+{
+    m8q_driver_data.parse.id_index = CLEAR; 
+    m8q_driver_data.parse.ck_a = CLEAR; 
+    m8q_driver_data.parse.ck_b = CLEAR; 
+
+    if (msg_byte == NMEA_START)
+    {
+        m8q_driver_data.parse.state = M8Q_PARSE_NMEA_ID; 
+    }
+    else if (msg_byte == UBX_SYNC_CHAR_1)
+    {
+        m8q_driver_data.parse.state = M8Q_PARSE_UBX_SYNC; 
+    }
+    else 
+    {
+        m8q_driver_data.parse.state = M8Q_PARSE_START; 
+        return M8Q_UNKNOWN_DATA; 
+    }
+
+    m8q_driver_data.parse.id_buff[m8q_driver_data.parse.id_index++] = msg_byte; 
+
+    return M8Q_OK; 
+}
+
+
+// Incoming NMEA message identification 
+M8Q_STATUS m8q_nmea_msg_id(uint8_t msg_byte)
+{
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+    uint8_t msg_offset = CLEAR; 
 
-    // Check for the start of an NMEA message 
-    if (*msg == nmea_msg_start)
+    // The NMEA checksum covers everything between the '$' and the '*' 
+    parse->id_buff[parse->id_index++] = msg_byte; 
+    parse->ck_a ^= msg_byte; 
+
+    // The address field can only be checked once a full field has been seen. PUBX 
+    // messages need two fields (ex. "$PUBX,00,") and standard messages need one (ex. 
+    // "$GNGGA,"). The message is identified when the byte following the address field 
+    // is the next byte to be read. 
+    if (msg_byte == COMMA_CHAR)
     {
-        // Check for a PUBX message ID 
-        if (str_compare(nmea_pubx_msg_id, msg, BYTE_1))
+        parse->id_buff[parse->id_index] = NULL_CHAR; 
+
+        if ((m8q_msg_id((char *)parse->id_buff, &msg_offset) == M8Q_MSG_NMEA) && 
+            ((msg_offset + BYTE_1) == parse->id_index))
         {
-            // Check for a valid PUBX message format 
-            id_check_status = m8q_msg_id_check(msg, 
-                                               (void *)nmea_pubx_msgs, 
-                                               NMEA_PUBX_NUM_MSGS, 
-                                               sizeof(nmea_msg_format_t), 
-                                               BYTE_6, 
-                                               &msg_index); 
-            if (id_check_status)
+            parse->num_param = nmea_msg_target.num_param; 
+            parse->msg_data = nmea_msg_target.msg_data; 
+            parse->data_index = CLEAR; 
+            parse->param_index = CLEAR; 
+            parse->stage_len = CLEAR; 
+            parse->field_valid = CLEAR; 
+            parse->field_buff = (uint8_t *)&parse->nmea_stage; 
+
+            // Check if the message has a data record in the driver. If not, then skip 
+            // the message payload. Stored messages start from the current values so 
+            // fields that aren't in the message keep their value. 
+            if (parse->msg_data == position)
             {
-                *msg_offset = BYTE_8; 
-                nmea_msg_target.num_param = nmea_pubx_msgs[msg_index].nmea_msg_data.num_param; 
-                nmea_msg_target.msg_data = nmea_pubx_msgs[msg_index].nmea_msg_data.msg_data; 
-
-                return M8Q_MSG_NMEA; 
+                parse->value_stage.pos = m8q_driver_data.pos_value; 
+                parse->stats_type = M8Q_STATS_POSITION; 
             }
-        }
-        else 
-        {
-            // Check for a standard NMEA message ID 
-            id_check_status = m8q_msg_id_check(msg, 
-                                               (void *)&nmea_std_msg_id[0][0], 
-                                               NMEA_STD_ID_NUM, 
-                                               NMEA_STD_ID_LEN, 
-                                               BYTE_1, 
-                                               &msg_index); 
-            if (id_check_status)
+            else if (parse->msg_data == time)
             {
-                // Check for a valid standard NMEA message format 
-                id_check_status = m8q_msg_id_check(msg, 
-                                                   (void *)nmea_std_msgs, 
-                                                   NMEA_STD_NUM_MSGS, 
-                                                   sizeof(nmea_msg_format_t), 
-                                                   BYTE_3, 
-                                                   &msg_index); 
-                if (id_check_status)
-                {
-                    *msg_offset = BYTE_6; 
-                    nmea_msg_target.num_param = nmea_std_msgs[msg_index].nmea_msg_data.num_param; 
-                    nmea_msg_target.msg_data = nmea_std_msgs[msg_index].nmea_msg_data.msg_data; 
+                parse->value_stage.time = m8q_driver_data.time_value; 
+                parse->stats_type = M8Q_STATS_TIME; 
+            }
+            else 
+            {
+                parse->stats_type = M8Q_STATS_NMEA; 
+            }
 
-                    return M8Q_MSG_NMEA; 
-                }
+            if (parse->msg_data == NULL)
+            {
+                parse->state = M8Q_PARSE_NMEA_SKIP; 
+            }
+            else 
+            {
+                parse->param_len = parse->msg_data[BYTE_1] - parse->msg_data[BYTE_0]; 
+                parse->state = M8Q_PARSE_NMEA_FIELDS; 
             }
+
+            return M8Q_OK; 
         }
     }
-    // Check for the start of a UBX config message 
-    else if (str_compare(ubx_msg_sync_str, msg, BYTE_0))
-    {
-        // Check for a valid UBX class string 
-        id_check_status = m8q_msg_id_check(msg, 
-                                           (void *)ubx_msg_class[0].ubx_msg_class_str, 
-                                           UBX_CLASS_NUM, 
-                                           sizeof(ubx_msg_class_t), 
-                                           BYTE_5, 
-                                           &msg_index); 
-        if (id_check_status)
+
+    if (parse->id_index >= NMEA_ID_MAX_LEN)
+    {
+        m8q_driver_data.msg_stats[M8Q_STATS_NMEA].unknown++; 
+        parse->state = M8Q_PARSE_START; 
+        return M8Q_UNKNOWN_DATA; 
+    }
+
+    return M8Q_OK; 
+}
+
+
+// Incoming NMEA message parse 
+void m8q_nmea_msg_parse(uint8_t msg_byte)
+{
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+    uint8_t **data = parse->msg_data; 
+
+    // Check for the end of the NMEA message parameters 
+    if (msg_byte == AST_CHAR)
+    {
+        // End of message parameters seen. Finish the last field and read the checksum. 
+        if (parse->state == M8Q_PARSE_NMEA_FIELDS)
         {
-            return M8Q_MSG_UBX; 
+            m8q_nmea_field_end(); 
         }
+
+        parse->ck_rx = CLEAR; 
+        parse->ck_index = CLEAR; 
+        parse->state = M8Q_PARSE_NMEA_CHECKSUM; 
+        return; 
+    }
+
+    // The end of the line before a checksum means the message was cut short 
+    if (msg_byte == NL_CHAR)
+    {
+        m8q_driver_data.msg_stats[parse->stats_type].truncated++; 
+        parse->state = M8Q_PARSE_START; 
+        return; 
+    }
+
+    parse->ck_a ^= msg_byte; 
+
+    if (parse->state == M8Q_PARSE_NMEA_SKIP)
+    {
+        return; 
     }
-    // Check for the start of a received UBX message 
-    else if (str_compare((char *)ubx_msg_sync_data, msg, BYTE_0))
-    {
-        // Check for a valid UBX class byte 
-        id_check_status = m8q_msg_id_check(msg, 
-                                           (void *)&ubx_msg_class[0].ubc_msg_class_data, 
-                                           UBX_CLASS_NUM, 
-                                           sizeof(ubx_msg_class_t), 
-                                           BYTE_2, 
-                                           &msg_index); 
-        if (id_check_status)
+
+    // Check for a comma - a comma is the separation between parameters 
+    if (msg_byte == COMMA_CHAR)
+    {
+        // End of message parameter. Proceed to check of there are any remainding 
+        // parameters to fill. 
+        m8q_nmea_field_end(); 
+
+        if (++parse->data_index >= parse->num_param)
         {
-            return M8Q_MSG_UBX; 
+            parse->state = M8Q_PARSE_NMEA_SKIP; 
+            return; 
         }
-    }
 
-    return M8Q_MSG_INVALID; 
+        // If there are additional parameters to store then get the next parameter 
+        // storage size and staging location and reset the parameter index. 
+        parse->param_index = CLEAR; 
+        parse->param_len = data[parse->data_index + BYTE_1] - data[parse->data_index]; 
+        parse->field_buff = (uint8_t *)&parse->nmea_stage + 
+                            (data[parse->data_index] - data[BYTE_0]); 
+    }
+    // Message parameter byte seen. Store the byte in the staging buffer if there is room 
+    // for it (so not to exceed parameter allocated memory). 
+    else if (parse->param_index < parse->param_len)
+    {
+        parse->field_buff[parse->param_index++] = msg_byte; 
+    }
 }
 
 
-// Message identification helper function 
-uint8_t m8q_msg_id_check(
-    const char *msg, 
-    const void *ref_msg, 
-    uint8_t num_compare, 
-    uint8_t max_size, 
-    uint8_t offset, 
-    uint8_t *msg_index)
+// Incoming NMEA message checksum 
+M8Q_STATUS m8q_nmea_msg_checksum(uint8_t msg_byte)
 {
-    for (uint8_t i = CLEAR; i < num_compare; i++)
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+    m8q_msg_stats_t *stats = &m8q_driver_data.msg_stats[parse->stats_type]; 
+
+    if (msg_byte == NMEA_START)
+    {
+        stats->truncated++; 
+        return m8q_msg_start(msg_byte); 
+    }
+
+    if (ubx_config_valid_char((char)msg_byte))
     {
-        if (str_compare((char *)ref_msg + i*max_size, msg, offset))
+        parse->ck_rx = (parse->ck_rx << SHIFT_4) | 
+                       ((msg_byte <= NINE_CHAR) ? (msg_byte - NUM_TO_CHAR_OFFSET) : 
+                                                  (msg_byte - HEX_TO_LET_CHAR)); 
+
+        if (++parse->ck_index < BYTE_2)
         {
-            *msg_index = i; 
-            return TRUE; 
+            return M8Q_OK; 
+        }
+
+        if (parse->ck_rx == parse->ck_a)
+        {
+            m8q_nmea_msg_end(); 
+            stats->accepted++; 
+            parse->state = M8Q_PARSE_NMEA_END; 
+            return M8Q_OK; 
         }
     }
 
-    return FALSE; 
+    stats->bad_checksum++; 
+    parse->state = M8Q_PARSE_NMEA_END; 
+
+    return M8Q_BAD_CHECKSUM; 
 }
 
 
-// Incoming NMEA message parse 
-void m8q_nmea_msg_parse(
-    const uint8_t *nmea_msg, 
-    uint16_t *stream_index, 
-    uint16_t stream_len, 
-    uint8_t arg_num, 
-    uint8_t **data)
-{
-    uint8_t param_index = CLEAR; 
-    uint8_t param_len = CLEAR; 
-    uint8_t data_index = CLEAR; 
-    uint8_t msg_byte = *nmea_msg; 
-
-    // Check if the message has a data record in the driver. If not, then count the length of 
-    // the message and return. 
-    if (data == NULL)
-    {
-        m8q_nmea_msg_count(nmea_msg, stream_index, stream_len); 
-        return; 
+// End of an NMEA message field 
+void m8q_nmea_field_end(void)
+{
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+
+    // If the message data is less than the memory allocated to store it then terminate 
+    // the data so old data is not mixed in. 
+    if (parse->param_index < parse->param_len)
+    {
+        parse->field_buff[parse->param_index] = NULL_CHAR; 
     }
 
-    // There is a data record to store the message. Offset the message to the first data 
-    // byte, get the length of the first data array to fill and start parsing the message 
-    // into it's data fields and storing them in the data record. 
-    param_len = data[data_index + BYTE_1] - data[data_index]; 
+    if (parse->param_index)
+    {
+        parse->field_valid |= (SET_BIT << parse->data_index); 
+    }
 
-    while ((*stream_index)++ < stream_len)
+    // Staged fields up to the end of this one get copied to the data record 
+    parse->stage_len = parse->msg_data[parse->data_index + BYTE_1] - parse->msg_data[BYTE_0]; 
+
+    // Convert the field now so getters don't have to 
+    if (parse->msg_data == position)
     {
-        // Check for the end of the NMEA message parameters 
-        if (msg_byte != AST_CHAR)
-        {
-            // Check for a comma - a comma is the separation between parameters 
-            if (msg_byte != COMMA_CHAR)
+        m8q_pos_field_decode(parse->data_index); 
+    }
+    else if (parse->msg_data == time)
+    {
+        m8q_time_field_decode(parse->data_index); 
+    }
+}
+
+
+// End of a stored NMEA message 
+void m8q_nmea_msg_end(void)
+{
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+
+    if (parse->msg_data == position)
+    {
+        memcpy((void *)&m8q_driver_data.pos_data, (void *)&parse->nmea_stage.pos, 
+               parse->stage_len); 
+        parse->value_stage.pos.valid = parse->field_valid; 
+        parse->value_stage.pos.seq++; 
+        m8q_driver_data.pos_value = parse->value_stage.pos; 
+        m8q_snapshot_publish(TRUE); 
+    }
+    else if (parse->msg_data == time)
+    {
+        memcpy((void *)&m8q_driver_data.time_data, (void *)&parse->nmea_stage.time, 
+               parse->stage_len); 
+        parse->value_stage.time.valid = (uint8_t)parse->field_valid; 
+        parse->value_stage.time.seq++; 
+        m8q_driver_data.time_value = parse->value_stage.time; 
+        m8q_snapshot_publish(FALSE); 
+    }
+}
+
+
+// POSITION message field decode 
+void m8q_pos_field_decode(uint8_t field)
+{
+    m8q_nmea_pos_t *pos_data = &m8q_driver_data.parse.nmea_stage.pos; 
+    m8q_pos_value_t *pos_value = &m8q_driver_data.parse.value_stage.pos; 
+
+    switch (field)
+    {
+        case POS_FIELD_LAT: 
+            pos_value->lat = m8q_coord_str_convert(pos_data->lat, BYTE_2); 
+            break; 
+
+        case POS_FIELD_NS: 
+            // The returned value is meant to be interpretted without needing the N/S 
+            // indicator so southern hemisphere coordinates are made negative. 
+            if (pos_data->NS[BYTE_0] == S_UP_CHAR)
             {
-                // Message parameter byte seen. Store the byte in the data record if there 
-                // is room for it (so not to exceed parameter allocated memory). 
-                if (param_index < param_len)
-                {
-                    data[data_index][param_index++] = msg_byte; 
-                }
+                pos_value->lat = -pos_value->lat; 
             }
-            else 
-            {
-                // End of message parameter. If the message data is less than the memory 
-                // allocated to store it then terminate the data so old data is not mixed 
-                // in. Proceed to check of there are any remainding parameters to fill. 
-                if (param_index < param_len)
-                {
-                    data[data_index][param_index] = NULL_CHAR; 
-                }
+            break; 
 
-                if (++data_index >= arg_num)
-                {
-                    m8q_nmea_msg_count(++nmea_msg, stream_index, stream_len); 
-                    break; 
-                }
+        case POS_FIELD_LON: 
+            pos_value->lon = m8q_coord_str_convert(pos_data->lon, BYTE_3); 
+            break; 
 
-                // If there are additional parameters to store then get the next parameter 
-                // storage size and reset the parameter index. 
-                param_index = CLEAR; 
-                param_len = data[data_index + BYTE_1] - data[data_index]; 
-            }
-        }
-        else 
-        {
-            // End of message parameters seen. If the message data is less than the memory 
-            // allocated to store it then terminate the data so old data is not mixed in. 
-            // Storing is done so check the remaining message bytes and exit the loop. 
-            if (param_index < param_len)
+        case POS_FIELD_EW: 
+            // Western hemisphere coordinates are made negative 
+            if (pos_data->EW[BYTE_0] == W_UP_CHAR)
             {
-                data[data_index][param_index] = NULL_CHAR; 
+                pos_value->lon = -pos_value->lon; 
             }
+            break; 
 
-            m8q_nmea_msg_count(++nmea_msg, stream_index, stream_len); 
+        case POS_FIELD_ALTREF: 
+            pos_value->altRef = m8q_nmea_num_parse(pos_data->altRef, sizeof(pos_data->altRef)); 
+            break; 
+
+        case POS_FIELD_NAVSTAT: 
+            pos_value->navStat = (pos_data->navStat[BYTE_0] == NULL_CHAR) ? CLEAR : 
+                                 (pos_data->navStat[BYTE_0] << SHIFT_8) | pos_data->navStat[BYTE_1]; 
+            break; 
+
+        case POS_FIELD_HACC: 
+            pos_value->hAcc = m8q_nmea_num_parse(pos_data->hAcc, sizeof(pos_data->hAcc)); 
             break; 
-        }
 
-        msg_byte = *(++nmea_msg); 
+        case POS_FIELD_VACC: 
+            pos_value->vAcc = m8q_nmea_num_parse(pos_data->vAcc, sizeof(pos_data->vAcc)); 
+            break; 
+
+        case POS_FIELD_SOG: 
+            pos_value->SOG = m8q_nmea_num_parse(pos_data->SOG, sizeof(pos_data->SOG)); 
+            break; 
+
+        case POS_FIELD_COG: 
+            pos_value->COG = m8q_nmea_num_parse(pos_data->COG, sizeof(pos_data->COG)); 
+            break; 
+
+        case POS_FIELD_VVEL: 
+            pos_value->vVel = m8q_nmea_num_parse(pos_data->vVel, sizeof(pos_data->vVel)); 
+            break; 
+
+        default: 
+            break; 
     }
 }
 
 
-// Incoming NMEA message counter 
-void m8q_nmea_msg_count(
-    const uint8_t *nmea_msg, 
-    uint16_t *stream_index, 
-    uint16_t stream_len)
+// TIME message field decode 
+void m8q_time_field_decode(uint8_t field)
 {
-    while ((*stream_index)++ < stream_len)
+    m8q_nmea_time_t *time_data = &m8q_driver_data.parse.nmea_stage.time; 
+    m8q_time_value_t *time_value = &m8q_driver_data.parse.value_stage.time; 
+
+    switch (field)
     {
-        if (*nmea_msg++ == NL_CHAR)
-        {
+        case TIME_FIELD_TIME: 
+            time_value->time = m8q_nmea_num_parse(time_data->time, sizeof(time_data->time)); 
+            break; 
+
+        case TIME_FIELD_DATE: 
+            time_value->date = m8q_nmea_num_parse(time_data->date, sizeof(time_data->date)); 
+            break; 
+
+        case TIME_FIELD_UTCTOW: 
+            time_value->utcTow = m8q_nmea_num_parse(time_data->utcTow, sizeof(time_data->utcTow)); 
+            break; 
+
+        case TIME_FIELD_UTCWK: 
+            time_value->utcWk = m8q_nmea_num_parse(time_data->utcWk, sizeof(time_data->utcWk)); 
+            break; 
+
+        default: 
             break; 
-        }
     }
 }
 
 
-// Incoming UBX message parse 
-void m8q_ubx_msg_parse(
-    const uint8_t *ubx_msg, 
-    uint16_t *stream_index, 
-    uint16_t stream_len)
+// Incoming UBX message identification 
+M8Q_STATUS m8q_ubx_msg_id(uint8_t msg_byte)
 {
-    uint16_t counter = BYTE_2; 
-    uint16_t max_count; 
-    uint16_t class_ID = (*ubx_msg << SHIFT_8) | *(ubx_msg + BYTE_1); 
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+    uint8_t msg_offset = CLEAR, store = FALSE; 
+    uint16_t class_ID, pl_len; 
+
+    parse->id_buff[parse->id_index++] = msg_byte; 
+
+    if (parse->id_index < UBX_HEADER_LEN)
+    {
+        return M8Q_OK; 
+    }
+
+    // The header is complete - check for a known message class 
+    if (m8q_msg_id((char *)parse->id_buff, &msg_offset) != M8Q_MSG_UBX)
+    {
+        m8q_driver_data.msg_stats[M8Q_STATS_UBX].unknown++; 
+        parse->state = M8Q_PARSE_START; 
+        return M8Q_UNKNOWN_DATA; 
+    }
+
+    // The UBX checksum covers the class, ID and length 
+    for (uint8_t i = BYTE_2; i < UBX_HEADER_LEN; i++)
+    {
+        m8q_ubx_checksum_add(parse->id_buff[i]); 
+    }
+
+    class_ID = (parse->id_buff[BYTE_2] << SHIFT_8) | parse->id_buff[BYTE_3]; 
+    pl_len = (uint16_t)parse->id_buff[BYTE_4] | ((uint16_t)parse->id_buff[BYTE_5] << SHIFT_8); 
 
-    // Check for an ACK or NAK message. 
-    // Right now the driver does not utilize received UBX messages other than for 
-    // acknowledging UBX config messages sent to the device so ACK and NAK messages are 
-    // checked for manually. If this changes then the method for checking for UBX 
-    // message types will also change. 
-    if (class_ID == ACK_ACK)
+    // NAV messages with a data record have their payload stored as long as the payload 
+    // is the expected length. All other payloads are skipped. 
+    switch (class_ID)
     {
-        m8q_driver_data.ack_msg_count++; 
+        case ACK_ACK: 
+        case ACK_NAK: 
+            parse->stats_type = M8Q_STATS_ACK; 
+            break; 
+
+        case NAV_PVT: 
+            parse->stats_type = M8Q_STATS_NAV_PVT; 
+            store = (pl_len == NAV_PVT_LEN); 
+            break; 
+
+        case NAV_STATUS: 
+            parse->stats_type = M8Q_STATS_NAV_STATUS; 
+            store = (pl_len == NAV_STATUS_LEN); 
+            break; 
+
+        case NAV_DOP: 
+            parse->stats_type = M8Q_STATS_NAV_DOP; 
+            store = (pl_len == NAV_DOP_LEN); 
+            break; 
+
+        default: 
+            parse->stats_type = M8Q_STATS_UBX; 
+            break; 
     }
-    else if (class_ID == ACK_NAK)
+
+    // A length larger than any message the device sends means the header is corrupted. 
+    // Skipping that many bytes would throw away the good messages that follow. 
+    if (pl_len > UBX_MAX_PAYLOAD_LEN)
     {
-        m8q_driver_data.nak_msg_count++; 
+        m8q_driver_data.msg_stats[parse->stats_type].unknown++; 
+        parse->state = M8Q_PARSE_START; 
+        return M8Q_UNKNOWN_DATA; 
     }
 
-    ubx_msg += BYTE_2; 
-    *stream_index += BYTE_4; 
-    max_count = ((*ubx_msg) | (*(ubx_msg + BYTE_1) << SHIFT_8)) + BYTE_4; 
+    parse->ubx_msg = class_ID; 
+    parse->ubx_store = store; 
+    parse->ubx_index = CLEAR; 
+    parse->ubx_count = pl_len + UBX_CHECKSUM_LEN; 
+    parse->state = M8Q_PARSE_UBX_PAYLOAD; 
+
+    return M8Q_OK; 
+}
+
+
+// Incoming UBX message parse 
+M8Q_STATUS m8q_ubx_msg_parse(uint8_t msg_byte)
+{
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+
+    parse->ubx_count--; 
 
-    while (*stream_index < stream_len)
+    // Payload byte. Store it if the message has a data record. The payload length was 
+    // checked against the buffer size when the message was identified. 
+    if (parse->ubx_count >= UBX_CHECKSUM_LEN)
     {
-        if (counter++ >= max_count)
+        m8q_ubx_checksum_add(msg_byte); 
+
+        if (parse->ubx_store)
         {
+            parse->ubx_payload[parse->ubx_index++] = msg_byte; 
+        }
+
+        return M8Q_OK; 
+    }
+
+    // CK_A 
+    if (parse->ubx_count)
+    {
+        parse->ck_rx = (msg_byte == parse->ck_a); 
+        return M8Q_OK; 
+    }
+
+    // CK_B - the message is done 
+    parse->state = M8Q_PARSE_START; 
+
+    if (parse->ck_rx && (msg_byte == parse->ck_b))
+    {
+        m8q_ubx_msg_end(); 
+        return M8Q_OK; 
+    }
+
+    m8q_driver_data.msg_stats[parse->stats_type].bad_checksum++; 
+
+    return M8Q_BAD_CHECKSUM; 
+}
+
+
+// End of a UBX message 
+void m8q_ubx_msg_end(void)
+{
+    m8q_stream_parse_t *parse = &m8q_driver_data.parse; 
+    m8q_msg_stats_t *stats = &m8q_driver_data.msg_stats[parse->stats_type]; 
+
+    switch (parse->ubx_msg)
+    {
+        case ACK_ACK: 
+            m8q_driver_data.ack_msg_count++; 
+            break; 
+
+        case ACK_NAK: 
+            m8q_driver_data.nak_msg_count++; 
+            break; 
+
+        case NAV_PVT: 
+        case NAV_STATUS: 
+        case NAV_DOP: 
+            // A NAV message that isn't the expected length can't be decoded 
+            if (!parse->ubx_store)
+            {
+                stats->unknown++; 
+                return; 
+            }
+            m8q_ubx_nav_decode(); 
+            m8q_snapshot_publish(parse->ubx_msg == NAV_PVT); 
+            break; 
+
+        default: 
             break; 
+    }
+
+    stats->accepted++; 
+}
+
+
+// Add a byte to the UBX message checksum 
+void m8q_ubx_checksum_add(uint8_t msg_byte)
+{
+    m8q_driver_data.parse.ck_a += msg_byte; 
+    m8q_driver_data.parse.ck_b += m8q_driver_data.parse.ck_a; 
+}
+
+
+// Publish a snapshot 
+void m8q_snapshot_publish(uint8_t new_fix)
+{
+    uint8_t published = m8q_driver_data.snapshot_index; 
+    uint8_t back = published ^ SET_BIT; 
+    m8q_snapshot_buff_t *buff = &m8q_driver_data.snapshot[back]; 
+
+    buff->write_count++; 
+    M8Q_MEMORY_BARRIER(); 
+
+    buff->data.seq = m8q_driver_data.snapshot[published].data.seq + 1; 
+    buff->data.pos = m8q_driver_data.pos_value; 
+    buff->data.time = m8q_driver_data.time_value; 
+    buff->data.nav = m8q_driver_data.nav_data; 
+
+    M8Q_MEMORY_BARRIER(); 
+    buff->write_count++; 
+    M8Q_MEMORY_BARRIER(); 
+
+    m8q_driver_data.snapshot_index = back; 
+
+    if (new_fix && (m8q_driver_data.fix_callback != NULL))
+    {
+        m8q_driver_data.fix_callback(&buff->data); 
+    }
+}
+
+
+// Write an RTCM3 frame to the device 
+M8Q_STATUS m8q_rtcm_write(
+    const uint8_t *circular_buff, 
+    uint16_t cb_size, 
+    uint16_t frame_start, 
+    uint16_t frame_len, 
+    uint8_t max_chunk)
+{
+    uint8_t bounce[RTCM_MIN_CHUNK]; 
+    const uint8_t *msg; 
+    uint16_t chunk, contig, index; 
+
+    while (frame_len)
+    {
+        contig = cb_size - frame_start; 
+        chunk = (frame_len > max_chunk) ? max_chunk : frame_len; 
+        chunk = (chunk > contig) ? contig : chunk; 
+        msg = &circular_buff[frame_start]; 
+
+        // Don't leave a single byte for the last write 
+        if ((frame_len - chunk) == BYTE_1)
+        {
+            chunk--; 
         }
-        
-        (*stream_index)++; 
+
+        // Too few bytes before the buffer end - write them along with the bytes after it 
+        if (chunk < RTCM_MIN_WRITE)
+        {
+            chunk = (frame_len > RTCM_MIN_CHUNK) ? RTCM_MIN_CHUNK : frame_len; 
+
+            if ((frame_len - chunk) == BYTE_1)
+            {
+                chunk--; 
+            }
+
+            for (uint8_t i = CLEAR; i < chunk; i++)
+            {
+                index = frame_start + i; 
+                bounce[i] = circular_buff[(index >= cb_size) ? (index - cb_size) : index]; 
+            }
+
+            msg = bounce; 
+        }
+
+        if (m8q_write_msg((void *)msg, (uint8_t)chunk))
+        {
+            return M8Q_WRITE_FAULT; 
+        }
+
+        frame_start += chunk; 
+        frame_len -= chunk; 
+
+        if (frame_start >= cb_size)
+        {
+            frame_start -= cb_size; 
+        }
+    }
+
+    return M8Q_OK; 
+}
+
+
+// UBX NAV message decode 
+void m8q_ubx_nav_decode(void)
+{
+    const uint8_t *payload = m8q_driver_data.parse.ubx_payload; 
+    m8q_ubx_nav_t *nav = &m8q_driver_data.nav_data; 
+
+    switch (m8q_driver_data.parse.ubx_msg)
+    {
+        case NAV_PVT: 
+            nav->iTOW = m8q_ubx_u32(&payload[NAV_PVT_ITOW]); 
+            nav->fixType = payload[NAV_PVT_FIX_TYPE]; 
+            nav->flags = payload[NAV_PVT_FLAGS]; 
+            nav->numSV = payload[NAV_PVT_NUM_SV]; 
+            nav->lon = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_LON]); 
+            nav->lat = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_LAT]); 
+            nav->height = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_HEIGHT]); 
+            nav->hMSL = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_HMSL]); 
+            nav->hAcc = m8q_ubx_u32(&payload[NAV_PVT_HACC]); 
+            nav->vAcc = m8q_ubx_u32(&payload[NAV_PVT_VACC]); 
+            nav->velN = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_VEL_N]); 
+            nav->velE = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_VEL_E]); 
+            nav->velD = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_VEL_D]); 
+            nav->gSpeed = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_GSPEED]); 
+            nav->headMot = (int32_t)m8q_ubx_u32(&payload[NAV_PVT_HEAD_MOT]); 
+            nav->sAcc = m8q_ubx_u32(&payload[NAV_PVT_SACC]); 
+            nav->pDOP = m8q_ubx_u16(&payload[NAV_PVT_PDOP]); 
+            break; 
+
+        case NAV_STATUS: 
+            nav->ttff = m8q_ubx_u32(&payload[NAV_STATUS_TTFF]); 
+            nav->msss = m8q_ubx_u32(&payload[NAV_STATUS_MSSS]); 
+            break; 
+
+        case NAV_DOP: 
+            nav->pDOP = m8q_ubx_u16(&payload[NAV_DOP_PDOP]); 
+            nav->vDOP = m8q_ubx_u16(&payload[NAV_DOP_VDOP]); 
+            nav->hDOP = m8q_ubx_u16(&payload[NAV_DOP_HDOP]); 
+            break; 
+
+        default: 
+            break; 
     }
 }
 
+
+// Read a little endian 16-bit UBX value 
+uint16_t m8q_ubx_u16(const uint8_t *data)
+{
+    return (uint16_t)data[BYTE_0] | ((uint16_t)data[BYTE_1] << SHIFT_8); 
+}
+
+
+// Read a little endian 32-bit UBX value 
+uint32_t m8q_ubx_u32(const uint8_t *data)
+{
+    return (uint32_t)data[BYTE_0] | 
+           ((uint32_t)data[BYTE_1] << SHIFT_8) | 
+           ((uint32_t)data[BYTE_2] << SHIFT_16) | 
+           ((uint32_t)data[BYTE_3] << SHIFT_24); 
+}
+
 //=======================================================================================
 
 
@@ -941,7 +941,8 @@ NRF24L01_STATUS nrf24l01_receive(
     spi_slave_select(nrf24l01_data.gpio_ss, nrf24l01_data.ss_pin); 
     spi_status |= spi_write_read(nrf24l01_data.spi, cmd, 
                                  &nrf24l01_data.status.status_reg, BYTE_1); 
-    spi_status |= spi_write_read(nrf24l01_data.spi, SPI_DUMMY, rec_buff, data_len); 
+    spi_status |= spi_transfer(nrf24l01_data.spi, NULL, rec_buff, 
+                               SPI_DUMMY, data_len); 
     spi_slave_deselect(nrf24l01_data.gpio_ss, nrf24l01_data.ss_pin); 
 
     if (spi_status)
@@ -993,7 +994,8 @@ NRF24L01_STATUS nrf24l01_write(
     spi_slave_select(nrf24l01_data.gpio_ss, nrf24l01_data.ss_pin); 
     spi_status |= spi_write_read(nrf24l01_data.spi, cmd, 
                                  &nrf24l01_data.status.status_reg, BYTE_1); 
-    spi_status |= spi_write(nrf24l01_data.spi, send_buff, data_len); 
+    spi_status |= spi_transfer(nrf24l01_data.spi, send_buff, NULL, 
+                               SPI_DUMMY, data_len); 
     spi_slave_deselect(nrf24l01_data.gpio_ss, nrf24l01_data.ss_pin); 
 
     if (spi_status)
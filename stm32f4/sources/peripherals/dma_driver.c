@@ -20,6 +20,14 @@
 //=======================================================================================
 
 
+//=======================================================================================
+// Macros 
+
+#define DMA_STREAM_FLAGS 0x3D      // Stream interrupt flag clear bits (bit 1 reserved) 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Function Prototypes 
 
@@ -89,23 +97,6 @@ void dma_priority(
     dma_priority_t priority); 
 
 
-/**
- * @brief Memory data size 
- * 
- * @details Tells the stream the size of the data being transferred from memory. It is 
- *          recommended to make the memory and peripheral data sizes the same. The memory 
- *          can act as either the source or the destination. 
- * 
- * @see dma_data_size_t
- * 
- * @param dma_stream : pointer to DMA port stream being configured 
- * @param msize : memory data size configuration 
- */
-void dma_msize(
-    DMA_Stream_TypeDef *dma_stream, 
-    dma_data_size_t msize); 
-
-
 /**
  * @brief Double buffer mode 
  * 
@@ -117,65 +108,6 @@ void dma_dbm(
     dma_dbm_t dbm); 
 
 
-/**
- * @brief Memory address increment 
- * 
- * @details Defines the behavior of the memory address after transfers. This can either be 
- *          defined as fixed, meaning the memory address doesn't change after a transfer, or 
- *          it can be defined as increment, meaning the address will be incremented after 
- *          each transfer. <br> 
- *          
- *          As an example, in peripheral-to-memory transfers such as ADC scan 
- *          mode using DMA, you want to store more than one conversion in memory to prevent 
- *          a loss of data. This can be done by getting the DMA to increment to the next address 
- *          in a buffer automatically using increment mode. 
- * 
- * @see dma_addr_inc_mode_t
- * 
- * @param dma_stream : pointer to DMA port stream being configured 
- * @param minc : memory address increment configuration 
- */
-void dma_minc(
-    DMA_Stream_TypeDef *dma_stream, 
-    dma_addr_inc_mode_t minc); 
-
-
-/**
- * @brief Peripheral data size 
- * 
- * @details Tells the stream the size of the data being transferred from the peripheral. It is 
- *          recommended to make the memory and peripheral data sizes the same. The peripheral 
- *          can act as either the source or the destination. In memory-to-memory transfers, this 
- *          peripheral configuration acts as the destination memory configuration. 
- * 
- * @see dma_data_size_t
- * 
- * @param dma_stream : pointer to DMA port stream being configured 
- * @param psize : peripheral data size configuration 
- */
-void dma_psize(
-    DMA_Stream_TypeDef *dma_stream, 
-    dma_data_size_t psize); 
-
-
-/**
- * @brief Peripheral address increment 
- * 
- * @details Defines the behavior of the peripheral address after transfers. This can either be 
- *          defined as fixed, meaning the peripheral address doesn't change after a transfer, or 
- *          it can be defined as increment, meaning the address will be incremented after 
- *          each transfer. 
- * 
- * @see dma_addr_inc_mode_t
- * 
- * @param dma_stream : pointer to DMA port stream being configured 
- * @param pinc : peripheral address increment configuration 
- */
-void dma_pinc(
-    DMA_Stream_TypeDef *dma_stream, 
-    dma_addr_inc_mode_t pinc); 
-
-
 /**
  * @brief Transfer complete interrupt 
  * 
@@ -379,8 +311,8 @@ void dma_stream_init(
     // Disable the stream 
     dma_stream_disable(dma_stream); 
     
-    // Clear all the stream interrupt flags LISR and HISR registers 
-    dma_clear_int_flags(dma); 
+    // Clear the stream interrupt flags - other streams on the port may be running 
+    dma_clear_stream_flags(dma, dma_stream); 
     
     // Select the DMA channel 
     dma_chsel(dma_stream, channel); 
@@ -554,6 +486,56 @@ uint8_t dma_get_tc_status(
     return status && FILTER_1_LSB; 
 }
 
+
+// Clear the interrupt flags of one stream 
+void dma_clear_stream_flags(
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef* dma_stream)
+{
+    // Streams are identified the same way as dma_get_tc_status. Each stream has 5 flags 
+    // (FEIF, DMEIF, TEIF, HTIF and TCIF). 
+
+    uint8_t address = (uint32_t)dma_stream; 
+
+    switch (address)
+    {
+        case (uint8_t)DMA1_Stream0_BASE: 
+            dma->LIFCR = (DMA_STREAM_FLAGS << SHIFT_0); 
+            break; 
+
+        case (uint8_t)DMA1_Stream1_BASE: 
+            dma->LIFCR = (DMA_STREAM_FLAGS << SHIFT_6); 
+            break; 
+
+        case (uint8_t)DMA1_Stream2_BASE: 
+            dma->LIFCR = (DMA_STREAM_FLAGS << SHIFT_16); 
+            break; 
+
+        case (uint8_t)DMA1_Stream3_BASE: 
+            dma->LIFCR = (DMA_STREAM_FLAGS << SHIFT_22); 
+            break; 
+
+        case (uint8_t)DMA1_Stream4_BASE: 
+            dma->HIFCR = (DMA_STREAM_FLAGS << SHIFT_0); 
+            break; 
+
+        case (uint8_t)DMA1_Stream5_BASE: 
+            dma->HIFCR = (DMA_STREAM_FLAGS << SHIFT_6); 
+            break; 
+
+        case (uint8_t)DMA1_Stream6_BASE: 
+            dma->HIFCR = (DMA_STREAM_FLAGS << SHIFT_16); 
+            break; 
+
+        case (uint8_t)DMA1_Stream7_BASE: 
+            dma->HIFCR = (DMA_STREAM_FLAGS << SHIFT_22); 
+            break; 
+        
+        default: 
+            break; 
+    }
+}
+
 //=======================================================================================
 
 
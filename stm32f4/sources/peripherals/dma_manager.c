@@ -0,0 +1,543 @@
+/**
+ * @file dma_manager.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief DMA stream allocator and interrupt dispatcher 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "dma_manager.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DMA_MGR_DMA1 0 
+#define DMA_MGR_DMA2 1 
+#define DMA_MGR_MAP_SIZE (sizeof(dma_mgr_map) / sizeof(dma_mgr_map[0]))
+#define DMA_MGR_FLAGS (DMA_MGR_FLAG_ERRORS | DMA_MGR_FLAG_HT | DMA_MGR_FLAG_TC)
+
+// Stream control register interrupt enable bits 
+#define DMA_MGR_CR_DMEIE (SET_BIT << SHIFT_1)
+#define DMA_MGR_CR_TEIE (SET_BIT << SHIFT_2)
+#define DMA_MGR_CR_HTIE (SET_BIT << SHIFT_3)
+#define DMA_MGR_CR_TCIE (SET_BIT << SHIFT_4)
+#define DMA_MGR_FCR_FEIE (SET_BIT << SHIFT_7)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+// Request mapping table entry 
+typedef struct dma_mgr_map_s 
+{
+    uint8_t request; 
+    uint8_t port; 
+    uint8_t stream; 
+    uint8_t channel; 
+}
+dma_mgr_map_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// STM32F411 request mapping - RM0383 table 27 (DMA1) and table 28 (DMA2). Requests that 
+// share a stream and channel (ex. TIM2_UP and TIM2_CH3) each have their own entry. 
+static const dma_mgr_map_t dma_mgr_map[] = 
+{
+    // DMA1 
+    { DMA_REQ_SPI3_RX,   DMA_MGR_DMA1, DMA_STREAM_0, DMA_CHNL_0 }, 
+    { DMA_REQ_SPI3_RX,   DMA_MGR_DMA1, DMA_STREAM_2, DMA_CHNL_0 }, 
+    { DMA_REQ_SPI2_RX,   DMA_MGR_DMA1, DMA_STREAM_3, DMA_CHNL_0 }, 
+    { DMA_REQ_SPI2_TX,   DMA_MGR_DMA1, DMA_STREAM_4, DMA_CHNL_0 }, 
+    { DMA_REQ_SPI3_TX,   DMA_MGR_DMA1, DMA_STREAM_5, DMA_CHNL_0 }, 
+    { DMA_REQ_SPI3_TX,   DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_0 }, 
+    { DMA_REQ_I2C1_RX,   DMA_MGR_DMA1, DMA_STREAM_0, DMA_CHNL_1 }, 
+    { DMA_REQ_I2C3_RX,   DMA_MGR_DMA1, DMA_STREAM_1, DMA_CHNL_1 }, 
+    { DMA_REQ_I2C1_RX,   DMA_MGR_DMA1, DMA_STREAM_5, DMA_CHNL_1 }, 
+    { DMA_REQ_I2C1_TX,   DMA_MGR_DMA1, DMA_STREAM_6, DMA_CHNL_1 }, 
+    { DMA_REQ_I2C1_TX,   DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_1 }, 
+    { DMA_REQ_TIM4_CH1,  DMA_MGR_DMA1, DMA_STREAM_0, DMA_CHNL_2 }, 
+    { DMA_REQ_TIM4_CH2,  DMA_MGR_DMA1, DMA_STREAM_3, DMA_CHNL_2 }, 
+    { DMA_REQ_TIM4_UP,   DMA_MGR_DMA1, DMA_STREAM_6, DMA_CHNL_2 }, 
+    { DMA_REQ_TIM4_CH3,  DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_2 }, 
+    { DMA_REQ_TIM2_UP,   DMA_MGR_DMA1, DMA_STREAM_1, DMA_CHNL_3 }, 
+    { DMA_REQ_TIM2_CH3,  DMA_MGR_DMA1, DMA_STREAM_1, DMA_CHNL_3 }, 
+    { DMA_REQ_I2C3_RX,   DMA_MGR_DMA1, DMA_STREAM_2, DMA_CHNL_3 }, 
+    { DMA_REQ_I2C3_TX,   DMA_MGR_DMA1, DMA_STREAM_4, DMA_CHNL_3 }, 
+    { DMA_REQ_TIM2_CH1,  DMA_MGR_DMA1, DMA_STREAM_5, DMA_CHNL_3 }, 
+    { DMA_REQ_TIM2_CH2,  DMA_MGR_DMA1, DMA_STREAM_6, DMA_CHNL_3 }, 
+    { DMA_REQ_TIM2_CH4,  DMA_MGR_DMA1, DMA_STREAM_6, DMA_CHNL_3 }, 
+    { DMA_REQ_TIM2_UP,   DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_3 }, 
+    { DMA_REQ_TIM2_CH4,  DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_3 }, 
+    { DMA_REQ_USART2_RX, DMA_MGR_DMA1, DMA_STREAM_5, DMA_CHNL_4 }, 
+    { DMA_REQ_USART2_TX, DMA_MGR_DMA1, DMA_STREAM_6, DMA_CHNL_4 }, 
+    { DMA_REQ_TIM3_CH4,  DMA_MGR_DMA1, DMA_STREAM_2, DMA_CHNL_5 }, 
+    { DMA_REQ_TIM3_UP,   DMA_MGR_DMA1, DMA_STREAM_2, DMA_CHNL_5 }, 
+    { DMA_REQ_TIM3_CH1,  DMA_MGR_DMA1, DMA_STREAM_4, DMA_CHNL_5 }, 
+    { DMA_REQ_TIM3_CH2,  DMA_MGR_DMA1, DMA_STREAM_5, DMA_CHNL_5 }, 
+    { DMA_REQ_TIM3_CH3,  DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_5 }, 
+    { DMA_REQ_TIM5_CH3,  DMA_MGR_DMA1, DMA_STREAM_0, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM5_UP,   DMA_MGR_DMA1, DMA_STREAM_0, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM5_CH4,  DMA_MGR_DMA1, DMA_STREAM_1, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM5_CH1,  DMA_MGR_DMA1, DMA_STREAM_2, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM5_CH4,  DMA_MGR_DMA1, DMA_STREAM_3, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM5_CH2,  DMA_MGR_DMA1, DMA_STREAM_4, DMA_CHNL_6 }, 
+    { DMA_REQ_I2C3_TX,   DMA_MGR_DMA1, DMA_STREAM_5, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM5_UP,   DMA_MGR_DMA1, DMA_STREAM_6, DMA_CHNL_6 }, 
+    { DMA_REQ_I2C2_RX,   DMA_MGR_DMA1, DMA_STREAM_2, DMA_CHNL_7 }, 
+    { DMA_REQ_I2C2_RX,   DMA_MGR_DMA1, DMA_STREAM_3, DMA_CHNL_7 }, 
+    { DMA_REQ_I2C2_TX,   DMA_MGR_DMA1, DMA_STREAM_7, DMA_CHNL_7 }, 
+
+    // DMA2 
+    { DMA_REQ_ADC1,      DMA_MGR_DMA2, DMA_STREAM_0, DMA_CHNL_0 }, 
+    { DMA_REQ_ADC1,      DMA_MGR_DMA2, DMA_STREAM_4, DMA_CHNL_0 }, 
+    { DMA_REQ_TIM1_CH1,  DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_0 }, 
+    { DMA_REQ_TIM1_CH2,  DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_0 }, 
+    { DMA_REQ_TIM1_CH3,  DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_0 }, 
+    { DMA_REQ_SPI5_RX,   DMA_MGR_DMA2, DMA_STREAM_3, DMA_CHNL_2 }, 
+    { DMA_REQ_SPI5_TX,   DMA_MGR_DMA2, DMA_STREAM_4, DMA_CHNL_2 }, 
+    { DMA_REQ_SPI1_RX,   DMA_MGR_DMA2, DMA_STREAM_0, DMA_CHNL_3 }, 
+    { DMA_REQ_SPI1_RX,   DMA_MGR_DMA2, DMA_STREAM_2, DMA_CHNL_3 }, 
+    { DMA_REQ_SPI1_TX,   DMA_MGR_DMA2, DMA_STREAM_3, DMA_CHNL_3 }, 
+    { DMA_REQ_SPI1_TX,   DMA_MGR_DMA2, DMA_STREAM_5, DMA_CHNL_3 }, 
+    { DMA_REQ_SPI4_RX,   DMA_MGR_DMA2, DMA_STREAM_0, DMA_CHNL_4 }, 
+    { DMA_REQ_SPI4_TX,   DMA_MGR_DMA2, DMA_STREAM_1, DMA_CHNL_4 }, 
+    { DMA_REQ_USART1_RX, DMA_MGR_DMA2, DMA_STREAM_2, DMA_CHNL_4 }, 
+    { DMA_REQ_SDIO,      DMA_MGR_DMA2, DMA_STREAM_3, DMA_CHNL_4 }, 
+    { DMA_REQ_USART1_RX, DMA_MGR_DMA2, DMA_STREAM_5, DMA_CHNL_4 }, 
+    { DMA_REQ_SDIO,      DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_4 }, 
+    { DMA_REQ_USART1_TX, DMA_MGR_DMA2, DMA_STREAM_7, DMA_CHNL_4 }, 
+    { DMA_REQ_USART6_RX, DMA_MGR_DMA2, DMA_STREAM_1, DMA_CHNL_5 }, 
+    { DMA_REQ_USART6_RX, DMA_MGR_DMA2, DMA_STREAM_2, DMA_CHNL_5 }, 
+    { DMA_REQ_SPI4_RX,   DMA_MGR_DMA2, DMA_STREAM_3, DMA_CHNL_5 }, 
+    { DMA_REQ_SPI4_TX,   DMA_MGR_DMA2, DMA_STREAM_4, DMA_CHNL_5 }, 
+    { DMA_REQ_USART6_TX, DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_5 }, 
+    { DMA_REQ_USART6_TX, DMA_MGR_DMA2, DMA_STREAM_7, DMA_CHNL_5 }, 
+    { DMA_REQ_TIM1_CH1,  DMA_MGR_DMA2, DMA_STREAM_1, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM1_CH2,  DMA_MGR_DMA2, DMA_STREAM_2, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM1_CH1,  DMA_MGR_DMA2, DMA_STREAM_3, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM1_CH4,  DMA_MGR_DMA2, DMA_STREAM_4, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM1_UP,   DMA_MGR_DMA2, DMA_STREAM_5, DMA_CHNL_6 }, 
+    { DMA_REQ_TIM1_CH3,  DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_6 }, 
+    { DMA_REQ_SPI5_RX,   DMA_MGR_DMA2, DMA_STREAM_5, DMA_CHNL_7 }, 
+    { DMA_REQ_SPI5_TX,   DMA_MGR_DMA2, DMA_STREAM_6, DMA_CHNL_7 }
+};
+
+
+// Stream registers of each port 
+static DMA_Stream_TypeDef * const dma_mgr_stream_regs[DMA_MGR_PORTS][DMA_MGR_STREAMS] = 
+{
+    { DMA1_Stream0, DMA1_Stream1, DMA1_Stream2, DMA1_Stream3, 
+      DMA1_Stream4, DMA1_Stream5, DMA1_Stream6, DMA1_Stream7 }, 
+    { DMA2_Stream0, DMA2_Stream1, DMA2_Stream2, DMA2_Stream3, 
+      DMA2_Stream4, DMA2_Stream5, DMA2_Stream6, DMA2_Stream7 }
+};
+
+
+// Interrupt numbers of each stream 
+static const IRQn_Type dma_mgr_irqns[DMA_MGR_PORTS][DMA_MGR_STREAMS] = 
+{
+    { DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn, 
+      DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn }, 
+    { DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn, 
+      DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn }
+};
+
+
+// Flag position of each stream in LISR/LIFCR (streams 0-3) and HISR/HIFCR (streams 4-7)
+static const uint8_t dma_mgr_flag_shift[DMA_MGR_STREAMS / BYTE_2] = 
+{
+    SHIFT_0, SHIFT_6, SHIFT_16, SHIFT_22 
+};
+
+
+// Streams and statistics 
+static dma_mgr_stream_t dma_mgr_streams[DMA_MGR_PORTS][DMA_MGR_STREAMS]; 
+static dma_mgr_stats_t dma_mgr_stat; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Get the port index of a DMA port 
+ * 
+ * @param dma : DMA port 
+ * @return uint8_t : port index, DMA_MGR_PORTS if it's not a DMA port 
+ */
+uint8_t dma_mgr_port_index(const DMA_TypeDef *dma); 
+
+
+/**
+ * @brief Check if a stream can serve a request 
+ * 
+ * @param request : peripheral request 
+ * @param port : port index 
+ * @param stream_num : stream number 
+ * @param channel : channel of the request on the stream 
+ * @return uint8_t : TRUE if the stream can serve the request 
+ */
+uint8_t dma_mgr_map_find(
+    dma_request_t request, 
+    uint8_t port, 
+    uint8_t stream_num, 
+    dma_channel_t *channel); 
+
+
+/**
+ * @brief Take a stream for a request 
+ * 
+ * @param request : peripheral request 
+ * @param port : port index 
+ * @param stream_num : stream number 
+ * @param channel : channel of the request on the stream 
+ * @return dma_mgr_stream_t* : allocated stream 
+ */
+dma_mgr_stream_t *dma_mgr_take(
+    dma_request_t request, 
+    uint8_t port, 
+    uint8_t stream_num, 
+    dma_channel_t channel); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Allocation 
+
+// Allocate a stream for a request 
+dma_mgr_stream_t *dma_mgr_alloc(dma_request_t request)
+{
+    if (request >= DMA_REQ_COUNT)
+    {
+        return NULL; 
+    }
+
+    // Memory to memory can use any DMA2 stream 
+    if (request == DMA_REQ_MEM2MEM)
+    {
+        for (uint8_t i = CLEAR; i < DMA_MGR_STREAMS; i++)
+        {
+            if (!dma_mgr_streams[DMA_MGR_DMA2][i].in_use)
+            {
+                return dma_mgr_take(request, DMA_MGR_DMA2, i, DMA_CHNL_0); 
+            }
+        }
+    }
+    else 
+    {
+        for (uint8_t i = CLEAR; i < DMA_MGR_MAP_SIZE; i++)
+        {
+            const dma_mgr_map_t *entry = &dma_mgr_map[i]; 
+
+            if ((entry->request == request) && 
+                !dma_mgr_streams[entry->port][entry->stream].in_use)
+            {
+                return dma_mgr_take(request, entry->port, entry->stream, 
+                                    (dma_channel_t)entry->channel); 
+            }
+        }
+    }
+
+    dma_mgr_stat.alloc_fails++; 
+
+    return NULL; 
+}
+
+
+// Allocate a specific stream for a request 
+dma_mgr_stream_t *dma_mgr_claim(
+    dma_request_t request, 
+    DMA_TypeDef *dma, 
+    dma_stream_t stream_num)
+{
+    uint8_t port = dma_mgr_port_index(dma); 
+    dma_channel_t channel = DMA_CHNL_0; 
+
+    if ((request >= DMA_REQ_COUNT) || (port >= DMA_MGR_PORTS) || 
+        (stream_num >= DMA_MGR_STREAMS) || 
+        !dma_mgr_map_find(request, port, stream_num, &channel))
+    {
+        return NULL; 
+    }
+
+    if (dma_mgr_streams[port][stream_num].in_use)
+    {
+        dma_mgr_stat.alloc_fails++; 
+        return NULL; 
+    }
+
+    return dma_mgr_take(request, port, stream_num, channel); 
+}
+
+
+// Free an allocated stream 
+void dma_mgr_free(dma_mgr_stream_t *stream)
+{
+    if ((stream == NULL) || !stream->in_use)
+    {
+        return; 
+    }
+
+    stream->in_use = FALSE; 
+    stream->half = NULL; 
+    stream->complete = NULL; 
+    stream->error = NULL; 
+    stream->context = NULL; 
+    dma_mgr_stat.streams_in_use--; 
+}
+
+
+// Check if a stream is free 
+uint8_t dma_mgr_free_status(
+    DMA_TypeDef *dma, 
+    dma_stream_t stream_num)
+{
+    uint8_t port = dma_mgr_port_index(dma); 
+
+    if ((port >= DMA_MGR_PORTS) || (stream_num >= DMA_MGR_STREAMS))
+    {
+        return FALSE; 
+    }
+
+    return dma_mgr_streams[port][stream_num].in_use ? FALSE : TRUE; 
+}
+
+
+// Get the port index of a DMA port 
+uint8_t dma_mgr_port_index(const DMA_TypeDef *dma)
+{
+    if (dma == DMA1)
+    {
+        return DMA_MGR_DMA1; 
+    }
+    else if (dma == DMA2)
+    {
+        return DMA_MGR_DMA2; 
+    }
+
+    return DMA_MGR_PORTS; 
+}
+
+
+// Check if a stream can serve a request 
+uint8_t dma_mgr_map_find(
+    dma_request_t request, 
+    uint8_t port, 
+    uint8_t stream_num, 
+    dma_channel_t *channel)
+{
+    if (request == DMA_REQ_MEM2MEM)
+    {
+        *channel = DMA_CHNL_0; 
+        return (port == DMA_MGR_DMA2) ? TRUE : FALSE; 
+    }
+
+    for (uint8_t i = CLEAR; i < DMA_MGR_MAP_SIZE; i++)
+    {
+        const dma_mgr_map_t *entry = &dma_mgr_map[i]; 
+
+        if ((entry->request == request) && (entry->port == port) && 
+            (entry->stream == stream_num))
+        {
+            *channel = (dma_channel_t)entry->channel; 
+            return TRUE; 
+        }
+    }
+
+    return FALSE; 
+}
+
+
+// Take a stream for a request 
+dma_mgr_stream_t *dma_mgr_take(
+    dma_request_t request, 
+    uint8_t port, 
+    uint8_t stream_num, 
+    dma_channel_t channel)
+{
+    dma_mgr_stream_t *stream = &dma_mgr_streams[port][stream_num]; 
+
+    memset((void *)stream, CLEAR, sizeof(dma_mgr_stream_t)); 
+    stream->dma = (port == DMA_MGR_DMA1) ? DMA1 : DMA2; 
+    stream->stream = dma_mgr_stream_regs[port][stream_num]; 
+    stream->channel = channel; 
+    stream->stream_num = (dma_stream_t)stream_num; 
+    stream->port = port; 
+    stream->request = request; 
+    stream->in_use = TRUE; 
+
+    dma_mgr_stat.streams_in_use++; 
+    dma_mgr_stat.allocs++; 
+
+    return stream; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Interrupts 
+
+// Set the event callbacks of a stream 
+void dma_mgr_set_callbacks(
+    dma_mgr_stream_t *stream, 
+    dma_mgr_callback_t half, 
+    dma_mgr_callback_t complete, 
+    dma_mgr_callback_t error, 
+    void *context)
+{
+    if (stream == NULL)
+    {
+        return; 
+    }
+
+    stream->half = half; 
+    stream->complete = complete; 
+    stream->error = error; 
+    stream->context = context; 
+}
+
+
+// Stream interrupt handler 
+void dma_mgr_irq(
+    DMA_TypeDef *dma, 
+    dma_stream_t stream_num)
+{
+    uint8_t port = dma_mgr_port_index(dma); 
+
+    if ((port >= DMA_MGR_PORTS) || (stream_num >= DMA_MGR_STREAMS))
+    {
+        return; 
+    }
+
+    dma_mgr_stream_t *stream = &dma_mgr_streams[port][stream_num]; 
+    DMA_Stream_TypeDef *stream_regs = dma_mgr_stream_regs[port][stream_num]; 
+    uint8_t shift = dma_mgr_flag_shift[stream_num & SET_3]; 
+    uint8_t flags; 
+
+    // Read and clear the flags of this stream only 
+    if (stream_num < DMA_STREAM_4)
+    {
+        flags = (uint8_t)((dma->LISR >> shift) & DMA_MGR_FLAGS); 
+        dma->LIFCR = (uint32_t)flags << shift; 
+    }
+    else 
+    {
+        flags = (uint8_t)((dma->HISR >> shift) & DMA_MGR_FLAGS); 
+        dma->HIFCR = (uint32_t)flags << shift; 
+    }
+
+    // Flags are set whether or not their interrupt is enabled 
+    uint32_t cr = stream_regs->CR; 
+    uint8_t enabled = CLEAR; 
+
+    enabled |= (cr & DMA_MGR_CR_TCIE) ? DMA_MGR_FLAG_TC : CLEAR; 
+    enabled |= (cr & DMA_MGR_CR_HTIE) ? DMA_MGR_FLAG_HT : CLEAR; 
+    enabled |= (cr & DMA_MGR_CR_TEIE) ? DMA_MGR_FLAG_TE : CLEAR; 
+    enabled |= (cr & DMA_MGR_CR_DMEIE) ? DMA_MGR_FLAG_DME : CLEAR; 
+    enabled |= (stream_regs->FCR & DMA_MGR_FCR_FEIE) ? DMA_MGR_FLAG_FE : CLEAR; 
+    flags &= enabled; 
+
+    if (stream->in_use)
+    {
+        dma_mgr_dispatch(stream, flags); 
+    }
+}
+
+
+// Dispatch stream events 
+void dma_mgr_dispatch(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags)
+{
+    if ((stream == NULL) || !stream->in_use)
+    {
+        return; 
+    }
+
+    // Errors first so the owner knows a following transfer complete isn't valid 
+    if (flags & DMA_MGR_FLAG_ERRORS)
+    {
+        stream->error_count++; 
+        dma_mgr_stat.errors++; 
+
+        if (stream->error != NULL)
+        {
+            stream->error(stream, flags & DMA_MGR_FLAG_ERRORS, stream->context); 
+        }
+    }
+
+    if (flags & DMA_MGR_FLAG_HT)
+    {
+        stream->half_count++; 
+        dma_mgr_stat.half++; 
+
+        if (stream->half != NULL)
+        {
+            stream->half(stream, DMA_MGR_FLAG_HT, stream->context); 
+        }
+    }
+
+    if (flags & DMA_MGR_FLAG_TC)
+    {
+        stream->complete_count++; 
+        dma_mgr_stat.complete++; 
+
+        if (stream->complete != NULL)
+        {
+            stream->complete(stream, DMA_MGR_FLAG_TC, stream->context); 
+        }
+    }
+}
+
+
+// Interrupt number of a stream 
+IRQn_Type dma_mgr_irqn(const dma_mgr_stream_t *stream)
+{
+    return dma_mgr_irqns[stream->port][stream->stream_num]; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Statistics 
+
+// Get the usage statistics 
+void dma_mgr_stats(dma_mgr_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = dma_mgr_stat; 
+    }
+}
+
+
+// Free all streams and clear the statistics 
+void dma_mgr_reset(void)
+{
+    memset((void *)dma_mgr_streams, CLEAR, sizeof(dma_mgr_streams)); 
+    memset((void *)&dma_mgr_stat, CLEAR, sizeof(dma_mgr_stat)); 
+}
+
+//=======================================================================================
@@ -0,0 +1,406 @@
+/**
+ * @file dma_mem.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief DMA memory copy and fill 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "dma_mem.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DMA_MEM_WORD_MASK 0x03       // Address/length bits that must be clear for words 
+#define DMA_MEM_FILL_WORD 0x01010101 // Spreads a fill byte across a word 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Start a DMA transfer or the CPU copy 
+ * 
+ * @param engine : DMA memory engine (NULL to use the CPU)
+ * @param dst : destination 
+ * @param src : source 
+ * @param len : number of bytes 
+ * @param src_inc : source increments (FALSE for fills)
+ * @param callback : done callback 
+ * @param context : passed to the callback 
+ * @return DMA_MEM_STATUS : status of the start 
+ */
+DMA_MEM_STATUS dma_mem_start(
+    dma_mem_t *engine, 
+    uint8_t *dst, 
+    const uint8_t *src, 
+    uint32_t len, 
+    uint8_t src_inc, 
+    dma_mem_callback_t callback, 
+    void *context); 
+
+
+/**
+ * @brief Start the next part of a transfer 
+ * 
+ * @details Uses word transfers when both addresses are word aligned. Up to 3 bytes left 
+ *          at the end of a word aligned block are copied by the CPU. 
+ * 
+ * @param engine : DMA memory engine 
+ * @return uint8_t : TRUE if a DMA transfer was started, FALSE if the block is done 
+ */
+uint8_t dma_mem_next(dma_mem_t *engine); 
+
+
+/**
+ * @brief Finish a transfer and run the callback 
+ * 
+ * @param engine : DMA memory engine 
+ * @param status : transfer status 
+ */
+void dma_mem_done(
+    dma_mem_t *engine, 
+    DMA_MEM_STATUS status); 
+
+
+/**
+ * @brief Transfer complete callback 
+ * 
+ * @param stream : memory-to-memory stream 
+ * @param flags : stream events 
+ * @param context : DMA memory engine 
+ */
+void dma_mem_complete(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags, 
+    void *context); 
+
+
+/**
+ * @brief Transfer error callback 
+ * 
+ * @param stream : memory-to-memory stream 
+ * @param flags : stream events 
+ * @param context : DMA memory engine 
+ */
+void dma_mem_error(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags, 
+    void *context); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// DMA memory engine initialization 
+DMA_MEM_STATUS dma_mem_init(
+    dma_mem_t *engine, 
+    dma_mgr_stream_t *stream)
+{
+    if ((engine == NULL) || (stream == NULL) || (stream->request != DMA_REQ_MEM2MEM))
+    {
+        return DMA_MEM_INVALID_PTR; 
+    }
+
+    memset((void *)engine, CLEAR, sizeof(dma_mem_t)); 
+    engine->stream = stream; 
+
+    // Direct mode can't be used for memory-to-memory transfers 
+    dma_fifo_config(stream->stream, DMA_FIFO_MODE, DMA_FTH_FULL, DMA_FEIE_DISABLE); 
+    dma_int_config(stream->stream, DMA_TCIE_ENABLE, DMA_HTIE_DISABLE, 
+                   DMA_TEIE_ENABLE, DMA_DMEIE_DISABLE); 
+    dma_mgr_set_callbacks(stream, NULL, dma_mem_complete, dma_mem_error, (void *)engine); 
+
+    return DMA_MEM_OK; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Transfers 
+
+// Copy memory 
+DMA_MEM_STATUS dma_memcpy(
+    dma_mem_t *engine, 
+    void *dst, 
+    const void *src, 
+    uint32_t len, 
+    dma_mem_callback_t callback, 
+    void *context)
+{
+    if ((dst == NULL) || (src == NULL))
+    {
+        return DMA_MEM_INVALID_PTR; 
+    }
+
+    if ((engine == NULL) || (len < DMA_MEM_MIN_LEN))
+    {
+        memcpy(dst, src, len); 
+
+        if (engine != NULL)
+        {
+            engine->cpu_bytes += len; 
+        }
+
+        if (callback != NULL)
+        {
+            callback(DMA_MEM_OK, context); 
+        }
+
+        return DMA_MEM_OK; 
+    }
+
+    return dma_mem_start(engine, (uint8_t *)dst, (const uint8_t *)src, len, TRUE, 
+                         callback, context); 
+}
+
+
+// Fill memory 
+DMA_MEM_STATUS dma_memset(
+    dma_mem_t *engine, 
+    void *dst, 
+    uint8_t value, 
+    uint32_t len, 
+    dma_mem_callback_t callback, 
+    void *context)
+{
+    if (dst == NULL)
+    {
+        return DMA_MEM_INVALID_PTR; 
+    }
+
+    if ((engine == NULL) || (len < DMA_MEM_MIN_LEN))
+    {
+        memset(dst, value, len); 
+
+        if (engine != NULL)
+        {
+            engine->cpu_bytes += len; 
+        }
+
+        if (callback != NULL)
+        {
+            callback(DMA_MEM_OK, context); 
+        }
+
+        return DMA_MEM_OK; 
+    }
+
+    if (engine->busy)
+    {
+        return DMA_MEM_BUSY; 
+    }
+
+    // The DMA reads the fill value from memory so it has to outlive this call 
+    engine->fill = value * DMA_MEM_FILL_WORD; 
+
+    return dma_mem_start(engine, (uint8_t *)dst, (const uint8_t *)&engine->fill, len, 
+                         FALSE, callback, context); 
+}
+
+
+// DMA memory engine busy status 
+uint8_t dma_mem_busy(const dma_mem_t *engine)
+{
+    if (engine == NULL)
+    {
+        return FALSE; 
+    }
+
+    return engine->busy; 
+}
+
+
+// Wait for the DMA memory engine 
+DMA_MEM_STATUS dma_mem_wait(const dma_mem_t *engine)
+{
+    if (engine == NULL)
+    {
+        return DMA_MEM_INVALID_PTR; 
+    }
+
+    while (engine->busy); 
+
+    return engine->status; 
+}
+
+
+// Start a DMA transfer or the CPU copy 
+DMA_MEM_STATUS dma_mem_start(
+    dma_mem_t *engine, 
+    uint8_t *dst, 
+    const uint8_t *src, 
+    uint32_t len, 
+    uint8_t src_inc, 
+    dma_mem_callback_t callback, 
+    void *context)
+{
+    if (engine->busy)
+    {
+        return DMA_MEM_BUSY; 
+    }
+
+    engine->dst = dst; 
+    engine->src = src; 
+    engine->remaining = len; 
+    engine->src_inc = src_inc; 
+    engine->callback = callback; 
+    engine->context = context; 
+    engine->status = DMA_MEM_OK; 
+    engine->busy = TRUE; 
+
+    if (!dma_mem_next(engine))
+    {
+        dma_mem_done(engine, DMA_MEM_OK); 
+    }
+
+    return DMA_MEM_OK; 
+}
+
+
+// Start the next part of a transfer 
+uint8_t dma_mem_next(dma_mem_t *engine)
+{
+    DMA_Stream_TypeDef *stream = engine->stream->stream; 
+    uintptr_t addresses = (uintptr_t)engine->dst; 
+    dma_data_size_t size = DMA_DATA_SIZE_BYTE; 
+    uint32_t len = engine->remaining; 
+
+    if (engine->src_inc)
+    {
+        addresses |= (uintptr_t)engine->src; 
+    }
+
+    if (!(addresses & DMA_MEM_WORD_MASK))
+    {
+        // Whole words by the DMA and what's left of the block by the CPU 
+        len &= ~DMA_MEM_WORD_MASK; 
+
+        if (len == CLEAR)
+        {
+            if (engine->src_inc)
+            {
+                memcpy((void *)engine->dst, (void *)engine->src, engine->remaining); 
+            }
+            else 
+            {
+                memset((void *)engine->dst, (uint8_t)engine->fill, engine->remaining); 
+            }
+
+            engine->cpu_bytes += engine->remaining; 
+            engine->remaining = CLEAR; 
+
+            return FALSE; 
+        }
+
+        size = DMA_DATA_SIZE_WORD; 
+
+        if (len > ((uint32_t)DMA_MEM_MAX_ITEMS << SHIFT_2))
+        {
+            len = (uint32_t)DMA_MEM_MAX_ITEMS << SHIFT_2; 
+        }
+    }
+    else if (len > DMA_MEM_MAX_ITEMS)
+    {
+        len = DMA_MEM_MAX_ITEMS; 
+    }
+
+    // The peripheral port is the source in memory-to-memory mode 
+    dma_clear_stream_flags(engine->stream->dma, stream); 
+    dma_psize(stream, size); 
+    dma_msize(stream, size); 
+    dma_pinc(stream, engine->src_inc ? DMA_ADDR_INCREMENT : DMA_ADDR_FIXED); 
+    dma_minc(stream, DMA_ADDR_INCREMENT); 
+    dma_stream_config(
+        stream, 
+        (uint32_t)(uintptr_t)engine->src, 
+        (uint32_t)(uintptr_t)engine->dst, 
+        (uint32_t)NULL_CHAR, 
+        (uint16_t)((size == DMA_DATA_SIZE_WORD) ? (len >> SHIFT_2) : len)); 
+
+    engine->dst += len; 
+
+    if (engine->src_inc)
+    {
+        engine->src += len; 
+    }
+
+    engine->remaining -= len; 
+    engine->dma_bytes += len; 
+    engine->dma_transfers++; 
+
+    dma_stream_enable(stream); 
+
+    return TRUE; 
+}
+
+
+// Finish a transfer and run the callback 
+void dma_mem_done(
+    dma_mem_t *engine, 
+    DMA_MEM_STATUS status)
+{
+    engine->status = status; 
+    engine->busy = FALSE; 
+
+    if (engine->callback != NULL)
+    {
+        engine->callback(status, engine->context); 
+    }
+}
+
+
+// Transfer complete callback 
+void dma_mem_complete(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags, 
+    void *context)
+{
+    dma_mem_t *engine = (dma_mem_t *)context; 
+
+    if (!engine->busy)
+    {
+        return; 
+    }
+
+    if ((engine->remaining == CLEAR) || !dma_mem_next(engine))
+    {
+        dma_mem_done(engine, engine->status); 
+    }
+}
+
+
+// Transfer error callback 
+void dma_mem_error(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags, 
+    void *context)
+{
+    dma_mem_t *engine = (dma_mem_t *)context; 
+
+    // The stream disables itself on a transfer error so the rest of the block is dropped 
+    if (engine->busy)
+    {
+        engine->remaining = CLEAR; 
+        dma_mem_done(engine, DMA_MEM_ERROR); 
+    }
+}
+
+//=======================================================================================
@@ -155,6 +155,40 @@ I2C_STATUS i2c_get(
     uint16_t data_size, 
     uint8_t increment); 
 
+
+/**
+ * @brief Start the transaction at the head of the asynchronous queue 
+ * 
+ * @details Enables the event and error interrupts and generates the start condition. The 
+ *          rest of the transaction is driven by the interrupt handlers. 
+ * 
+ * @param engine : engine of the I2C port 
+ */
+void i2c_async_start(i2c_async_t *engine); 
+
+
+/**
+ * @brief Finish the active asynchronous transaction 
+ * 
+ * @details Removes the transaction from the queue, records the result, runs the 
+ *          callback and starts the next queued transaction. The I2C interrupts are 
+ *          disabled once the queue is empty. 
+ * 
+ * @param engine : engine of the I2C port 
+ * @param status : transaction result 
+ */
+void i2c_async_complete(
+    i2c_async_t *engine, 
+    I2C_STATUS status); 
+
+
+/**
+ * @brief Stop any DMA transfer used by the active asynchronous transaction 
+ * 
+ * @param engine : engine of the I2C port 
+ */
+void i2c_async_dma_stop(i2c_async_t *engine); 
+
 //=======================================================================================
 
 
@@ -586,3 +620,423 @@ I2C_STATUS i2c_read_to_len(
 }
 
 //=======================================================================================
+
+
+
+//=======================================================================================
+// Asynchronous transactions 
+
+// Asynchronous engine initialization 
+void i2c_async_init(
+    i2c_async_t *engine, 
+    I2C_TypeDef *i2c, 
+    DMA_Stream_TypeDef *dma_tx, 
+    DMA_Stream_TypeDef *dma_rx)
+{
+    if ((engine == NULL) || (i2c == NULL))
+    {
+        return; 
+    }
+
+    engine->i2c = i2c; 
+    engine->dma_tx = dma_tx; 
+    engine->dma_rx = dma_rx; 
+    engine->head = NULL; 
+    engine->tail = NULL; 
+    engine->state = I2C_ASYNC_IDLE; 
+    engine->count = CLEAR; 
+    engine->attempts = CLEAR; 
+    engine->completed = CLEAR; 
+    engine->errors = CLEAR; 
+
+    // Interrupts stay off until a transaction is submitted 
+    i2c->CR2 &= ~((SET_BIT << SHIFT_8) | (SET_BIT << SHIFT_9) | (SET_BIT << SHIFT_10)); 
+}
+
+
+// Submit a transaction 
+I2C_STATUS i2c_async_submit(
+    i2c_async_t *engine, 
+    i2c_txn_t *txn)
+{
+    if ((engine == NULL) || (engine->i2c == NULL) || (txn == NULL) || 
+        ((txn->tx_len == BYTE_0) && (txn->rx_len == BYTE_0)) || 
+        (txn->tx_len && (txn->tx_data == NULL)) || 
+        (txn->rx_len && (txn->rx_data == NULL)))
+    {
+        return I2C_NULL_PTR; 
+    }
+
+    // Mask every interrupt that can complete a transaction while the queue is modified 
+    uint32_t irq_mask = i2c_async_lock(engine); 
+
+    // A transaction can only be in the queue once 
+    for (i2c_txn_t *queued = engine->head; queued != NULL; queued = queued->next)
+    {
+        if (queued == txn)
+        {
+            i2c_async_unlock(engine, irq_mask); 
+            return I2C_BUSY; 
+        }
+    }
+
+    txn->status = I2C_BUSY; 
+    txn->next = NULL; 
+
+    if (engine->tail == NULL)
+    {
+        engine->head = txn; 
+    }
+    else 
+    {
+        engine->tail->next = txn; 
+    }
+    engine->tail = txn; 
+
+    i2c_async_unlock(engine, irq_mask); 
+
+    if (engine->state == I2C_ASYNC_IDLE)
+    {
+        i2c_async_start(engine); 
+    }
+
+    return I2C_OK; 
+}
+
+
+// Start the transaction at the head of the queue 
+void i2c_async_start(i2c_async_t *engine)
+{
+    I2C_TypeDef *i2c = engine->i2c; 
+
+    // Transactions without write data go straight to the read phase 
+    engine->state = (engine->head->tx_len) ? I2C_ASYNC_WRITE : I2C_ASYNC_READ; 
+    engine->count = CLEAR; 
+
+    // Enable the event (ITEVTEN) and error (ITERREN) interrupts then generate the start 
+    i2c->CR2 |= (SET_BIT << SHIFT_8) | (SET_BIT << SHIFT_9); 
+    i2c_set_ack(i2c); 
+    i2c->CR1 |= (SET_BIT << SHIFT_8); 
+}
+
+
+// Event interrupt handler 
+void i2c_async_ev_irq(i2c_async_t *engine)
+{
+    if ((engine == NULL) || (engine->head == NULL) || (engine->state == I2C_ASYNC_IDLE))
+    {
+        return; 
+    }
+
+    I2C_TypeDef *i2c = engine->i2c; 
+    i2c_txn_t *txn = engine->head; 
+    uint32_t sr1 = i2c->SR1; 
+
+    if (sr1 & (SET_BIT << SHIFT_0))
+    {
+        // SB - start generated. Send the address (writing DR clears SB). 
+        i2c->DR = txn->address + 
+                  ((engine->state == I2C_ASYNC_WRITE) ? I2C_W_OFFSET : I2C_R_OFFSET); 
+    }
+    else if (sr1 & (SET_BIT << SHIFT_1))
+    {
+        // ADDR - address acknowledged. Set up the data phase before clearing ADDR 
+        // because clearing it releases the clock. 
+        if (engine->state == I2C_ASYNC_WRITE)
+        {
+            if (engine->dma_tx != NULL)
+            {
+                dma_stream_config(
+                    engine->dma_tx, 
+                    (uint32_t)(uintptr_t)(&i2c->DR), 
+                    (uint32_t)(uintptr_t)txn->tx_data, 
+                    (uint32_t)NULL_CHAR, 
+                    txn->tx_len); 
+                dma_stream_enable(engine->dma_tx); 
+                i2c->CR2 |= (SET_BIT << SHIFT_11);   // DMAEN 
+            }
+            else 
+            {
+                i2c->CR2 |= (SET_BIT << SHIFT_10);   // ITBUFEN 
+            }
+
+            i2c_clear_addr(i2c); 
+        }
+        else if (txn->rx_len == BYTE_1)
+        {
+            // Single byte - the NACK and stop must be set up around clearing ADDR 
+            i2c_clear_ack(i2c); 
+            i2c_clear_addr(i2c); 
+            i2c_stop(i2c); 
+            i2c->CR2 |= (SET_BIT << SHIFT_10); 
+        }
+        else if (engine->dma_rx != NULL)
+        {
+            // LAST makes the hardware NACK the final byte read by the DMA 
+            dma_stream_config(
+                engine->dma_rx, 
+                (uint32_t)(uintptr_t)(&i2c->DR), 
+                (uint32_t)(uintptr_t)txn->rx_data, 
+                (uint32_t)NULL_CHAR, 
+                txn->rx_len); 
+            dma_stream_enable(engine->dma_rx); 
+            i2c->CR2 |= (SET_BIT << SHIFT_11) | (SET_BIT << SHIFT_12); 
+            i2c_clear_addr(i2c); 
+        }
+        else 
+        {
+            i2c->CR2 |= (SET_BIT << SHIFT_10); 
+            i2c_clear_addr(i2c); 
+        }
+    }
+    else if (engine->state == I2C_ASYNC_WRITE)
+    {
+        if ((sr1 & (SET_BIT << SHIFT_7)) && (engine->count < txn->tx_len) && 
+            !(i2c->CR2 & (SET_BIT << SHIFT_11)))
+        {
+            // TxE - load the next byte. Once the last byte is loaded, wait for BTF. 
+            i2c->DR = txn->tx_data[engine->count++]; 
+
+            if (engine->count >= txn->tx_len)
+            {
+                i2c->CR2 &= ~(SET_BIT << SHIFT_10); 
+            }
+        }
+        else if (sr1 & (SET_BIT << SHIFT_2))
+        {
+            // BTF - all write data is out. Repeated start for the read or finish. 
+            i2c->CR2 &= ~((SET_BIT << SHIFT_10) | (SET_BIT << SHIFT_11)); 
+
+            if (txn->rx_len)
+            {
+                engine->state = I2C_ASYNC_READ; 
+                engine->count = CLEAR; 
+                i2c_set_ack(i2c); 
+                i2c->CR1 |= (SET_BIT << SHIFT_8); 
+            }
+            else 
+            {
+                i2c_stop(i2c); 
+                i2c_async_complete(engine, I2C_OK); 
+            }
+        }
+    }
+    else if (sr1 & (SET_BIT << SHIFT_6))
+    {
+        // RxNE - NACK and stop are set after the second last byte is read (same as 
+        // i2c_read) so the device releases the bus after the last byte. 
+        txn->rx_data[engine->count++] = (uint8_t)i2c->DR; 
+
+        if (engine->count >= txn->rx_len)
+        {
+            i2c->CR2 &= ~(SET_BIT << SHIFT_10); 
+            i2c_async_complete(engine, I2C_OK); 
+        }
+        else if ((txn->rx_len - engine->count) == BYTE_1)
+        {
+            i2c_clear_ack(i2c); 
+            i2c_stop(i2c); 
+        }
+    }
+}
+
+
+// Error interrupt handler 
+void i2c_async_er_irq(i2c_async_t *engine)
+{
+    if ((engine == NULL) || (engine->i2c == NULL))
+    {
+        return; 
+    }
+
+    I2C_TypeDef *i2c = engine->i2c; 
+    uint32_t sr1 = i2c->SR1; 
+    I2C_STATUS status = I2C_OK; 
+
+    // Check the error flags 
+    if (sr1 & (SET_BIT << SHIFT_10))
+    {
+        status = I2C_NACK;         // AF - acknowledge failure 
+    }
+    else if (sr1 & (SET_BIT << SHIFT_9))
+    {
+        status = I2C_ARB_LOST;     // ARLO - arbitration lost 
+    }
+    else if (sr1 & (SET_BIT << SHIFT_8))
+    {
+        status = I2C_BUS_ERROR;    // BERR - misplaced start or stop 
+    }
+    else if (sr1 & (SET_BIT << SHIFT_11))
+    {
+        status = I2C_OVERRUN;      // OVR - overrun/underrun 
+    }
+
+    // Clear the error flags (rc_w0) 
+    i2c->SR1 &= ~((SET_BIT << SHIFT_8) | (SET_BIT << SHIFT_9) | 
+                  (SET_BIT << SHIFT_10) | (SET_BIT << SHIFT_11)); 
+
+    if ((engine->head == NULL) || (engine->state == I2C_ASYNC_IDLE) || (status == I2C_OK))
+    {
+        return; 
+    }
+
+    i2c_async_dma_stop(engine); 
+
+    // After an arbitration loss the peripheral is already back in slave mode and 
+    // doesn't own the bus so no stop is sent. 
+    if (status != I2C_ARB_LOST)
+    {
+        i2c_stop(i2c); 
+    }
+
+    if ((status == I2C_NACK) && (engine->attempts < engine->head->retries))
+    {
+        engine->attempts++; 
+        i2c_async_start(engine); 
+        return; 
+    }
+
+    i2c_async_complete(engine, status); 
+}
+
+
+// DMA read complete handler 
+void i2c_async_dma_rx_irq(i2c_async_t *engine)
+{
+    if ((engine == NULL) || (engine->head == NULL) || (engine->state != I2C_ASYNC_READ))
+    {
+        return; 
+    }
+
+    // The last byte was NACKed by the hardware (LAST) so the stop can go out now 
+    engine->i2c->CR2 &= ~((SET_BIT << SHIFT_11) | (SET_BIT << SHIFT_12)); 
+    i2c_stop(engine->i2c); 
+    engine->count = engine->head->rx_len; 
+    i2c_async_complete(engine, I2C_OK); 
+}
+
+
+// Abort the active transaction 
+void i2c_async_abort(i2c_async_t *engine)
+{
+    if ((engine == NULL) || (engine->head == NULL) || (engine->state == I2C_ASYNC_IDLE))
+    {
+        return; 
+    }
+
+    i2c_async_dma_stop(engine); 
+    i2c_stop(engine->i2c); 
+    i2c_async_complete(engine, I2C_TIMEOUT); 
+}
+
+
+// Engine busy status 
+uint8_t i2c_async_busy(const i2c_async_t *engine)
+{
+    if (engine == NULL)
+    {
+        return FALSE; 
+    }
+
+    return (engine->head != NULL) ? TRUE : FALSE; 
+}
+
+
+// Mask the engines interrupts 
+uint32_t i2c_async_lock(i2c_async_t *engine)
+{
+    // The I2C event/error interrupts (ITEVTEN and ITERREN) and the read streams transfer 
+    // complete interrupt (TCIE) can all finish a transaction. A transfer that completes 
+    // while they're masked leaves its flag set and is handled once they're restored. 
+    uint32_t irq_mask = engine->i2c->CR2 & ((SET_BIT << SHIFT_8) | (SET_BIT << SHIFT_9)); 
+    engine->i2c->CR2 &= ~irq_mask; 
+
+    if (engine->dma_rx != NULL)
+    {
+        irq_mask |= engine->dma_rx->CR & (SET_BIT << SHIFT_4); 
+        engine->dma_rx->CR &= ~(SET_BIT << SHIFT_4); 
+    }
+
+    return irq_mask; 
+}
+
+
+// Restore the engines interrupts 
+void i2c_async_unlock(
+    i2c_async_t *engine, 
+    uint32_t irq_mask)
+{
+    // The port bits go back first. A transaction finishing after this point clears them 
+    // itself if the queue is empty so they're never written back over its change. 
+    engine->i2c->CR2 |= irq_mask & ((SET_BIT << SHIFT_8) | (SET_BIT << SHIFT_9)); 
+
+    if (engine->dma_rx != NULL)
+    {
+        engine->dma_rx->CR |= irq_mask & (SET_BIT << SHIFT_4); 
+    }
+}
+
+
+// Finish the active transaction 
+void i2c_async_complete(
+    i2c_async_t *engine, 
+    I2C_STATUS status)
+{
+    i2c_txn_t *txn = engine->head; 
+
+    // Remove the transaction from the queue 
+    engine->head = txn->next; 
+    if (engine->head == NULL)
+    {
+        engine->tail = NULL; 
+
+        // Nothing left to run - disable ITEVTEN, ITERREN and ITBUFEN 
+        engine->i2c->CR2 &= 
+            ~((SET_BIT << SHIFT_8) | (SET_BIT << SHIFT_9) | (SET_BIT << SHIFT_10)); 
+    }
+
+    txn->next = NULL; 
+    txn->status = status; 
+    engine->state = I2C_ASYNC_IDLE; 
+    engine->attempts = CLEAR; 
+
+    if (status == I2C_OK)
+    {
+        engine->completed++; 
+    }
+    else 
+    {
+        engine->errors++; 
+    }
+
+    if (txn->callback != NULL)
+    {
+        txn->callback(txn); 
+    }
+
+    // The callback may have already started the next transaction by submitting 
+    if ((engine->state == I2C_ASYNC_IDLE) && (engine->head != NULL))
+    {
+        i2c_async_start(engine); 
+    }
+}
+
+
+// Stop any DMA transfer used by the active transaction 
+void i2c_async_dma_stop(i2c_async_t *engine)
+{
+    engine->i2c->CR2 &= 
+        ~((SET_BIT << SHIFT_10) | (SET_BIT << SHIFT_11) | (SET_BIT << SHIFT_12)); 
+
+    if ((engine->dma_tx != NULL) && dma_stream_status(engine->dma_tx))
+    {
+        dma_stream_disable(engine->dma_tx); 
+    }
+
+    if ((engine->dma_rx != NULL) && dma_stream_status(engine->dma_rx))
+    {
+        dma_stream_disable(engine->dma_rx); 
+    }
+}
+
+//=======================================================================================
\ No newline at end of file
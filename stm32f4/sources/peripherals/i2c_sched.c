@@ -0,0 +1,421 @@
+/**
+ * @file i2c_sched.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C shared bus scheduler 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "i2c_sched.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define I2C_SCHED_BYTE_BITS 9          // 8 data bits + ACK/NACK 
+#define I2C_SCHED_US_PER_S 1000000 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Estimate the bus time of a transfer 
+ * 
+ * @details Counts the start, address, data, repeated start and stop bits at the bus 
+ *          frequency. Rounded up to the next microsecond. 
+ * 
+ * @param sched : scheduler of the shared port 
+ * @param txn : transfer to estimate 
+ * @return uint32_t : estimated bus time (us)
+ */
+uint32_t i2c_sched_cost(
+    const i2c_sched_t *sched, 
+    const i2c_txn_t *txn); 
+
+
+/**
+ * @brief Dispatch the next transfer 
+ * 
+ * @details Picks the highest priority released slot (earliest deadline between equal 
+ *          priorities) that will finish before any higher priority periodic slot is 
+ *          released and submits it. Does nothing if the bus is in use. 
+ * 
+ * @param sched : scheduler of the shared port 
+ */
+void i2c_sched_dispatch(i2c_sched_t *sched); 
+
+
+/**
+ * @brief Transfer complete callback from the asynchronous engine 
+ * 
+ * @param txn : transaction of the finished slot 
+ */
+void i2c_sched_done(i2c_txn_t *txn); 
+
+
+/**
+ * @brief Deadline of a slot 
+ * 
+ * @param slot : slot to check 
+ * @return uint32_t : time after release the slot should finish by (0 for none)
+ */
+uint32_t i2c_sched_deadline(const i2c_sched_slot_t *slot); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Scheduler functions 
+
+// Scheduler initialization 
+void i2c_sched_init(
+    i2c_sched_t *sched, 
+    i2c_async_t *engine, 
+    i2c_sched_time_t time, 
+    uint32_t bus_hz)
+{
+    if ((sched == NULL) || (engine == NULL) || (time == NULL) || (bus_hz == CLEAR))
+    {
+        return; 
+    }
+
+    sched->engine = engine; 
+    sched->time = time; 
+    sched->bus_hz = bus_hz; 
+    sched->slots = NULL; 
+    sched->active = NULL; 
+    sched->start = CLEAR; 
+    i2c_sched_stats_reset(sched); 
+}
+
+
+// Register a slot 
+I2C_STATUS i2c_sched_add(
+    i2c_sched_t *sched, 
+    i2c_sched_slot_t *slot)
+{
+    if ((sched == NULL) || (sched->engine == NULL) || (slot == NULL) || 
+        (slot->device >= I2C_SCHED_MAX_DEVICES) || 
+        ((slot->txn.tx_len == BYTE_0) && (slot->txn.rx_len == BYTE_0)))
+    {
+        return I2C_NULL_PTR; 
+    }
+
+    if (slot->sched != NULL)
+    {
+        return I2C_BUSY; 
+    }
+
+    uint32_t now = sched->time(); 
+
+    slot->sched = sched; 
+    slot->cost = i2c_sched_cost(sched, &slot->txn); 
+    slot->late = FALSE; 
+    slot->release = now; 
+    slot->next_release = now + slot->period; 
+    slot->pending = (slot->period) ? TRUE : FALSE; 
+    slot->txn.status = I2C_OK; 
+
+    // Insert after any slots of the same or higher priority 
+    uint32_t irq_mask = i2c_async_lock(sched->engine); 
+    i2c_sched_slot_t **link = &sched->slots; 
+
+    while ((*link != NULL) && ((*link)->priority <= slot->priority))
+    {
+        link = &(*link)->next; 
+    }
+
+    slot->next = *link; 
+    *link = slot; 
+    i2c_async_unlock(sched->engine, irq_mask); 
+
+    i2c_sched_dispatch(sched); 
+
+    return I2C_OK; 
+}
+
+
+// Release a one-shot slot 
+I2C_STATUS i2c_sched_request(i2c_sched_slot_t *slot)
+{
+    if ((slot == NULL) || (slot->sched == NULL))
+    {
+        return I2C_NULL_PTR; 
+    }
+
+    i2c_sched_t *sched = slot->sched; 
+    uint32_t irq_mask = i2c_async_lock(sched->engine); 
+
+    if (slot->pending)
+    {
+        i2c_async_unlock(sched->engine, irq_mask); 
+        return I2C_BUSY; 
+    }
+
+    slot->release = sched->time(); 
+    slot->late = FALSE; 
+    slot->pending = TRUE; 
+    i2c_async_unlock(sched->engine, irq_mask); 
+
+    i2c_sched_dispatch(sched); 
+
+    return I2C_OK; 
+}
+
+
+// Run the scheduler 
+void i2c_sched_run(i2c_sched_t *sched)
+{
+    if ((sched == NULL) || (sched->engine == NULL))
+    {
+        return; 
+    }
+
+    uint32_t now = sched->time(); 
+    uint32_t irq_mask = i2c_async_lock(sched->engine); 
+
+    for (i2c_sched_slot_t *slot = sched->slots; slot != NULL; slot = slot->next)
+    {
+        // Periodic release 
+        if (slot->period && ((int32_t)(now - slot->next_release) >= 0))
+        {
+            if (slot == sched->active)
+            {
+                // Still on the bus from the last release - skip this one 
+                sched->stats[slot->device].missed++; 
+            }
+            else 
+            {
+                // A release that never got the bus is replaced by the new one 
+                if (slot->pending && !slot->late)
+                {
+                    sched->stats[slot->device].missed++; 
+                }
+
+                slot->release = slot->next_release; 
+                slot->late = FALSE; 
+                slot->pending = TRUE; 
+            }
+
+            slot->next_release += slot->period; 
+
+            // Don't try to catch up on releases that were missed entirely 
+            if ((int32_t)(now - slot->next_release) >= 0)
+            {
+                slot->next_release = now + slot->period; 
+            }
+        }
+
+        // A release still waiting for the bus past its deadline is counted once 
+        uint32_t deadline = i2c_sched_deadline(slot); 
+
+        if (slot->pending && !slot->late && (slot != sched->active) && deadline && 
+            ((now - slot->release) > deadline))
+        {
+            sched->stats[slot->device].missed++; 
+            slot->late = TRUE; 
+        }
+    }
+
+    i2c_async_unlock(sched->engine, irq_mask); 
+
+    i2c_sched_dispatch(sched); 
+}
+
+
+// Device bus utilization 
+float i2c_sched_utilization(
+    i2c_sched_t *sched, 
+    uint8_t device)
+{
+    if ((sched == NULL) || (sched->time == NULL) || (device >= I2C_SCHED_MAX_DEVICES))
+    {
+        return 0.0f; 
+    }
+
+    uint32_t window = sched->time() - sched->window; 
+
+    if (window == CLEAR)
+    {
+        return 0.0f; 
+    }
+
+    return 100.0f * (float)sched->stats[device].bus_time / (float)window; 
+}
+
+
+// Reset the statistics 
+void i2c_sched_stats_reset(i2c_sched_t *sched)
+{
+    if ((sched == NULL) || (sched->time == NULL))
+    {
+        return; 
+    }
+
+    memset((void *)sched->stats, CLEAR, sizeof(sched->stats)); 
+    sched->window = sched->time(); 
+}
+
+
+// Estimate the bus time of a transfer 
+uint32_t i2c_sched_cost(
+    const i2c_sched_t *sched, 
+    const i2c_txn_t *txn)
+{
+    uint32_t bits = BYTE_1;   // Stop 
+
+    if (txn->tx_len)
+    {
+        // Start + address + data 
+        bits += BYTE_1 + (BYTE_1 + txn->tx_len) * I2C_SCHED_BYTE_BITS; 
+    }
+
+    if (txn->rx_len)
+    {
+        // (Repeated) start + address + data 
+        bits += BYTE_1 + (BYTE_1 + txn->rx_len) * I2C_SCHED_BYTE_BITS; 
+    }
+
+    return (bits * I2C_SCHED_US_PER_S + sched->bus_hz - BYTE_1) / sched->bus_hz; 
+}
+
+
+// Dispatch the next transfer 
+void i2c_sched_dispatch(i2c_sched_t *sched)
+{
+    uint32_t irq_mask = i2c_async_lock(sched->engine); 
+
+    if ((sched->active != NULL) || i2c_async_busy(sched->engine))
+    {
+        i2c_async_unlock(sched->engine, irq_mask); 
+        return; 
+    }
+
+    uint32_t now = sched->time(); 
+    i2c_sched_slot_t *best = NULL; 
+
+    for (i2c_sched_slot_t *slot = sched->slots; slot != NULL; slot = slot->next)
+    {
+        if (!slot->pending)
+        {
+            continue; 
+        }
+
+        // The list is in priority order so a lower priority slot can't beat 'best' 
+        if ((best != NULL) && (slot->priority > best->priority))
+        {
+            break; 
+        }
+
+        // Make sure the transfer is done before any higher priority slot is released 
+        uint8_t fits = TRUE; 
+
+        for (i2c_sched_slot_t *hp = sched->slots; 
+             (hp != NULL) && (hp->priority < slot->priority); 
+             hp = hp->next)
+        {
+            if (hp->period && !hp->pending && 
+                ((int32_t)(hp->next_release - now) < (int32_t)slot->cost))
+            {
+                fits = FALSE; 
+                break; 
+            }
+        }
+
+        if (!fits)
+        {
+            continue; 
+        }
+
+        // Earliest deadline between equal priorities 
+        if ((best == NULL) || 
+            ((int32_t)((slot->release + i2c_sched_deadline(slot)) - 
+                       (best->release + i2c_sched_deadline(best))) < 0))
+        {
+            best = slot; 
+        }
+    }
+
+    if (best != NULL)
+    {
+        sched->active = best; 
+        sched->start = now; 
+        best->txn.callback = i2c_sched_done; 
+        best->txn.context = best; 
+
+        if (i2c_async_submit(sched->engine, &best->txn) != I2C_OK)
+        {
+            // Invalid transfer - drop the release 
+            sched->active = NULL; 
+            best->pending = FALSE; 
+            sched->stats[best->device].errors++; 
+        }
+    }
+
+    i2c_async_unlock(sched->engine, irq_mask); 
+}
+
+
+// Transfer complete callback from the asynchronous engine 
+void i2c_sched_done(i2c_txn_t *txn)
+{
+    i2c_sched_slot_t *slot = (i2c_sched_slot_t *)txn->context; 
+    i2c_sched_t *sched = slot->sched; 
+    i2c_sched_stats_t *stats = &sched->stats[slot->device]; 
+    uint32_t now = sched->time(); 
+    uint32_t latency = now - slot->release; 
+    uint32_t deadline = i2c_sched_deadline(slot); 
+
+    // Update the device statistics 
+    stats->bus_time += now - sched->start; 
+    stats->transfers++; 
+
+    if (txn->status != I2C_OK)
+    {
+        stats->errors++; 
+    }
+
+    if (deadline && (latency > deadline) && !slot->late)
+    {
+        stats->missed++; 
+    }
+
+    if (latency > stats->latency_max)
+    {
+        stats->latency_max = latency; 
+    }
+
+    slot->pending = FALSE; 
+    sched->active = NULL; 
+
+    if (slot->callback != NULL)
+    {
+        slot->callback(slot); 
+    }
+
+    // Next transfer goes out right away 
+    i2c_sched_dispatch(sched); 
+}
+
+
+// Deadline of a slot 
+uint32_t i2c_sched_deadline(const i2c_sched_slot_t *slot)
+{
+    return (slot->deadline) ? slot->deadline : slot->period; 
+}
+
+//=======================================================================================
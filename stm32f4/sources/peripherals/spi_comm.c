@@ -24,6 +24,17 @@
 // Macros 
 
 #define SPI_TIMEOUT_COUNT 10000
+#define SPI_DMA_MAX_LEN 0xFFFF     // NDTR is 16 bits 
+#define SPI_CR1_BR_MASK 0x07       // Baud rate control bits (before shifting) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// DMA engines registered with spi_dma_init 
+static spi_dma_t *spi_dma_engines[SPI_DMA_PORTS]; 
 
 //=======================================================================================
 
@@ -88,6 +99,50 @@ void spi_rxne_wait(SPI_TypeDef *spi);
  */
 void spi_bsy_wait(SPI_TypeDef *spi);
 
+
+/**
+ * @brief Polled full-duplex transfer 
+ * 
+ * @details Same as spi_write_read except each byte sent comes from 'write_data' (or 
+ *          'fill') and received bytes are discarded if 'read_data' is NULL. 
+ * 
+ * @param spi : pointer to spi port 
+ * @param write_data : data to send (NULL to send 'fill') 
+ * @param read_data : buffer to store the read data (NULL to discard it) 
+ * @param fill : byte sent when there's no write data 
+ * @param data_len : length of the transfer (bytes) 
+ * @return SPI_STATUS : SPI status 
+ */
+SPI_STATUS spi_transfer_poll(
+    SPI_TypeDef *spi, 
+    const uint8_t *write_data, 
+    uint8_t *read_data, 
+    uint8_t fill, 
+    uint32_t data_len); 
+
+
+/**
+ * @brief Find the DMA engine registered for a port 
+ * 
+ * @param spi : pointer to spi port 
+ * @return spi_dma_t* : engine of the port, NULL if there isn't one 
+ */
+spi_dma_t *spi_dma_engine(const SPI_TypeDef *spi); 
+
+
+/**
+ * @brief Finish the active DMA transfer 
+ * 
+ * @details Stops the SPI DMA requests and both streams, waits for the last byte to leave 
+ *          the port then runs the callback. 
+ * 
+ * @param engine : engine of the spi port 
+ * @param status : result of the transfer 
+ */
+void spi_dma_complete(
+    spi_dma_t *engine, 
+    SPI_STATUS status); 
+
 //=======================================================================================
 
 
@@ -195,6 +250,64 @@ void spi_ss_init(
 //=======================================================================================
 
 
+//=======================================================================================
+// Clock functions 
+
+// SPI baud rate control for a clock frequency 
+spi_baud_rate_ctrl_t spi_baud_select(
+    uint32_t pclk, 
+    uint32_t max_freq)
+{
+    spi_baud_rate_ctrl_t baud_rate_ctrl = SPI_BR_FPCLK_2; 
+
+    // Each step doubles the divider (F_PCLK/2 to F_PCLK/256) 
+    while (((pclk >> (baud_rate_ctrl + BYTE_1)) > max_freq) && 
+           (baud_rate_ctrl < SPI_BR_FPCLK_256))
+    {
+        baud_rate_ctrl++; 
+    }
+
+    return baud_rate_ctrl; 
+}
+
+
+// SPI port clock frequency 
+uint32_t spi_get_pclk(const SPI_TypeDef *spi)
+{
+    get_sys_clk_init(); 
+
+    if ((spi == SPI2) || (spi == SPI3))
+    {
+        return rcc_get_pclk1_frq(); 
+    }
+
+    return rcc_get_pclk2_frq(); 
+}
+
+
+// SPI set baud rate 
+void spi_set_baud(
+    SPI_TypeDef *spi, 
+    spi_baud_rate_ctrl_t baud_rate_ctrl)
+{
+    if (spi == NULL)
+    {
+        return; 
+    }
+
+    // Let the last byte finish before the clock changes 
+    spi_txe_wait(spi); 
+    spi_bsy_wait(spi); 
+
+    spi_disable(spi); 
+    spi->CR1 = (spi->CR1 & ~(SPI_CR1_BR_MASK << SHIFT_3)) | 
+               ((baud_rate_ctrl & SPI_CR1_BR_MASK) << SHIFT_3); 
+    spi_enable(spi); 
+}
+
+//=======================================================================================
+
+
 //=======================================================================================
 // SPI register functions 
 
@@ -335,3 +448,320 @@ SPI_STATUS spi_write_read(
 }
 
 //=======================================================================================
+
+
+// SPI full-duplex transfer 
+SPI_STATUS spi_transfer(
+    SPI_TypeDef *spi, 
+    const uint8_t *write_data, 
+    uint8_t *read_data, 
+    uint8_t fill, 
+    uint32_t data_len)
+{
+    // Argument check - NULL pointers and zero length 
+    if ((spi == NULL) || !data_len) 
+    {
+        return SPI_OK; 
+    }
+
+    spi_dma_t *engine = spi_dma_engine(spi); 
+
+    // Short transfers are done before the DMA could be set up 
+    if ((engine == NULL) || (data_len < SPI_DMA_MIN_LEN) || (data_len > SPI_DMA_MAX_LEN))
+    {
+        return spi_transfer_poll(spi, write_data, read_data, fill, data_len); 
+    }
+
+    SPI_STATUS spi_status = 
+        spi_transfer_dma(engine, write_data, read_data, fill, data_len, NULL, NULL); 
+
+    if (spi_status != SPI_OK)
+    {
+        return spi_status; 
+    }
+
+    return spi_dma_wait(engine); 
+}
+
+
+// Polled full-duplex transfer 
+SPI_STATUS spi_transfer_poll(
+    SPI_TypeDef *spi, 
+    const uint8_t *write_data, 
+    uint8_t *read_data, 
+    uint8_t fill, 
+    uint32_t data_len)
+{
+    uint8_t data; 
+
+    // Write the first piece of data 
+    spi_txe_wait(spi); 
+    spi->DR = (write_data != NULL) ? *write_data++ : fill; 
+
+    // Iterate through all data to be sent and received 
+    for (uint32_t i = BYTE_1; i < data_len; i++)
+    {
+        spi_txe_wait(spi); 
+        spi->DR = (write_data != NULL) ? *write_data++ : fill; 
+
+        spi_rxne_wait(spi); 
+        data = spi->DR; 
+
+        if (read_data != NULL)
+        {
+            *read_data++ = data; 
+        }
+    }
+
+    // Read the last piece of data 
+    spi_rxne_wait(spi); 
+    data = spi->DR; 
+
+    if (read_data != NULL)
+    {
+        *read_data = data; 
+    }
+
+    // Wait for TXE bit to set 
+    spi_txe_wait(spi); 
+
+    // Wait for BSY to clear 
+    spi_bsy_wait(spi); 
+
+    return SPI_OK; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// DMA transfers 
+
+// SPI DMA engine initialization 
+void spi_dma_init(
+    spi_dma_t *engine, 
+    SPI_TypeDef *spi, 
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef *dma_tx, 
+    DMA_Stream_TypeDef *dma_rx, 
+    spi_yield_t yield)
+{
+    if ((engine == NULL) || (spi == NULL) || (dma == NULL) || 
+        (dma_tx == NULL) || (dma_rx == NULL))
+    {
+        return; 
+    }
+
+    memset((void *)engine, CLEAR, sizeof(spi_dma_t)); 
+    engine->spi = spi; 
+    engine->dma = dma; 
+    engine->dma_tx = dma_tx; 
+    engine->dma_rx = dma_rx; 
+    engine->yield = yield; 
+
+    // Replace the ports existing engine or take the first free slot 
+    spi_dma_t **slot = NULL; 
+
+    for (uint8_t i = CLEAR; i < SPI_DMA_PORTS; i++)
+    {
+        if ((spi_dma_engines[i] != NULL) && (spi_dma_engines[i]->spi == spi))
+        {
+            slot = &spi_dma_engines[i]; 
+            break; 
+        }
+
+        if ((spi_dma_engines[i] == NULL) && (slot == NULL))
+        {
+            slot = &spi_dma_engines[i]; 
+        }
+    }
+
+    if (slot != NULL)
+    {
+        *slot = engine; 
+    }
+}
+
+
+// Start a DMA full-duplex transfer 
+SPI_STATUS spi_transfer_dma(
+    spi_dma_t *engine, 
+    const uint8_t *write_data, 
+    uint8_t *read_data, 
+    uint8_t fill, 
+    uint32_t data_len, 
+    spi_dma_callback_t callback, 
+    void *context)
+{
+    if ((engine == NULL) || (engine->spi == NULL) || !data_len || 
+        (data_len > SPI_DMA_MAX_LEN))
+    {
+        return SPI_NULL_PTR; 
+    }
+
+    if (engine->busy)
+    {
+        return SPI_BUSY; 
+    }
+
+    SPI_TypeDef *spi = engine->spi; 
+
+    engine->busy = TRUE; 
+    engine->fill = fill; 
+    engine->callback = callback; 
+    engine->context = context; 
+
+    // Empty the RX buffer and clear any overrun left by polled transfers 
+    dummy_read(spi->DR); 
+    dummy_read(spi->SR); 
+
+    dma_clear_stream_flags(engine->dma, engine->dma_rx); 
+    dma_clear_stream_flags(engine->dma, engine->dma_tx); 
+
+    // Without a buffer the memory address is fixed on the fill or sink byte 
+    dma_stream_config(
+        engine->dma_rx, 
+        (uint32_t)(uintptr_t)(&spi->DR), 
+        (read_data != NULL) ? (uint32_t)(uintptr_t)read_data : 
+                              (uint32_t)(uintptr_t)(&engine->sink), 
+        (uint32_t)NULL_CHAR, 
+        (uint16_t)data_len); 
+    dma_minc(engine->dma_rx, (read_data != NULL) ? DMA_ADDR_INCREMENT : DMA_ADDR_FIXED); 
+
+    dma_stream_config(
+        engine->dma_tx, 
+        (uint32_t)(uintptr_t)(&spi->DR), 
+        (write_data != NULL) ? (uint32_t)(uintptr_t)write_data : 
+                               (uint32_t)(uintptr_t)(&engine->fill), 
+        (uint32_t)NULL_CHAR, 
+        (uint16_t)data_len); 
+    dma_minc(engine->dma_tx, (write_data != NULL) ? DMA_ADDR_INCREMENT : DMA_ADDR_FIXED); 
+
+    // The receive side is ready before the first byte goes out so nothing is overrun 
+    spi->CR2 |= (SET_BIT << SHIFT_0);     // RXDMAEN 
+    dma_stream_enable(engine->dma_rx); 
+    dma_stream_enable(engine->dma_tx); 
+    spi->CR2 |= (SET_BIT << SHIFT_1);     // TXDMAEN 
+
+    return SPI_OK; 
+}
+
+
+// DMA receive complete handler 
+void spi_dma_rx_irq(spi_dma_t *engine)
+{
+    if ((engine == NULL) || !engine->busy)
+    {
+        return; 
+    }
+
+    spi_dma_complete(engine, SPI_OK); 
+}
+
+
+// Wait for the active DMA transfer 
+SPI_STATUS spi_dma_wait(spi_dma_t *engine)
+{
+    if (engine == NULL)
+    {
+        return SPI_NULL_PTR; 
+    }
+
+    SPI_STATUS spi_status = SPI_OK; 
+    uint32_t timeout = (engine->dma_rx->NDTR + BYTE_1) * SPI_TIMEOUT_COUNT; 
+
+    // The RX stream clears its EN bit once the last byte is received so without the 
+    // transfer complete interrupt (TCIE) the transfer can be finished here. 
+    while (engine->busy)
+    {
+        if (!(engine->dma_rx->CR & (SET_BIT << SHIFT_4)) && 
+            !dma_stream_status(engine->dma_rx))
+        {
+            spi_dma_complete(engine, SPI_OK); 
+        }
+        else if (!--timeout)
+        {
+            spi_status = SPI_TIMEOUT; 
+            spi_dma_complete(engine, spi_status); 
+        }
+        else if (engine->yield != NULL)
+        {
+            engine->yield(); 
+        }
+    }
+
+    return spi_status; 
+}
+
+
+// Engine busy status 
+uint8_t spi_dma_busy(const spi_dma_t *engine)
+{
+    if (engine == NULL)
+    {
+        return FALSE; 
+    }
+
+    return engine->busy ? TRUE : FALSE; 
+}
+
+
+// Find the DMA engine registered for a port 
+spi_dma_t *spi_dma_engine(const SPI_TypeDef *spi)
+{
+    for (uint8_t i = CLEAR; i < SPI_DMA_PORTS; i++)
+    {
+        if ((spi_dma_engines[i] != NULL) && (spi_dma_engines[i]->spi == spi))
+        {
+            return spi_dma_engines[i]; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Finish the active DMA transfer 
+void spi_dma_complete(
+    spi_dma_t *engine, 
+    SPI_STATUS status)
+{
+    SPI_TypeDef *spi = engine->spi; 
+
+    // Disable TXDMAEN and RXDMAEN 
+    spi->CR2 &= ~((SET_BIT << SHIFT_0) | (SET_BIT << SHIFT_1)); 
+
+    if (dma_stream_status(engine->dma_tx))
+    {
+        dma_stream_disable(engine->dma_tx); 
+    }
+
+    if (dma_stream_status(engine->dma_rx))
+    {
+        dma_stream_disable(engine->dma_rx); 
+    }
+
+    // The RX stream finishes after the last byte is clocked in so the port is idle unless 
+    // the transfer was cut short 
+    spi_bsy_wait(spi); 
+    dummy_read(spi->DR); 
+    dummy_read(spi->SR); 
+
+    if (status == SPI_OK)
+    {
+        engine->transfers++; 
+    }
+    else 
+    {
+        engine->errors++; 
+    }
+
+    engine->busy = FALSE; 
+
+    if (engine->callback != NULL)
+    {
+        engine->callback(engine, status, engine->context); 
+    }
+}
+
+//=======================================================================================
@@ -26,6 +26,34 @@
 #define UART_GET_TIMEOUT 10000        // Max number of times to get for received data 
 #define CURSOR_MOVE_BUFF_SIZE 10 
 
+// Status and control bits 
+#define UART_SR_IDLE (SET_BIT << SHIFT_4) 
+#define UART_SR_TC (SET_BIT << SHIFT_6) 
+#define UART_SR_TXE (SET_BIT << SHIFT_7) 
+#define UART_CR1_IDLEIE (SET_BIT << SHIFT_4) 
+#define UART_CR1_TXEIE (SET_BIT << SHIFT_7) 
+#define UART_CR1_UE (SET_BIT << SHIFT_13) 
+#define UART_CR1_OVER8 (SET_BIT << SHIFT_15) 
+#define UART_CR3_DMAR (SET_BIT << SHIFT_6) 
+#define UART_CR3_DMAT (SET_BIT << SHIFT_7) 
+#define UART_DMA_TCIE (SET_BIT << SHIFT_4) 
+
+// Baud rate 
+#define UART_DIV_OVER16_MIN 16        // Smallest USARTDIV (1/16 units) with OVER8 clear 
+#define UART_DIV_OVER8_MIN 8          // Smallest USARTDIV (1/8 units) with OVER8 set 
+#define UART_DIV_MAX 0xFFFF           // 12-bit mantissa and 4-bit fraction 
+#define UART_DIV_FRAC_OVER8 0x07      // OVER8 fraction bits (bit 3 must be clear) 
+#define UART_PPM 1000000 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Transmit buffers registered with uart_tx_buff_init 
+static uart_tx_buff_t *uart_tx_buffs[UART_TX_PORTS]; 
+
 //=======================================================================================
 
 
@@ -48,6 +76,69 @@ uint8_t uart_idle_line_status(USART_TypeDef *uart);
  */
 void uart_idle_line_clear(USART_TypeDef *uart); 
 
+
+/**
+ * @brief Find the transmit buffer registered for a port 
+ * 
+ * @param uart : UART port to use 
+ * @return uart_tx_buff_t* : transmit buffer of the port, NULL if there isn't one 
+ */
+uart_tx_buff_t *uart_tx_buff_get(const USART_TypeDef *uart); 
+
+
+/**
+ * @brief Add data to a transmit buffer 
+ * 
+ * @details Copies the data into the buffer, applying the overflow policy if it doesn't 
+ *          fit, then enables the TXE interrupt so the buffer is sent. 
+ * 
+ * @param tx_buff : transmit buffer 
+ * @param data : data to add 
+ * @param data_len : length of the data 
+ */
+void uart_tx_buff_write(
+    uart_tx_buff_t *tx_buff, 
+    const uint8_t *data, 
+    uint16_t data_len); 
+
+
+/**
+ * @brief Free space in a transmit buffer 
+ * 
+ * @param tx_buff : transmit buffer 
+ * @return uint16_t : bytes that can be added 
+ */
+uint16_t uart_tx_buff_space(const uart_tx_buff_t *tx_buff); 
+
+
+/**
+ * @brief Send the next buffered byte by polling 
+ * 
+ * @details Masks the TXE interrupt and sends the next byte if the data register is 
+ *          empty. The interrupt is restored if there's still data left. Used to make room 
+ *          for the block policy and to flush. 
+ * 
+ * @param tx_buff : transmit buffer 
+ * @return uint8_t : TRUE if there's still data in the buffer 
+ */
+uint8_t uart_tx_buff_poll(uart_tx_buff_t *tx_buff); 
+
+
+/**
+ * @brief Start the DMA on the fill buffer and swap buffers 
+ * 
+ * @param tx : DMA transmit 
+ */
+void uart_dma_tx_start(uart_dma_tx_t *tx); 
+
+
+/**
+ * @brief Wait for the DMA to take the queued fill buffer 
+ * 
+ * @param tx : DMA transmit 
+ */
+void uart_dma_tx_wait(uart_dma_tx_t *tx); 
+
 //=======================================================================================
 
 
@@ -155,6 +246,106 @@ void uart_data_frame_config(
 }
 
 
+// Calculate the baud rate register setting 
+UART_STATUS uart_baud_calc(
+    uint32_t pclk, 
+    uint32_t baud, 
+    uart_baud_t *setting)
+{
+    if (setting == NULL)
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    if ((pclk == CLEAR) || (baud == CLEAR))
+    {
+        return UART_BAD_DATA; 
+    }
+
+    // USARTDIV in 1/16 (OVER8 = 0) or 1/8 (OVER8 = 1) units is pclk / baud in both modes 
+    uint32_t div = (pclk + (baud >> SHIFT_1)) / baud; 
+
+    if ((div > UART_DIV_MAX) || (div < UART_DIV_OVER8_MIN))
+    {
+        return UART_BAD_DATA; 
+    }
+
+    if (div >= UART_DIV_OVER16_MIN)
+    {
+        setting->over8 = FALSE; 
+        setting->brr = (uint16_t)div; 
+    }
+    else 
+    {
+        // Fraction is 3 bits and the mantissa stays in bits 4-15 
+        setting->over8 = TRUE; 
+        setting->brr = (uint16_t)(((div & ~UART_DIV_FRAC_OVER8) << SHIFT_1) | 
+                                  (div & UART_DIV_FRAC_OVER8)); 
+    }
+
+    setting->baud = (pclk + (div >> SHIFT_1)) / div; 
+    setting->error_ppm = (int32_t)((((int64_t)setting->baud - (int64_t)baud) * UART_PPM) / 
+                                   (int64_t)baud); 
+
+    return UART_OK; 
+}
+
+
+// Set the baud rate 
+UART_STATUS uart_set_baud(
+    USART_TypeDef *uart, 
+    uint32_t baud, 
+    uart_baud_t *setting)
+{
+    if (uart == NULL)
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    if ((uart != USART1) && (uart != USART2) && (uart != USART6))
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    // Refresh the stored clock in case it hasn't been read or has changed 
+    get_sys_clk_init(); 
+
+    // USART2 is on APB1, USART1 and USART6 are on APB2 
+    uint32_t pclk = (uart == USART2) ? rcc_get_pclk1_frq() : rcc_get_pclk2_frq(); 
+
+    uart_baud_t result; 
+    UART_STATUS status = uart_baud_calc(pclk, baud, &result); 
+
+    if (status != UART_OK)
+    {
+        return status; 
+    }
+
+    // OVER8 can only be written while the port is disabled 
+    while (!(uart->SR & UART_SR_TC)); 
+    uart->CR1 &= ~UART_CR1_UE; 
+
+    if (result.over8)
+    {
+        uart->CR1 |= UART_CR1_OVER8; 
+    }
+    else 
+    {
+        uart->CR1 &= ~UART_CR1_OVER8; 
+    }
+
+    uart->BRR = result.brr; 
+    uart->CR1 |= UART_CR1_UE; 
+
+    if (setting != NULL)
+    {
+        *setting = result; 
+    }
+
+    return UART_OK; 
+}
+
+
 // UART interrupt initialization 
 void uart_interrupt_init(
     USART_TypeDef *uart, 
@@ -250,6 +441,14 @@ void uart_send_char(
         return; 
     }
 
+    uart_tx_buff_t *tx_buff = uart_tx_buff_get(uart); 
+
+    if (tx_buff != NULL)
+    {
+        uart_tx_buff_write(tx_buff, &character, BYTE_1); 
+        return; 
+    }
+
     // Write the data to the data register then read the Transmission Complete (TC) bit 
     // in the status register continuously until it is set. 
     uart->DR = character; 
@@ -267,6 +466,14 @@ void uart_send_str(
         return; 
     }
 
+    uart_tx_buff_t *tx_buff = uart_tx_buff_get(uart); 
+
+    if (tx_buff != NULL)
+    {
+        uart_tx_buff_write(tx_buff, (const uint8_t *)string, (uint16_t)strlen(string)); 
+        return; 
+    }
+
     while ((*string != NULL_CHAR) && (string != NULL))
     {
         uart_send_char(uart, *string++); 
@@ -285,6 +492,14 @@ void uart_send_data(
         return; 
     }
 
+    uart_tx_buff_t *tx_buff = uart_tx_buff_get(uart); 
+
+    if (tx_buff != NULL)
+    {
+        uart_tx_buff_write(tx_buff, data, data_len); 
+        return; 
+    }
+
     for (uint16_t i = CLEAR; (i < data_len) && (data != NULL); i++)
     {
         uart_send_char(uart, *data++); 
@@ -397,6 +612,621 @@ void uart_cursor_move(
 //=======================================================================================
 
 
+//=======================================================================================
+// Transmit buffer 
+
+// UART transmit buffer initialization 
+UART_STATUS uart_tx_buff_init(
+    uart_tx_buff_t *tx_buff, 
+    USART_TypeDef *uart, 
+    uint8_t *buff, 
+    uint16_t size, 
+    uart_tx_policy_t policy)
+{
+    if ((tx_buff == NULL) || (uart == NULL) || (buff == NULL) || (size < BYTE_2))
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    // Anything left in the ports current buffer goes out first 
+    uart_tx_flush(uart); 
+
+    tx_buff->uart = uart; 
+    tx_buff->buff = buff; 
+    tx_buff->size = size; 
+    tx_buff->head = CLEAR; 
+    tx_buff->tail = CLEAR; 
+    tx_buff->policy = policy; 
+    tx_buff->dropped = CLEAR; 
+
+    // Replace the ports existing buffer or take the first free slot 
+    uart_tx_buff_t **slot = NULL; 
+
+    for (uint8_t i = CLEAR; i < UART_TX_PORTS; i++)
+    {
+        if ((uart_tx_buffs[i] != NULL) && (uart_tx_buffs[i]->uart == uart))
+        {
+            slot = &uart_tx_buffs[i]; 
+            break; 
+        }
+
+        if ((uart_tx_buffs[i] == NULL) && (slot == NULL))
+        {
+            slot = &uart_tx_buffs[i]; 
+        }
+    }
+
+    if (slot == NULL)
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    *slot = tx_buff; 
+
+    return UART_OK; 
+}
+
+
+// UART transmit interrupt handler 
+void uart_tx_buff_irq(uart_tx_buff_t *tx_buff)
+{
+    if (tx_buff == NULL)
+    {
+        return; 
+    }
+
+    USART_TypeDef *uart = tx_buff->uart; 
+
+    if (!(uart->CR1 & UART_CR1_TXEIE) || !(uart->SR & UART_SR_TXE))
+    {
+        return; 
+    }
+
+    uint16_t tail = tx_buff->tail; 
+
+    if (tail != tx_buff->head)
+    {
+        uart->DR = tx_buff->buff[tail]; 
+        tx_buff->tail = (tail + BYTE_1) % tx_buff->size; 
+    }
+
+    // Nothing left to send - the send functions enable the interrupt again 
+    if (tx_buff->tail == tx_buff->head)
+    {
+        uart->CR1 &= ~UART_CR1_TXEIE; 
+    }
+}
+
+
+// UART transmit flush 
+void uart_tx_flush(USART_TypeDef *uart)
+{
+    if (uart == NULL)
+    {
+        return; 
+    }
+
+    uart_tx_buff_t *tx_buff = uart_tx_buff_get(uart); 
+
+    if (tx_buff != NULL)
+    {
+        while (uart_tx_buff_poll(tx_buff)); 
+    }
+
+    while (!(uart->SR & UART_SR_TC)); 
+}
+
+
+// Find the transmit buffer registered for a port 
+uart_tx_buff_t *uart_tx_buff_get(const USART_TypeDef *uart)
+{
+    for (uint8_t i = CLEAR; i < UART_TX_PORTS; i++)
+    {
+        if ((uart_tx_buffs[i] != NULL) && (uart_tx_buffs[i]->uart == uart))
+        {
+            return uart_tx_buffs[i]; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Add data to a transmit buffer 
+void uart_tx_buff_write(
+    uart_tx_buff_t *tx_buff, 
+    const uint8_t *data, 
+    uint16_t data_len)
+{
+    USART_TypeDef *uart = tx_buff->uart; 
+    uint16_t capacity = tx_buff->size - BYTE_1; 
+    uint16_t space = uart_tx_buff_space(tx_buff); 
+
+    if (data_len > space)
+    {
+        if (tx_buff->policy == UART_TX_DROP)
+        {
+            tx_buff->dropped += data_len; 
+            return; 
+        }
+
+        if (tx_buff->policy == UART_TX_OVERWRITE)
+        {
+            // Only the end of data longer than the buffer can be kept 
+            if (data_len > capacity)
+            {
+                tx_buff->dropped += data_len - capacity; 
+                data += data_len - capacity; 
+                data_len = capacity; 
+            }
+
+            // The interrupt also moves the tail so it's masked while the oldest data is 
+            // discarded 
+            uint32_t txeie = uart->CR1 & UART_CR1_TXEIE; 
+            uart->CR1 &= ~UART_CR1_TXEIE; 
+            space = uart_tx_buff_space(tx_buff); 
+
+            if (data_len > space)
+            {
+                tx_buff->tail = (tx_buff->tail + (data_len - space)) % tx_buff->size; 
+                tx_buff->dropped += data_len - space; 
+            }
+
+            uart->CR1 |= txeie; 
+        }
+    }
+
+    // Copy the data in pieces that fit. Only the block policy loops here. 
+    while (data_len)
+    {
+        space = uart_tx_buff_space(tx_buff); 
+
+        if (space == CLEAR)
+        {
+            uart_tx_buff_poll(tx_buff); 
+            continue; 
+        }
+
+        uint16_t head = tx_buff->head; 
+        uint16_t chunk = (data_len < space) ? data_len : space; 
+        uint16_t first = tx_buff->size - head; 
+
+        // Wrap around the end of the buffer 
+        if (chunk <= first)
+        {
+            memcpy((void *)&tx_buff->buff[head], (void *)data, chunk); 
+        }
+        else 
+        {
+            memcpy((void *)&tx_buff->buff[head], (void *)data, first); 
+            memcpy((void *)tx_buff->buff, (void *)&data[first], chunk - first); 
+        }
+
+        tx_buff->head = (head + chunk) % tx_buff->size; 
+        data += chunk; 
+        data_len -= chunk; 
+
+        // Start (or keep) the interrupt sending the buffer 
+        uart->CR1 |= UART_CR1_TXEIE; 
+    }
+}
+
+
+// Free space in a transmit buffer 
+uint16_t uart_tx_buff_space(const uart_tx_buff_t *tx_buff)
+{
+    uint16_t head = tx_buff->head; 
+    uint16_t tail = tx_buff->tail; 
+    uint16_t used = (head >= tail) ? (head - tail) : (tx_buff->size - tail + head); 
+
+    return tx_buff->size - BYTE_1 - used; 
+}
+
+
+// Send the next buffered byte by polling 
+uint8_t uart_tx_buff_poll(uart_tx_buff_t *tx_buff)
+{
+    USART_TypeDef *uart = tx_buff->uart; 
+    uint32_t txeie = uart->CR1 & UART_CR1_TXEIE; 
+
+    uart->CR1 &= ~UART_CR1_TXEIE; 
+
+    if ((tx_buff->tail != tx_buff->head) && (uart->SR & UART_SR_TXE))
+    {
+        uart->DR = tx_buff->buff[tx_buff->tail]; 
+        tx_buff->tail = (tx_buff->tail + BYTE_1) % tx_buff->size; 
+    }
+
+    if (tx_buff->tail == tx_buff->head)
+    {
+        return FALSE; 
+    }
+
+    uart->CR1 |= txeie; 
+
+    return TRUE; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Receive stream 
+
+// UART DMA receive stream initialization 
+UART_STATUS uart_rx_stream_init(
+    uart_rx_stream_t *stream, 
+    USART_TypeDef *uart, 
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef *dma_stream, 
+    uint8_t *buff, 
+    uint16_t size, 
+    uart_rx_stream_callback_t callback, 
+    void *context)
+{
+    if ((stream == NULL) || (uart == NULL) || (dma == NULL) || (dma_stream == NULL) || 
+        (buff == NULL) || (size < BYTE_2))
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    memset((void *)stream, CLEAR, sizeof(uart_rx_stream_t)); 
+    stream->uart = uart; 
+    stream->dma = dma; 
+    stream->dma_stream = dma_stream; 
+    stream->buff = buff; 
+    stream->size = size; 
+    stream->callback = callback; 
+    stream->context = context; 
+
+    // The stream can only be configured while it's disabled 
+    if (dma_stream_status(dma_stream))
+    {
+        dma_stream_disable(dma_stream); 
+    }
+
+    dma_clear_stream_flags(dma, dma_stream); 
+    dma_stream_config(
+        dma_stream, 
+        (uint32_t)(uintptr_t)(&uart->DR), 
+        (uint32_t)(uintptr_t)buff, 
+        (uint32_t)NULL_CHAR, 
+        size); 
+    dma_int_config(dma_stream, DMA_TCIE_ENABLE, DMA_HTIE_ENABLE, 
+                   DMA_TEIE_DISABLE, DMA_DMEIE_DISABLE); 
+
+    // Receive by DMA and interrupt when the line goes idle after a frame 
+    uart->CR3 |= UART_CR3_DMAR; 
+    uart_idle_line_clear(uart); 
+    uart->CR1 |= UART_CR1_IDLEIE; 
+
+    dma_stream_enable(dma_stream); 
+
+    return UART_OK; 
+}
+
+
+// Receive stream interrupt handler 
+void uart_rx_stream_irq(uart_rx_stream_t *stream)
+{
+    if (stream == NULL)
+    {
+        return; 
+    }
+
+    if (uart_idle_line_status(stream->uart))
+    {
+        uart_idle_line_clear(stream->uart); 
+    }
+
+    // NDTR counts down from the buffer size and reloads once it reaches zero 
+    uint16_t head = stream->size - dma_ndt_read(stream->dma_stream); 
+
+    if (head >= stream->size)
+    {
+        head = CLEAR; 
+    }
+
+    uint16_t new_data = (head + stream->size - stream->head) % stream->size; 
+
+    if (new_data == CLEAR)
+    {
+        return; 
+    }
+
+    stream->head = head; 
+    stream->received += new_data; 
+
+    if (stream->callback != NULL)
+    {
+        stream->callback(stream, stream->context); 
+    }
+}
+
+
+// Get the received data without copying it 
+uint16_t uart_rx_stream_peek(
+    uart_rx_stream_t *stream, 
+    uart_rx_span_t *spans)
+{
+    if ((stream == NULL) || (spans == NULL))
+    {
+        return CLEAR; 
+    }
+
+    uint32_t available = stream->received - stream->consumed; 
+
+    // More data than the buffer holds means the DMA has written over unread data. 
+    // Everything up to the current write position is dropped. 
+    if (available > stream->size)
+    {
+        stream->tail = (stream->tail + available) % stream->size; 
+        stream->consumed += available; 
+        stream->overruns++; 
+        available = CLEAR; 
+    }
+
+    uint16_t first = stream->size - stream->tail; 
+
+    spans[0].data = &stream->buff[stream->tail]; 
+    spans[1].data = stream->buff; 
+
+    if (available <= first)
+    {
+        spans[0].size = (uint16_t)available; 
+        spans[1].size = CLEAR; 
+    }
+    else 
+    {
+        spans[0].size = first; 
+        spans[1].size = (uint16_t)available - first; 
+    }
+
+    return (uint16_t)available; 
+}
+
+
+// Release received data 
+void uart_rx_stream_commit(
+    uart_rx_stream_t *stream, 
+    uint16_t size)
+{
+    if (stream == NULL)
+    {
+        return; 
+    }
+
+    uint32_t available = stream->received - stream->consumed; 
+
+    if (size > available)
+    {
+        size = (uint16_t)available; 
+    }
+
+    stream->tail = (stream->tail + size) % stream->size; 
+    stream->consumed += size; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// DMA transmit 
+
+// UART DMA transmit initialization 
+UART_STATUS uart_dma_tx_init(
+    uart_dma_tx_t *tx, 
+    USART_TypeDef *uart, 
+    DMA_TypeDef *dma, 
+    DMA_Stream_TypeDef *dma_stream, 
+    uint8_t *buff_a, 
+    uint8_t *buff_b, 
+    uint16_t size, 
+    uart_yield_t yield)
+{
+    if ((tx == NULL) || (uart == NULL) || (dma == NULL) || (dma_stream == NULL) || 
+        (buff_a == NULL) || (buff_b == NULL) || (size == CLEAR))
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    memset((void *)tx, CLEAR, sizeof(uart_dma_tx_t)); 
+    tx->uart = uart; 
+    tx->dma = dma; 
+    tx->dma_stream = dma_stream; 
+    tx->buff[0] = buff_a; 
+    tx->buff[1] = buff_b; 
+    tx->size = size; 
+    tx->yield = yield; 
+
+    if (dma_stream_status(dma_stream))
+    {
+        dma_stream_disable(dma_stream); 
+    }
+
+    dma_clear_stream_flags(dma, dma_stream); 
+    dma_stream_config(
+        dma_stream, 
+        (uint32_t)(uintptr_t)(&uart->DR), 
+        (uint32_t)(uintptr_t)buff_a, 
+        (uint32_t)NULL_CHAR, 
+        CLEAR); 
+    dma_int_config(dma_stream, DMA_TCIE_ENABLE, DMA_HTIE_DISABLE, 
+                   DMA_TEIE_DISABLE, DMA_DMEIE_DISABLE); 
+
+    uart->CR3 |= UART_CR3_DMAT; 
+
+    return UART_OK; 
+}
+
+
+// Reserve space in the fill buffer 
+uint8_t *uart_dma_tx_reserve(
+    uart_dma_tx_t *tx, 
+    uint16_t data_len)
+{
+    if ((tx == NULL) || (data_len == CLEAR) || (data_len > tx->size))
+    {
+        return NULL; 
+    }
+
+    // A queued fill buffer can't be touched until the DMA has started on it 
+    uart_dma_tx_wait(tx); 
+
+    if ((tx->size - tx->fill_len) < data_len)
+    {
+        uart_dma_tx_send(tx); 
+        uart_dma_tx_wait(tx); 
+    }
+
+    return &tx->buff[tx->fill][tx->fill_len]; 
+}
+
+
+// Add reserved data to the fill buffer 
+void uart_dma_tx_commit(
+    uart_dma_tx_t *tx, 
+    uint16_t data_len)
+{
+    if (tx == NULL)
+    {
+        return; 
+    }
+
+    tx->fill_len += data_len; 
+
+    if (tx->fill_len > tx->size)
+    {
+        tx->fill_len = tx->size; 
+    }
+}
+
+
+// Copy data into the fill buffer 
+UART_STATUS uart_dma_tx_write(
+    uart_dma_tx_t *tx, 
+    const uint8_t *data, 
+    uint16_t data_len)
+{
+    if ((tx == NULL) || (data == NULL))
+    {
+        return UART_INVALID_PTR; 
+    }
+
+    if (data_len == CLEAR)
+    {
+        return UART_OK; 
+    }
+
+    uint8_t *space = uart_dma_tx_reserve(tx, data_len); 
+
+    if (space == NULL)
+    {
+        return UART_BAD_DATA; 
+    }
+
+    memcpy((void *)space, (void *)data, data_len); 
+    uart_dma_tx_commit(tx, data_len); 
+
+    return UART_OK; 
+}
+
+
+// Send the fill buffer 
+void uart_dma_tx_send(uart_dma_tx_t *tx)
+{
+    if ((tx == NULL) || (tx->fill_len == CLEAR) || tx->pending)
+    {
+        return; 
+    }
+
+    // Mask the transfer complete interrupt so the DMA can't finish between checking and 
+    // queueing. A transfer that finishes meanwhile is handled once it's unmasked. 
+    tx->dma_stream->CR &= ~UART_DMA_TCIE; 
+
+    if (tx->busy)
+    {
+        tx->pending = TRUE; 
+    }
+    else 
+    {
+        uart_dma_tx_start(tx); 
+    }
+
+    tx->dma_stream->CR |= UART_DMA_TCIE; 
+}
+
+
+// DMA transmit complete handler 
+void uart_dma_tx_irq(uart_dma_tx_t *tx)
+{
+    if ((tx == NULL) || !tx->busy)
+    {
+        return; 
+    }
+
+    tx->busy = FALSE; 
+
+    if (tx->pending)
+    {
+        tx->pending = FALSE; 
+        uart_dma_tx_start(tx); 
+    }
+}
+
+
+// DMA transmit busy status 
+uint8_t uart_dma_tx_busy(const uart_dma_tx_t *tx)
+{
+    if (tx == NULL)
+    {
+        return FALSE; 
+    }
+
+    return (tx->busy || tx->pending) ? TRUE : FALSE; 
+}
+
+
+// Start the DMA on the fill buffer and swap buffers 
+void uart_dma_tx_start(uart_dma_tx_t *tx)
+{
+    DMA_Stream_TypeDef *dma_stream = tx->dma_stream; 
+
+    dma_clear_stream_flags(tx->dma, dma_stream); 
+    dma_stream_config(
+        dma_stream, 
+        (uint32_t)(uintptr_t)(&tx->uart->DR), 
+        (uint32_t)(uintptr_t)tx->buff[tx->fill], 
+        (uint32_t)NULL_CHAR, 
+        tx->fill_len); 
+
+    // TC is cleared by writing 0 to it - writing 1 to the other flags does nothing 
+    tx->uart->SR = ~UART_SR_TC; 
+
+    tx->bytes += tx->fill_len; 
+    tx->busy = TRUE; 
+    tx->fill ^= SET_BIT; 
+    tx->fill_len = CLEAR; 
+
+    dma_stream_enable(dma_stream); 
+}
+
+
+// Wait for the DMA to take the queued fill buffer 
+void uart_dma_tx_wait(uart_dma_tx_t *tx)
+{
+    while (tx->pending)
+    {
+        if (tx->yield != NULL)
+        {
+            tx->yield(); 
+        }
+    }
+}
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Read Data 
 
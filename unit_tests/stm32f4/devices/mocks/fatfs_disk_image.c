@@ -0,0 +1,619 @@
+/**
+ * @file fatfs_disk_image.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS disk image implementation - for unit testing and host benchmarks 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include <fcntl.h> 
+#include <sys/mman.h> 
+#include <sys/stat.h> 
+#include <time.h> 
+#include <unistd.h> 
+
+#include "fatfs_disk_image.h" 
+#include "fatfs_cache.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Disk status - same as the driver 
+#define FATFS_IMG_STATUS_NOINIT 0x01 
+#define FATFS_IMG_STATUS_PROTECT 0x04 
+
+// IO control commands used by FatFs - same as the driver 
+#define FATFS_IMG_CTRL_SYNC 0 
+#define FATFS_IMG_GET_SECTOR_COUNT 1 
+#define FATFS_IMG_GET_SECTOR_SIZE 2 
+#define FATFS_IMG_CTRL_POWER 5 
+
+#define FATFS_IMG_US_TO_NS 1000 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Disk image record 
+typedef struct fatfs_img_s 
+{
+    int fd; 
+    uint8_t *data; 
+    uint32_t sectors; 
+
+    DISK_STATUS status; 
+    uint8_t protect; 
+    fatfs_cache_t *cache; 
+
+    fatfs_img_profile_t profile; 
+    uint8_t realtime; 
+    uint32_t trace_index; 
+    uint32_t write_count;            // Write commands for the stall interval 
+
+    fatfs_img_stats_t stats; 
+}
+fatfs_img_t; 
+
+static fatfs_img_t img = { .fd = -1, .status = FATFS_IMG_STATUS_NOINIT }; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+// Read sectors from the image 
+DISK_RESULT fatfs_img_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+// Write sectors to the image - one buffer or a buffer per sector 
+DISK_RESULT fatfs_img_write(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+// Write sectors to the image for the sector cache 
+DISK_RESULT fatfs_img_cache_write(
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count); 
+
+
+// Card busy time after a data packet 
+uint32_t fatfs_img_busy_us(uint32_t busy_us); 
+
+
+// Account for the time of a disk function 
+void fatfs_img_elapse(uint32_t time_us); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Disk image functions 
+
+// Open an image file 
+DISK_RESULT fatfs_img_open(
+    const char *path, 
+    uint32_t sectors)
+{
+    struct stat file_stat; 
+
+    if ((path == NULL) || (img.fd >= 0))
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    img.fd = open(path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR); 
+
+    if (img.fd < 0)
+    {
+        return FATFS_RES_ERROR; 
+    }
+
+    if (fstat(img.fd, &file_stat) || 
+        (!sectors && (file_stat.st_size < FATFS_IMG_SEC_SIZE)))
+    {
+        fatfs_img_close(); 
+        return FATFS_RES_ERROR; 
+    }
+
+    if (!sectors)
+    {
+        sectors = (uint32_t)(file_stat.st_size / FATFS_IMG_SEC_SIZE); 
+    }
+    else if ((file_stat.st_size < ((off_t)sectors * FATFS_IMG_SEC_SIZE)) && 
+             ftruncate(img.fd, (off_t)sectors * FATFS_IMG_SEC_SIZE))
+    {
+        fatfs_img_close(); 
+        return FATFS_RES_ERROR; 
+    }
+
+    img.data = (uint8_t *)mmap(NULL, (size_t)sectors * FATFS_IMG_SEC_SIZE, 
+                               PROT_READ | PROT_WRITE, MAP_SHARED, img.fd, 0); 
+
+    if (img.data == MAP_FAILED)
+    {
+        img.data = NULL; 
+        fatfs_img_close(); 
+        return FATFS_RES_ERROR; 
+    }
+
+    img.sectors = sectors; 
+    img.status = FATFS_IMG_STATUS_NOINIT; 
+
+    return FATFS_RES_OK; 
+}
+
+
+// Write the image back to the file and close it 
+DISK_RESULT fatfs_img_close(void)
+{
+    DISK_RESULT result = FATFS_RES_OK; 
+    size_t size = (size_t)img.sectors * FATFS_IMG_SEC_SIZE; 
+
+    if (img.data != NULL)
+    {
+        if (msync(img.data, size, MS_SYNC) || munmap(img.data, size))
+        {
+            result = FATFS_RES_ERROR; 
+        }
+    }
+
+    if ((img.fd >= 0) && close(img.fd))
+    {
+        result = FATFS_RES_ERROR; 
+    }
+
+    img.fd = -1; 
+    img.data = NULL; 
+    img.sectors = CLEAR; 
+    img.status = FATFS_IMG_STATUS_NOINIT; 
+
+    return result; 
+}
+
+
+// Set the card profile 
+void fatfs_img_set_profile(const fatfs_img_profile_t *profile)
+{
+    if (profile != NULL)
+    {
+        img.profile = *profile; 
+    }
+    else 
+    {
+        memset((void *)&img.profile, CLEAR, sizeof(fatfs_img_profile_t)); 
+    }
+
+    img.trace_index = CLEAR; 
+    img.write_count = CLEAR; 
+}
+
+
+// Sleep for the simulated disk function times 
+void fatfs_img_set_realtime(uint8_t realtime)
+{
+    img.realtime = realtime; 
+}
+
+
+// Set the write protect switch 
+void fatfs_img_set_protect(uint8_t protect)
+{
+    img.protect = protect; 
+}
+
+
+// Get the statistics 
+void fatfs_img_get_stats(fatfs_img_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = img.stats; 
+    }
+}
+
+
+// Clear the statistics 
+void fatfs_img_reset_stats(void)
+{
+    memset((void *)&img.stats, CLEAR, sizeof(fatfs_img_stats_t)); 
+}
+
+
+// Simulated time in microseconds 
+uint32_t fatfs_img_time_us(void)
+{
+    return (uint32_t)img.stats.time_us; 
+}
+
+
+// Image data 
+uint8_t *fatfs_img_data(void)
+{
+    return img.data; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Driver functions 
+
+// FATFS user init 
+void fatfs_user_init(
+    SPI_TypeDef *spi, 
+    GPIO_TypeDef *gpio, 
+    uint16_t fatfs_slave_pin)
+{
+    img.status = FATFS_IMG_STATUS_NOINIT; 
+    img.cache = NULL; 
+}
+
+
+// FATFS DMA - no bus to stream on 
+void fatfs_dma_init(spi_dma_t *engine)
+{
+    // 
+}
+
+
+// FATFS end multi-block transfer - writes are always complete 
+DISK_RESULT fatfs_stream_end(void)
+{
+    return FATFS_RES_OK; 
+}
+
+
+// FATFS sector cache 
+DISK_RESULT fatfs_cache_attach(fatfs_cache_t *cache)
+{
+    DISK_RESULT result = FATFS_RES_OK; 
+
+    if ((img.cache != NULL) && (img.status != FATFS_IMG_STATUS_NOINIT))
+    {
+        result = fatfs_cache_flush(img.cache); 
+    }
+
+    if (cache != NULL)
+    {
+        cache->read = fatfs_img_read; 
+        cache->write = fatfs_img_cache_write; 
+        fatfs_cache_invalidate(cache); 
+    }
+
+    img.cache = cache; 
+
+    return result; 
+}
+
+
+// FATFS get card type 
+CARD_TYPE fatfs_get_card_type(void)
+{
+    return (img.data != NULL) ? FATFS_CT_SDC2_BLOCK : FATFS_CT_UNKNOWN; 
+}
+
+
+// FATFS ready to receive commands 
+DISK_RESULT fatfs_ready_rec(void)
+{
+    return (img.data != NULL) ? FATFS_RES_OK : FATFS_RES_NOTRDY; 
+}
+
+
+// FATFS card present 
+DISK_RESULT fatfs_get_existance(void)
+{
+    return (img.data != NULL) ? FATFS_RES_OK : FATFS_RES_NOTRDY; 
+}
+
+
+// FATFS initialization 
+DISK_STATUS fatfs_init(uint8_t pdrv)
+{
+    if (pdrv || (img.data == NULL))
+    {
+        return FATFS_IMG_STATUS_NOINIT; 
+    }
+
+    fatfs_cache_invalidate(img.cache); 
+
+    // Card identification and the CSD read 
+    fatfs_img_elapse(img.profile.cmd_us * BYTE_4 + img.profile.read_access_us); 
+
+    img.status = img.protect ? FATFS_IMG_STATUS_PROTECT : CLEAR; 
+
+    return img.status; 
+}
+
+
+// FATFS disk status 
+DISK_STATUS fatfs_status(uint8_t pdrv)
+{
+    if (pdrv)
+    {
+        return FATFS_IMG_STATUS_NOINIT; 
+    }
+
+    return img.status; 
+}
+
+
+// FATFS read 
+DISK_RESULT fatfs_read(
+    uint8_t pdrv, 
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    if (buff == NULL)
+    {
+        return FATFS_RES_ERROR; 
+    }
+
+    if (pdrv || (count == NONE))
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    if (img.status & FATFS_IMG_STATUS_NOINIT)
+    {
+        return FATFS_RES_NOTRDY; 
+    }
+
+    if (img.cache != NULL)
+    {
+        return fatfs_cache_read(img.cache, buff, sector, count); 
+    }
+
+    return fatfs_img_read(buff, sector, count); 
+}
+
+
+// FATFS write 
+DISK_RESULT fatfs_write(
+    uint8_t pdrv, 
+    const uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    if (buff == NULL)
+    {
+        return FATFS_RES_ERROR; 
+    }
+
+    if (pdrv || (count == NONE))
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    if (img.status & FATFS_IMG_STATUS_NOINIT)
+    {
+        return FATFS_RES_NOTRDY; 
+    }
+
+    if (img.status & FATFS_IMG_STATUS_PROTECT)
+    {
+        return FATFS_RES_WRPRT; 
+    }
+
+    if (img.cache != NULL)
+    {
+        return fatfs_cache_write(img.cache, buff, sector, count); 
+    }
+
+    return fatfs_img_write(buff, NULL, sector, count); 
+}
+
+
+// FATFS IO control 
+DISK_RESULT fatfs_ioctl(
+    uint8_t pdrv, 
+    uint8_t cmd, 
+    void *buff)
+{
+    DISK_RESULT result = FATFS_RES_OK; 
+
+    if (pdrv)
+    {
+        return FATFS_RES_PARERR; 
+    }
+
+    if ((img.status & FATFS_IMG_STATUS_NOINIT) && (cmd != FATFS_IMG_CTRL_POWER))
+    {
+        return FATFS_RES_NOTRDY; 
+    }
+
+    switch (cmd)
+    {
+        case FATFS_IMG_CTRL_SYNC: 
+            if (img.cache != NULL)
+            {
+                result = fatfs_cache_flush(img.cache); 
+            }
+
+            img.stats.syncs++; 
+            break; 
+
+        case FATFS_IMG_GET_SECTOR_COUNT: 
+            *(uint32_t *)buff = img.sectors; 
+            break; 
+
+        case FATFS_IMG_GET_SECTOR_SIZE: 
+            *(uint16_t *)buff = (uint16_t)FATFS_IMG_SEC_SIZE; 
+            break; 
+
+        // Block size, trim, power and the card registers aren't supported by the 
+        // driver either 
+        default: 
+            result = FATFS_RES_PARERR; 
+            break; 
+    }
+
+    return result; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Read sectors from the image 
+DISK_RESULT fatfs_img_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    const fatfs_img_profile_t *profile = &img.profile; 
+    uint32_t time_us; 
+
+    if (((uint64_t)sector + count) > img.sectors)
+    {
+        return FATFS_RES_ERROR; 
+    }
+
+    memcpy((void *)buff, (void *)&img.data[(size_t)sector * FATFS_IMG_SEC_SIZE], 
+           (size_t)count * FATFS_IMG_SEC_SIZE); 
+
+    // CMD17 or CMD18 + CMD12, then the access time and packet of each sector 
+    time_us = profile->cmd_us * ((count > BYTE_1) ? BYTE_2 : BYTE_1); 
+    time_us += count * (profile->read_access_us + profile->sector_us); 
+
+    img.stats.read_cmds++; 
+    img.stats.sectors_read += count; 
+    fatfs_img_elapse(time_us); 
+
+    return FATFS_RES_OK; 
+}
+
+
+// Write sectors to the image 
+DISK_RESULT fatfs_img_write(
+    const uint8_t *buff, 
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    const fatfs_img_profile_t *profile = &img.profile; 
+    uint32_t time_us; 
+
+    if (((uint64_t)sector + count) > img.sectors)
+    {
+        return FATFS_RES_ERROR; 
+    }
+
+    for (uint16_t i = CLEAR; i < count; i++)
+    {
+        memcpy((void *)&img.data[((size_t)sector + i) * FATFS_IMG_SEC_SIZE], 
+               (sectors != NULL) ? (const void *)sectors[i] : 
+                                   (const void *)&buff[(size_t)i * FATFS_IMG_SEC_SIZE], 
+               FATFS_IMG_SEC_SIZE); 
+    }
+
+    // CMD24, or ACMD23 (two commands) + CMD25 with the stop token. Each packet is 
+    // followed by the card busy time. 
+    if (count == BYTE_1)
+    {
+        time_us = profile->cmd_us + profile->sector_us + 
+                  fatfs_img_busy_us(profile->write_busy_us); 
+    }
+    else 
+    {
+        time_us = profile->cmd_us * BYTE_3; 
+
+        for (uint16_t i = CLEAR; i < count; i++)
+        {
+            time_us += profile->sector_us + fatfs_img_busy_us(profile->multi_busy_us); 
+        }
+    }
+
+    // Stalls happen per write command 
+    img.write_count++; 
+
+    if (profile->stall_interval && !(img.write_count % profile->stall_interval))
+    {
+        time_us += profile->stall_us; 
+    }
+
+    img.stats.write_cmds++; 
+    img.stats.sectors_written += count; 
+    fatfs_img_elapse(time_us); 
+
+    return FATFS_RES_OK; 
+}
+
+
+// Write sectors to the image for the sector cache 
+DISK_RESULT fatfs_img_cache_write(
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    return fatfs_img_write(NULL, sectors, sector, count); 
+}
+
+
+// Card busy time after a data packet 
+uint32_t fatfs_img_busy_us(uint32_t busy_us)
+{
+    const fatfs_img_profile_t *profile = &img.profile; 
+
+    if ((profile->trace == NULL) || !profile->trace_len)
+    {
+        return busy_us; 
+    }
+
+    busy_us = profile->trace[img.trace_index++]; 
+
+    if (img.trace_index >= profile->trace_len)
+    {
+        img.trace_index = CLEAR; 
+    }
+
+    return busy_us; 
+}
+
+
+// Account for the time of a disk function 
+void fatfs_img_elapse(uint32_t time_us)
+{
+    img.stats.time_us += time_us; 
+
+    if (time_us > img.stats.max_cmd_us)
+    {
+        img.stats.max_cmd_us = time_us; 
+    }
+
+    if (img.realtime && time_us)
+    {
+        struct timespec delay; 
+        delay.tv_sec = time_us / (FATFS_IMG_US_TO_NS * FATFS_IMG_US_TO_NS); 
+        delay.tv_nsec = (long)(time_us % (FATFS_IMG_US_TO_NS * FATFS_IMG_US_TO_NS)) * 
+                        FATFS_IMG_US_TO_NS; 
+        nanosleep(&delay, NULL); 
+    }
+}
+
+//=======================================================================================
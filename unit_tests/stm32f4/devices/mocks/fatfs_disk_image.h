@@ -0,0 +1,145 @@
+/**
+ * @file fatfs_disk_image.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS disk image interface - for unit testing and host benchmarks 
+ * 
+ * @details Implements the FATFS driver disk functions (fatfs_init, fatfs_status, 
+ *          fatfs_read, fatfs_write and fatfs_ioctl) on top of a memory mapped image file 
+ *          so the FatFs module (user_diskio.c, ff.c) and anything built on it can run on 
+ *          Linux. Link this in place of fatfs_driver.c. 
+ *          
+ *          Each disk function is timed the way the SPI driver sends it to a card: the 
+ *          commands used, the data packets at the bus speed and the card busy time. The 
+ *          times come from a card profile (measured on the hardware) and are added to a 
+ *          simulated clock so results don't depend on the host. Write busy times can also 
+ *          be replayed from a trace of measured times to reproduce the long stalls some 
+ *          cards have. Optionally the host sleeps for the simulated time too. 
+ *          
+ *          The sector cache can be attached (fatfs_cache_attach) the same as with the 
+ *          card. 
+ *          
+ *          The unit tests use the FatFs mock (ff_mock.c). To benchmark FatFs itself link 
+ *          ff.c, diskio.c, ff_gen_drv.c, option/syscall.c, option/ccsbcs.c and 
+ *          user_diskio.c in place of the mock with the ffconf.h under test, then 
+ *          FATFS_LinkDriver(&USER_Driver, path) and f_mkfs/f_mount the image. 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _FATFS_DISK_IMAGE_H_
+#define _FATFS_DISK_IMAGE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "fatfs_driver.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define FATFS_IMG_SEC_SIZE 512 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+// Card timing profile - all times in microseconds 
+typedef struct fatfs_img_profile_s 
+{
+    uint32_t cmd_us;                 // Command and response 
+    uint32_t sector_us;              // One data packet on the bus (depends on the SPI clock) 
+    uint32_t read_access_us;         // Card read access time before each data packet 
+    uint32_t write_busy_us;          // Card busy after a single sector write (CMD24) 
+    uint32_t multi_busy_us;          // Card busy after each packet of a CMD25 write 
+
+    // Long stalls (ex. card garbage collection) 
+    uint32_t stall_us;               // Added to every 'stall_interval'th write command 
+    uint32_t stall_interval;         // 0 for no stalls 
+
+    // Measured busy times replayed in order (in place of the busy times above) - the 
+    // trace isn't copied 
+    const uint32_t *trace; 
+    uint32_t trace_len;              // 0 for no trace 
+}
+fatfs_img_profile_t; 
+
+
+// Disk image statistics 
+typedef struct fatfs_img_stats_s 
+{
+    uint32_t read_cmds;              // fatfs_read calls 
+    uint32_t write_cmds;             // fatfs_write calls 
+    uint32_t sectors_read; 
+    uint32_t sectors_written; 
+    uint32_t syncs; 
+    uint32_t max_cmd_us;             // Longest single disk function 
+    uint64_t time_us;                // Simulated time spent in the disk functions 
+}
+fatfs_img_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Disk image functions 
+
+// Open an image file - it's created (or extended) to 'sectors' sectors. A 'sectors' of 0 
+// uses the size of an existing file. 
+DISK_RESULT fatfs_img_open(
+    const char *path, 
+    uint32_t sectors); 
+
+
+// Write the image back to the file and close it 
+DISK_RESULT fatfs_img_close(void); 
+
+
+// Set the card profile - NULL for no latency 
+void fatfs_img_set_profile(const fatfs_img_profile_t *profile); 
+
+
+// Sleep for the simulated disk function times (FALSE by default) 
+void fatfs_img_set_realtime(uint8_t realtime); 
+
+
+// Set the write protect switch 
+void fatfs_img_set_protect(uint8_t protect); 
+
+
+// Get the statistics 
+void fatfs_img_get_stats(fatfs_img_stats_t *stats); 
+
+
+// Clear the statistics 
+void fatfs_img_reset_stats(void); 
+
+
+// Simulated time in microseconds - can be used as a time source (ex. fatfs_logger) 
+uint32_t fatfs_img_time_us(void); 
+
+
+// Image data (NULL if no image is open) 
+uint8_t *fatfs_img_data(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _FATFS_DISK_IMAGE_H_ 
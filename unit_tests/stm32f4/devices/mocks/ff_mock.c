@@ -0,0 +1,290 @@
+/**
+ * @file ff_mock.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief Mock FatFs file functions implementation - for unit testing 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "ff_mock.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define FF_MOCK_NAME_LEN 32 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Mock file 
+typedef struct ff_mock_file_s 
+{
+    char name[FF_MOCK_NAME_LEN]; 
+    uint8_t data[FF_MOCK_FILE_SIZE]; 
+    uint32_t size; 
+    uint8_t used; 
+    uint8_t expanded; 
+}
+ff_mock_file_t; 
+
+
+// Mock data record 
+typedef struct ff_mock_data_s 
+{
+    ff_mock_file_t files[FF_MOCK_MAX_FILES]; 
+    uint8_t contiguous; 
+    FRESULT write_result; 
+    uint32_t write_time; 
+    uint32_t time; 
+
+    uint32_t write_offset[FF_MOCK_MAX_WRITES]; 
+    uint32_t write_len[FF_MOCK_MAX_WRITES]; 
+    uint16_t write_count; 
+    uint16_t sync_count; 
+}
+ff_mock_data_t; 
+
+static ff_mock_data_t mock_data; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Mock functions 
+
+// Mock initialization 
+void ff_mock_init(void)
+{
+    memset((void *)&mock_data, CLEAR, sizeof(ff_mock_data_t)); 
+    mock_data.contiguous = TRUE; 
+    mock_data.write_result = FR_OK; 
+}
+
+
+// Set whether f_expand finds a contiguous block 
+void ff_mock_set_contiguous(uint8_t contiguous)
+{
+    mock_data.contiguous = contiguous; 
+}
+
+
+// Set the result of the following f_write calls 
+void ff_mock_set_write_result(FRESULT result)
+{
+    mock_data.write_result = result; 
+}
+
+
+// Set how long f_write takes 
+void ff_mock_set_write_time(uint32_t time)
+{
+    mock_data.write_time = time; 
+}
+
+
+// Mock time 
+uint32_t ff_mock_time(void)
+{
+    return mock_data.time; 
+}
+
+
+// Get a file 
+const uint8_t *ff_mock_get_file(
+    const char *name, 
+    uint32_t *size, 
+    uint8_t *expanded)
+{
+    for (uint8_t i = CLEAR; i < FF_MOCK_MAX_FILES; i++)
+    {
+        ff_mock_file_t *file = &mock_data.files[i]; 
+
+        if (file->used && !strcmp(file->name, name))
+        {
+            *size = file->size; 
+            *expanded = file->expanded; 
+            return file->data; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Number of f_write calls 
+uint16_t ff_mock_write_count(void)
+{
+    return mock_data.write_count; 
+}
+
+
+// Get the file offset and length of an f_write call 
+void ff_mock_get_write(
+    uint16_t index, 
+    uint32_t *offset, 
+    uint32_t *len)
+{
+    *offset = mock_data.write_offset[index % FF_MOCK_MAX_WRITES]; 
+    *len = mock_data.write_len[index % FF_MOCK_MAX_WRITES]; 
+}
+
+
+// Number of f_sync calls 
+uint16_t ff_mock_sync_count(void)
+{
+    return mock_data.sync_count; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// FatFs functions 
+
+// The mock file index is kept in the start cluster of the file object 
+
+// Open or create a file 
+FRESULT f_open(
+    FIL *fp, 
+    const TCHAR *path, 
+    BYTE mode)
+{
+    ff_mock_file_t *file = NULL; 
+
+    for (uint8_t i = CLEAR; i < FF_MOCK_MAX_FILES; i++)
+    {
+        if (!mock_data.files[i].used || !strcmp(mock_data.files[i].name, path))
+        {
+            file = &mock_data.files[i]; 
+            fp->obj.sclust = i; 
+            break; 
+        }
+    }
+
+    if ((file == NULL) || (strlen(path) >= FF_MOCK_NAME_LEN))
+    {
+        return FR_TOO_MANY_OPEN_FILES; 
+    }
+
+    memset((void *)file, CLEAR, sizeof(ff_mock_file_t)); 
+    strcpy(file->name, path); 
+    file->used = TRUE; 
+
+    fp->flag = mode; 
+    fp->fptr = CLEAR; 
+    fp->obj.objsize = CLEAR; 
+
+    return FR_OK; 
+}
+
+
+// Allocate a contiguous block to the file 
+FRESULT f_expand(
+    FIL *fp, 
+    FSIZE_t szf, 
+    BYTE opt)
+{
+    ff_mock_file_t *file = &mock_data.files[fp->obj.sclust]; 
+
+    if (!mock_data.contiguous || (szf > FF_MOCK_FILE_SIZE))
+    {
+        return FR_DENIED; 
+    }
+
+    if (opt)
+    {
+        file->expanded = TRUE; 
+        file->size = (uint32_t)szf; 
+        fp->obj.objsize = szf; 
+    }
+
+    return FR_OK; 
+}
+
+
+// Write data to the file 
+FRESULT f_write(
+    FIL *fp, 
+    const void *buff, 
+    UINT btw, 
+    UINT *bw)
+{
+    ff_mock_file_t *file = &mock_data.files[fp->obj.sclust]; 
+    uint32_t offset = (uint32_t)fp->fptr; 
+
+    mock_data.time += mock_data.write_time; 
+    *bw = CLEAR; 
+
+    if (mock_data.write_result != FR_OK)
+    {
+        return mock_data.write_result; 
+    }
+
+    mock_data.write_offset[mock_data.write_count % FF_MOCK_MAX_WRITES] = offset; 
+    mock_data.write_len[mock_data.write_count % FF_MOCK_MAX_WRITES] = btw; 
+    mock_data.write_count++; 
+
+    // Volume full 
+    if ((offset + btw) > FF_MOCK_FILE_SIZE)
+    {
+        btw = (offset < FF_MOCK_FILE_SIZE) ? (FF_MOCK_FILE_SIZE - offset) : CLEAR; 
+    }
+
+    memcpy((void *)&file->data[offset], buff, btw); 
+    fp->fptr += btw; 
+
+    if (fp->fptr > fp->obj.objsize)
+    {
+        fp->obj.objsize = fp->fptr; 
+        file->size = (uint32_t)fp->fptr; 
+    }
+
+    *bw = btw; 
+
+    return FR_OK; 
+}
+
+
+// Flush cached data of the file 
+FRESULT f_sync(FIL *fp)
+{
+    mock_data.sync_count++; 
+    return FR_OK; 
+}
+
+
+// Truncate the file at the file pointer 
+FRESULT f_truncate(FIL *fp)
+{
+    ff_mock_file_t *file = &mock_data.files[fp->obj.sclust]; 
+
+    fp->obj.objsize = fp->fptr; 
+    file->size = (uint32_t)fp->fptr; 
+
+    return FR_OK; 
+}
+
+
+// Close the file 
+FRESULT f_close(FIL *fp)
+{
+    fp->flag = CLEAR; 
+    return FR_OK; 
+}
+
+//=======================================================================================
@@ -0,0 +1,94 @@
+/**
+ * @file ff_mock.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief Mock FatFs file functions interface - for unit testing 
+ * 
+ * @details Files are held in RAM. Only the file functions used by the drivers are 
+ *          mocked. 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _FF_MOCK_H_ 
+#define _FF_MOCK_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "ff.h" 
+#include "tools.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define FF_MOCK_MAX_FILES 8 
+#define FF_MOCK_FILE_SIZE 16384       // Max bytes in a mock file 
+#define FF_MOCK_MAX_WRITES 64         // Writes recorded 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Mock functions 
+
+// Mock initialization - deletes all files 
+void ff_mock_init(void); 
+
+
+// Set whether f_expand finds a contiguous block (FR_DENIED if not) 
+void ff_mock_set_contiguous(uint8_t contiguous); 
+
+
+// Set the result of the following f_write calls 
+void ff_mock_set_write_result(FRESULT result); 
+
+
+// Set how long f_write takes (mock time counts) 
+void ff_mock_set_write_time(uint32_t time); 
+
+
+// Mock time - advanced by f_write 
+uint32_t ff_mock_time(void); 
+
+
+// Get a file - NULL if it doesn't exist 
+const uint8_t *ff_mock_get_file(
+    const char *name, 
+    uint32_t *size, 
+    uint8_t *expanded); 
+
+
+// Number of f_write calls 
+uint16_t ff_mock_write_count(void); 
+
+
+// Get the file offset and length of an f_write call 
+void ff_mock_get_write(
+    uint16_t index, 
+    uint32_t *offset, 
+    uint32_t *len); 
+
+
+// Number of f_sync calls 
+uint16_t ff_mock_sync_count(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _FF_MOCK_H_ 
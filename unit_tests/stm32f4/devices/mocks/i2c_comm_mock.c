@@ -16,6 +16,7 @@
 // Includes 
 
 #include "i2c_comm_mock.h"
+#include "i2c_dev_sim.h" 
 
 //=======================================================================================
 
@@ -35,6 +36,7 @@
 typedef struct i2c_mock_driver_data_s 
 {
     uint8_t i2c_timeout; 
+    uint8_t sim; 
     uint8_t increment_mode_write; 
     uint8_t increment_mode_read; 
 
@@ -43,6 +45,9 @@ typedef struct i2c_mock_driver_data_s
     uint8_t write_index; 
 
     uint8_t read_data[I2C_MOCK_MAX_INDEX][MAX_DATA_SIZE]; 
+    const uint8_t *read_data_ref[I2C_MOCK_MAX_INDEX]; 
+    uint16_t read_data_size[I2C_MOCK_MAX_INDEX]; 
+    uint16_t read_offset; 
     uint8_t read_index; 
 }
 i2c_mock_driver_data_t; 
@@ -52,6 +57,15 @@ static i2c_mock_driver_data_t mock_driver_data;
 //=======================================================================================
 
 
+//=======================================================================================
+// Prototypes 
+
+// Move through the read data buffers 
+void i2c_mock_read_increment(uint16_t data_size); 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Driver functions 
 
@@ -59,6 +73,12 @@ static i2c_mock_driver_data_t mock_driver_data;
 I2C_STATUS i2c_start(
     I2C_TypeDef *i2c)
 {
+    if (mock_driver_data.sim)
+    {
+        i2c_dev_sim_start(); 
+        return I2C_OK; 
+    }
+
     if (mock_driver_data.i2c_timeout)
     {
         return I2C_TIMEOUT; 
@@ -72,7 +92,10 @@ I2C_STATUS i2c_start(
 void i2c_stop(
     I2C_TypeDef *i2c)
 {
-    // 
+    if (mock_driver_data.sim)
+    {
+        i2c_dev_sim_stop(); 
+    }
 }
 
 
@@ -89,6 +112,11 @@ I2C_STATUS i2c_write_addr(
     I2C_TypeDef *i2c, 
     uint8_t i2c_address)
 {
+    if (mock_driver_data.sim)
+    {
+        return i2c_dev_sim_addr(i2c_address); 
+    }
+
     return I2C_OK; 
 }
 
@@ -99,6 +127,11 @@ I2C_STATUS i2c_write(
     const uint8_t *data, 
     uint8_t data_size)
 {
+    if (mock_driver_data.sim && (data != NULL))
+    {
+        return i2c_dev_sim_write(data, data_size); 
+    }
+
     if ((data == NULL) || (mock_driver_data.write_index >= I2C_MOCK_MAX_INDEX))
     {
         return I2C_NULL_PTR; 
@@ -123,20 +156,27 @@ I2C_STATUS i2c_read(
     uint8_t *data, 
     uint16_t data_size)
 {
+    if (mock_driver_data.sim && (data != NULL))
+    {
+        return i2c_dev_sim_read(data, data_size); 
+    }
+
     if ((data == NULL) || (mock_driver_data.read_index >= I2C_MOCK_MAX_INDEX))
     {
         return I2C_NULL_PTR; 
     }
 
-    memcpy((void *)data, 
-           (void *)(&mock_driver_data.read_data[mock_driver_data.read_index][0]), 
-           data_size); 
+    const uint8_t *read_data = mock_driver_data.read_data_ref[mock_driver_data.read_index]; 
 
-    if (mock_driver_data.increment_mode_read)
+    if (read_data == NULL)
     {
-        mock_driver_data.read_index++; 
+        read_data = &mock_driver_data.read_data[mock_driver_data.read_index][0]; 
     }
 
+    memcpy((void *)data, (void *)(read_data + mock_driver_data.read_offset), data_size); 
+
+    i2c_mock_read_increment(data_size); 
+
     return I2C_OK; 
 }
 
@@ -146,16 +186,18 @@ I2C_STATUS i2c_clear(
     I2C_TypeDef *i2c, 
     uint16_t data_size)
 {
-    if (mock_driver_data.read_index >= I2C_MOCK_MAX_INDEX)
+    if (mock_driver_data.sim)
     {
-        return I2C_NULL_PTR; 
+        return i2c_dev_sim_read(NULL, data_size); 
     }
 
-    if (mock_driver_data.increment_mode_read)
+    if (mock_driver_data.read_index >= I2C_MOCK_MAX_INDEX)
     {
-        mock_driver_data.read_index++; 
+        return I2C_NULL_PTR; 
     }
 
+    i2c_mock_read_increment(data_size); 
+
     return I2C_OK; 
 }
 
@@ -172,6 +214,7 @@ void i2c_mock_init(
     i2c_mock_increment_mode_t increment_mode_read)
 {
     mock_driver_data.i2c_timeout = timeout_status; 
+    mock_driver_data.sim = I2C_MOCK_SIM_DISABLE; 
     mock_driver_data.increment_mode_write = increment_mode_write; 
     mock_driver_data.increment_mode_read = increment_mode_read; 
 
@@ -181,6 +224,11 @@ void i2c_mock_init(
     mock_driver_data.write_index = CLEAR; 
 
     memset((void *)mock_driver_data.read_data, CLEAR, sizeof(mock_driver_data.read_data)); 
+    memset((void *)mock_driver_data.read_data_ref, CLEAR, 
+            sizeof(mock_driver_data.read_data_ref)); 
+    memset((void *)mock_driver_data.read_data_size, CLEAR, 
+            sizeof(mock_driver_data.read_data_size)); 
+    mock_driver_data.read_offset = CLEAR; 
     mock_driver_data.read_index = CLEAR; 
 }
 
@@ -208,12 +256,72 @@ void i2c_mock_set_read_data(
     uint16_t read_data_size, 
     uint8_t read_index)
 {
-    if ((read_data == NULL) || (read_index >= I2C_MOCK_MAX_INDEX))
+    if ((read_data == NULL) || (read_index >= I2C_MOCK_MAX_INDEX) || 
+        (read_data_size > MAX_DATA_SIZE))
     {
         return; 
     }
 
     memcpy((void *)(&mock_driver_data.read_data[read_index][0]), read_data, read_data_size); 
+    mock_driver_data.read_data_ref[read_index] = NULL; 
+    mock_driver_data.read_data_size[read_index] = read_data_size; 
+}
+
+
+// Set read data by reference 
+void i2c_mock_set_read_ref(
+    const void *read_data, 
+    uint16_t read_data_size, 
+    uint8_t read_index)
+{
+    if ((read_data == NULL) || (read_index >= I2C_MOCK_MAX_INDEX))
+    {
+        return; 
+    }
+
+    mock_driver_data.read_data_ref[read_index] = (const uint8_t *)read_data; 
+    mock_driver_data.read_data_size[read_index] = read_data_size; 
+}
+
+
+// Restart reading from the first read buffer 
+void i2c_mock_read_restart(void)
+{
+    mock_driver_data.read_offset = CLEAR; 
+    mock_driver_data.read_index = CLEAR; 
+}
+
+
+// Pass bus activity to the device simulator 
+void i2c_mock_set_sim(i2c_mock_sim_t sim_status)
+{
+    mock_driver_data.sim = sim_status; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Move through the read data buffers 
+void i2c_mock_read_increment(uint16_t data_size)
+{
+    if (!mock_driver_data.increment_mode_read)
+    {
+        return; 
+    }
+
+    // A buffer can be read in pieces (ex. a driver reading a data stream in chunks). The 
+    // next buffer is only moved to once the whole size of the current buffer is read. 
+    mock_driver_data.read_offset += data_size; 
+
+    if (mock_driver_data.read_offset >= 
+        mock_driver_data.read_data_size[mock_driver_data.read_index])
+    {
+        mock_driver_data.read_offset = CLEAR; 
+        mock_driver_data.read_index++; 
+    }
 }
 
 //=======================================================================================
@@ -57,6 +57,13 @@ typedef enum {
     I2C_MOCK_INC_MODE_ENABLE 
 } i2c_mock_increment_mode_t; 
 
+
+// I2C mock driver device simulator selection 
+typedef enum {
+    I2C_MOCK_SIM_DISABLE, 
+    I2C_MOCK_SIM_ENABLE 
+} i2c_mock_sim_t; 
+
 //=======================================================================================
 
 
@@ -83,6 +90,24 @@ void i2c_mock_set_read_data(
     uint16_t data_size, 
     uint8_t read_index); 
 
+
+// Set read data by reference - the data isn't copied so it can be larger than the mock 
+// buffers (ex. a recorded data stream) but it must stay valid while it's being read. 
+void i2c_mock_set_read_ref(
+    const void *read_data, 
+    uint16_t data_size, 
+    uint8_t read_index); 
+
+
+// Restart reading from the first read buffer - lets the same read buffers be used again 
+// without clearing the mock. 
+void i2c_mock_read_restart(void); 
+
+
+// Pass bus activity to the device simulator (i2c_dev_sim) instead of the indexed buffers. 
+// The simulator must be set up with i2c_dev_sim_init. i2c_mock_init disables it. 
+void i2c_mock_set_sim(i2c_mock_sim_t sim_status); 
+
 //=======================================================================================
 
 #endif  // _I2C_COMM_MOCK_H_ 
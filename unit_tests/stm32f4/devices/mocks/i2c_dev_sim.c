@@ -0,0 +1,624 @@
+/**
+ * @file i2c_dev_sim.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C device simulator implementation - for unit testing 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "i2c_dev_sim.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define I2C_DEV_SIM_BYTE_BITS 9          // 8 data bits + ACK/NACK 
+#define I2C_DEV_SIM_NS_PER_S 1000000000 
+
+// Register map models 
+#define I2C_DEV_SIM_MSB_INC 0x80         // LSM303AGR register address increment bit 
+#define I2C_DEV_SIM_MPU6050_WHO_AM_I 0x75 
+#define I2C_DEV_SIM_MPU6050_PWR_MGMT_1 0x6B 
+#define I2C_DEV_SIM_LSM303AGR_A_ADDR 0x32 
+#define I2C_DEV_SIM_LSM303AGR_A_WHO_AM_I 0x0F 
+#define I2C_DEV_SIM_LSM303AGR_M_WHO_AM_I 0x4F 
+
+// M8Q DDC registers 
+#define I2C_DEV_SIM_M8Q_SIZE_H 0xFD 
+#define I2C_DEV_SIM_M8Q_SIZE_L 0xFE 
+#define I2C_DEV_SIM_M8Q_STREAM 0xFF 
+#define I2C_DEV_SIM_M8Q_EMPTY 0xFF       // Stream value when no data is available 
+
+// PCF8574 to HD44780U wiring 
+#define I2C_DEV_SIM_LCD_RS 0x01 
+#define I2C_DEV_SIM_LCD_RW 0x02 
+#define I2C_DEV_SIM_LCD_EN 0x04 
+#define I2C_DEV_SIM_LCD_DATA 0xF0 
+#define I2C_DEV_SIM_LCD_DB0_3 0x0F       // Unwired data lines - pulled up in the HD44780U 
+
+// HD44780U instructions 
+#define I2C_DEV_SIM_LCD_DDRAM 0x80 
+#define I2C_DEV_SIM_LCD_CGRAM 0x40 
+#define I2C_DEV_SIM_LCD_FUNCTION 0x20 
+#define I2C_DEV_SIM_LCD_8BIT 0x10 
+#define I2C_DEV_SIM_LCD_SHIFT 0x10 
+#define I2C_DEV_SIM_LCD_DISPLAY 0x08 
+#define I2C_DEV_SIM_LCD_ENTRY 0x04 
+#define I2C_DEV_SIM_LCD_INC 0x02 
+#define I2C_DEV_SIM_LCD_HOME 0x02 
+#define I2C_DEV_SIM_LCD_CLEAR 0x01 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+i2c_dev_sim_t i2c_dev_sim; 
+
+// Display data RAM address of the start of each line (20x4 display)
+static const uint8_t lcd_line_addr[] = { 0x00, 0x40, 0x14, 0x54 };
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+// Count bus time for a number of bits plus clock stretching 
+uint32_t i2c_dev_sim_bits(
+    uint32_t bits, 
+    uint32_t stretch_ns); 
+
+
+// Stream device (M8Q) register read 
+uint8_t i2c_dev_sim_m8q_read(i2c_dev_sim_device_t *device); 
+
+
+// PCF8574 output change - the HD44780U latches data on the falling edge of E 
+void i2c_dev_sim_lcd_port(
+    i2c_dev_sim_device_t *device, 
+    uint8_t port); 
+
+
+// HD44780U executes an instruction or writes a character 
+void i2c_dev_sim_lcd_exec(
+    i2c_dev_sim_device_t *device, 
+    uint8_t rs, 
+    uint8_t value); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator functions 
+
+// Reset the simulator 
+void i2c_dev_sim_init(uint32_t bus_hz)
+{
+    memset((void *)&i2c_dev_sim, CLEAR, sizeof(i2c_dev_sim)); 
+    i2c_dev_sim.bus_hz = (bus_hz) ? bus_hz : I2C_DEV_SIM_BUS_HZ; 
+}
+
+
+// Add a device 
+i2c_dev_sim_device_t *i2c_dev_sim_add(
+    i2c_dev_sim_model_t model, 
+    uint8_t address)
+{
+    for (uint8_t i = CLEAR; i < I2C_DEV_SIM_MAX_DEVICES; i++)
+    {
+        i2c_dev_sim_device_t *device = &i2c_dev_sim.devices[i]; 
+
+        if (device->address != CLEAR)
+        {
+            continue; 
+        }
+
+        memset((void *)device, CLEAR, sizeof(i2c_dev_sim_device_t)); 
+        device->model = model; 
+        device->address = address & ~I2C_R_OFFSET; 
+
+        // Power-on state 
+        switch (model)
+        {
+            case I2C_DEV_SIM_MPU6050: 
+                device->regs[I2C_DEV_SIM_MPU6050_WHO_AM_I] = 0x68; 
+                device->regs[I2C_DEV_SIM_MPU6050_PWR_MGMT_1] = 0x40;   // Sleep 
+                break; 
+
+            case I2C_DEV_SIM_LSM303AGR: 
+                if (device->address == I2C_DEV_SIM_LSM303AGR_A_ADDR)
+                {
+                    device->regs[I2C_DEV_SIM_LSM303AGR_A_WHO_AM_I] = 0x33; 
+                }
+                else 
+                {
+                    device->regs[I2C_DEV_SIM_LSM303AGR_M_WHO_AM_I] = 0x40; 
+                }
+                break; 
+
+            case I2C_DEV_SIM_M8Q: 
+                device->reg_ptr = I2C_DEV_SIM_M8Q_STREAM; 
+                break; 
+
+            case I2C_DEV_SIM_HD44780U: 
+                memset((void *)device->ddram, ' ', sizeof(device->ddram)); 
+                device->entry_mode = I2C_DEV_SIM_LCD_ENTRY | I2C_DEV_SIM_LCD_INC; 
+                break; 
+
+            default: 
+                break; 
+        }
+
+        return device; 
+    }
+
+    return NULL; 
+}
+
+
+// Set the data a stream device has available to read 
+void i2c_dev_sim_stream_set(
+    i2c_dev_sim_device_t *device, 
+    const void *data, 
+    uint16_t size)
+{
+    if (device == NULL)
+    {
+        return; 
+    }
+
+    device->stream = (const uint8_t *)data; 
+    device->stream_size = (data != NULL) ? size : CLEAR; 
+    device->stream_pos = CLEAR; 
+}
+
+
+// Start of a display line in display data RAM 
+const char *i2c_dev_sim_lcd_line(
+    const i2c_dev_sim_device_t *device, 
+    uint8_t line)
+{
+    if ((device == NULL) || (line >= sizeof(lcd_line_addr)))
+    {
+        return NULL; 
+    }
+
+    return &device->ddram[lcd_line_addr[line]]; 
+}
+
+
+// Clear the bus time and transfer counts 
+void i2c_dev_sim_stats_reset(void)
+{
+    i2c_dev_sim.busy_ns = CLEAR; 
+    i2c_dev_sim.starts = CLEAR; 
+    i2c_dev_sim.stops = CLEAR; 
+
+    for (uint8_t i = CLEAR; i < I2C_DEV_SIM_MAX_DEVICES; i++)
+    {
+        i2c_dev_sim.devices[i].busy_ns = CLEAR; 
+        i2c_dev_sim.devices[i].transfers = CLEAR; 
+        i2c_dev_sim.devices[i].bytes = CLEAR; 
+    }
+}
+
+
+// Bus time in microseconds 
+uint32_t i2c_dev_sim_busy_us(void)
+{
+    return i2c_dev_sim.busy_ns / 1000; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Bus functions 
+
+// Start or repeated start 
+void i2c_dev_sim_start(void)
+{
+    if (i2c_dev_sim.active && (i2c_dev_sim.device != NULL))
+    {
+        i2c_dev_sim_dev_end(i2c_dev_sim.device); 
+    }
+
+    // The start is counted for the device that gets addressed after it 
+    i2c_dev_sim.active = TRUE; 
+    i2c_dev_sim.device = NULL; 
+    i2c_dev_sim.starts++; 
+    i2c_dev_sim.start_ns = i2c_dev_sim_bits(BYTE_1, CLEAR); 
+}
+
+
+// Address phase 
+I2C_STATUS i2c_dev_sim_addr(uint8_t address)
+{
+    i2c_dev_sim.read = (address & I2C_R_OFFSET) ? TRUE : FALSE; 
+    i2c_dev_sim.device = i2c_dev_sim_dev_addr(address); 
+    i2c_dev_sim_bits(I2C_DEV_SIM_BYTE_BITS, CLEAR); 
+
+    if (i2c_dev_sim.device == NULL)
+    {
+        return I2C_TIMEOUT; 
+    }
+
+    i2c_dev_sim.device->busy_ns += i2c_dev_sim.start_ns; 
+
+    return I2C_OK; 
+}
+
+
+// Master writes bytes to the addressed device 
+I2C_STATUS i2c_dev_sim_write(
+    const uint8_t *data, 
+    uint16_t data_size)
+{
+    i2c_dev_sim_device_t *device = i2c_dev_sim.device; 
+
+    if ((device == NULL) || i2c_dev_sim.read)
+    {
+        return I2C_TIMEOUT; 
+    }
+
+    while (data_size--)
+    {
+        i2c_dev_sim_dev_write(device, *data++); 
+        i2c_dev_sim_bits(I2C_DEV_SIM_BYTE_BITS, device->stretch_ns); 
+    }
+
+    return I2C_OK; 
+}
+
+
+// Master reads bytes from the addressed device 
+I2C_STATUS i2c_dev_sim_read(
+    uint8_t *data, 
+    uint16_t data_size)
+{
+    i2c_dev_sim_device_t *device = i2c_dev_sim.device; 
+
+    if ((device == NULL) || !i2c_dev_sim.read)
+    {
+        return I2C_TIMEOUT; 
+    }
+
+    while (data_size--)
+    {
+        uint8_t value = i2c_dev_sim_dev_read(device); 
+
+        if (data != NULL)
+        {
+            *data++ = value; 
+        }
+
+        i2c_dev_sim_bits(I2C_DEV_SIM_BYTE_BITS, device->stretch_ns); 
+    }
+
+    return I2C_OK; 
+}
+
+
+// Stop 
+void i2c_dev_sim_stop(void)
+{
+    if (!i2c_dev_sim.active)
+    {
+        return; 
+    }
+
+    if (i2c_dev_sim.device != NULL)
+    {
+        i2c_dev_sim_dev_end(i2c_dev_sim.device); 
+    }
+
+    i2c_dev_sim_bits(BYTE_1, CLEAR); 
+    i2c_dev_sim.active = FALSE; 
+    i2c_dev_sim.device = NULL; 
+    i2c_dev_sim.stops++; 
+}
+
+
+// Count bus time for a number of bits plus clock stretching 
+uint32_t i2c_dev_sim_bits(
+    uint32_t bits, 
+    uint32_t stretch_ns)
+{
+    uint32_t time_ns = 
+        (uint32_t)(((uint64_t)bits * I2C_DEV_SIM_NS_PER_S) / i2c_dev_sim.bus_hz) + stretch_ns; 
+
+    i2c_dev_sim.busy_ns += time_ns; 
+
+    if (i2c_dev_sim.device != NULL)
+    {
+        i2c_dev_sim.device->busy_ns += time_ns; 
+    }
+
+    return time_ns; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Device functions 
+
+// Address phase 
+i2c_dev_sim_device_t *i2c_dev_sim_dev_addr(uint8_t address)
+{
+    i2c_dev_sim_device_t *device = NULL; 
+
+    for (uint8_t i = CLEAR; i < I2C_DEV_SIM_MAX_DEVICES; i++)
+    {
+        if (i2c_dev_sim.devices[i].address && 
+            (i2c_dev_sim.devices[i].address == (address & ~I2C_R_OFFSET)))
+        {
+            device = &i2c_dev_sim.devices[i]; 
+        }
+    }
+
+    if ((device != NULL) && device->nack_count)
+    {
+        device->nack_count--; 
+        device = NULL; 
+    }
+
+    if (device != NULL)
+    {
+        device->write_count = CLEAR; 
+        device->transfers++; 
+    }
+
+    return device; 
+}
+
+
+// Device receives a byte 
+void i2c_dev_sim_dev_write(
+    i2c_dev_sim_device_t *device, 
+    uint8_t data)
+{
+    uint16_t count = device->write_count++; 
+
+    device->bytes++; 
+
+    switch (device->model)
+    {
+        case I2C_DEV_SIM_M8Q: 
+            // Held until it's known whether this is a register address or a message 
+            if (count == CLEAR)
+            {
+                device->write_first = data; 
+                break; 
+            }
+
+            if ((count == BYTE_1) && (device->msg_size < I2C_DEV_SIM_MSG_SIZE))
+            {
+                device->msg[device->msg_size++] = device->write_first; 
+            }
+
+            if (device->msg_size < I2C_DEV_SIM_MSG_SIZE)
+            {
+                device->msg[device->msg_size++] = data; 
+            }
+            break; 
+
+        case I2C_DEV_SIM_HD44780U: 
+            i2c_dev_sim_lcd_port(device, data); 
+            break; 
+
+        default: 
+            // Register map - the first byte is the register address 
+            if (count == CLEAR)
+            {
+                if (device->model == I2C_DEV_SIM_LSM303AGR)
+                {
+                    device->reg_inc = (data & I2C_DEV_SIM_MSB_INC) ? TRUE : FALSE; 
+                    data &= ~I2C_DEV_SIM_MSB_INC; 
+                }
+                else 
+                {
+                    device->reg_inc = TRUE; 
+                }
+
+                device->reg_ptr = data; 
+                break; 
+            }
+
+            device->regs[device->reg_ptr] = data; 
+
+            if (device->reg_inc)
+            {
+                device->reg_ptr++; 
+            }
+            break; 
+    }
+}
+
+
+// Device sends a byte 
+uint8_t i2c_dev_sim_dev_read(i2c_dev_sim_device_t *device)
+{
+    uint8_t value; 
+
+    device->bytes++; 
+
+    switch (device->model)
+    {
+        case I2C_DEV_SIM_M8Q: 
+            value = i2c_dev_sim_m8q_read(device); 
+            break; 
+
+        case I2C_DEV_SIM_HD44780U: 
+            value = device->port;   // PCF8574 reads back its pins 
+            break; 
+
+        default: 
+            value = device->regs[device->reg_ptr]; 
+
+            if (device->reg_inc)
+            {
+                device->reg_ptr++; 
+            }
+            break; 
+    }
+
+    return value; 
+}
+
+
+// End of a transfer phase 
+void i2c_dev_sim_dev_end(i2c_dev_sim_device_t *device)
+{
+    // A single byte written to the M8Q sets the register address. Anything longer is a 
+    // message and was already logged. A read phase doesn't write so it's never 1 byte. 
+    if ((device->model == I2C_DEV_SIM_M8Q) && (device->write_count == BYTE_1))
+    {
+        device->reg_ptr = device->write_first; 
+    }
+
+    device->write_count = CLEAR; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Device models 
+
+// Stream device (M8Q) register read 
+uint8_t i2c_dev_sim_m8q_read(i2c_dev_sim_device_t *device)
+{
+    uint16_t available = device->stream_size - device->stream_pos; 
+    uint8_t value; 
+
+    switch (device->reg_ptr)
+    {
+        case I2C_DEV_SIM_M8Q_SIZE_H: 
+            value = (uint8_t)(available >> SHIFT_8); 
+            break; 
+
+        case I2C_DEV_SIM_M8Q_SIZE_L: 
+            value = (uint8_t)available; 
+            break; 
+
+        case I2C_DEV_SIM_M8Q_STREAM: 
+            // The register pointer stays on the stream once it gets there 
+            if (available)
+            {
+                return device->stream[device->stream_pos++]; 
+            }
+            return I2C_DEV_SIM_M8Q_EMPTY; 
+
+        default: 
+            value = device->regs[device->reg_ptr]; 
+            break; 
+    }
+
+    device->reg_ptr++; 
+
+    return value; 
+}
+
+
+// PCF8574 output change 
+void i2c_dev_sim_lcd_port(
+    i2c_dev_sim_device_t *device, 
+    uint8_t port)
+{
+    uint8_t falling_edge = (device->port & I2C_DEV_SIM_LCD_EN) && !(port & I2C_DEV_SIM_LCD_EN); 
+
+    device->port = port; 
+
+    if (!falling_edge || (port & I2C_DEV_SIM_LCD_RW))
+    {
+        return; 
+    }
+
+    uint8_t rs = port & I2C_DEV_SIM_LCD_RS; 
+    uint8_t nibble = port & I2C_DEV_SIM_LCD_DATA; 
+
+    if (!device->four_bit)
+    {
+        // 8-bit mode - DB0-DB3 aren't wired to the backpack 
+        i2c_dev_sim_lcd_exec(device, rs, nibble | I2C_DEV_SIM_LCD_DB0_3); 
+    }
+    else if (!device->nibble_pending)
+    {
+        device->nibble = nibble; 
+        device->nibble_pending = TRUE; 
+    }
+    else 
+    {
+        device->nibble_pending = FALSE; 
+        i2c_dev_sim_lcd_exec(device, rs, device->nibble | (nibble >> SHIFT_4)); 
+    }
+}
+
+
+// HD44780U executes an instruction or writes a character 
+void i2c_dev_sim_lcd_exec(
+    i2c_dev_sim_device_t *device, 
+    uint8_t rs, 
+    uint8_t value)
+{
+    if (rs)
+    {
+        device->ddram[device->ddram_addr % I2C_DEV_SIM_DDRAM_SIZE] = (char)value; 
+        device->ddram_addr += (device->entry_mode & I2C_DEV_SIM_LCD_INC) ? 1 : -1; 
+        device->characters++; 
+        return; 
+    }
+
+    device->instructions++; 
+
+    if (value & I2C_DEV_SIM_LCD_DDRAM)
+    {
+        device->ddram_addr = value & ~I2C_DEV_SIM_LCD_DDRAM; 
+    }
+    else if (value & I2C_DEV_SIM_LCD_CGRAM)
+    {
+        // Custom characters aren't modelled 
+    }
+    else if (value & I2C_DEV_SIM_LCD_FUNCTION)
+    {
+        device->four_bit = (value & I2C_DEV_SIM_LCD_8BIT) ? FALSE : TRUE; 
+    }
+    else if (value & I2C_DEV_SIM_LCD_SHIFT)
+    {
+        // Cursor and display shifts aren't modelled 
+    }
+    else if (value & I2C_DEV_SIM_LCD_DISPLAY)
+    {
+        device->display_control = value; 
+    }
+    else if (value & I2C_DEV_SIM_LCD_ENTRY)
+    {
+        device->entry_mode = value; 
+    }
+    else if (value & I2C_DEV_SIM_LCD_HOME)
+    {
+        device->ddram_addr = CLEAR; 
+    }
+    else if (value & I2C_DEV_SIM_LCD_CLEAR)
+    {
+        memset((void *)device->ddram, ' ', sizeof(device->ddram)); 
+        device->ddram_addr = CLEAR; 
+        device->entry_mode |= I2C_DEV_SIM_LCD_INC; 
+    }
+}
+
+//=======================================================================================
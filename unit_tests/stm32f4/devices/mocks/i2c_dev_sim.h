@@ -0,0 +1,235 @@
+/**
+ * @file i2c_dev_sim.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C device simulator interface - for unit testing 
+ * 
+ * @details Models the devices on an I2C bus at the register level so device drivers can
+ *          be tested against the bytes they actually put on the bus instead of indexed 
+ *          mock buffers. When enabled with i2c_mock_set_sim the blocking I2C mock 
+ *          functions (start, address, write, read, stop) are passed to the simulator. 
+ *          Each device sits at its own address and responds the way the real part does: 
+ *          register pointer writes, auto-increment, the M8Q data stream registers and the 
+ *          HD44780U instructions clocked through a PCF8574 backpack. Bus time is counted 
+ *          per bit at the chosen bus speed plus any clock stretching per byte so tests 
+ *          can report the bus occupancy of a driver sequence. 
+ *          
+ *          The device models are also used on their own by the peripheral level I2C 
+ *          simulator (i2c_sim), which plays the I2C port registers for the asynchronous 
+ *          engine. The bus (front end) passes each address phase and data byte to the 
+ *          device functions so the same models answer both the blocking and the 
+ *          interrupt/DMA driven transfers. 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _I2C_DEV_SIM_H_
+#define _I2C_DEV_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "i2c_comm.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define I2C_DEV_SIM_MAX_DEVICES 6 
+#define I2C_DEV_SIM_BUS_HZ 400000        // Default bus speed 
+#define I2C_DEV_SIM_MSG_SIZE 512         // Bytes kept of messages written to a stream 
+#define I2C_DEV_SIM_DDRAM_SIZE 128       // HD44780U display data RAM addresses 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Device models 
+typedef enum {
+    I2C_DEV_SIM_REG,          // Generic register map - pointer increments after each byte 
+    I2C_DEV_SIM_MPU6050,      // Register map - pointer increments after each byte 
+    I2C_DEV_SIM_LSM303AGR,    // Register map - increments if register address bit 7 is set 
+    I2C_DEV_SIM_M8Q,          // u-blox DDC - 0xFD/0xFE bytes available, 0xFF data stream 
+    I2C_DEV_SIM_HD44780U      // PCF8574 port expander driving an HD44780U in 4-bit mode 
+} i2c_dev_sim_model_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+// Simulated device 
+typedef struct i2c_dev_sim_device_s 
+{
+    i2c_dev_sim_model_t model; 
+    uint8_t address;                 // Address with the R/W bit clear 
+    uint8_t nack_count;              // Number of upcoming address phases to NACK 
+    uint32_t stretch_ns;             // Clock stretching added to each byte 
+
+    // Register map 
+    uint8_t regs[256]; 
+    uint8_t reg_ptr; 
+    uint8_t reg_inc;                 // Pointer increments on this access 
+
+    // Transfer 
+    uint16_t write_count;            // Bytes written since the address 
+    uint8_t write_first;             // First byte written since the address 
+
+    // Data stream (M8Q)
+    const uint8_t *stream;           // Data the device has to send (not copied)
+    uint16_t stream_size; 
+    uint16_t stream_pos; 
+    uint8_t msg[I2C_DEV_SIM_MSG_SIZE];   // Messages written to the device 
+    uint16_t msg_size; 
+
+    // Display (HD44780U)
+    uint8_t port;                    // Last byte written to the PCF8574 
+    uint8_t four_bit;                // Interface is in 4-bit mode 
+    uint8_t nibble;                  // High nibble waiting for its low nibble 
+    uint8_t nibble_pending; 
+    uint8_t entry_mode;              // Last entry mode set instruction 
+    uint8_t display_control;         // Last display control instruction 
+    uint8_t ddram_addr; 
+    char ddram[I2C_DEV_SIM_DDRAM_SIZE]; 
+    uint16_t instructions;           // Instructions executed (RS = 0)
+    uint16_t characters;             // Characters written (RS = 1)
+
+    // Statistics 
+    uint32_t busy_ns;                // Bus time spent with this device addressed 
+    uint32_t transfers;              // Address phases ACKed 
+    uint32_t bytes;                  // Data bytes moved 
+}
+i2c_dev_sim_device_t; 
+
+
+// Simulator state 
+typedef struct i2c_dev_sim_s 
+{
+    i2c_dev_sim_device_t devices[I2C_DEV_SIM_MAX_DEVICES]; 
+    i2c_dev_sim_device_t *device;    // Addressed device - NULL if the address was NACKed 
+    uint8_t active;                  // Start sent and no stop yet 
+    uint8_t read;                    // Addressed for a read 
+
+    // Bus timing 
+    uint32_t bus_hz; 
+    uint32_t busy_ns;                // Time the bus spent transferring bits 
+    uint32_t start_ns;               // Time of the last start 
+    uint32_t starts;                 // Starts and repeated starts 
+    uint32_t stops; 
+}
+i2c_dev_sim_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator functions 
+
+extern i2c_dev_sim_t i2c_dev_sim; 
+
+
+// Reset the simulator and remove all devices - a bus_hz of 0 uses the default 
+void i2c_dev_sim_init(uint32_t bus_hz); 
+
+
+// Add a device at an address (R/W bit clear) with its power-on register values - returns 
+// NULL if there's no room 
+i2c_dev_sim_device_t *i2c_dev_sim_add(
+    i2c_dev_sim_model_t model, 
+    uint8_t address); 
+
+
+// Set the data a stream device (M8Q) has available to read. The data isn't copied. 
+void i2c_dev_sim_stream_set(
+    i2c_dev_sim_device_t *device, 
+    const void *data, 
+    uint16_t size); 
+
+
+// Start of a display line (HD44780U_L1 - HD44780U_L4) in display data RAM - the line is 
+// HD44780U_LINE_LEN characters and isn't null terminated 
+const char *i2c_dev_sim_lcd_line(
+    const i2c_dev_sim_device_t *device, 
+    uint8_t line); 
+
+
+// Clear the bus time and transfer counts of the bus and all devices 
+void i2c_dev_sim_stats_reset(void); 
+
+
+// Bus time in microseconds 
+uint32_t i2c_dev_sim_busy_us(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Bus functions - called by the I2C mock 
+
+// Start or repeated start 
+void i2c_dev_sim_start(void); 
+
+
+// Address phase - I2C_TIMEOUT if no device ACKs (same as the driver waiting on ADDR)
+I2C_STATUS i2c_dev_sim_addr(uint8_t address); 
+
+
+// Master writes bytes to the addressed device 
+I2C_STATUS i2c_dev_sim_write(
+    const uint8_t *data, 
+    uint16_t data_size); 
+
+
+// Master reads bytes from the addressed device - data can be NULL to discard them 
+I2C_STATUS i2c_dev_sim_read(
+    uint8_t *data, 
+    uint16_t data_size); 
+
+
+// Stop 
+void i2c_dev_sim_stop(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Device functions - called by the bus front ends (blocking mock and i2c_sim) 
+
+// Address phase - returns the device that ACKs the address or NULL if it's NACKed 
+i2c_dev_sim_device_t *i2c_dev_sim_dev_addr(uint8_t address); 
+
+
+// Device receives a byte 
+void i2c_dev_sim_dev_write(
+    i2c_dev_sim_device_t *device, 
+    uint8_t data); 
+
+
+// Device sends a byte 
+uint8_t i2c_dev_sim_dev_read(i2c_dev_sim_device_t *device); 
+
+
+// End of a transfer phase (repeated start or stop)
+void i2c_dev_sim_dev_end(i2c_dev_sim_device_t *device); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _I2C_DEV_SIM_H_
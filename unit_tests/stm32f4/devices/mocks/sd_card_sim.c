@@ -0,0 +1,524 @@
+/**
+ * @file sd_card_sim.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief SD card simulator implementation - for unit testing 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sd_card_sim.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SD_CARD_SIM_HIGH 0xFF            // Idle MISO/MOSI level 
+#define SD_CARD_SIM_CMD_MASK 0xC0        // Start and transmission bits of a command 
+#define SD_CARD_SIM_CMD_START 0x40 
+#define SD_CARD_SIM_CMD_INDEX 0x3F 
+#define SD_CARD_SIM_CRC_LEN 2 
+#define SD_CARD_SIM_CSD_LEN 16 
+#define SD_CARD_SIM_INIT_COUNT 2         // ACMD41 calls before the card is ready 
+#define SD_CARD_SIM_BUSY_BYTES 4         // Busy bytes after each written sector 
+#define SD_CARD_SIM_C_SIZE_UNIT 1024     // Sectors per CSD C_SIZE count 
+
+// Commands 
+#define SD_CARD_SIM_CMD0 0 
+#define SD_CARD_SIM_CMD8 8 
+#define SD_CARD_SIM_CMD9 9 
+#define SD_CARD_SIM_CMD12 12 
+#define SD_CARD_SIM_CMD16 16 
+#define SD_CARD_SIM_CMD17 17 
+#define SD_CARD_SIM_CMD18 18 
+#define SD_CARD_SIM_CMD23 23 
+#define SD_CARD_SIM_CMD24 24 
+#define SD_CARD_SIM_CMD25 25 
+#define SD_CARD_SIM_CMD41 41 
+#define SD_CARD_SIM_CMD55 55 
+#define SD_CARD_SIM_CMD58 58 
+
+// R1 response 
+#define SD_CARD_SIM_R1_READY 0x00 
+#define SD_CARD_SIM_R1_IDLE 0x01 
+#define SD_CARD_SIM_R1_ILLEGAL 0x04 
+#define SD_CARD_SIM_R1_PARAM 0x40 
+
+// Tokens and data responses 
+#define SD_CARD_SIM_TOKEN 0xFE           // CMD17/18/24 data token 
+#define SD_CARD_SIM_TOKEN_MULTI 0xFC     // CMD25 data token 
+#define SD_CARD_SIM_TOKEN_STOP 0xFD      // CMD25 stop token 
+#define SD_CARD_SIM_DE_RANGE 0x08        // Data error token - address out of range 
+#define SD_CARD_SIM_DR_OK 0x05           // Data accepted 
+#define SD_CARD_SIM_DR_CRC 0x0B          // Data rejected - CRC error 
+#define SD_CARD_SIM_DR_WRITE 0x0D        // Data rejected - write error 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+sd_card_sim_t sd_card_sim; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+// Queue a byte to send 
+void sd_card_sim_out(uint8_t data); 
+
+
+// Queue a data packet (token, sector and CRC) - a data error token if it's out of range 
+void sd_card_sim_out_sector(uint32_t sector); 
+
+
+// Next byte to send 
+uint8_t sd_card_sim_out_next(void); 
+
+
+// Card receives a byte 
+void sd_card_sim_receive(uint8_t mosi); 
+
+
+// Card executes a command 
+void sd_card_sim_command(void); 
+
+
+// Card receives the end of a written data packet 
+void sd_card_sim_packet_end(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator functions 
+
+// Reset the simulator 
+void sd_card_sim_init(
+    uint8_t *data, 
+    uint32_t sectors, 
+    uint8_t tran_speed)
+{
+    memset((void *)&sd_card_sim, CLEAR, sizeof(sd_card_sim)); 
+    sd_card_sim.data = data; 
+    sd_card_sim.sectors = (data != NULL) ? sectors : CLEAR; 
+    sd_card_sim.tran_speed = (tran_speed) ? tran_speed : SD_CARD_SIM_TRAN_25MHZ; 
+    sd_card_sim.busy_bytes = SD_CARD_SIM_BUSY_BYTES; 
+    sd_card_sim.init_count = SD_CARD_SIM_INIT_COUNT; 
+}
+
+
+// Inject transfer errors 
+void sd_card_sim_set_errors(
+    uint16_t lost_tokens, 
+    uint16_t crc_errors)
+{
+    sd_card_sim.lost_tokens = lost_tokens; 
+    sd_card_sim.crc_errors = crc_errors; 
+}
+
+
+// Set the card timing 
+void sd_card_sim_set_timing(
+    uint32_t access_bytes, 
+    uint32_t busy_bytes)
+{
+    sd_card_sim.access_bytes = access_bytes; 
+    sd_card_sim.busy_bytes = busy_bytes; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Bus functions 
+
+// Chip select 
+void sd_card_sim_select(uint8_t selected)
+{
+    // A partly received command or queued response is dropped when the card is released 
+    if (!selected)
+    {
+        sd_card_sim.cmd_index = CLEAR; 
+        sd_card_sim.out_head = CLEAR; 
+        sd_card_sim.out_tail = CLEAR; 
+        sd_card_sim.access = CLEAR; 
+    }
+
+    sd_card_sim.selected = selected; 
+}
+
+
+// Exchange one byte 
+uint8_t sd_card_sim_exchange(uint8_t mosi)
+{
+    // MISO is released (pulled high) while the card isn't selected 
+    if (!sd_card_sim.selected)
+    {
+        return SD_CARD_SIM_HIGH; 
+    }
+
+    // The card shifts out its byte while the master's byte is shifted in 
+    uint8_t miso = sd_card_sim_out_next(); 
+    sd_card_sim_receive(mosi); 
+
+    return miso; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Card functions 
+
+// Queue a byte to send 
+void sd_card_sim_out(uint8_t data)
+{
+    if (sd_card_sim.out_head < SD_CARD_SIM_OUT_SIZE)
+    {
+        sd_card_sim.out[sd_card_sim.out_head++] = data; 
+    }
+}
+
+
+// Queue a data packet 
+void sd_card_sim_out_sector(uint32_t sector)
+{
+    sd_card_sim_out(SD_CARD_SIM_HIGH); 
+
+    if (sector >= sd_card_sim.sectors)
+    {
+        sd_card_sim_out(SD_CARD_SIM_DE_RANGE); 
+        sd_card_sim.state = SD_CARD_SIM_IDLE; 
+        return; 
+    }
+
+    // The token is held back for the read access time 
+    sd_card_sim.access_at = sd_card_sim.out_head; 
+    sd_card_sim.access = sd_card_sim.access_bytes; 
+    sd_card_sim_out(SD_CARD_SIM_TOKEN); 
+
+    for (uint16_t i = CLEAR; i < SD_CARD_SIM_SEC_SIZE; i++)
+    {
+        sd_card_sim_out(sd_card_sim.data[sector*SD_CARD_SIM_SEC_SIZE + i]); 
+    }
+
+    for (uint8_t i = CLEAR; i < SD_CARD_SIM_CRC_LEN; i++)
+    {
+        sd_card_sim_out(SD_CARD_SIM_HIGH); 
+    }
+
+    sd_card_sim.sectors_read++; 
+}
+
+
+// Next byte to send 
+uint8_t sd_card_sim_out_next(void)
+{
+    if ((sd_card_sim.out_tail == sd_card_sim.out_head) && (sd_card_sim.out_head))
+    {
+        sd_card_sim.out_head = CLEAR; 
+        sd_card_sim.out_tail = CLEAR; 
+    }
+
+    if (sd_card_sim.out_tail < sd_card_sim.out_head)
+    {
+        if (sd_card_sim.access && (sd_card_sim.out_tail == sd_card_sim.access_at))
+        {
+            sd_card_sim.access--; 
+            return SD_CARD_SIM_HIGH; 
+        }
+
+        return sd_card_sim.out[sd_card_sim.out_tail++]; 
+    }
+
+    if (sd_card_sim.busy)
+    {
+        sd_card_sim.busy--; 
+        return CLEAR; 
+    }
+
+    // Sectors of a multiple block read are sent one after another until CMD12 
+    if (sd_card_sim.state == SD_CARD_SIM_READ_MULTI)
+    {
+        sd_card_sim_out_sector(sd_card_sim.sector++); 
+        return sd_card_sim.out[sd_card_sim.out_tail++]; 
+    }
+
+    return SD_CARD_SIM_HIGH; 
+}
+
+
+// Card receives a byte 
+void sd_card_sim_receive(uint8_t mosi)
+{
+    // Data packet of a write 
+    if ((sd_card_sim.state == SD_CARD_SIM_WRITE_SINGLE) || 
+        (sd_card_sim.state == SD_CARD_SIM_WRITE_MULTI))
+    {
+        // A busy card doesn't take data - a packet sent now would be lost 
+        if (sd_card_sim.busy)
+        {
+            if ((mosi == SD_CARD_SIM_TOKEN) || (mosi == SD_CARD_SIM_TOKEN_MULTI))
+            {
+                sd_card_sim.busy_packets++; 
+            }
+
+            return; 
+        }
+
+        if (sd_card_sim.rx_count)
+        {
+            if (sd_card_sim.rx_count <= SD_CARD_SIM_SEC_SIZE)
+            {
+                sd_card_sim.rx[sd_card_sim.rx_count - BYTE_1] = mosi; 
+            }
+
+            if (++sd_card_sim.rx_count > (SD_CARD_SIM_SEC_SIZE + SD_CARD_SIM_CRC_LEN))
+            {
+                sd_card_sim.rx_count = CLEAR; 
+                sd_card_sim_packet_end(); 
+            }
+        }
+        else if (((sd_card_sim.state == SD_CARD_SIM_WRITE_SINGLE) && 
+                  (mosi == SD_CARD_SIM_TOKEN)) || 
+                 ((sd_card_sim.state == SD_CARD_SIM_WRITE_MULTI) && 
+                  (mosi == SD_CARD_SIM_TOKEN_MULTI)))
+        {
+            sd_card_sim.rx_count = BYTE_1; 
+        }
+        else if ((sd_card_sim.state == SD_CARD_SIM_WRITE_MULTI) && 
+                 (mosi == SD_CARD_SIM_TOKEN_STOP))
+        {
+            sd_card_sim.state = SD_CARD_SIM_IDLE; 
+            sd_card_sim.busy = sd_card_sim.busy_bytes; 
+        }
+
+        return; 
+    }
+
+    // Command frame 
+    if (!sd_card_sim.cmd_index && ((mosi & SD_CARD_SIM_CMD_MASK) != SD_CARD_SIM_CMD_START))
+    {
+        return; 
+    }
+
+    sd_card_sim.cmd[sd_card_sim.cmd_index++] = mosi; 
+
+    if (sd_card_sim.cmd_index >= BYTE_6)
+    {
+        sd_card_sim.cmd_index = CLEAR; 
+        sd_card_sim_command(); 
+    }
+}
+
+
+// Card executes a command 
+void sd_card_sim_command(void)
+{
+    uint8_t index = sd_card_sim.cmd[BYTE_0] & SD_CARD_SIM_CMD_INDEX; 
+    uint32_t arg = ((uint32_t)sd_card_sim.cmd[BYTE_1] << SHIFT_24) | 
+                   ((uint32_t)sd_card_sim.cmd[BYTE_2] << SHIFT_16) | 
+                   ((uint32_t)sd_card_sim.cmd[BYTE_3] << SHIFT_8) | 
+                   (uint32_t)sd_card_sim.cmd[BYTE_4]; 
+    uint8_t app_cmd = sd_card_sim.app_cmd; 
+    uint8_t r1 = (sd_card_sim.ready) ? SD_CARD_SIM_R1_READY : SD_CARD_SIM_R1_IDLE; 
+
+    sd_card_sim.commands++; 
+    sd_card_sim.app_cmd = FALSE; 
+
+    // CMD12 ends a read - the byte after the command is a stuff byte 
+    if (index == SD_CARD_SIM_CMD12)
+    {
+        sd_card_sim.out_head = CLEAR; 
+        sd_card_sim.out_tail = CLEAR; 
+        sd_card_sim.access = CLEAR; 
+        sd_card_sim.state = SD_CARD_SIM_IDLE; 
+        sd_card_sim_out(SD_CARD_SIM_HIGH); 
+    }
+
+    // Sector commands with an address past the end of the card 
+    if (((index == SD_CARD_SIM_CMD17) || (index == SD_CARD_SIM_CMD18) || 
+         (index == SD_CARD_SIM_CMD24) || (index == SD_CARD_SIM_CMD25)) && 
+        (arg >= sd_card_sim.sectors))
+    {
+        sd_card_sim.param_errors++; 
+        r1 |= SD_CARD_SIM_R1_PARAM; 
+        index = CLEAR; 
+    }
+
+    if (index == SD_CARD_SIM_CMD0)
+    {
+        // Software reset (or a rejected sector command)
+        if (!(r1 & SD_CARD_SIM_R1_PARAM))
+        {
+            sd_card_sim.ready = FALSE; 
+            sd_card_sim.init_count = SD_CARD_SIM_INIT_COUNT; 
+            sd_card_sim.state = SD_CARD_SIM_IDLE; 
+            r1 = SD_CARD_SIM_R1_IDLE; 
+        }
+
+        sd_card_sim_out(SD_CARD_SIM_HIGH); 
+        sd_card_sim_out(r1); 
+        return; 
+    }
+
+    // Ncr - the R1 response comes one byte after the command 
+    sd_card_sim_out(SD_CARD_SIM_HIGH); 
+
+    switch (index)
+    {
+        case SD_CARD_SIM_CMD8:   // R7 - voltage accepted and the check pattern echoed 
+            sd_card_sim_out(r1); 
+            sd_card_sim_out(CLEAR); 
+            sd_card_sim_out(CLEAR); 
+            sd_card_sim_out((uint8_t)(arg >> SHIFT_8)); 
+            sd_card_sim_out((uint8_t)arg); 
+            break; 
+
+        case SD_CARD_SIM_CMD9:   // CSD version 2 
+            sd_card_sim_out(r1); 
+            sd_card_sim_out(SD_CARD_SIM_HIGH); 
+            sd_card_sim_out(SD_CARD_SIM_TOKEN); 
+            {
+                uint32_t c_size = (sd_card_sim.sectors / SD_CARD_SIM_C_SIZE_UNIT) ? 
+                                  (sd_card_sim.sectors / SD_CARD_SIM_C_SIZE_UNIT - 1) : 
+                                  CLEAR; 
+                uint8_t csd[SD_CARD_SIM_CSD_LEN] = 
+                {
+                    0x40, 0x0E, 0x00, sd_card_sim.tran_speed, 0x5B, 0x59, 0x00, 
+                    (uint8_t)((c_size >> SHIFT_16) & 0x3F), (uint8_t)(c_size >> SHIFT_8), 
+                    (uint8_t)c_size, 0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01 
+                };
+
+                for (uint8_t i = CLEAR; i < SD_CARD_SIM_CSD_LEN; i++)
+                {
+                    sd_card_sim_out(csd[i]); 
+                }
+            }
+            sd_card_sim_out(SD_CARD_SIM_HIGH); 
+            sd_card_sim_out(SD_CARD_SIM_HIGH); 
+            break; 
+
+        case SD_CARD_SIM_CMD41: 
+            if (app_cmd && sd_card_sim.init_count)
+            {
+                sd_card_sim.init_count--; 
+            }
+            else if (app_cmd)
+            {
+                sd_card_sim.ready = TRUE; 
+                r1 = SD_CARD_SIM_R1_READY; 
+            }
+            else 
+            {
+                r1 |= SD_CARD_SIM_R1_ILLEGAL; 
+            }
+            sd_card_sim_out(r1); 
+            break; 
+
+        case SD_CARD_SIM_CMD55: 
+            sd_card_sim.app_cmd = TRUE; 
+            sd_card_sim_out(r1); 
+            break; 
+
+        case SD_CARD_SIM_CMD58:   // OCR - powered up, CCS set (block addressing)
+            sd_card_sim_out(r1); 
+            sd_card_sim_out(0xC0); 
+            sd_card_sim_out(0xFF); 
+            sd_card_sim_out(0x80); 
+            sd_card_sim_out(0x00); 
+            break; 
+
+        case SD_CARD_SIM_CMD12: 
+        case SD_CARD_SIM_CMD16: 
+        case SD_CARD_SIM_CMD23: 
+            sd_card_sim_out(r1); 
+            break; 
+
+        case SD_CARD_SIM_CMD17: 
+            sd_card_sim_out(r1); 
+
+            if (sd_card_sim.lost_tokens)
+            {
+                sd_card_sim.lost_tokens--; 
+                break; 
+            }
+
+            sd_card_sim_out_sector(arg); 
+            break; 
+
+        case SD_CARD_SIM_CMD18:   // A lost token leaves the card waiting for a command 
+            sd_card_sim_out(r1); 
+
+            if (sd_card_sim.lost_tokens)
+            {
+                sd_card_sim.lost_tokens--; 
+                break; 
+            }
+
+            sd_card_sim_out_sector(arg); 
+            sd_card_sim.sector = arg + BYTE_1; 
+            sd_card_sim.state = SD_CARD_SIM_READ_MULTI; 
+            break; 
+
+        case SD_CARD_SIM_CMD24: 
+        case SD_CARD_SIM_CMD25: 
+            sd_card_sim_out(r1); 
+            sd_card_sim.sector = arg; 
+            sd_card_sim.rx_count = CLEAR; 
+            sd_card_sim.state = (index == SD_CARD_SIM_CMD24) ? SD_CARD_SIM_WRITE_SINGLE : 
+                                                               SD_CARD_SIM_WRITE_MULTI; 
+            break; 
+
+        default: 
+            sd_card_sim_out(r1 | SD_CARD_SIM_R1_ILLEGAL); 
+            break; 
+    }
+}
+
+
+// Card receives the end of a written data packet 
+void sd_card_sim_packet_end(void)
+{
+    if (sd_card_sim.state == SD_CARD_SIM_WRITE_SINGLE)
+    {
+        sd_card_sim.state = SD_CARD_SIM_IDLE; 
+    }
+
+    if (sd_card_sim.crc_errors)
+    {
+        sd_card_sim.crc_errors--; 
+        sd_card_sim_out(SD_CARD_SIM_DR_CRC); 
+        return; 
+    }
+
+    if (sd_card_sim.sector >= sd_card_sim.sectors)
+    {
+        sd_card_sim_out(SD_CARD_SIM_DR_WRITE); 
+        return; 
+    }
+
+    memcpy((void *)&sd_card_sim.data[sd_card_sim.sector*SD_CARD_SIM_SEC_SIZE], 
+           (void *)sd_card_sim.rx, SD_CARD_SIM_SEC_SIZE); 
+    sd_card_sim.sector++; 
+    sd_card_sim.sectors_written++; 
+
+    sd_card_sim_out(SD_CARD_SIM_DR_OK); 
+    sd_card_sim.busy = sd_card_sim.busy_bytes; 
+}
+
+//=======================================================================================
@@ -0,0 +1,162 @@
+/**
+ * @file sd_card_sim.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief SD card simulator interface - for unit testing 
+ * 
+ * @details Models an SDHC card on the SPI bus at the byte level so the FATFS driver can
+ *          be tested against the bytes it actually sends. When enabled with 
+ *          spi_mock_set_sim the SPI mock functions (slave select, write, read and 
+ *          transfers) are passed to the simulator. The card answers the commands the 
+ *          driver uses (identification, CSD, single and multiple block reads and 
+ *          writes, stop transmission) from a RAM sector buffer. Out of range addresses 
+ *          get an R1 parameter error or a data error token the same as a real card. 
+ * 
+ *          Transfer errors can be injected: a read data token that never comes (card 
+ *          didn't see the command data correctly) and a write data packet rejected with 
+ *          a CRC error. The time a slow card takes to find read data (read access time) and 
+ *          to program written data (busy) can be set as a number of bytes clocked. 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _SD_CARD_SIM_H_
+#define _SD_CARD_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "tools.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SD_CARD_SIM_SEC_SIZE 512 
+#define SD_CARD_SIM_OUT_SIZE 600         // Bytes the card can have queued to send 
+#define SD_CARD_SIM_TRAN_25MHZ 0x32      // CSD TRAN_SPEED of a default speed card 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Card state 
+typedef enum {
+    SD_CARD_SIM_IDLE,            // Waiting for a command 
+    SD_CARD_SIM_READ_MULTI,      // Sending sectors until CMD12 
+    SD_CARD_SIM_WRITE_SINGLE,    // Waiting for the CMD24 data packet 
+    SD_CARD_SIM_WRITE_MULTI      // Waiting for CMD25 data packets or the stop token 
+} sd_card_sim_state_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+// Simulator state 
+typedef struct sd_card_sim_s 
+{
+    // Storage 
+    uint8_t *data;                   // Sector data (not copied)
+    uint32_t sectors;                // Card capacity 
+    uint8_t tran_speed;              // CSD TRAN_SPEED 
+
+    // Bus 
+    uint8_t selected; 
+    uint8_t cmd[BYTE_6];             // Command being received 
+    uint8_t cmd_index; 
+    uint8_t out[SD_CARD_SIM_OUT_SIZE];   // Bytes queued to send 
+    uint16_t out_head; 
+    uint16_t out_tail; 
+    uint32_t busy;                   // Busy (0x00) bytes left after a write 
+    uint32_t busy_bytes;             // Busy bytes after each written sector 
+    uint32_t access;                 // Read access (0xFF) bytes left before a data token 
+    uint32_t access_bytes;           // Read access bytes before each read data token 
+    uint16_t access_at;              // Queue index of the data token being held back 
+
+    // Card 
+    sd_card_sim_state_t state; 
+    uint8_t app_cmd;                 // Last command was CMD55 
+    uint8_t init_count;              // ACMD41 calls left before the card is ready 
+    uint8_t ready;                   // Initialization done 
+    uint32_t sector;                 // Next sector of a multiple block transfer 
+    uint16_t rx_count;               // Data packet bytes received 
+    uint8_t rx[SD_CARD_SIM_SEC_SIZE]; 
+
+    // Injected transfer errors 
+    uint16_t lost_tokens;            // Read commands that don't get a data token 
+    uint16_t crc_errors;             // Written sectors rejected with a CRC error 
+
+    // Statistics 
+    uint32_t commands; 
+    uint32_t param_errors;           // Commands rejected for an out of range address 
+    uint32_t sectors_read; 
+    uint32_t sectors_written; 
+    uint32_t busy_packets;           // Write data tokens sent while the card was busy 
+}
+sd_card_sim_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator functions 
+
+extern sd_card_sim_t sd_card_sim; 
+
+
+// Reset the simulator with an inserted card that holds 'sectors' sectors of 'data'. The 
+// data isn't copied. A tran_speed of 0 uses a default speed (25 MHz) card. 
+void sd_card_sim_init(
+    uint8_t *data, 
+    uint32_t sectors, 
+    uint8_t tran_speed); 
+
+
+// Inject transfer errors - the next 'lost_tokens' read commands don't get a data token 
+// and the next 'crc_errors' written sectors are rejected 
+void sd_card_sim_set_errors(
+    uint16_t lost_tokens, 
+    uint16_t crc_errors); 
+
+
+// Set the card timing - 'access_bytes' bytes are clocked before each read data token and 
+// the card stays busy for 'busy_bytes' bytes after each written sector 
+void sd_card_sim_set_timing(
+    uint32_t access_bytes, 
+    uint32_t busy_bytes); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Bus functions - called by the SPI mock 
+
+// Chip select - TRUE when the card is selected 
+void sd_card_sim_select(uint8_t selected); 
+
+
+// Exchange one byte - returns the byte the card sends while 'mosi' is received 
+uint8_t sd_card_sim_exchange(uint8_t mosi); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _SD_CARD_SIM_H_
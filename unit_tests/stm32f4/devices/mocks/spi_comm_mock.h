@@ -56,6 +56,13 @@ typedef enum {
     SPI_MOCK_INC_MODE_ENABLE 
 } spi_mock_increment_mode_t; 
 
+
+// SPI mock driver SD card simulator selection 
+typedef enum {
+    SPI_MOCK_SIM_DISABLE, 
+    SPI_MOCK_SIM_ENABLE 
+} spi_mock_sim_t; 
+
 //=======================================================================================
 
 
@@ -82,6 +89,15 @@ void spi_mock_set_read_data(
     uint16_t data_size, 
     uint8_t read_index); 
 
+
+// Pass bus activity to the SD card simulator (sd_card_sim) instead of the indexed 
+// buffers. The simulator must be set up with sd_card_sim_init. spi_mock_init disables it. 
+void spi_mock_set_sim(spi_mock_sim_t sim_status); 
+
+
+// Get the last baud rate control set with spi_set_baud 
+spi_baud_rate_ctrl_t spi_mock_get_baud(void); 
+
 //=======================================================================================
 
 #endif   // _SPI_COMM_MOCK_H_ 
@@ -0,0 +1,372 @@
+/**
+ * @file fatfs_cache_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS sector cache unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - The cache is tested against a RAM disk that records each read and write so the 
+//   number and size of card accesses can be checked. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include <cstring> 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "fatfs_cache.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DISK_SECTORS 64 
+#define CACHE_LINES 4 
+#define CACHE_WAYS 2 
+#define MAX_ACCESSES 32 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// RAM disk 
+
+static uint8_t disk[DISK_SECTORS][FATFS_CACHE_SEC_SIZE]; 
+static uint16_t read_runs[MAX_ACCESSES]; 
+static uint16_t write_runs[MAX_ACCESSES]; 
+static uint32_t write_starts[MAX_ACCESSES]; 
+static uint16_t num_reads; 
+static uint16_t num_writes; 
+static uint8_t write_fail; 
+
+
+static DISK_RESULT disk_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    read_runs[num_reads++ % MAX_ACCESSES] = count; 
+    memcpy(buff, disk[sector], count * FATFS_CACHE_SEC_SIZE); 
+    return FATFS_RES_OK; 
+}
+
+
+static DISK_RESULT disk_write(
+    const uint8_t *const *sectors, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    if (write_fail)
+    {
+        return FATFS_RES_ERROR; 
+    }
+
+    write_starts[num_writes % MAX_ACCESSES] = sector; 
+    write_runs[num_writes++ % MAX_ACCESSES] = count; 
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        memcpy(disk[sector + i], sectors[i], FATFS_CACHE_SEC_SIZE); 
+    }
+
+    return FATFS_RES_OK; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test group 
+
+TEST_GROUP(fatfs_cache_test)
+{
+    // Global test group variables 
+    fatfs_cache_t cache; 
+    fatfs_cache_line_t lines[CACHE_LINES]; 
+    uint8_t buff[DISK_SECTORS * FATFS_CACHE_SEC_SIZE]; 
+
+    // Constructor 
+    void setup()
+    {
+        // Each sector is filled with its own number 
+        for (uint16_t i = 0; i < DISK_SECTORS; i++)
+        {
+            memset(disk[i], (uint8_t)i, FATFS_CACHE_SEC_SIZE); 
+        }
+
+        num_reads = 0; 
+        num_writes = 0; 
+        write_fail = FALSE; 
+
+        fatfs_cache_init(&cache, lines, CACHE_LINES, CACHE_WAYS, disk_read, disk_write); 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Check that a sector buffer is filled with one value 
+static void check_sector(
+    const uint8_t *sector, 
+    uint8_t value)
+{
+    for (uint16_t i = 0; i < FATFS_CACHE_SEC_SIZE; i++)
+    {
+        if (sector[i] != value)
+        {
+            FAIL("Unexpected sector data"); 
+        }
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Initialization argument checks 
+TEST(fatfs_cache_test, init_params)
+{
+    fatfs_cache_t test_cache; 
+
+    LONGS_EQUAL(FATFS_RES_PARERR, 
+                fatfs_cache_init(NULL, lines, CACHE_LINES, CACHE_WAYS, NULL, NULL)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, 
+                fatfs_cache_init(&test_cache, NULL, CACHE_LINES, CACHE_WAYS, NULL, NULL)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, 
+                fatfs_cache_init(&test_cache, lines, CACHE_LINES, 0, NULL, NULL)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, 
+                fatfs_cache_init(&test_cache, lines, 1, CACHE_WAYS, NULL, NULL)); 
+
+    // Lines are rounded down to a multiple of the ways 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_init(&test_cache, lines, 3, 2, NULL, NULL)); 
+    LONGS_EQUAL(1, test_cache.sets); 
+
+    // No card to read from or write to 
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_cache_read(&test_cache, buff, 0, 1)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_cache_write(&test_cache, buff, 0, 1)); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_init(&test_cache, lines, CACHE_LINES, CACHE_LINES, 
+                                               disk_read, disk_write)); 
+    LONGS_EQUAL(1, test_cache.sets); 
+}
+
+
+// A single sector is read from the card once and then from the cache 
+TEST(fatfs_cache_test, read_hit)
+{
+    fatfs_cache_stats_t stats; 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_read(&cache, buff, 5, 1)); 
+    check_sector(buff, 5); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_read(&cache, buff, 5, 1)); 
+    check_sector(buff, 5); 
+
+    LONGS_EQUAL(1, num_reads); 
+
+    fatfs_cache_stats(&cache, &stats); 
+    LONGS_EQUAL(1, stats.hits); 
+    LONGS_EQUAL(1, stats.misses); 
+    LONGS_EQUAL(1, stats.card_reads); 
+}
+
+
+// Multiple sector reads use cached sectors and read the rest in runs 
+TEST(fatfs_cache_test, read_runs)
+{
+    // Sector 4 is cached and written to (only in the cache) 
+    memset(buff, 0xAA, FATFS_CACHE_SEC_SIZE); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_write(&cache, buff, 4, 1)); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_read(&cache, buff, 2, 5)); 
+
+    check_sector(&buff[0 * FATFS_CACHE_SEC_SIZE], 2); 
+    check_sector(&buff[1 * FATFS_CACHE_SEC_SIZE], 3); 
+    check_sector(&buff[2 * FATFS_CACHE_SEC_SIZE], 0xAA); 
+    check_sector(&buff[3 * FATFS_CACHE_SEC_SIZE], 5); 
+    check_sector(&buff[4 * FATFS_CACHE_SEC_SIZE], 6); 
+
+    LONGS_EQUAL(2, num_reads); 
+    LONGS_EQUAL(2, read_runs[0]); 
+    LONGS_EQUAL(2, read_runs[1]); 
+
+    // Multiple sector reads aren't cached 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_read(&cache, buff, 2, 1)); 
+    LONGS_EQUAL(3, num_reads); 
+}
+
+
+// Single sector writes stay in the cache until they're flushed 
+TEST(fatfs_cache_test, write_back)
+{
+    memset(buff, 0x55, FATFS_CACHE_SEC_SIZE); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_write(&cache, buff, 9, 1)); 
+
+    LONGS_EQUAL(0, num_writes); 
+    check_sector(disk[9], 9); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_flush(&cache)); 
+    LONGS_EQUAL(1, num_writes); 
+    check_sector(disk[9], 0x55); 
+
+    // Nothing left to write 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_flush(&cache)); 
+    LONGS_EQUAL(1, num_writes); 
+}
+
+
+// Consecutive dirty sectors are written back in one write 
+TEST(fatfs_cache_test, flush_coalesce)
+{
+    fatfs_cache_stats_t stats; 
+
+    // Sectors 11 and 10 land in different sets (sector % 2) 
+    memset(buff, 0x11, FATFS_CACHE_SEC_SIZE); 
+    fatfs_cache_write(&cache, buff, 11, 1); 
+    memset(buff, 0x10, FATFS_CACHE_SEC_SIZE); 
+    fatfs_cache_write(&cache, buff, 10, 1); 
+    memset(buff, 0x20, FATFS_CACHE_SEC_SIZE); 
+    fatfs_cache_write(&cache, buff, 20, 1); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_flush(&cache)); 
+
+    LONGS_EQUAL(2, num_writes); 
+    LONGS_EQUAL(10, write_starts[0]); 
+    LONGS_EQUAL(2, write_runs[0]); 
+    LONGS_EQUAL(20, write_starts[1]); 
+    LONGS_EQUAL(1, write_runs[1]); 
+
+    check_sector(disk[10], 0x10); 
+    check_sector(disk[11], 0x11); 
+    check_sector(disk[20], 0x20); 
+
+    fatfs_cache_stats(&cache, &stats); 
+    LONGS_EQUAL(3, stats.write_backs); 
+    LONGS_EQUAL(2, stats.card_writes); 
+}
+
+
+// The least recently used line of a set is replaced and written back if dirty 
+TEST(fatfs_cache_test, lru_eviction)
+{
+    fatfs_cache_stats_t stats; 
+
+    // Sectors 0, 2 and 4 all map to set 0 (2 ways) 
+    memset(buff, 0xA0, FATFS_CACHE_SEC_SIZE); 
+    fatfs_cache_write(&cache, buff, 0, 1); 
+    fatfs_cache_read(&cache, buff, 2, 1); 
+
+    // Use sector 0 again so sector 2 is the LRU line 
+    fatfs_cache_read(&cache, buff, 0, 1); 
+    check_sector(buff, 0xA0); 
+
+    fatfs_cache_read(&cache, buff, 4, 1); 
+    LONGS_EQUAL(0, num_writes); 
+
+    // Sector 2 was replaced, sector 0 is still cached 
+    LONGS_EQUAL(2, num_reads); 
+    fatfs_cache_read(&cache, buff, 0, 1); 
+    LONGS_EQUAL(2, num_reads); 
+    fatfs_cache_read(&cache, buff, 2, 1); 
+    LONGS_EQUAL(3, num_reads); 
+
+    // That replaced sector 4 (LRU) and then the dirty sector 0 had to go 
+    fatfs_cache_read(&cache, buff, 6, 1); 
+    LONGS_EQUAL(1, num_writes); 
+    LONGS_EQUAL(0, write_starts[0]); 
+    check_sector(disk[0], 0xA0); 
+
+    fatfs_cache_stats(&cache, &stats); 
+    LONGS_EQUAL(3, stats.evictions); 
+    LONGS_EQUAL(1, stats.write_backs); 
+}
+
+
+// Multiple sector writes go to the card and update cached copies 
+TEST(fatfs_cache_test, bulk_write)
+{
+    fatfs_cache_read(&cache, buff, 3, 1); 
+
+    for (uint16_t i = 0; i < 40; i++)
+    {
+        memset(&buff[i * FATFS_CACHE_SEC_SIZE], 0xC0 + (i & 0x0F), FATFS_CACHE_SEC_SIZE); 
+    }
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_write(&cache, buff, 2, 40)); 
+
+    // Split into the max run length 
+    LONGS_EQUAL(2, num_writes); 
+    LONGS_EQUAL(FATFS_CACHE_MAX_RUN, write_runs[0]); 
+    LONGS_EQUAL(40 - FATFS_CACHE_MAX_RUN, write_runs[1]); 
+    check_sector(disk[2], 0xC0); 
+    check_sector(disk[41], 0xC7); 
+
+    // The cached copy has the new data and is clean 
+    fatfs_cache_read(&cache, buff, 3, 1); 
+    check_sector(buff, 0xC1); 
+    LONGS_EQUAL(1, num_reads); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_flush(&cache)); 
+    LONGS_EQUAL(2, num_writes); 
+}
+
+
+// Dirty sectors are kept when the card write fails 
+TEST(fatfs_cache_test, write_fail)
+{
+    memset(buff, 0x77, FATFS_CACHE_SEC_SIZE); 
+    fatfs_cache_write(&cache, buff, 7, 1); 
+
+    write_fail = TRUE; 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_cache_flush(&cache)); 
+    check_sector(disk[7], 7); 
+
+    write_fail = FALSE; 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_flush(&cache)); 
+    check_sector(disk[7], 0x77); 
+}
+
+
+// Invalidating drops cached and dirty sectors 
+TEST(fatfs_cache_test, invalidate)
+{
+    memset(buff, 0x33, FATFS_CACHE_SEC_SIZE); 
+    fatfs_cache_write(&cache, buff, 1, 1); 
+
+    fatfs_cache_invalidate(&cache); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_flush(&cache)); 
+    LONGS_EQUAL(0, num_writes); 
+    fatfs_cache_read(&cache, buff, 1, 1); 
+    check_sector(buff, 1); 
+    LONGS_EQUAL(1, num_reads); 
+}
+
+//=======================================================================================
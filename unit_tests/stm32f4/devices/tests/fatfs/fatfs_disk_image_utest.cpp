@@ -0,0 +1,319 @@
+/**
+ * @file fatfs_disk_image_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS disk image unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - Images are temporary files that are deleted after each test. 
+// - Times are simulated (microseconds) so they're exact sums of the profile times. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include <cstdlib> 
+#include <cstring> 
+#include <unistd.h> 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "fatfs_disk_image.h" 
+    #include "fatfs_cache.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define IMG_SECTORS 128 
+#define IMG_PDRV 0 
+#define CTRL_SYNC 0 
+#define GET_SECTOR_COUNT 1 
+#define GET_SECTOR_SIZE 2 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test group 
+
+TEST_GROUP(fatfs_disk_image_test)
+{
+    // Global test group variables 
+    char path[32]; 
+    uint8_t buff[8 * FATFS_IMG_SEC_SIZE]; 
+    uint8_t read_buff[8 * FATFS_IMG_SEC_SIZE]; 
+    fatfs_img_profile_t profile; 
+
+    // Constructor 
+    void setup()
+    {
+        strcpy(path, "/tmp/fatfs_img_XXXXXX"); 
+        close(mkstemp(path)); 
+
+        memset(&profile, 0, sizeof(profile)); 
+        profile.cmd_us = 10; 
+        profile.sector_us = 170; 
+        profile.read_access_us = 100; 
+        profile.write_busy_us = 500; 
+        profile.multi_busy_us = 300; 
+
+        fatfs_user_init(NULL, NULL, 0); 
+        fatfs_img_set_profile(NULL); 
+        fatfs_img_set_protect(FALSE); 
+        fatfs_img_reset_stats(); 
+        fatfs_img_open(path, IMG_SECTORS); 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        fatfs_img_close(); 
+        unlink(path); 
+    }
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Fill sectors with their sector number 
+static void fill_sectors(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        memset(&buff[i * FATFS_IMG_SEC_SIZE], (uint8_t)(sector + i), FATFS_IMG_SEC_SIZE); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// The disk isn't ready until the image is open and initialized 
+TEST(fatfs_disk_image_test, not_ready)
+{
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_img_open(path, IMG_SECTORS)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_img_open(NULL, IMG_SECTORS)); 
+
+    LONGS_EQUAL(0x01, fatfs_status(IMG_PDRV)); 
+    LONGS_EQUAL(FATFS_RES_NOTRDY, fatfs_read(IMG_PDRV, buff, 0, 1)); 
+    LONGS_EQUAL(FATFS_RES_NOTRDY, fatfs_write(IMG_PDRV, buff, 0, 1)); 
+
+    // Nothing to open 
+    fatfs_img_close(); 
+    LONGS_EQUAL(0x01, fatfs_init(IMG_PDRV)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_img_open("/tmp/fatfs_img_none/img", 0)); 
+
+    // An empty file needs a size 
+    LONGS_EQUAL(0, truncate(path, 0)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_img_open(path, 0)); 
+}
+
+
+// Sectors are read back as written and the image size is reported 
+TEST(fatfs_disk_image_test, read_write)
+{
+    uint32_t sector_count = 0; 
+    uint16_t sector_size = 0; 
+
+    LONGS_EQUAL(0, fatfs_init(IMG_PDRV)); 
+    LONGS_EQUAL(0, fatfs_status(IMG_PDRV)); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_ioctl(IMG_PDRV, GET_SECTOR_COUNT, &sector_count)); 
+    LONGS_EQUAL(IMG_SECTORS, sector_count); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_ioctl(IMG_PDRV, GET_SECTOR_SIZE, &sector_size)); 
+    LONGS_EQUAL(FATFS_IMG_SEC_SIZE, sector_size); 
+
+    fill_sectors(buff, 20, 8); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(IMG_PDRV, buff, 20, 8)); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(IMG_PDRV, read_buff, 20, 8)); 
+    MEMCMP_EQUAL(buff, read_buff, sizeof(buff)); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(IMG_PDRV, read_buff, 23, 1)); 
+    MEMCMP_EQUAL(&buff[3 * FATFS_IMG_SEC_SIZE], read_buff, FATFS_IMG_SEC_SIZE); 
+
+    // Out of range 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_read(IMG_PDRV, buff, IMG_SECTORS - 1, 2)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_write(IMG_PDRV, buff, IMG_SECTORS, 1)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_read(IMG_PDRV, buff, 0, 0)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_read(1, buff, 0, 1)); 
+    LONGS_EQUAL(FATFS_RES_PARERR, fatfs_ioctl(IMG_PDRV, 3, &sector_count)); 
+}
+
+
+// The image file keeps the data 
+TEST(fatfs_disk_image_test, persistent)
+{
+    uint32_t sector_count = 0; 
+
+    fatfs_init(IMG_PDRV); 
+    fill_sectors(buff, 5, 2); 
+    fatfs_write(IMG_PDRV, buff, 5, 2); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_img_close()); 
+
+    // Reopened at its existing size 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_img_open(path, 0)); 
+    fatfs_init(IMG_PDRV); 
+    fatfs_ioctl(IMG_PDRV, GET_SECTOR_COUNT, &sector_count); 
+    LONGS_EQUAL(IMG_SECTORS, sector_count); 
+
+    fatfs_read(IMG_PDRV, read_buff, 5, 2); 
+    MEMCMP_EQUAL(buff, read_buff, 2 * FATFS_IMG_SEC_SIZE); 
+    MEMCMP_EQUAL(buff, fatfs_img_data() + 5 * FATFS_IMG_SEC_SIZE, 2 * FATFS_IMG_SEC_SIZE); 
+}
+
+
+// Writes fail with the write protect switch set 
+TEST(fatfs_disk_image_test, write_protect)
+{
+    fatfs_img_set_protect(TRUE); 
+    LONGS_EQUAL(0x04, fatfs_init(IMG_PDRV)); 
+    LONGS_EQUAL(FATFS_RES_WRPRT, fatfs_write(IMG_PDRV, buff, 0, 1)); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(IMG_PDRV, buff, 0, 1)); 
+}
+
+
+// Disk functions take the time the profile gives the commands and packets they use 
+TEST(fatfs_disk_image_test, profile_timing)
+{
+    fatfs_img_stats_t stats; 
+
+    fatfs_init(IMG_PDRV); 
+    fatfs_img_set_profile(&profile); 
+    fatfs_img_reset_stats(); 
+
+    // CMD17: 10 + 100 + 170 
+    fatfs_read(IMG_PDRV, buff, 0, 1); 
+    LONGS_EQUAL(280, fatfs_img_time_us()); 
+
+    // CMD18 + CMD12: 20 + 4 * 270 
+    fatfs_read(IMG_PDRV, buff, 0, 4); 
+    LONGS_EQUAL(280 + 1100, fatfs_img_time_us()); 
+
+    // CMD24: 10 + 170 + 500 
+    fatfs_write(IMG_PDRV, buff, 0, 1); 
+    LONGS_EQUAL(1380 + 680, fatfs_img_time_us()); 
+
+    // ACMD23 + CMD25: 30 + 4 * 470 
+    fatfs_write(IMG_PDRV, buff, 0, 4); 
+    LONGS_EQUAL(2060 + 1910, fatfs_img_time_us()); 
+
+    fatfs_img_get_stats(&stats); 
+    LONGS_EQUAL(2, stats.read_cmds); 
+    LONGS_EQUAL(2, stats.write_cmds); 
+    LONGS_EQUAL(5, stats.sectors_read); 
+    LONGS_EQUAL(5, stats.sectors_written); 
+    LONGS_EQUAL(1910, stats.max_cmd_us); 
+}
+
+
+// Stalls and busy time traces 
+TEST(fatfs_disk_image_test, stalls)
+{
+    const uint32_t trace[] = { 1000, 120000 }; 
+    fatfs_img_stats_t stats; 
+
+    fatfs_init(IMG_PDRV); 
+
+    // Every 3rd write command stalls 
+    profile.stall_us = 100000; 
+    profile.stall_interval = 3; 
+    fatfs_img_set_profile(&profile); 
+    fatfs_img_reset_stats(); 
+
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        fatfs_write(IMG_PDRV, buff, 0, 1); 
+    }
+
+    fatfs_img_get_stats(&stats); 
+    LONGS_EQUAL(6 * 680 + 2 * 100000, (uint32_t)stats.time_us); 
+    LONGS_EQUAL(100680, stats.max_cmd_us); 
+
+    // Busy times replayed from a trace 
+    memset(&profile, 0, sizeof(profile)); 
+    profile.trace = trace; 
+    profile.trace_len = 2; 
+    fatfs_img_set_profile(&profile); 
+    fatfs_img_reset_stats(); 
+
+    fatfs_write(IMG_PDRV, buff, 0, 1); 
+    LONGS_EQUAL(1000, fatfs_img_time_us()); 
+    fatfs_write(IMG_PDRV, buff, 0, 2); 
+    LONGS_EQUAL(1000 + 120000 + 1000, fatfs_img_time_us()); 
+}
+
+
+// The sector cache works in front of the image like it does in front of the card 
+TEST(fatfs_disk_image_test, sector_cache)
+{
+    fatfs_cache_t cache; 
+    fatfs_cache_line_t lines[4]; 
+    fatfs_img_stats_t stats; 
+    uint32_t uncached_us; 
+
+    fatfs_init(IMG_PDRV); 
+    fatfs_img_set_profile(&profile); 
+
+    // FAT sector updates without the cache 
+    fatfs_img_reset_stats(); 
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        fatfs_read(IMG_PDRV, buff, 1, 1); 
+        fatfs_write(IMG_PDRV, buff, 1, 1); 
+    }
+
+    fatfs_ioctl(IMG_PDRV, CTRL_SYNC, NULL); 
+    uncached_us = fatfs_img_time_us(); 
+
+    // And with it 
+    fatfs_cache_init(&cache, lines, 4, 2, NULL, NULL); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_cache_attach(&cache)); 
+    fatfs_img_reset_stats(); 
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        fatfs_read(IMG_PDRV, buff, 1, 1); 
+        memset(buff, i, FATFS_IMG_SEC_SIZE); 
+        fatfs_write(IMG_PDRV, buff, 1, 1); 
+    }
+
+    fatfs_img_get_stats(&stats); 
+    LONGS_EQUAL(1, stats.read_cmds); 
+    LONGS_EQUAL(0, stats.write_cmds); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_ioctl(IMG_PDRV, CTRL_SYNC, NULL)); 
+    fatfs_img_get_stats(&stats); 
+    LONGS_EQUAL(1, stats.write_cmds); 
+    BYTES_EQUAL(9, fatfs_img_data()[FATFS_IMG_SEC_SIZE]); 
+    LONGS_EQUAL(uncached_us / 10, fatfs_img_time_us()); 
+
+    fatfs_cache_attach(NULL); 
+}
+
+//=======================================================================================
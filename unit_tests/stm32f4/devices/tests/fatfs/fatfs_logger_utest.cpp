@@ -0,0 +1,430 @@
+/**
+ * @file fatfs_logger_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS binary data logger unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - Files are written to the FatFs mock (RAM) and read back with the record format 
+//   described in fatfs_logger.h. 
+// - Record data is filled with the record number so lost or mixed up records show up 
+//   when the files are parsed. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include <cstdio> 
+#include <cstring> 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "fatfs_logger.h" 
+    #include "ff_mock.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define RING_SIZE 4096 
+#define BLOCK_SIZE 1024 
+#define FILE_SIZE 4096 
+#define RECORD_ID 0x10 
+#define RECORD_LEN 60             // 64 byte records with the header 
+#define LOG_PREFIX "0:/LOG" 
+#define PARSE_ERROR 0xFFFFFFFF    // Returned when a record is wrong 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test group 
+
+TEST_GROUP(fatfs_logger_test)
+{
+    // Global test group variables 
+    fatfs_logger_t logger; 
+    uint8_t ring[RING_SIZE]; 
+    uint8_t stream[FF_MOCK_MAX_FILES * FF_MOCK_FILE_SIZE]; 
+    uint32_t record_num; 
+
+    // Constructor 
+    void setup()
+    {
+        ff_mock_init(); 
+        record_num = 0; 
+        fatfs_logger_init(&logger, ring, RING_SIZE, BLOCK_SIZE, LOG_PREFIX, 1, FILE_SIZE, 
+                          ff_mock_time); 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+
+    // Log records with their record number as data 
+    uint32_t log_records(uint32_t count, uint16_t len = RECORD_LEN)
+    {
+        uint8_t data[RING_SIZE]; 
+        uint32_t logged = 0; 
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            memset(data, (uint8_t)record_num, len); 
+
+            if (fatfs_logger_log(&logger, RECORD_ID, data, len) == FATFS_LOGGER_OK)
+            {
+                record_num++; 
+                logged++; 
+            }
+        }
+
+        return logged; 
+    }
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Get a log file by number 
+static const uint8_t *get_log_file(
+    uint16_t index, 
+    uint32_t *size, 
+    uint8_t *expanded)
+{
+    char name[FATFS_LOGGER_NAME_LEN]; 
+    snprintf(name, sizeof(name), "%s%05u.BIN", LOG_PREFIX, index); 
+    return ff_mock_get_file(name, size, expanded); 
+}
+
+
+// Parse a log file - returns the number of records or PARSE_ERROR if they're not in order 
+static uint32_t parse_log_file(
+    const uint8_t *file, 
+    uint32_t size, 
+    uint32_t *next_num)
+{
+    uint32_t pos = 0; 
+    uint32_t records = 0; 
+
+    while ((pos + FATFS_LOGGER_HDR_SIZE) <= size)
+    {
+        if (file[pos] != FATFS_LOGGER_SYNC)
+        {
+            break; 
+        }
+
+        uint8_t id = file[pos + 1]; 
+        uint16_t len = file[pos + 2] | (file[pos + 3] << 8); 
+        pos += FATFS_LOGGER_HDR_SIZE; 
+
+        if (id != FATFS_LOGGER_ID_PAD)
+        {
+            if (id != RECORD_ID)
+            {
+                return PARSE_ERROR; 
+            }
+
+            for (uint16_t i = 0; i < len; i++)
+            {
+                if (file[pos + i] != (uint8_t)*next_num)
+                {
+                    return PARSE_ERROR; 
+                }
+            }
+
+            (*next_num)++; 
+            records++; 
+        }
+
+        pos += len; 
+    }
+
+    return records; 
+}
+
+
+// Read all the log files into one stream 
+static uint32_t read_log(uint8_t *stream)
+{
+    uint32_t size, len = 0; 
+    uint8_t expanded; 
+    const uint8_t *file; 
+
+    for (uint16_t i = 1; (file = get_log_file(i, &size, &expanded)) != NULL; i++)
+    {
+        memcpy(&stream[len], file, size); 
+        len += size; 
+    }
+
+    return len; 
+}
+
+
+// Check that every write was whole sectors at a sector offset 
+static void check_writes_aligned(void)
+{
+    uint32_t offset, len; 
+
+    for (uint16_t i = 0; i < ff_mock_write_count(); i++)
+    {
+        ff_mock_get_write(i, &offset, &len); 
+        LONGS_EQUAL(0, offset % FATFS_LOGGER_SEC_SIZE); 
+        LONGS_EQUAL(0, len % FATFS_LOGGER_SEC_SIZE); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Initialization argument checks 
+TEST(fatfs_logger_test, init_params)
+{
+    fatfs_logger_t test; 
+
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(NULL, ring, RING_SIZE, BLOCK_SIZE, LOG_PREFIX, 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, NULL, RING_SIZE, BLOCK_SIZE, LOG_PREFIX, 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, ring, 3072, BLOCK_SIZE, LOG_PREFIX, 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, ring, RING_SIZE, 1000, LOG_PREFIX, 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, ring, RING_SIZE, RING_SIZE, LOG_PREFIX, 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, ring, RING_SIZE, BLOCK_SIZE, LOG_PREFIX, 1, 1000, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, ring, RING_SIZE, BLOCK_SIZE, NULL, 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+        fatfs_logger_init(&test, ring, RING_SIZE, BLOCK_SIZE, 
+                          "0:/A_VERY_LONG_PREFIX/", 1, FILE_SIZE, NULL)); 
+    LONGS_EQUAL(FATFS_LOGGER_OK, 
+        fatfs_logger_init(&test, ring, RING_SIZE, BLOCK_SIZE, LOG_PREFIX, 1, FILE_SIZE, NULL)); 
+
+    // Padding ID is reserved 
+    LONGS_EQUAL(FATFS_LOGGER_INVALID_PARAM, 
+                fatfs_logger_log(&test, FATFS_LOGGER_ID_PAD, ring, 1)); 
+}
+
+
+// Nothing is written until a block has been collected 
+TEST(fatfs_logger_test, block_writes)
+{
+    uint32_t size, next_num = 0; 
+    uint8_t expanded; 
+
+    // 15 records = 960 bytes 
+    log_records(15); 
+    LONGS_EQUAL(FATFS_LOGGER_OK, fatfs_logger_task(&logger)); 
+    LONGS_EQUAL(0, ff_mock_write_count()); 
+
+    // 2 blocks and a bit 
+    log_records(20); 
+    LONGS_EQUAL(FATFS_LOGGER_OK, fatfs_logger_task(&logger)); 
+    LONGS_EQUAL(1, ff_mock_write_count()); 
+    check_writes_aligned(); 
+
+    // The file is preallocated 
+    const uint8_t *file = get_log_file(1, &size, &expanded); 
+    CHECK(file != NULL); 
+    LONGS_EQUAL(TRUE, expanded); 
+    LONGS_EQUAL(FILE_SIZE, size); 
+
+    // Whole blocks written - the record that runs past the block isn't complete yet 
+    LONGS_EQUAL(32, parse_log_file(file, 2 * BLOCK_SIZE, &next_num)); 
+}
+
+
+// Producers never wait - records are dropped when the ring is full 
+TEST(fatfs_logger_test, ring_full_drops)
+{
+    fatfs_logger_stats_t stats; 
+
+    // The ring holds 64 records 
+    LONGS_EQUAL(64, log_records(70)); 
+    LONGS_EQUAL(FATFS_LOGGER_FULL, fatfs_logger_log(&logger, RECORD_ID, ring, 1)); 
+
+    fatfs_logger_stats(&logger, &stats); 
+    LONGS_EQUAL(64, stats.records); 
+    LONGS_EQUAL(7, stats.dropped); 
+    LONGS_EQUAL(RING_SIZE, stats.max_fill); 
+
+    // Draining makes room again 
+    fatfs_logger_task(&logger); 
+    LONGS_EQUAL(1, log_records(1)); 
+}
+
+
+// A flush pads to the end of the sector so the next write starts on a sector 
+TEST(fatfs_logger_test, flush_padding)
+{
+    uint32_t size, next_num = 0; 
+    uint8_t expanded; 
+
+    log_records(3); 
+    LONGS_EQUAL(FATFS_LOGGER_OK, fatfs_logger_flush(&logger)); 
+    LONGS_EQUAL(1, ff_mock_write_count()); 
+    LONGS_EQUAL(1, ff_mock_sync_count()); 
+
+    log_records(40); 
+    fatfs_logger_flush(&logger); 
+    check_writes_aligned(); 
+
+    const uint8_t *file = get_log_file(1, &size, &expanded); 
+    LONGS_EQUAL(43, parse_log_file(file, size, &next_num)); 
+
+    // Nothing left so nothing written 
+    uint16_t writes = ff_mock_write_count(); 
+    fatfs_logger_flush(&logger); 
+    LONGS_EQUAL(writes, ff_mock_write_count()); 
+}
+
+
+// Records that wrap around the end of the ring are written intact 
+TEST(fatfs_logger_test, ring_wrap)
+{
+    uint32_t size, next_num = 0; 
+    fatfs_logger_stats_t stats; 
+
+    // Odd record sizes so records land across the end of the ring 
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        log_records(7, 97); 
+        fatfs_logger_task(&logger); 
+    }
+
+    fatfs_logger_close(&logger); 
+    check_writes_aligned(); 
+
+    fatfs_logger_stats(&logger, &stats); 
+    LONGS_EQUAL(0, stats.dropped); 
+
+    size = read_log(stream); 
+    LONGS_EQUAL(140, parse_log_file(stream, size, &next_num)); 
+}
+
+
+// Full files are closed and logging continues in the next file 
+TEST(fatfs_logger_test, file_rotation)
+{
+    uint32_t size, next_num = 0; 
+    uint8_t expanded; 
+    fatfs_logger_stats_t stats; 
+
+    // 2.5 files worth of records 
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        log_records(16); 
+        fatfs_logger_task(&logger); 
+    }
+
+    fatfs_logger_close(&logger); 
+
+    fatfs_logger_stats(&logger, &stats); 
+    LONGS_EQUAL(3, stats.files); 
+    LONGS_EQUAL(10 * 16 * (RECORD_LEN + FATFS_LOGGER_HDR_SIZE), stats.bytes_written); 
+
+    // Full files keep the preallocated size and the last one is cut to its data 
+    get_log_file(1, &size, &expanded); 
+    LONGS_EQUAL(FILE_SIZE, size); 
+    get_log_file(2, &size, &expanded); 
+    LONGS_EQUAL(FILE_SIZE, size); 
+    get_log_file(3, &size, &expanded); 
+    LONGS_EQUAL(2048, size); 
+    POINTERS_EQUAL(NULL, get_log_file(4, &size, &expanded)); 
+
+    // Records carry on from one file into the next 
+    size = read_log(stream); 
+    LONGS_EQUAL(160, parse_log_file(stream, size, &next_num)); 
+}
+
+
+// Files are still written when there's no contiguous space for them 
+TEST(fatfs_logger_test, not_contiguous)
+{
+    uint32_t size, next_num = 0; 
+    uint8_t expanded; 
+    fatfs_logger_stats_t stats; 
+
+    ff_mock_set_contiguous(FALSE); 
+
+    log_records(16); 
+    LONGS_EQUAL(FATFS_LOGGER_OK, fatfs_logger_task(&logger)); 
+
+    fatfs_logger_stats(&logger, &stats); 
+    LONGS_EQUAL(1, stats.not_contiguous); 
+
+    const uint8_t *file = get_log_file(1, &size, &expanded); 
+    LONGS_EQUAL(FALSE, expanded); 
+    LONGS_EQUAL(BLOCK_SIZE, size); 
+    LONGS_EQUAL(16, parse_log_file(file, size, &next_num)); 
+}
+
+
+// Card stalls are recorded and absorbed by the ring 
+TEST(fatfs_logger_test, write_latency)
+{
+    fatfs_logger_stats_t stats; 
+
+    ff_mock_set_write_time(150); 
+
+    log_records(16); 
+    fatfs_logger_task(&logger); 
+
+    // Records keep being accepted while the card is busy 
+    LONGS_EQUAL(16, log_records(16)); 
+
+    fatfs_logger_stats(&logger, &stats); 
+    LONGS_EQUAL(150, stats.max_latency); 
+    LONGS_EQUAL(1, stats.writes); 
+}
+
+
+// A write error closes the file and the data goes to the next file 
+TEST(fatfs_logger_test, write_error)
+{
+    uint32_t size, next_num = 0; 
+    uint8_t expanded; 
+    fatfs_logger_stats_t stats; 
+
+    ff_mock_set_write_result(FR_DISK_ERR); 
+    log_records(16); 
+    LONGS_EQUAL(FATFS_LOGGER_FILE_ERROR, fatfs_logger_task(&logger)); 
+
+    fatfs_logger_stats(&logger, &stats); 
+    LONGS_EQUAL(1, stats.errors); 
+    LONGS_EQUAL(FR_DISK_ERR, stats.last_error); 
+
+    ff_mock_set_write_result(FR_OK); 
+    LONGS_EQUAL(FATFS_LOGGER_OK, fatfs_logger_task(&logger)); 
+
+    const uint8_t *file = get_log_file(2, &size, &expanded); 
+    CHECK(file != NULL); 
+    LONGS_EQUAL(16, parse_log_file(file, size, &next_num)); 
+}
+
+//=======================================================================================
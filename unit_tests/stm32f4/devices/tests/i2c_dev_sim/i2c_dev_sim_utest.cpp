@@ -0,0 +1,387 @@
+/**
+ * @file i2c_dev_sim_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C device simulator unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - The drivers run unchanged on top of the I2C mock with the device simulator enabled 
+//   so these tests check what the drivers put on the bus and what they make of the 
+//   device responses. 
+// - Bus times are exact bit counts at the simulated bus speed: start/stop = 1 bit, 
+//   address/data byte = 9 bits. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include <cstdio> 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "lsm303agr_driver.h" 
+    #include "mpu6050_driver.h" 
+    #include "m8q_driver.h" 
+    #include "hd44780u_driver.h" 
+    #include "m8q_config_test.h" 
+    #include "m8q_capture_test.h" 
+    #include "i2c_comm_mock.h" 
+    #include "i2c_dev_sim.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define LSM303AGR_M_ADDR 0x3C 
+#define LSM303AGR_M_CFG_A 0x60 
+#define LSM303AGR_M_OFFSET_X_L 0x45 
+#define LSM303AGR_M_OUT_X_L 0x68 
+#define MPU6050_PWR_MGMT_1 0x6B 
+#define MPU6050_ACCEL_XOUT_H 0x3B 
+#define M8Q_ADDR 0x84 
+#define M8Q_REG_STREAM 0xFF 
+#define PCF8574_ADDR 0x4E 
+#define SIM_SEQ_LEN 1000          // Number of updates in the long sequence tests 
+#define SIM_STRETCH_NS 2000       // Clock stretching used in the timing tests 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test group 
+
+TEST_GROUP(i2c_dev_sim_test)
+{
+    // Global test group variables 
+    I2C_TypeDef I2C_FAKE; 
+    TIM_TypeDef TIM_FAKE; 
+
+    // Constructor 
+    void setup()
+    {
+        i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, 
+                      I2C_MOCK_INC_MODE_DISABLE); 
+        i2c_mock_set_sim(I2C_MOCK_SIM_ENABLE); 
+        i2c_dev_sim_init(I2C_DEV_SIM_BUS_HZ); 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, 
+                      I2C_MOCK_INC_MODE_DISABLE); 
+    }
+
+    // Initialize the LSM303AGR magnetometer 
+    LSM303AGR_STATUS lsm303agr_init(void)
+    {
+        return lsm303agr_m_init(
+            &I2C_FAKE, 
+            LSM303AGR_M_ODR_10, 
+            LSM303AGR_M_MODE_CONT, 
+            LSM303AGR_CFG_DISABLE, 
+            LSM303AGR_CFG_ENABLE, 
+            LSM303AGR_CFG_DISABLE, 
+            LSM303AGR_CFG_DISABLE); 
+    }
+
+    // Initialize the MPU6050 
+    MPU6050_STATUS mpu6050_init_dev(void)
+    {
+        return mpu6050_init(
+            DEVICE_ONE, 
+            &I2C_FAKE, 
+            MPU6050_ADDR_1, 
+            CLEAR, 
+            MPU6050_DLPF_CFG_1, 
+            CLEAR, 
+            MPU6050_AFS_SEL_4, 
+            MPU6050_FS_SEL_500); 
+    }
+
+    // Bus time of a number of start/stop conditions and bytes 
+    uint32_t bus_ns(
+        uint32_t conditions, 
+        uint32_t bytes, 
+        uint32_t bus_hz)
+    {
+        return (uint32_t)(((uint64_t)(conditions + bytes*9) * 1000000000) / bus_hz); 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Devices at their addresses and NACK 
+TEST(i2c_dev_sim_test, device_address_nack)
+{
+    // No device at the magnetometer address 
+    LONGS_EQUAL(LSM303AGR_WHOAMI | LSM303AGR_WRITE_FAULT, lsm303agr_init()); 
+
+    // Device present but it NACKs once 
+    i2c_dev_sim_device_t *mag = i2c_dev_sim_add(I2C_DEV_SIM_LSM303AGR, LSM303AGR_M_ADDR); 
+    CHECK(mag != NULL); 
+    mag->nack_count = 1; 
+    LONGS_EQUAL(LSM303AGR_WHOAMI, lsm303agr_init()); 
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_init()); 
+    LONGS_EQUAL(0, mag->nack_count); 
+
+    // The table is full 
+    i2c_dev_sim_init(I2C_DEV_SIM_BUS_HZ); 
+    for (uint8_t i = 0; i < I2C_DEV_SIM_MAX_DEVICES; i++)
+    {
+        CHECK(i2c_dev_sim_add(I2C_DEV_SIM_REG, (uint8_t)(0x10 + i*2)) != NULL); 
+    }
+    POINTERS_EQUAL(NULL, i2c_dev_sim_add(I2C_DEV_SIM_REG, 0x30)); 
+}
+
+
+// LSM303AGR register writes and auto-increment only when register address bit 7 is set 
+TEST(i2c_dev_sim_test, lsm303agr_auto_increment)
+{
+    i2c_dev_sim_device_t *mag = i2c_dev_sim_add(I2C_DEV_SIM_LSM303AGR, LSM303AGR_M_ADDR); 
+    int16_t offsets[NUM_AXES] = { 300, -600, 900 };
+
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_init()); 
+
+    // Configuration registers written one at a time - ODR = 10 Hz, continuous mode, LPF 
+    UNSIGNED_LONGS_EQUAL(0x00, mag->regs[LSM303AGR_M_CFG_A]); 
+    UNSIGNED_LONGS_EQUAL(0x01, mag->regs[LSM303AGR_M_CFG_A + 1]); 
+
+    // A single byte access doesn't increment 
+    UNSIGNED_LONGS_EQUAL(LSM303AGR_M_CFG_A + 2, mag->reg_ptr); 
+
+    // Hard-iron offsets written to 6 registers in one transfer (scaled by 2/3)
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_m_offset_reg_set(offsets)); 
+    UNSIGNED_LONGS_EQUAL(200 & 0xFF, mag->regs[LSM303AGR_M_OFFSET_X_L]); 
+    UNSIGNED_LONGS_EQUAL(200 >> 8, mag->regs[LSM303AGR_M_OFFSET_X_L + 1]); 
+    UNSIGNED_LONGS_EQUAL((uint16_t)-400 & 0xFF, mag->regs[LSM303AGR_M_OFFSET_X_L + 2]); 
+    UNSIGNED_LONGS_EQUAL((uint16_t)-400 >> 8, mag->regs[LSM303AGR_M_OFFSET_X_L + 3]); 
+    UNSIGNED_LONGS_EQUAL(600 & 0xFF, mag->regs[LSM303AGR_M_OFFSET_X_L + 4]); 
+    UNSIGNED_LONGS_EQUAL(600 >> 8, mag->regs[LSM303AGR_M_OFFSET_X_L + 5]); 
+    UNSIGNED_LONGS_EQUAL(LSM303AGR_M_OFFSET_X_L + 6, mag->reg_ptr); 
+}
+
+
+// LSM303AGR axis data over a long sequence of updates 
+TEST(i2c_dev_sim_test, lsm303agr_update_sequence)
+{
+    i2c_dev_sim_device_t *mag = i2c_dev_sim_add(I2C_DEV_SIM_LSM303AGR, LSM303AGR_M_ADDR); 
+    int16_t axis[NUM_AXES]; 
+
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_init()); 
+
+    for (int16_t i = 0; i < SIM_SEQ_LEN; i++)
+    {
+        int16_t sample[NUM_AXES] = { i, (int16_t)(-i), (int16_t)(i*30) };
+
+        memcpy((void *)&mag->regs[LSM303AGR_M_OUT_X_L], (void *)sample, sizeof(sample)); 
+        LONGS_EQUAL(LSM303AGR_OK, lsm303agr_m_update()); 
+        lsm303agr_m_get_axis_raw(axis); 
+
+        LONGS_EQUAL(sample[X_AXIS], axis[X_AXIS]); 
+        LONGS_EQUAL(sample[Y_AXIS], axis[Y_AXIS]); 
+        LONGS_EQUAL(sample[Z_AXIS], axis[Z_AXIS]); 
+    }
+
+    // Init: WHO_AM_I read (2 address phases) and 3 register writes, then 2 per update 
+    UNSIGNED_LONGS_EQUAL(5 + 2*SIM_SEQ_LEN, mag->transfers); 
+}
+
+
+// MPU6050 wake up and burst reads of the measurement registers 
+TEST(i2c_dev_sim_test, mpu6050_update_sequence)
+{
+    i2c_dev_sim_device_t *imu = i2c_dev_sim_add(I2C_DEV_SIM_MPU6050, MPU6050_ADDR_1); 
+    int16_t accel[NUM_AXES], gyro[NUM_AXES]; 
+
+    // Wrong address - WHO_AM_I isn't read 
+    imu->address = MPU6050_ADDR_2; 
+    LONGS_EQUAL(MPU6050_WHOAMI, mpu6050_init_dev()); 
+
+    // Taken out of sleep mode and the clock source set during init 
+    imu->address = MPU6050_ADDR_1; 
+    LONGS_EQUAL(MPU6050_OK, mpu6050_init_dev()); 
+    UNSIGNED_LONGS_EQUAL(0x05, imu->regs[MPU6050_PWR_MGMT_1]); 
+
+    for (uint16_t i = 0; i < SIM_SEQ_LEN; i++)
+    {
+        for (uint8_t j = 0; j < BYTE_14; j++)
+        {
+            imu->regs[MPU6050_ACCEL_XOUT_H + j] = (uint8_t)(i + j); 
+        }
+
+        LONGS_EQUAL(MPU6050_OK, mpu6050_update(DEVICE_ONE)); 
+        mpu6050_get_accel_axis(DEVICE_ONE, accel); 
+        mpu6050_get_gyro_axis(DEVICE_ONE, gyro); 
+
+        LONGS_EQUAL((int16_t)(((i & 0xFF) << 8) | ((i + 1) & 0xFF)), accel[X_AXIS]); 
+        LONGS_EQUAL((int16_t)((((i + 12) & 0xFF) << 8) | ((i + 13) & 0xFF)), gyro[Z_AXIS]); 
+    }
+
+    // The register pointer ends after the last gyro byte 
+    UNSIGNED_LONGS_EQUAL(MPU6050_ACCEL_XOUT_H + BYTE_14, imu->reg_ptr); 
+}
+
+
+// M8Q data stream read and messages written to the receiver 
+TEST(i2c_dev_sim_test, m8q_stream)
+{
+    i2c_dev_sim_device_t *gps = i2c_dev_sim_add(I2C_DEV_SIM_M8Q, M8Q_ADDR); 
+    const char *msg = "$PUBX,40,GGA,0,0,0,0,0,0*5A\r\n"; 
+
+    m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+
+    // Nothing available 
+    LONGS_EQUAL(M8Q_NO_DATA_AVAILABLE, m8q_read_data()); 
+    UNSIGNED_LONGS_EQUAL(M8Q_REG_STREAM, gps->reg_ptr); 
+
+    // The full stream is read and parsed in pieces until it's empty 
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        i2c_dev_sim_stream_set(gps, m8q_capture_epoch, m8q_capture_epoch_len); 
+        LONGS_EQUAL(M8Q_OK, m8q_read_data()); 
+        UNSIGNED_LONGS_EQUAL(m8q_capture_epoch_len, gps->stream_pos); 
+        LONGS_EQUAL(M8Q_NO_DATA_AVAILABLE, m8q_read_data()); 
+    }
+
+    // A message goes to the receiver as-is (no register address)
+    LONGS_EQUAL(M8Q_OK, m8q_send_msg(&m8q_config_pkt[0][0], M8Q_CONFIG_MAX_MSG_LEN)); 
+    UNSIGNED_LONGS_EQUAL(strlen(msg), gps->msg_size); 
+    MEMCMP_EQUAL(msg, gps->msg, strlen(msg)); 
+}
+
+
+// HD44780U instructions and characters clocked through the PCF8574 in 4-bit mode 
+TEST(i2c_dev_sim_test, hd44780u_display)
+{
+    i2c_dev_sim_device_t *lcd = i2c_dev_sim_add(I2C_DEV_SIM_HD44780U, PCF8574_ADDR); 
+    char line_l1[] = "I2C device sim"; 
+    char line_l4[] = "Line 4"; 
+
+    hd44780u_init(&I2C_FAKE, &TIM_FAKE, PCF8574_ADDR_HHH); 
+    LONGS_EQUAL(0, hd44780u_get_status()); 
+
+    // 4-bit mode, display on 
+    CHECK(lcd->four_bit); 
+    UNSIGNED_LONGS_EQUAL(HD44780U_DISPLAY_CONTROL | HD44780U_DISPLAY_ON, 
+                         lcd->display_control); 
+    UNSIGNED_LONGS_EQUAL(HD44780U_ENTRY_SET | HD44780U_CURSOR_DIR, lcd->entry_mode); 
+
+    hd44780u_line_set(HD44780U_L1, line_l1, 0); 
+    hd44780u_line_set(HD44780U_L4, line_l4, 4); 
+    hd44780u_send_line(HD44780U_L1); 
+    hd44780u_send_line(HD44780U_L4); 
+
+    MEMCMP_EQUAL("I2C device sim      ", i2c_dev_sim_lcd_line(lcd, HD44780U_L1), 
+                 HD44780U_LINE_LEN); 
+    MEMCMP_EQUAL("    Line 4          ", i2c_dev_sim_lcd_line(lcd, HD44780U_L4), 
+                 HD44780U_LINE_LEN); 
+    MEMCMP_EQUAL("                    ", i2c_dev_sim_lcd_line(lcd, HD44780U_L2), 
+                 HD44780U_LINE_LEN); 
+    UNSIGNED_LONGS_EQUAL(2*HD44780U_LINE_LEN, lcd->characters); 
+
+    // Clear 
+    hd44780u_clear(); 
+    MEMCMP_EQUAL("                    ", i2c_dev_sim_lcd_line(lcd, HD44780U_L1), 
+                 HD44780U_LINE_LEN); 
+    UNSIGNED_LONGS_EQUAL(0, lcd->ddram_addr); 
+}
+
+
+// Bus time per byte and clock stretching 
+TEST(i2c_dev_sim_test, bus_timing)
+{
+    i2c_dev_sim_device_t *mag = i2c_dev_sim_add(I2C_DEV_SIM_LSM303AGR, LSM303AGR_M_ADDR); 
+
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_init()); 
+
+    // Magnetometer update: start, address, register, restart, address, 6 bytes, stop 
+    i2c_dev_sim_stats_reset(); 
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_m_update()); 
+    UNSIGNED_LONGS_EQUAL(bus_ns(3, 9, I2C_DEV_SIM_BUS_HZ), i2c_dev_sim.busy_ns); 
+    UNSIGNED_LONGS_EQUAL(i2c_dev_sim.busy_ns, mag->busy_ns); 
+    UNSIGNED_LONGS_EQUAL(2, mag->transfers); 
+    UNSIGNED_LONGS_EQUAL(7, mag->bytes); 
+    UNSIGNED_LONGS_EQUAL(2, i2c_dev_sim.starts); 
+    UNSIGNED_LONGS_EQUAL(1, i2c_dev_sim.stops); 
+
+    // Clock stretching on each data byte 
+    mag->stretch_ns = SIM_STRETCH_NS; 
+    i2c_dev_sim_stats_reset(); 
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_m_update()); 
+    UNSIGNED_LONGS_EQUAL(bus_ns(3, 9, I2C_DEV_SIM_BUS_HZ) + 7*SIM_STRETCH_NS, 
+                         i2c_dev_sim.busy_ns); 
+
+    // Standard mode 
+    i2c_dev_sim.bus_hz = 100000; 
+    mag->stretch_ns = CLEAR; 
+    i2c_dev_sim_stats_reset(); 
+    LONGS_EQUAL(LSM303AGR_OK, lsm303agr_m_update()); 
+    UNSIGNED_LONGS_EQUAL(bus_ns(3, 9, 100000), i2c_dev_sim.busy_ns); 
+}
+
+
+// Bus occupancy of a full sensor update cycle on one bus 
+TEST(i2c_dev_sim_test, sensor_cycle_occupancy)
+{
+    const uint32_t bus_speeds[] = { 100000, 400000 };
+    char line[] = "Heading 123 deg"; 
+
+    printf("\n\nI2C bus occupancy - sensor update cycle (IMU, magnetometer, GPS epoch, " 
+           "one LCD line)\n"); 
+
+    for (uint8_t i = 0; i < (sizeof(bus_speeds) / sizeof(bus_speeds[0])); i++)
+    {
+        i2c_dev_sim_init(bus_speeds[i]); 
+        i2c_dev_sim_device_t *imu = i2c_dev_sim_add(I2C_DEV_SIM_MPU6050, MPU6050_ADDR_1); 
+        i2c_dev_sim_device_t *mag = i2c_dev_sim_add(I2C_DEV_SIM_LSM303AGR, LSM303AGR_M_ADDR); 
+        i2c_dev_sim_device_t *gps = i2c_dev_sim_add(I2C_DEV_SIM_M8Q, M8Q_ADDR); 
+        i2c_dev_sim_device_t *lcd = i2c_dev_sim_add(I2C_DEV_SIM_HD44780U, PCF8574_ADDR); 
+
+        LONGS_EQUAL(MPU6050_OK, mpu6050_init_dev()); 
+        LONGS_EQUAL(LSM303AGR_OK, lsm303agr_init()); 
+        m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+        hd44780u_init(&I2C_FAKE, &TIM_FAKE, PCF8574_ADDR_HHH); 
+        i2c_dev_sim_stream_set(gps, m8q_capture_epoch, m8q_capture_epoch_len); 
+
+        i2c_dev_sim_stats_reset(); 
+        LONGS_EQUAL(MPU6050_OK, mpu6050_update(DEVICE_ONE)); 
+        LONGS_EQUAL(LSM303AGR_OK, lsm303agr_m_update()); 
+        LONGS_EQUAL(M8Q_OK, m8q_read_data()); 
+        hd44780u_line_set(HD44780U_L1, line, 0); 
+        hd44780u_send_line(HD44780U_L1); 
+
+        // Every bit on the bus belongs to one of the devices 
+        UNSIGNED_LONGS_EQUAL(i2c_dev_sim.busy_ns, 
+                             imu->busy_ns + mag->busy_ns + gps->busy_ns + lcd->busy_ns); 
+        UNSIGNED_LONGS_EQUAL(bus_ns(3, 17, bus_speeds[i]), imu->busy_ns); 
+        UNSIGNED_LONGS_EQUAL(bus_ns(3, 9, bus_speeds[i]), mag->busy_ns); 
+
+        printf("  %3lu kHz : total %7.1f us (IMU %6.1f, MAG %6.1f, GPS %7.1f, LCD %7.1f)\n", 
+               (unsigned long)(bus_speeds[i] / 1000), 
+               i2c_dev_sim.busy_ns / 1000.0, imu->busy_ns / 1000.0, mag->busy_ns / 1000.0, 
+               gps->busy_ns / 1000.0, lcd->busy_ns / 1000.0); 
+    }
+}
+
+//=======================================================================================
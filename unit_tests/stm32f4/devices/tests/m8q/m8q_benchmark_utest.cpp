@@ -0,0 +1,406 @@
+/** 
+ * @file m8q_benchmark_utest.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief M8Q driver host benchmarks 
+ * 
+ * @version 0.1 
+ * @date 2026-10-15 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - These tests measure host (not target) throughput. The numbers are for comparing 
+//   driver changes against each other, not for estimating time on the device. 
+// - Each benchmark also checks that the capture was parsed without errors so a faster 
+//   but broken parser can't pass. 
+// - The read replay benchmark goes through m8q_read_data and the I2C mock so the whole 
+//   driver read path is timed. Set the M8Q_CAPTURE_FILE environment variable to the path 
+//   of a raw receiver log (ex. a u-center .ubx log of the I2C/UART output) to also replay 
+//   that file. Parse errors in a user capture are reported but don't fail the test. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include <chrono> 
+#include <cstdio> 
+#include <cstdlib> 
+#include <vector> 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "m8q_driver.h" 
+    #include "m8q_config_test.h" 
+    #include "m8q_capture_test.h" 
+    #include "i2c_comm_mock.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define BENCH_NUM_EPOCHS 2000    // Number of times the capture is replayed 
+#define BENCH_EPOCH_MSGS 17      // Number of messages in m8q_capture_epoch 
+#define BENCH_ID_REPEAT 20000    // Number of times the ID stream is replayed 
+#define BENCH_ID_MSGS 17         // Number of messages in m8q_bench_id_stream 
+#define BENCH_READ_EPOCHS 500    // Number of times the capture is read through the driver 
+#define BENCH_FILE_PASSES 20     // Number of times a user capture file is read 
+#define BENCH_CORRUPT_STEP 101   // Byte spacing of corrupted bytes in the bad capture 
+#define BENCH_FILE_BUFF_SIZE 256 // Capture file read buffer size 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Data 
+
+// The messages of m8q_capture_epoch with only the address field or header (no payload) 
+// so message identification is most of the work done by the parser. 
+static const char m8q_bench_id_stream[] = 
+    "$PUBX,00,\r\n" 
+    "$PUBX,04,\r\n" 
+    "\xB5\x62\x01\x07\x00\x00\x08\x19" 
+    "\xB5\x62\x01\x03\x00\x00\x04\x0D" 
+    "\xB5\x62\x01\x04\x00\x00\x05\x10" 
+    "$GNRMC,\r\n" 
+    "$GNVTG,\r\n" 
+    "$GNGGA,\r\n" 
+    "$GNGSA,\r\n" 
+    "$GNGSA,\r\n" 
+    "$GPGSV,\r\n" 
+    "$GPGSV,\r\n" 
+    "$GPGSV,\r\n" 
+    "$GLGSV,\r\n" 
+    "$GLGSV,\r\n" 
+    "$GNGLL,\r\n" 
+    "\xB5\x62\x05\x01\x00\x00\x06\x17"; 
+
+
+// Read replay results 
+typedef struct m8q_bench_result_s 
+{
+    M8Q_STATUS status;          // All read statuses OR'd together 
+    uint64_t bytes;             // Data stream bytes read 
+    uint32_t reads;             // Calls to m8q_read_data 
+    uint32_t msgs;              // Messages accepted by the parser 
+    uint32_t errors;            // Bad checksum, truncated and unknown messages 
+    double seconds;             // Total time spent in m8q_read_data 
+    double worst_call;          // Longest single call to m8q_read_data (s) 
+}
+m8q_bench_result_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test group 
+
+TEST_GROUP(m8q_benchmark)
+{
+    // Global test group variables 
+    I2C_TypeDef I2C_FAKE; 
+
+    // Constructor 
+    void setup()
+    {
+        // Initialize driver but don't send/check any messages 
+        m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        //
+    }
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Replay a capture through the stream parser in pieces of 'chunk_size' 
+M8Q_STATUS m8q_bench_replay(
+    const uint8_t *capture, 
+    uint16_t capture_len, 
+    uint16_t chunk_size, 
+    uint32_t num_epochs)
+{
+    M8Q_STATUS parse_status = M8Q_OK; 
+    uint16_t remaining, chunk; 
+
+    for (uint32_t i = CLEAR; i < num_epochs; i++)
+    {
+        remaining = capture_len; 
+
+        while (remaining)
+        {
+            chunk = (remaining > chunk_size) ? chunk_size : remaining; 
+            parse_status |= m8q_parse_data(&capture[capture_len - remaining], chunk); 
+            remaining -= chunk; 
+        }
+    }
+
+    return parse_status; 
+}
+
+
+// Replay a capture through m8q_read_data. Each read the device reports up to 
+// 'poll_size' bytes in its data stream, the same as a receiver that's polled while its 
+// output is coming in. 
+void m8q_bench_read_replay(
+    const uint8_t *capture, 
+    uint32_t capture_len, 
+    uint16_t poll_size, 
+    uint32_t num_epochs, 
+    m8q_bench_result_t *result)
+{
+    uint8_t stream_len[BYTE_2]; 
+    uint32_t offset; 
+    uint16_t chunk; 
+    double call_time; 
+
+    *result = {}; 
+
+    for (uint32_t i = CLEAR; i < num_epochs; i++)
+    {
+        offset = CLEAR; 
+
+        while (offset < capture_len)
+        {
+            chunk = ((capture_len - offset) > poll_size) ? 
+                    poll_size : (uint16_t)(capture_len - offset); 
+            stream_len[BYTE_0] = (uint8_t)(chunk >> SHIFT_8); 
+            stream_len[BYTE_1] = (uint8_t)chunk; 
+
+            i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_0); 
+            i2c_mock_set_read_ref(&capture[offset], chunk, I2C_MOCK_INDEX_1); 
+            i2c_mock_read_restart(); 
+
+            auto start = std::chrono::steady_clock::now(); 
+            result->status |= m8q_read_data(); 
+            auto stop = std::chrono::steady_clock::now(); 
+
+            call_time = std::chrono::duration<double>(stop - start).count(); 
+            result->seconds += call_time; 
+            result->worst_call = (call_time > result->worst_call) ? 
+                                 call_time : result->worst_call; 
+            result->bytes += chunk; 
+            result->reads++; 
+            offset += chunk; 
+        }
+    }
+
+    for (uint8_t i = CLEAR; i < M8Q_STATS_NUM; i++)
+    {
+        m8q_msg_stats_t stats = m8q_get_msg_stats((m8q_msg_stats_type_t)i); 
+        result->msgs += stats.accepted; 
+        result->errors += stats.bad_checksum + stats.truncated + stats.unknown; 
+    }
+}
+
+
+// Print read replay results 
+void m8q_bench_read_print(
+    const char *label, 
+    uint16_t poll_size, 
+    const m8q_bench_result_t *result)
+{
+    printf("  %s poll %4u bytes : %8.2f MB/s, %10.0f msgs/s, worst call %7.2f us, " 
+           "%u parse errors\n", 
+           label, 
+           (unsigned)poll_size, 
+           (double)result->bytes / (result->seconds * 1.0e6), 
+           (double)result->msgs / result->seconds, 
+           result->worst_call * 1.0e6, 
+           (unsigned)result->errors); 
+}
+
+
+// Load a capture file 
+bool m8q_bench_load_file(
+    const char *path, 
+    std::vector<uint8_t> &capture)
+{
+    FILE *file = fopen(path, "rb"); 
+    uint8_t buff[BENCH_FILE_BUFF_SIZE]; 
+    size_t num_read; 
+
+    if (file == nullptr)
+    {
+        return false; 
+    }
+
+    while ((num_read = fread(buff, BYTE_1, sizeof(buff), file)) > 0)
+    {
+        capture.insert(capture.end(), buff, buff + num_read); 
+    }
+
+    fclose(file); 
+
+    return !capture.empty(); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Stream parser throughput for different read sizes 
+TEST(m8q_benchmark, m8q_stream_parse_throughput)
+{
+    uint16_t chunk_sizes[] = { 1, 8, 32, M8Q_STREAM_BUFF_SIZE, 255, m8q_capture_epoch_len }; 
+    const uint8_t *capture = (const uint8_t *)m8q_capture_epoch; 
+    M8Q_STATUS parse_status; 
+    double seconds; 
+
+    printf("\n\nM8Q stream parse (%u byte epoch, %u epochs)\n", 
+           (unsigned)m8q_capture_epoch_len, (unsigned)BENCH_NUM_EPOCHS); 
+
+    for (uint8_t i = CLEAR; i < (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); i++)
+    {
+        m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+
+        auto start = std::chrono::steady_clock::now(); 
+        parse_status = m8q_bench_replay(capture, m8q_capture_epoch_len, 
+                                        chunk_sizes[i], BENCH_NUM_EPOCHS); 
+        auto stop = std::chrono::steady_clock::now(); 
+
+        seconds = std::chrono::duration<double>(stop - start).count(); 
+
+        printf("  chunk %4u bytes : %8.2f MB/s, %10.0f msgs/s\n", 
+               (unsigned)chunk_sizes[i], 
+               ((double)m8q_capture_epoch_len * BENCH_NUM_EPOCHS) / (seconds * 1.0e6), 
+               ((double)BENCH_EPOCH_MSGS * BENCH_NUM_EPOCHS) / seconds); 
+
+        LONGS_EQUAL(M8Q_OK, parse_status); 
+        LONGS_EQUAL(M8Q_NAVSTAT_G3, m8q_get_position_navstat()); 
+    }
+}
+
+
+
+// Message identification time on a mixed NMEA/UBX stream 
+TEST(m8q_benchmark, m8q_msg_id_dispatch)
+{
+    const uint8_t *stream = (const uint8_t *)m8q_bench_id_stream; 
+    uint16_t stream_len = sizeof(m8q_bench_id_stream) - 1; 
+    M8Q_STATUS parse_status; 
+    double seconds; 
+
+    auto start = std::chrono::steady_clock::now(); 
+    parse_status = m8q_bench_replay(stream, stream_len, stream_len, BENCH_ID_REPEAT); 
+    auto stop = std::chrono::steady_clock::now(); 
+
+    seconds = std::chrono::duration<double>(stop - start).count(); 
+
+    printf("\n\nM8Q message ID (%u msgs, %u repeats)\n", 
+           (unsigned)BENCH_ID_MSGS, (unsigned)BENCH_ID_REPEAT); 
+    printf("  %8.1f ns/msg\n", (seconds * 1.0e9) / ((double)BENCH_ID_MSGS * BENCH_ID_REPEAT)); 
+
+    LONGS_EQUAL(M8Q_OK, parse_status); 
+}
+
+
+
+// Driver read path throughput for different data stream sizes 
+TEST(m8q_benchmark, m8q_read_replay_throughput)
+{
+    uint16_t poll_sizes[] = { 32, M8Q_STREAM_BUFF_SIZE, 255, 512, m8q_capture_epoch_len }; 
+    const uint8_t *capture = (const uint8_t *)m8q_capture_epoch; 
+    m8q_bench_result_t result; 
+
+    printf("\n\nM8Q read replay (%u byte epoch, %u epochs)\n", 
+           (unsigned)m8q_capture_epoch_len, (unsigned)BENCH_READ_EPOCHS); 
+
+    for (uint8_t i = CLEAR; i < (sizeof(poll_sizes) / sizeof(poll_sizes[0])); i++)
+    {
+        m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+        i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, 
+                      I2C_MOCK_INC_MODE_ENABLE); 
+
+        m8q_bench_read_replay(capture, m8q_capture_epoch_len, poll_sizes[i], 
+                              BENCH_READ_EPOCHS, &result); 
+        m8q_bench_read_print("epoch", poll_sizes[i], &result); 
+
+        LONGS_EQUAL(M8Q_OK, result.status); 
+        LONGS_EQUAL(BENCH_EPOCH_MSGS * BENCH_READ_EPOCHS, result.msgs); 
+        LONGS_EQUAL(0, result.errors); 
+        LONGS_EQUAL(M8Q_NAVSTAT_G3, m8q_get_position_navstat()); 
+    }
+}
+
+
+
+// Driver read path with a corrupted capture - errors are counted, not fatal 
+TEST(m8q_benchmark, m8q_read_replay_errors)
+{
+    std::vector<uint8_t> capture(m8q_capture_epoch, m8q_capture_epoch + m8q_capture_epoch_len); 
+    m8q_bench_result_t result; 
+
+    // Change bytes spread over the capture. Bytes that land on a message start can join 
+    // two messages into one so the exact error count isn't fixed, only that errors are 
+    // seen and that parsing carries on afterwards. 
+    for (uint32_t i = BENCH_CORRUPT_STEP; i < capture.size(); i += BENCH_CORRUPT_STEP)
+    {
+        capture[i] ^= 0x5A; 
+    }
+
+    m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, 
+                  I2C_MOCK_INC_MODE_ENABLE); 
+
+    printf("\n\nM8Q read replay - corrupted epoch\n"); 
+    m8q_bench_read_replay(capture.data(), capture.size(), M8Q_STREAM_BUFF_SIZE, 
+                          BENCH_READ_EPOCHS, &result); 
+    m8q_bench_read_print("corrupt", M8Q_STREAM_BUFF_SIZE, &result); 
+
+    CHECK(result.errors >= BENCH_READ_EPOCHS); 
+    CHECK(result.msgs > 0); 
+    CHECK(result.msgs < (BENCH_EPOCH_MSGS * BENCH_READ_EPOCHS)); 
+}
+
+
+
+// Driver read path with a user supplied capture file (M8Q_CAPTURE_FILE) 
+TEST(m8q_benchmark, m8q_read_replay_file)
+{
+    uint16_t poll_sizes[] = { M8Q_STREAM_BUFF_SIZE, 512 }; 
+    const char *path = getenv("M8Q_CAPTURE_FILE"); 
+    std::vector<uint8_t> capture; 
+    m8q_bench_result_t result; 
+
+    if ((path == nullptr) || !m8q_bench_load_file(path, capture))
+    {
+        return; 
+    }
+
+    printf("\n\nM8Q read replay (%s, %u bytes, %u passes)\n", 
+           path, (unsigned)capture.size(), (unsigned)BENCH_FILE_PASSES); 
+
+    for (uint8_t i = CLEAR; i < (sizeof(poll_sizes) / sizeof(poll_sizes[0])); i++)
+    {
+        m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+        i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, 
+                      I2C_MOCK_INC_MODE_ENABLE); 
+
+        m8q_bench_read_replay(capture.data(), capture.size(), poll_sizes[i], 
+                              BENCH_FILE_PASSES, &result); 
+        m8q_bench_read_print("file", poll_sizes[i], &result); 
+    }
+}
+
+//=======================================================================================
@@ -0,0 +1,65 @@
+/**
+ * @file m8q_capture_test.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief M8Q data stream capture test implementation 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "m8q_capture_test.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Captures 
+
+// One navigation epoch of receiver output in the order the device sends it. PUBX 
+// POSITION and TIME are enabled along with the default standard NMEA messages and 
+// NAV-PVT, NAV-STATUS and NAV-DOP. The stream ends with the ACK for a CFG-MSG message. 
+// Other captures can be added in the same format (binary bytes written as hex escapes). 
+const char m8q_capture_epoch[] = 
+    "$PUBX,00,081350.00,4717.11321,N,11433.91518,W,546.589,G3,2.1,2.0,0.007,77.52," 
+    "0.007,,0.92,1.19,0.77,9,0,0*46\r\n" 
+    "$PUBX,04,081350.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*53\r\n" 
+    // UBX NAV-PVT 
+    "\xB5\x62\x01\x07\x5C\x00\xF0\x10\xC1\x01\xD2\x07\x0C\x09\x08\x0D" 
+    "\x32\x37\xDC\x05\x00\x00\x70\x2F\xFC\xFF\x03\x01\xEA\x09\xCE\xBA" 
+    "\xB6\xBB\xE9\x26\x2F\x1C\xB5\x14\x08\x00\x1D\x57\x08\x00\x34\x08" 
+    "\x00\x00\xD0\x07\x00\x00\x0C\x00\x00\x00\xFD\xFF\xFF\xFF\x07\x00" 
+    "\x00\x00\x07\x00\x00\x00\x40\x49\x76\x00\x52\x03\x00\x00\xC0\xD4" 
+    "\x01\x00\x77\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00" 
+    "\x00\x00\x2B\x7E" 
+    // UBX NAV-STATUS 
+    "\xB5\x62\x01\x03\x10\x00\xF0\x10\xC1\x01\x03\x0D\x00\x00\x12\x7A" 
+    "\x00\x00\xF0\x2A\x1C\x00\xA8\x07" 
+    // UBX NAV-DOP 
+    "\xB5\x62\x01\x04\x12\x00\xF0\x10\xC1\x01\x8C\x00\x77\x00\x4D\x00" 
+    "\x4D\x00\x5C\x00\x3D\x00\x44\x00\x53\x2B" 
+    "$GNRMC,081350.00,A,4717.11321,N,11433.91518,W,0.013,77.52,091202,,,A*55\r\n" 
+    "$GNVTG,77.52,T,,M,0.013,N,0.024,K,A*10\r\n" 
+    "$GNGGA,081350.00,4717.11321,N,11433.91518,W,1,09,0.92,546.6,M,-17.0,M,,*72\r\n" 
+    "$GNGSA,A,3,10,32,24,12,25,,,,,,,,1.19,0.92,0.77*1C\r\n" 
+    "$GNGSA,A,3,66,76,75,,,,,,,,,,1.19,0.92,0.77*1D\r\n" 
+    "$GPGSV,3,1,10,10,68,113,41,12,22,302,33,14,05,044,,15,14,244,28*78\r\n" 
+    "$GPGSV,3,2,10,20,00,168,,24,41,270,38,25,29,296,35,31,05,126,*7C\r\n" 
+    "$GPGSV,3,3,10,32,75,046,43,46,33,213,*7C\r\n" 
+    "$GLGSV,2,1,05,65,18,038,,66,52,006,37,75,49,217,36,76,70,322,40*68\r\n" 
+    "$GLGSV,2,2,05,77,16,272,*50\r\n" 
+    "$GNGLL,4717.11321,N,11433.91518,W,081350.00,A,A*6F\r\n" 
+    // UBX ACK-ACK (CFG-MSG) 
+    "\xB5\x62\x05\x01\x02\x00\x06\x01\x0F\x38"; 
+
+// Capture length (the string terminator is not part of the capture) 
+const uint16_t m8q_capture_epoch_len = sizeof(m8q_capture_epoch) - 1; 
+
+//=======================================================================================
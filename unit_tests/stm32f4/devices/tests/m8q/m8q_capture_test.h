@@ -0,0 +1,35 @@
+/**
+ * @file m8q_capture_test.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief M8Q data stream capture test interface 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _M8Q_CAPTURE_TEST_H_ 
+#define _M8Q_CAPTURE_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include <stdint.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Captures 
+
+// One navigation epoch of receiver output (NMEA and UBX mixed) 
+extern const char m8q_capture_epoch[]; 
+extern const uint16_t m8q_capture_epoch_len; 
+
+//=======================================================================================
+
+#endif   // _M8Q_CAPTURE_TEST_H_ 
@@ -27,10 +27,14 @@ extern "C"
 	// Add your C-only include files here 
     #include "m8q_driver.h" 
     #include "m8q_config_test.h" 
+    #include "m8q_capture_test.h" 
     #include "i2c_comm.h" 
     #include "i2c_comm_mock.h"
+    #include "gpio_driver_mock.h" 
 }
 
+#include "m8q_config_builder.h" 
+
 //=======================================================================================
 
 
@@ -45,6 +49,16 @@ extern "C"
 //=======================================================================================
 
 
+//=======================================================================================
+// Test data 
+
+// New fix callback record 
+static uint8_t fix_callback_count; 
+static int32_t fix_callback_lat; 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Test group 
 
@@ -134,6 +148,59 @@ void m8q_test_itob(
     bytes[BYTE_1] = integer & HIGH_8BIT; 
 }
 
+
+// Add data to a circular buffer 
+void m8q_test_cb_add(
+    uint8_t *circular_buff, 
+    cb_index_t *cb_index, 
+    const uint8_t *data, 
+    uint16_t data_size)
+{
+    for (uint16_t i = CLEAR; i < data_size; i++)
+    {
+        circular_buff[cb_index->head++] = data[i]; 
+
+        if (cb_index->head >= cb_index->cb_size)
+        {
+            cb_index->head = CLEAR; 
+        }
+    }
+}
+
+
+// Check the I2C writes of an RTCM frame 
+void m8q_test_rtcm_writes(
+    const uint8_t *frame, 
+    uint16_t frame_len, 
+    const uint8_t *write_sizes, 
+    uint8_t num_writes)
+{
+    uint8_t write_msg[M8Q_CONFIG_MAX_MSG_LEN]; 
+    uint8_t write_msg_len, sent[M8Q_RTCM_MAX_FRAME_LEN]; 
+    uint16_t sent_len = CLEAR; 
+
+    for (uint8_t i = CLEAR; i < num_writes; i++)
+    {
+        i2c_mock_get_write_data((void *)write_msg, &write_msg_len, i); 
+        LONGS_EQUAL(write_sizes[i], write_msg_len); 
+        CHECK(write_msg_len >= BYTE_2); 
+
+        memcpy(&sent[sent_len], write_msg, write_msg_len); 
+        sent_len += write_msg_len; 
+    }
+
+    LONGS_EQUAL(frame_len, sent_len); 
+    MEMCMP_EQUAL(frame, sent, frame_len); 
+}
+
+
+// New fix callback 
+void m8q_test_fix_callback(const m8q_snapshot_t *snapshot)
+{
+    fix_callback_count++; 
+    fix_callback_lat = snapshot->pos.lat; 
+}
+
 //=======================================================================================
 
 
@@ -407,7 +474,7 @@ TEST(m8q_driver, m8q_init_ubx_config_invalid_msg_check)
     }; 
 
     // NAK message to be read in the init function in the final CFG message check 
-    const uint8_t device_msg[] = {181,98,5,0,2,0,6,1,15,56}; 
+    const uint8_t device_msg[] = {181,98,5,0,2,0,6,1,14,51}; 
     
     //==================================================
 
@@ -718,9 +785,9 @@ TEST(m8q_driver, m8q_read_unknown_multi_msg)
     const uint8_t device_msg1[] = 
         {181,98,6,0,20,0,1,0,0,0,192,8,0,0,128,37,0,0,0,0,0,0,0,0,0,0,136,107}; 
     const uint8_t device_msg2[] = 
-        {181,98,2,0,20,0,1,0,0,0,192,8,0,0,128,37,0,0,0,0,0,0,0,0,0,0,136,107}; 
+        {181,98,2,0,20,0,1,0,0,0,192,8,0,0,128,37,0,0,0,0,0,0,0,0,0,0,132,11}; 
     const char device_msg3[] = 
-        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*3C\r\n"; 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
     const char device_msg4[] = 
         "$PUBX,45,GLL,1,0,0,0,0,0*5D\r\n"; 
 
@@ -760,9 +827,9 @@ TEST(m8q_driver, m8q_read_known_multi_msg)
     const uint8_t device_msg1[] = 
         {181,98,6,0,20,0,1,0,0,0,192,8,0,0,128,37,0,0,0,0,0,0,0,0,0,0,136,107}; 
     const uint8_t device_msg2[] = 
-        {181,98,2,0,20,0,1,0,0,0,192,8,0,0,128,37,0,0,0,0,0,0,0,0,0,0,136,107}; 
+        {181,98,2,0,20,0,1,0,0,0,192,8,0,0,128,37,0,0,0,0,0,0,0,0,0,0,132,11}; 
     const char device_msg3[] = 
-        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*3C\r\n"; 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
     const char device_msg4[] = 
         "$PUBX,40,GLL,1,0,0,0,0,0*5D\r\n"; 
 
@@ -810,7 +877,7 @@ TEST(m8q_driver, m8q_read_msg_record_update)
     // driver data record and others are discarded. 
     const char device_msg0[] = 
         "$PUBX,00,081350.00,4717.113210,N,11433.915187,W,546.589,G3,2.1,2.0,0.007,77.52," 
-        "0.007,,0.92,1.19,0.77,9,0,0*5F\r\n"; 
+        "0.007,,0.92,1.19,0.77,9,0,0*41\r\n"; 
     const char device_msg1[] = 
         "$GNGRS,104148.00,1,2.6,2.2,-1.6,-1.1,-1.7,-1.5,5.8,1.7,,,,,1,1*52\r\n"; 
     const uint8_t device_msg2[] = 
@@ -818,7 +885,7 @@ TEST(m8q_driver, m8q_read_msg_record_update)
     const uint8_t device_msg3[] = 
         {181,98,5,1,2,0,6,1,15,56}; 
     const char device_msg4[] = 
-        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*3C\r\n"; 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
 
     memcpy((void *)&device_stream[0], (void *)device_msg0, msg0_len); 
     memcpy((void *)&device_stream[msg0_len], (void *)device_msg1, msg1_len); 
@@ -1042,7 +1109,7 @@ TEST(m8q_driver, m8q_read_get_data_stream)
         "$PUBX,00,081350.00,4717.113210,N,00833.915187,E,546.589,G3,2.1,2.0,0.007,77.52," 
         "0.007,,0.92,1.19,0.77,9,0,0*5F\r\n"; 
     const char device_msg1[] = 
-        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*3C\r\n"; 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
 
     memcpy((void *)&device_stream[0], (void *)device_msg0, msg0_len); 
     memcpy((void *)&device_stream[msg0_len], (void *)device_msg1, msg1_len); 
@@ -1084,7 +1151,7 @@ TEST(m8q_driver, m8q_read_flush_stream)
         "$PUBX,00,081350.00,4717.113210,N,00833.915187,E,546.589,G3,2.1,2.0,0.007,77.52," 
         "0.007,,0.92,1.19,0.77,9,0,0*5F\r\n"; 
     const char device_msg1[] = 
-        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*3C\r\n"; 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
 
     memcpy((void *)&device_stream[0], (void *)device_msg0, msg0_len); 
     memcpy((void *)&device_stream[msg0_len], (void *)device_msg1, msg1_len); 
@@ -1110,6 +1177,657 @@ TEST(m8q_driver, m8q_read_flush_stream)
     LONGS_EQUAL(M8Q_NO_DATA_AVAILABLE, read_status_1); 
 }
 
+
+// M8Q read - Message split across two data stream reads 
+TEST(m8q_driver, m8q_read_split_msg)
+{
+    M8Q_STATUS read_status_0, read_status_1; 
+    uint8_t lat_str[BYTE_11]; 
+    uint8_t utc_time[BYTE_10]; 
+
+    memset((void *)lat_str, CLEAR, sizeof(lat_str)); 
+    memset((void *)utc_time, CLEAR, sizeof(utc_time)); 
+
+    // The first read ends part way through the POSITION message and the second read 
+    // contains the rest of it followed by a TIME message. 
+    uint8_t msg0_len = 40, msg1_len = 142; 
+    uint8_t stream_len_0[BYTE_2], stream_len_1[BYTE_2]; 
+    m8q_test_itob(msg0_len, stream_len_0); 
+    m8q_test_itob(msg1_len, stream_len_1); 
+
+    const char device_stream[] = 
+        "$PUBX,00,081350.00,4717.113210,N,11433.915187,W,546.589,G3,2.1,2.0,0.007,77.52," 
+        "0.007,,0.92,1.19,0.77,9,0,0*41\r\n" 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, I2C_MOCK_INC_MODE_ENABLE); 
+    i2c_mock_set_read_data((void *)stream_len_0, BYTE_2, I2C_MOCK_INDEX_0); 
+    i2c_mock_set_read_data((void *)device_stream, msg0_len, I2C_MOCK_INDEX_1); 
+    i2c_mock_set_read_data((void *)stream_len_1, BYTE_2, I2C_MOCK_INDEX_2); 
+    i2c_mock_set_read_data((void *)&device_stream[msg0_len], msg1_len, I2C_MOCK_INDEX_3); 
+
+    // Nothing is complete after the first read 
+    read_status_0 = m8q_read_data(); 
+    LONGS_EQUAL(M8Q_OK, read_status_0); 
+    LONGS_EQUAL(M8Q_OK, m8q_get_time_utc_time(utc_time, BYTE_10)); 
+    STRCMP_EQUAL("", (char *)utc_time); 
+
+    // The second read completes the POSITION message 
+    read_status_1 = m8q_read_data(); 
+    LONGS_EQUAL(M8Q_OK, read_status_1); 
+    m8q_get_position_lat_str(lat_str, BYTE_11); 
+    m8q_get_time_utc_time(utc_time, BYTE_10); 
+    STRCMP_EQUAL("4717.11321", (char *)lat_str); 
+    LONGS_EQUAL(W_UP_CHAR, m8q_get_position_EW()); 
+    STRCMP_EQUAL("073731.00", (char *)utc_time); 
+}
+
+
+// M8Q parse - Data stream fed in pieces of different sizes 
+TEST(m8q_driver, m8q_parse_stream_chunks)
+{
+    uint8_t chunk_sizes[] = { 1, 7, 64, 255 }; 
+    const uint8_t *stream = (const uint8_t *)m8q_capture_epoch; 
+    uint16_t remaining, chunk; 
+    M8Q_STATUS parse_status; 
+    uint8_t lat_str[BYTE_11]; 
+    uint8_t utc_date[BYTE_7]; 
+
+    LONGS_EQUAL(M8Q_INVALID_PTR, m8q_parse_data(NULL, BYTE_1)); 
+
+    for (uint8_t i = CLEAR; i < sizeof(chunk_sizes); i++)
+    {
+        m8q_init(&I2C_FAKE, &m8q_config_pkt[0][0], CLEAR, CLEAR, CLEAR); 
+        memset((void *)lat_str, CLEAR, sizeof(lat_str)); 
+        memset((void *)utc_date, CLEAR, sizeof(utc_date)); 
+        parse_status = M8Q_OK; 
+        remaining = m8q_capture_epoch_len; 
+
+        while (remaining)
+        {
+            chunk = (remaining > chunk_sizes[i]) ? chunk_sizes[i] : remaining; 
+            parse_status |= m8q_parse_data(&stream[m8q_capture_epoch_len - remaining], chunk); 
+            remaining -= chunk; 
+        }
+
+        m8q_get_position_lat_str(lat_str, BYTE_11); 
+        m8q_get_time_utc_date(utc_date, BYTE_7); 
+
+        LONGS_EQUAL(M8Q_OK, parse_status); 
+        STRCMP_EQUAL("4717.11321", (char *)lat_str); 
+        STRCMP_EQUAL("091202", (char *)utc_date); 
+        LONGS_EQUAL(M8Q_NAVSTAT_G3, m8q_get_position_navstat()); 
+    }
+}
+
+
+// M8Q parse - Unknown data between messages is skipped 
+TEST(m8q_driver, m8q_parse_unknown_data_resync)
+{
+    uint8_t utc_time[BYTE_10]; 
+    memset((void *)utc_time, CLEAR, sizeof(utc_time)); 
+
+    // Unknown bytes and an unknown message before a known message 
+    const char stream[] = 
+        "\x01\x02$GNXXX,1,2,3*00\r\n" 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+
+    LONGS_EQUAL(M8Q_UNKNOWN_DATA, m8q_parse_data((const uint8_t *)stream, sizeof(stream) - 1)); 
+    m8q_get_time_utc_time(utc_time, BYTE_10); 
+    STRCMP_EQUAL("073731.00", (char *)utc_time); 
+}
+
+
+// M8Q parse - POSITION and TIME values converted when the message is read 
+TEST(m8q_driver, m8q_parse_nmea_value_decode)
+{
+    const char pos_msg0[] = 
+        "$PUBX,00,081350.00,3345.12345,S,00833.91518,E,12.500,D3,1.5,2.5,1.250,180.00," 
+        "-0.125,,0.92,1.19,0.77,9,0,0*67\r\n"; 
+    const char pos_msg1[] = 
+        "$PUBX,00,081351.00,,,,,,NF,,,,,,,,,,0,0,0*07\r\n"; 
+    const char time_msg[] = 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+
+    LONGS_EQUAL(0, m8q_get_position_seq()); 
+    LONGS_EQUAL(0, m8q_get_position_valid()); 
+    LONGS_EQUAL(0, m8q_get_time_seq()); 
+
+    // Southern and eastern hemisphere position 
+    m8q_parse_data((const uint8_t *)pos_msg0, sizeof(pos_msg0) - 1); 
+    LONGS_EQUAL(1, m8q_get_position_seq()); 
+    LONGS_EQUAL(0x0007FFFF & ~M8Q_POS_VALID_DIFFAGE, m8q_get_position_valid()); 
+    LONGS_EQUAL(-337520575, m8q_get_position_latI()); 
+    LONGS_EQUAL(85652530, m8q_get_position_lonI()); 
+    DOUBLES_EQUAL(-33.7520575, m8q_get_position_lat(), 0.00001); 
+    DOUBLES_EQUAL(8.5652530, m8q_get_position_lon(), 0.00001); 
+    LONGS_EQUAL(12500, m8q_get_position_altrefI()); 
+    LONGS_EQUAL(M8Q_NAVSTAT_D3, m8q_get_position_navstat()); 
+    LONGS_EQUAL(15, m8q_get_position_haccI()); 
+    LONGS_EQUAL(25, m8q_get_position_vaccI()); 
+    LONGS_EQUAL(1250, m8q_get_position_sogI()); 
+    LONGS_EQUAL(18000, m8q_get_position_cogI()); 
+    LONGS_EQUAL(-125, m8q_get_position_vvelI()); 
+
+    // No fix - empty fields read as zero and are not marked as seen 
+    m8q_parse_data((const uint8_t *)pos_msg1, sizeof(pos_msg1) - 1); 
+    LONGS_EQUAL(2, m8q_get_position_seq()); 
+    LONGS_EQUAL(M8Q_POS_VALID_TIME | M8Q_POS_VALID_NAVSTAT | M8Q_POS_VALID_NUMSVS | 
+                M8Q_POS_VALID_RES | M8Q_POS_VALID_DR, m8q_get_position_valid()); 
+    LONGS_EQUAL(0, m8q_get_position_latI()); 
+    LONGS_EQUAL(0, m8q_get_position_lonI()); 
+    LONGS_EQUAL(0, m8q_get_position_altrefI()); 
+    LONGS_EQUAL(M8Q_NAVSTAT_NF, m8q_get_position_navstat()); 
+    LONGS_EQUAL(FALSE, m8q_get_position_navstat_lock()); 
+    LONGS_EQUAL(0, m8q_get_position_sogI()); 
+
+    // TIME 
+    m8q_parse_data((const uint8_t *)time_msg, sizeof(time_msg) - 1); 
+    LONGS_EQUAL(1, m8q_get_time_seq()); 
+    LONGS_EQUAL(0xFF, m8q_get_time_valid()); 
+    LONGS_EQUAL(7373100, m8q_get_time_utc_timeI()); 
+    LONGS_EQUAL(91202, m8q_get_time_utc_dateI()); 
+    LONGS_EQUAL(11385100, m8q_get_time_utc_towI()); 
+    LONGS_EQUAL(1196, m8q_get_time_utc_wk()); 
+}
+
+
+// M8Q parse - Message cut short is not counted 
+TEST(m8q_driver, m8q_parse_nmea_msg_cut_short)
+{
+    const char stream[] = 
+        "$PUBX,00,081350.00,4717.11321,N,11433.9" 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+
+    m8q_parse_data((const uint8_t *)stream, sizeof(stream) - 1); 
+    LONGS_EQUAL(0, m8q_get_position_seq()); 
+    LONGS_EQUAL(1, m8q_get_time_seq()); 
+}
+
+
+// M8Q parse - UBX NAV messages decoded into integer values 
+TEST(m8q_driver, m8q_parse_ubx_nav_msgs)
+{
+    // Nothing is stored before NAV messages are read 
+    LONGS_EQUAL(0, m8q_get_nav_lat()); 
+    LONGS_EQUAL(0, m8q_get_nav_fix_type()); 
+    LONGS_EQUAL(FALSE, m8q_get_nav_fix_lock()); 
+
+    LONGS_EQUAL(M8Q_OK, m8q_parse_data((const uint8_t *)m8q_capture_epoch, 
+                                       m8q_capture_epoch_len)); 
+
+    // NAV-PVT 
+    LONGS_EQUAL(29430000, m8q_get_nav_itow()); 
+    LONGS_EQUAL(3, m8q_get_nav_fix_type()); 
+    LONGS_EQUAL(TRUE, m8q_get_nav_fix_lock()); 
+    LONGS_EQUAL(9, m8q_get_nav_num_sv()); 
+    LONGS_EQUAL(472852201, m8q_get_nav_lat()); 
+    LONGS_EQUAL(-1145652530, m8q_get_nav_lon()); 
+    LONGS_EQUAL(529589, m8q_get_nav_height()); 
+    LONGS_EQUAL(546589, m8q_get_nav_hmsl()); 
+    LONGS_EQUAL(2100, m8q_get_nav_hacc()); 
+    LONGS_EQUAL(2000, m8q_get_nav_vacc()); 
+    LONGS_EQUAL(12, m8q_get_nav_vel_n()); 
+    LONGS_EQUAL(-3, m8q_get_nav_vel_e()); 
+    LONGS_EQUAL(7, m8q_get_nav_vel_d()); 
+    LONGS_EQUAL(7, m8q_get_nav_gspeed()); 
+    LONGS_EQUAL(7752000, m8q_get_nav_head_mot()); 
+    LONGS_EQUAL(850, m8q_get_nav_sacc()); 
+
+    // NAV-STATUS 
+    LONGS_EQUAL(31250, m8q_get_nav_ttff()); 
+    LONGS_EQUAL(1846000, m8q_get_nav_msss()); 
+
+    // NAV-DOP 
+    LONGS_EQUAL(119, m8q_get_nav_pdop()); 
+    LONGS_EQUAL(92, m8q_get_nav_hdop()); 
+    LONGS_EQUAL(77, m8q_get_nav_vdop()); 
+}
+
+
+// M8Q parse - UBX NAV message with an unexpected length is skipped 
+TEST(m8q_driver, m8q_parse_ubx_nav_bad_len)
+{
+    // NAV-DOP with a payload one byte shorter than expected followed by a TIME message 
+    const char stream[] = 
+        "\xB5\x62\x01\x04\x11\x00\xF0\x10\xC1\x01\x8C\x00\x77\x00\x4D\x00" 
+        "\x4D\x00\x5C\x00\x3D\x00\x44\x52\xC5" 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+    uint8_t utc_time[BYTE_10]; 
+    memset((void *)utc_time, CLEAR, sizeof(utc_time)); 
+
+    LONGS_EQUAL(M8Q_OK, m8q_parse_data((const uint8_t *)stream, sizeof(stream) - 1)); 
+    LONGS_EQUAL(0, m8q_get_nav_pdop()); 
+    LONGS_EQUAL(0, m8q_get_nav_hdop()); 
+    m8q_get_time_utc_time(utc_time, BYTE_10); 
+    STRCMP_EQUAL("073731.00", (char *)utc_time); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_NAV_DOP).unknown); 
+}
+
+
+// M8Q parse - UBX message with a corrupted length doesn't swallow the messages after it 
+TEST(m8q_driver, m8q_parse_ubx_corrupted_len)
+{
+    // NAV-DOP with a length of 0xFFFF and NAV-SAT with a length above the max payload, 
+    // each followed by a TIME message 
+    const char stream[] = 
+        "\xB5\x62\x01\x04\xFF\xFF\xF0\x10\xC1\x01" 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n" 
+        "\xB5\x62\x01\x35\x01\x04\x01\x00" 
+        "$PUBX,04,073732.00,091202,113852.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+    uint8_t utc_time[BYTE_10]; 
+    memset((void *)utc_time, CLEAR, sizeof(utc_time)); 
+
+    LONGS_EQUAL(M8Q_UNKNOWN_DATA, m8q_parse_data((const uint8_t *)stream, sizeof(stream) - 1)); 
+    LONGS_EQUAL(2, m8q_get_time_seq()); 
+    m8q_get_time_utc_time(utc_time, BYTE_10); 
+    STRCMP_EQUAL("073732.00", (char *)utc_time); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_NAV_DOP).unknown); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_UBX).unknown); 
+    LONGS_EQUAL(2, m8q_get_msg_stats(M8Q_STATS_TIME).accepted); 
+}
+
+
+// M8Q parse - Messages with a bad checksum don't overwrite stored data 
+TEST(m8q_driver, m8q_parse_bad_checksum_reject)
+{
+    uint8_t lat_str[BYTE_11]; 
+    m8q_msg_stats_t stats; 
+    memset((void *)lat_str, CLEAR, sizeof(lat_str)); 
+
+    // POSITION then the same message with a corrupted latitude 
+    const char pos_msg[] = 
+        "$PUBX,00,081350.00,3345.12345,S,00833.91518,E,12.500,D3,1.5,2.5,1.250,180.00," 
+        "-0.125,,0.92,1.19,0.77,9,0,0*67\r\n"; 
+    const char pos_msg_bad[] = 
+        "$PUBX,00,081350.00,3945.12345,S,00833.91518,E,12.500,D3,1.5,2.5,1.250,180.00," 
+        "-0.125,,0.92,1.19,0.77,9,0,0*67\r\n"; 
+
+    // NAV-DOP with a corrupted pDOP 
+    const char dop_msg_bad[] = 
+        "\xB5\x62\x01\x04\x12\x00\xF0\x10\xC1\x01\x8C\x00\x78\x00\x4D\x00" 
+        "\x4D\x00\x5C\x00\x3D\x00\x44\x00\x53\x2B"; 
+
+    LONGS_EQUAL(M8Q_OK, m8q_parse_data((const uint8_t *)pos_msg, sizeof(pos_msg) - 1)); 
+    LONGS_EQUAL(M8Q_BAD_CHECKSUM, 
+                m8q_parse_data((const uint8_t *)pos_msg_bad, sizeof(pos_msg_bad) - 1)); 
+    LONGS_EQUAL(M8Q_BAD_CHECKSUM, 
+                m8q_parse_data((const uint8_t *)dop_msg_bad, sizeof(dop_msg_bad) - 1)); 
+
+    LONGS_EQUAL(1, m8q_get_position_seq()); 
+    LONGS_EQUAL(-337520575, m8q_get_position_latI()); 
+    m8q_get_position_lat_str(lat_str, BYTE_11); 
+    STRCMP_EQUAL("3345.12345", (char *)lat_str); 
+    LONGS_EQUAL(0, m8q_get_nav_pdop()); 
+
+    stats = m8q_get_msg_stats(M8Q_STATS_POSITION); 
+    LONGS_EQUAL(1, stats.accepted); 
+    LONGS_EQUAL(1, stats.bad_checksum); 
+    stats = m8q_get_msg_stats(M8Q_STATS_NAV_DOP); 
+    LONGS_EQUAL(0, stats.accepted); 
+    LONGS_EQUAL(1, stats.bad_checksum); 
+}
+
+
+// M8Q parse - Data stream health counters 
+TEST(m8q_driver, m8q_parse_msg_stats)
+{
+    m8q_msg_stats_t stats; 
+
+    // An unknown message and a cut short POSITION message 
+    const char stream[] = 
+        "$GNXXX,1,2,3*00\r\n" 
+        "$PUBX,00,081350.00,4717.11321,N,11433.9" 
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43,*5D\r\n"; 
+
+    m8q_parse_data((const uint8_t *)m8q_capture_epoch, m8q_capture_epoch_len); 
+
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_POSITION).accepted); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_TIME).accepted); 
+    LONGS_EQUAL(11, m8q_get_msg_stats(M8Q_STATS_NMEA).accepted); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_NAV_PVT).accepted); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_NAV_STATUS).accepted); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_NAV_DOP).accepted); 
+    LONGS_EQUAL(1, m8q_get_msg_stats(M8Q_STATS_ACK).accepted); 
+
+    m8q_parse_data((const uint8_t *)stream, sizeof(stream) - 1); 
+
+    stats = m8q_get_msg_stats(M8Q_STATS_NMEA); 
+    LONGS_EQUAL(11, stats.accepted); 
+    LONGS_EQUAL(1, stats.unknown); 
+    stats = m8q_get_msg_stats(M8Q_STATS_POSITION); 
+    LONGS_EQUAL(1, stats.accepted); 
+    LONGS_EQUAL(1, stats.truncated); 
+    LONGS_EQUAL(0, stats.bad_checksum); 
+    LONGS_EQUAL(2, m8q_get_msg_stats(M8Q_STATS_TIME).accepted); 
+
+    // Invalid type and clearing the counters 
+    LONGS_EQUAL(0, m8q_get_msg_stats(M8Q_STATS_NUM).accepted); 
+    m8q_clear_msg_stats(); 
+    stats = m8q_get_msg_stats(M8Q_STATS_POSITION); 
+    LONGS_EQUAL(0, stats.accepted); 
+    LONGS_EQUAL(0, stats.truncated); 
+}
+
+
+// M8Q snapshot - position, time and accuracy copied together 
+TEST(m8q_driver, m8q_snapshot_update)
+{
+    m8q_snapshot_t snapshot; 
+
+    // A cut short POSITION message 
+    const char pos_msg_short[] = "$PUBX,00,091350.00,3345.12345,S,00833.91518,E"; 
+
+    LONGS_EQUAL(M8Q_INVALID_PTR, m8q_get_snapshot(NULL)); 
+
+    // Nothing has been published yet 
+    LONGS_EQUAL(M8Q_OK, m8q_get_snapshot(&snapshot)); 
+    LONGS_EQUAL(0, snapshot.seq); 
+    LONGS_EQUAL(0, snapshot.pos.lat); 
+
+    // One update for each stored message in the capture (POSITION, TIME, NAV-PVT, 
+    // NAV-STATUS and NAV-DOP) 
+    m8q_parse_data((const uint8_t *)m8q_capture_epoch, m8q_capture_epoch_len); 
+    m8q_get_snapshot(&snapshot); 
+    LONGS_EQUAL(5, snapshot.seq); 
+    LONGS_EQUAL(1, snapshot.pos.seq); 
+    LONGS_EQUAL(m8q_get_position_latI(), snapshot.pos.lat); 
+    LONGS_EQUAL(m8q_get_position_lonI(), snapshot.pos.lon); 
+    LONGS_EQUAL(M8Q_NAVSTAT_G3, snapshot.pos.navStat); 
+    LONGS_EQUAL(21, snapshot.pos.hAcc); 
+    LONGS_EQUAL(1, snapshot.time.seq); 
+    LONGS_EQUAL(8135000, snapshot.time.time); 
+    LONGS_EQUAL(91202, snapshot.time.date); 
+    LONGS_EQUAL(2100, snapshot.nav.hAcc); 
+    LONGS_EQUAL(2000, snapshot.nav.vAcc); 
+    LONGS_EQUAL(92, snapshot.nav.hDOP); 
+    LONGS_EQUAL(9, snapshot.nav.numSV); 
+
+    // A message that isn't finished doesn't change the snapshot 
+    m8q_parse_data((const uint8_t *)pos_msg_short, sizeof(pos_msg_short) - 1); 
+    m8q_get_snapshot(&snapshot); 
+    LONGS_EQUAL(5, snapshot.seq); 
+    LONGS_EQUAL(m8q_get_position_latI(), snapshot.pos.lat); 
+}
+
+
+// M8Q TX ready - data stream is only read after a TX ready interrupt 
+TEST(m8q_driver, m8q_txr_read_event)
+{
+    GPIO_TypeDef GPIO_FAKE; 
+    uint8_t stream_len[BYTE_2]; 
+    const char pos_msg[] = 
+        "$PUBX,00,081350.00,3345.12345,S,00833.91518,E,12.500,D3,1.5,2.5,1.250,180.00," 
+        "-0.125,,0.92,1.19,0.77,9,0,0*67\r\n"; 
+
+    m8q_test_itob(sizeof(pos_msg) - 1, stream_len); 
+    fix_callback_count = CLEAR; 
+    fix_callback_lat = CLEAR; 
+    m8q_txr_pin_init(&GPIO_FAKE, PIN_0); 
+    m8q_set_fix_callback(m8q_test_fix_callback); 
+    gpio_mock_set_read_state(GPIO_LOW); 
+
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, I2C_MOCK_INC_MODE_ENABLE); 
+    i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_0); 
+    i2c_mock_set_read_data(pos_msg, sizeof(pos_msg) - 1, I2C_MOCK_INDEX_1); 
+
+    // No interrupt - nothing is read 
+    LONGS_EQUAL(M8Q_NO_DATA_AVAILABLE, m8q_txr_read()); 
+    LONGS_EQUAL(0, m8q_get_position_seq()); 
+
+    // Interrupt - the stream is read and the fix callback is called once 
+    m8q_txr_irq(); 
+    LONGS_EQUAL(M8Q_OK, m8q_txr_read()); 
+    LONGS_EQUAL(1, m8q_get_position_seq()); 
+    LONGS_EQUAL(1, fix_callback_count); 
+    LONGS_EQUAL(-337520575, fix_callback_lat); 
+    LONGS_EQUAL(M8Q_NO_DATA_AVAILABLE, m8q_txr_read()); 
+
+    // TX ready still high after the read - the next call reads again 
+    i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_2); 
+    i2c_mock_set_read_data(pos_msg, sizeof(pos_msg) - 1, I2C_MOCK_INDEX_3); 
+    i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_4); 
+    i2c_mock_set_read_data(pos_msg, sizeof(pos_msg) - 1, I2C_MOCK_INDEX_5); 
+    gpio_mock_set_read_state(GPIO_HIGH); 
+    m8q_txr_irq(); 
+    LONGS_EQUAL(M8Q_OK, m8q_txr_read()); 
+    gpio_mock_set_read_state(GPIO_LOW); 
+    LONGS_EQUAL(M8Q_OK, m8q_txr_read()); 
+    LONGS_EQUAL(3, m8q_get_position_seq()); 
+    LONGS_EQUAL(3, fix_callback_count); 
+    LONGS_EQUAL(M8Q_NO_DATA_AVAILABLE, m8q_txr_read()); 
+
+    m8q_set_fix_callback(NULL); 
+}
+
+
+// M8Q NAV message configuration 
+TEST(m8q_driver, m8q_nav_config_ack)
+{
+    uint8_t stream_len[] = { 0x00, 0x0A }; 
+    const uint8_t ack_msg[] = { 181, 98, 5, 1, 2, 0, 6, 1, 15, 56 }; 
+    const uint8_t nak_msg[] = { 181, 98, 5, 0, 2, 0, 6, 1, 14, 51 }; 
+
+    // The 3 CFG-MSG messages and the CFG-RATE message are acknowledged 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, I2C_MOCK_INC_MODE_ENABLE); 
+
+    for (uint8_t i = CLEAR; i < 4; i++)
+    {
+        i2c_mock_set_read_data(stream_len, BYTE_2, 2*i); 
+        i2c_mock_set_read_data(ack_msg, sizeof(ack_msg), 2*i + 1); 
+    }
+
+    LONGS_EQUAL(M8Q_OK, m8q_nav_config(100)); 
+
+    // The first message is not acknowledged 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, I2C_MOCK_INC_MODE_ENABLE); 
+    i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_0); 
+    i2c_mock_set_read_data(nak_msg, sizeof(nak_msg), I2C_MOCK_INDEX_1); 
+
+    LONGS_EQUAL(M8Q_INVALID_CONFIG, m8q_nav_config(100)); 
+}
+
+
+// M8Q config builder - built messages match what the driver sends for ASCII messages 
+TEST(m8q_driver, m8q_config_builder_match)
+{
+    static constexpr auto gga_off = m8q_pubx_rate("GGA", 0); 
+    static constexpr auto pos_on = m8q_cfg_msg(0xF1, 0x00, 1); 
+    static constexpr auto ddc_prt = m8q_cfg_prt_ddc( 
+        M8Q_PRT_PROTO_UBX | M8Q_PRT_PROTO_NMEA | M8Q_PRT_PROTO_RTCM, 
+        M8Q_PRT_PROTO_UBX | M8Q_PRT_PROTO_NMEA, 
+        6, 40, M8Q_PRT_EXT_TX_TIMEOUT); 
+    static constexpr auto save = m8q_cfg_cfg(0x00000000, 0xFFFFFFFF, 0x00000000); 
+    static constexpr auto nav_rate = m8q_cfg_rate(1000, 1, 1); 
+    static constexpr auto pos_poll = m8q_nmea_msg("PUBX,00"); 
+
+    // Messages are complete at compile time 
+    static_assert(nav_rate.size == 14, "CFG-RATE size"); 
+    static_assert((nav_rate.data[12] == 0x01) && (nav_rate.data[13] == 0x39), "CFG-RATE CK"); 
+    static_assert((pos_poll.data[9] == '3') && (pos_poll.data[10] == '3'), "PUBX,00 CS"); 
+
+    const m8q_raw_msg_t built_msgs[] = { gga_off.raw(), pos_on.raw(), ddc_prt.raw(), save.raw() }; 
+    const uint8_t msg_num[] = { 0, 6, 10, 11 }; 
+    uint8_t write_msg[M8Q_CONFIG_MAX_MSG_LEN]; 
+    uint8_t write_msg_len; 
+
+    // Send the ASCII version of each message and compare it to the built message 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_DISABLE); 
+
+    for (uint8_t i = CLEAR; i < (sizeof(msg_num) / sizeof(msg_num[0])); i++)
+    {
+        LONGS_EQUAL(M8Q_OK, m8q_send_msg(m8q_config_pkt[msg_num[i]], M8Q_CONFIG_MAX_MSG_LEN)); 
+        i2c_mock_get_write_data((void *)write_msg, &write_msg_len, i); 
+
+        LONGS_EQUAL(write_msg_len, built_msgs[i].msg_size); 
+        MEMCMP_EQUAL(write_msg, built_msgs[i].msg, write_msg_len); 
+    }
+}
+
+
+// M8Q ready to send config messages - sent as is and UBX CFG messages are acknowledged 
+TEST(m8q_driver, m8q_config_raw_ack)
+{
+    static constexpr auto gga_off = m8q_pubx_rate("GGA", 0); 
+    static constexpr auto nav_rate = m8q_cfg_rate(1000, 1, 1); 
+    static constexpr m8q_raw_msg_t config_msgs[] = { gga_off.raw(), nav_rate.raw() }; 
+
+    uint8_t stream_len[] = { 0x00, 0x0A }; 
+    const uint8_t ack_msg[] = { 181, 98, 5, 1, 2, 0, 6, 8, 22, 63 }; 
+    const uint8_t nak_msg[] = { 181, 98, 5, 0, 2, 0, 6, 8, 21, 58 }; 
+    uint8_t write_msg[M8Q_CONFIG_MAX_MSG_LEN]; 
+    uint8_t write_msg_len; 
+
+    LONGS_EQUAL(M8Q_INVALID_PTR, m8q_config_raw(nullptr, 1)); 
+    LONGS_EQUAL(M8Q_INVALID_PTR, m8q_send_raw_msg(nullptr, 1)); 
+    LONGS_EQUAL(M8Q_INVALID_CONFIG, m8q_send_raw_msg(nav_rate.data, 0)); 
+    LONGS_EQUAL(M8Q_OK, m8q_init(&I2C_FAKE, nullptr, CLEAR, CLEAR, CLEAR)); 
+
+    // Only the CFG-RATE message reads the data stream for an ACK 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_ENABLE); 
+    i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_0); 
+    i2c_mock_set_read_data(ack_msg, sizeof(ack_msg), I2C_MOCK_INDEX_1); 
+
+    LONGS_EQUAL(M8Q_OK, m8q_config_raw(config_msgs, 2)); 
+
+    i2c_mock_get_write_data((void *)write_msg, &write_msg_len, I2C_MOCK_INDEX_0); 
+    LONGS_EQUAL(gga_off.size, write_msg_len); 
+    MEMCMP_EQUAL(gga_off.data, write_msg, write_msg_len); 
+    i2c_mock_get_write_data((void *)write_msg, &write_msg_len, I2C_MOCK_INDEX_1); 
+    LONGS_EQUAL(nav_rate.size, write_msg_len); 
+    MEMCMP_EQUAL(nav_rate.data, write_msg, write_msg_len); 
+
+    // A NAK stops the configuration 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_DISABLE, I2C_MOCK_INC_MODE_ENABLE); 
+    i2c_mock_set_read_data(stream_len, BYTE_2, I2C_MOCK_INDEX_0); 
+    i2c_mock_set_read_data(nak_msg, sizeof(nak_msg), I2C_MOCK_INDEX_1); 
+
+    LONGS_EQUAL(M8Q_INVALID_CONFIG, m8q_config_raw(&config_msgs[1], 1)); 
+}
+
+
+// M8Q RTCM passthrough - valid frames are sent from the circular buffer in chunks 
+TEST(m8q_driver, m8q_rtcm_forward_frames)
+{
+    // RTCM3 1005 message frame 
+    const uint8_t frame[] = 
+    {
+        0xD3, 0x00, 0x13, 0x3E, 0xD0, 0x00, 0x03, 0x8A, 0x0E, 0xDE, 0xEF, 0x34, 0xB4, 
+        0xBD, 0x62, 0xAC, 0x09, 0x41, 0x98, 0x6F, 0x33, 0x36, 0x88, 0x91, 0xBA 
+    }; 
+    const uint8_t junk[] = { 0x01, 0x02 }; 
+    uint8_t bad_frame[sizeof(frame)]; 
+    uint8_t circular_buff[96]; 
+    cb_index_t cb_index = { sizeof(circular_buff), 80, 80 }; 
+    m8q_rtcm_t rtcm; 
+    uint8_t write_msg[M8Q_CONFIG_MAX_MSG_LEN]; 
+    uint8_t write_msg_len, sent[2*sizeof(frame)]; 
+    uint16_t sent_len = CLEAR; 
+    const uint8_t chunk_sizes[] = { 14, 11, 16, 9, 16, 9 }; 
+
+    memcpy(bad_frame, frame, sizeof(frame)); 
+    bad_frame[10] ^= 0x01; 
+
+    LONGS_EQUAL(M8Q_INVALID_PTR, m8q_rtcm_init(nullptr, &cb_index)); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_init(&rtcm, &cb_index)); 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_DISABLE); 
+
+    // Junk, a frame that wraps around the buffer end, a corrupted frame and a frame 
+    m8q_test_cb_add(circular_buff, &cb_index, junk, sizeof(junk)); 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, sizeof(frame)); 
+    m8q_test_cb_add(circular_buff, &cb_index, bad_frame, sizeof(bad_frame)); 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, sizeof(frame)); 
+
+    LONGS_EQUAL(M8Q_UNKNOWN_DATA | M8Q_BAD_CHECKSUM, 
+                m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 16)); 
+    LONGS_EQUAL(2, rtcm.frames); 
+    LONGS_EQUAL(1, rtcm.bad_crc); 
+    LONGS_EQUAL(sizeof(junk) + sizeof(bad_frame) - 1, rtcm.skipped); 
+    LONGS_EQUAL(cb_index.head, cb_index.tail); 
+
+    // Part of a frame - nothing is sent and the tail stays at the frame start 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, 10); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 16)); 
+    LONGS_EQUAL(2, rtcm.frames); 
+    LONGS_EQUAL(61, cb_index.tail); 
+
+    m8q_test_cb_add(circular_buff, &cb_index, &frame[10], sizeof(frame) - 10); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 16)); 
+    LONGS_EQUAL(3, rtcm.frames); 
+    LONGS_EQUAL(cb_index.head, cb_index.tail); 
+
+    // Each frame is written in pieces no larger than the chunk size or the buffer end 
+    for (uint8_t i = CLEAR; i < sizeof(chunk_sizes); i++)
+    {
+        i2c_mock_get_write_data((void *)write_msg, &write_msg_len, i); 
+        LONGS_EQUAL(chunk_sizes[i], write_msg_len); 
+
+        if (i == 4)
+        {
+            MEMCMP_EQUAL(frame, sent, sizeof(frame)); 
+            MEMCMP_EQUAL(frame, &sent[sizeof(frame)], sizeof(frame)); 
+            sent_len = CLEAR; 
+        }
+
+        memcpy(&sent[sent_len], write_msg, write_msg_len); 
+        sent_len += write_msg_len; 
+    }
+
+    LONGS_EQUAL(sizeof(frame), sent_len); 
+    MEMCMP_EQUAL(frame, sent, sizeof(frame)); 
+}
+
+
+// M8Q RTCM passthrough - frames are never written in pieces of less than 2 bytes 
+TEST(m8q_driver, m8q_rtcm_forward_min_write)
+{
+    // RTCM3 1005 message frame 
+    const uint8_t frame[] = 
+    {
+        0xD3, 0x00, 0x13, 0x3E, 0xD0, 0x00, 0x03, 0x8A, 0x0E, 0xDE, 0xEF, 0x34, 0xB4, 
+        0xBD, 0x62, 0xAC, 0x09, 0x41, 0x98, 0x6F, 0x33, 0x36, 0x88, 0x91, 0xBA 
+    }; 
+    uint8_t circular_buff[64]; 
+    cb_index_t cb_index = { sizeof(circular_buff), 63, 63 }; 
+    m8q_rtcm_t rtcm; 
+    const uint8_t wrap_first_sizes[] = { 3, 8, 8, 6 }; 
+    const uint8_t remainder_sizes[] = { 8, 8, 7, 2 }; 
+    const uint8_t min_chunk_sizes[] = { 3, 3, 3, 3, 3, 3, 3, 2, 2 }; 
+    const uint8_t wrap_last_sizes[] = { 16, 7, 2 }; 
+
+    // 1 byte before the buffer end - it's written with the bytes after the wrap 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_init(&rtcm, &cb_index)); 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_DISABLE); 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, sizeof(frame)); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 8)); 
+    LONGS_EQUAL(1, rtcm.frames); 
+    m8q_test_rtcm_writes(frame, sizeof(frame), wrap_first_sizes, sizeof(wrap_first_sizes)); 
+
+    // Frame length is a multiple of the chunk size plus 1 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_DISABLE); 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, sizeof(frame)); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 8)); 
+    LONGS_EQUAL(2, rtcm.frames); 
+    m8q_test_rtcm_writes(frame, sizeof(frame), remainder_sizes, sizeof(remainder_sizes)); 
+
+    // Chunk sizes that are too small to avoid a 1 byte write are raised 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_DISABLE); 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, sizeof(frame)); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 1)); 
+    LONGS_EQUAL(3, rtcm.frames); 
+    m8q_test_rtcm_writes(frame, sizeof(frame), min_chunk_sizes, sizeof(min_chunk_sizes)); 
+
+    // Only the last byte is after the buffer end 
+    cb_index.head = sizeof(circular_buff) - sizeof(frame) + 1; 
+    cb_index.tail = cb_index.head; 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_init(&rtcm, &cb_index)); 
+    i2c_mock_init(I2C_MOCK_TIMEOUT_DISABLE, I2C_MOCK_INC_MODE_ENABLE, I2C_MOCK_INC_MODE_DISABLE); 
+    m8q_test_cb_add(circular_buff, &cb_index, frame, sizeof(frame)); 
+    LONGS_EQUAL(M8Q_OK, m8q_rtcm_forward(&rtcm, circular_buff, &cb_index, 16)); 
+    LONGS_EQUAL(1, rtcm.frames); 
+    m8q_test_rtcm_writes(frame, sizeof(frame), wrap_last_sizes, sizeof(wrap_last_sizes)); 
+}
+
 //==================================================
 
 //=======================================================================================
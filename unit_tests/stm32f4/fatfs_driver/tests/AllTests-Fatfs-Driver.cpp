@@ -0,0 +1,13 @@
+//- Copyright (c) 2008-2013 James Grenning --- All rights reserved
+//- For exclusive use by participants in Renaissance Software Consulting training courses.
+//- Cannot be used by attendees to train others without written permission.
+//- www.renaissancesoftware.net james@renaissancesoftware.net
+
+
+#include "CppUTest/CommandLineTestRunner.h"
+
+int main(int ac, char** av)
+{
+    return CommandLineTestRunner::RunAllTests(ac, av);
+}
+
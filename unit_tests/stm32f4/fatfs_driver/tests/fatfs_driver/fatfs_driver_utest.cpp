@@ -0,0 +1,257 @@
+/**
+ * @file fatfs_driver_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief FATFS driver unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - The driver talks to the SD card simulator through the SPI mock so the tests run 
+//   against the bytes the driver actually sends. 
+// - These tests have their own build because the devices tests replace the driver with 
+//   the disk image mock (fatfs_disk_image). 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include <cstring> 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "fatfs_driver.h" 
+    #include "spi_comm_mock.h" 
+    #include "sd_card_sim.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DISK_SECTORS 16 
+#define FATFS_PDRV 0
+
+// Card timing in bytes clocked at 25 MHz (3125 bytes per ms)
+#define SLOW_CARD_ACCESS 250000
+#define SLOW_CARD_BUSY 625000
+#define STUCK_CARD_BUSY 2000000
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test group 
+
+static uint8_t disk[DISK_SECTORS*SD_CARD_SIM_SEC_SIZE]; 
+static uint8_t buff[BYTE_3*SD_CARD_SIM_SEC_SIZE]; 
+
+
+TEST_GROUP(fatfs_driver_test)
+{
+    // Global test group variables 
+
+    // Constructor 
+    void setup()
+    {
+        for (uint32_t i = CLEAR; i < sizeof(disk); i++)
+        {
+            disk[i] = (uint8_t)(i / SD_CARD_SIM_SEC_SIZE + i); 
+        }
+
+        memset((void *)buff, CLEAR, sizeof(buff)); 
+
+        sd_card_sim_init(disk, DISK_SECTORS, CLEAR); 
+        spi_mock_init(SPI_MOCK_TIMEOUT_DISABLE, SPI_MOCK_INC_MODE_DISABLE, 
+                      SPI_MOCK_INC_MODE_DISABLE); 
+        spi_mock_set_sim(SPI_MOCK_SIM_ENABLE); 
+
+        fatfs_user_init(SPI2, GPIOB, GPIOX_PIN_9); 
+        fatfs_init(FATFS_PDRV); 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Initialization identifies the card and sets the data transfer clock from the CSD 
+TEST(fatfs_driver_test, fatfs_init_sets_data_clock)
+{
+    LONGS_EQUAL(CLEAR, fatfs_status(FATFS_PDRV)); 
+    LONGS_EQUAL(FATFS_CT_SDC2_BLOCK, fatfs_get_card_type()); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud()); 
+}
+
+
+// Single and multiple sector reads and writes 
+TEST(fatfs_driver_test, fatfs_read_write)
+{
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_2, BYTE_1)); 
+    MEMCMP_EQUAL(&disk[BYTE_2*SD_CARD_SIM_SEC_SIZE], buff, SD_CARD_SIM_SEC_SIZE); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_4, BYTE_3)); 
+    MEMCMP_EQUAL(&disk[BYTE_4*SD_CARD_SIM_SEC_SIZE], buff, BYTE_3*SD_CARD_SIM_SEC_SIZE); 
+
+    memset((void *)buff, 0x5A, sizeof(buff)); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(FATFS_PDRV, buff, BYTE_1, BYTE_1)); 
+    MEMCMP_EQUAL(buff, &disk[BYTE_1*SD_CARD_SIM_SEC_SIZE], SD_CARD_SIM_SEC_SIZE); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(FATFS_PDRV, buff, BYTE_8, BYTE_3)); 
+    MEMCMP_EQUAL(buff, &disk[BYTE_8*SD_CARD_SIM_SEC_SIZE], BYTE_3*SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(BYTE_4, sd_card_sim.sectors_written); 
+
+    LONGS_EQUAL(CLEAR, sd_card_sim.param_errors); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud()); 
+}
+
+
+// A command the card rejects (out of range address) isn't retried at a slower clock 
+TEST(fatfs_driver_test, fatfs_param_error_keeps_clock)
+{
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_read(FATFS_PDRV, buff, DISK_SECTORS, BYTE_1)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_read(FATFS_PDRV, buff, DISK_SECTORS, BYTE_2)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_write(FATFS_PDRV, buff, DISK_SECTORS, BYTE_1)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_write(FATFS_PDRV, buff, DISK_SECTORS, BYTE_2)); 
+
+    // Each command was sent once 
+    LONGS_EQUAL(BYTE_4, sd_card_sim.param_errors); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud()); 
+
+    // A data error token (read runs off the end of the card) isn't retried either 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_read(FATFS_PDRV, buff, DISK_SECTORS - BYTE_1, BYTE_2)); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud()); 
+
+    // The card still works at full speed 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, CLEAR, BYTE_1)); 
+    MEMCMP_EQUAL(disk, buff, SD_CARD_SIM_SEC_SIZE); 
+}
+
+
+// A read data token that never comes is retried one clock step slower 
+TEST(fatfs_driver_test, fatfs_lost_token_slows_clock)
+{
+    sd_card_sim_set_errors(BYTE_1, CLEAR); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_3, BYTE_1)); 
+    MEMCMP_EQUAL(&disk[BYTE_3*SD_CARD_SIM_SEC_SIZE], buff, SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_8, spi_mock_get_baud()); 
+
+    sd_card_sim_set_errors(BYTE_1, CLEAR); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_3, BYTE_3)); 
+    MEMCMP_EQUAL(&disk[BYTE_3*SD_CARD_SIM_SEC_SIZE], buff, BYTE_3*SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_16, spi_mock_get_baud()); 
+}
+
+
+// A rejected write data packet is retried one clock step slower 
+TEST(fatfs_driver_test, fatfs_crc_error_slows_clock)
+{
+    memset((void *)buff, 0xA5, sizeof(buff)); 
+    sd_card_sim_set_errors(CLEAR, BYTE_1); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(FATFS_PDRV, buff, BYTE_5, BYTE_1)); 
+    MEMCMP_EQUAL(buff, &disk[BYTE_5*SD_CARD_SIM_SEC_SIZE], SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_8, spi_mock_get_baud()); 
+
+    sd_card_sim_set_errors(CLEAR, BYTE_1); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(FATFS_PDRV, buff, BYTE_5, BYTE_3)); 
+    MEMCMP_EQUAL(buff, &disk[BYTE_5*SD_CARD_SIM_SEC_SIZE], BYTE_3*SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_16, spi_mock_get_baud()); 
+}
+
+
+// Same errors with the multi-block transfers left open between calls (DMA)
+TEST(fatfs_driver_test, fatfs_stream_errors)
+{
+    spi_dma_t engine; 
+
+    memset((void *)&engine, CLEAR, sizeof(engine)); 
+    fatfs_dma_init(&engine); 
+
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_read(FATFS_PDRV, buff, DISK_SECTORS, BYTE_2)); 
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_write(FATFS_PDRV, buff, DISK_SECTORS, BYTE_2)); 
+    LONGS_EQUAL(BYTE_2, sd_card_sim.param_errors); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud()); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_2, BYTE_2)); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, &buff[BYTE_2*SD_CARD_SIM_SEC_SIZE], 
+                                         BYTE_4, BYTE_1)); 
+    MEMCMP_EQUAL(&disk[BYTE_2*SD_CARD_SIM_SEC_SIZE], buff, BYTE_3*SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud()); 
+
+    sd_card_sim_set_errors(BYTE_1, CLEAR); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_8, BYTE_2)); 
+    MEMCMP_EQUAL(&disk[BYTE_8*SD_CARD_SIM_SEC_SIZE], buff, BYTE_2*SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_8, spi_mock_get_baud()); 
+
+    memset((void *)buff, 0x3C, sizeof(buff)); 
+    sd_card_sim_set_errors(CLEAR, BYTE_1); 
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(FATFS_PDRV, buff, BYTE_1, BYTE_2)); 
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_stream_end()); 
+    MEMCMP_EQUAL(buff, &disk[BYTE_1*SD_CARD_SIM_SEC_SIZE], BYTE_2*SD_CARD_SIM_SEC_SIZE); 
+    LONGS_EQUAL(SPI_BR_FPCLK_16, spi_mock_get_baud());
+}
+
+
+// The token and busy waits last as long in time at full speed (25 MHz)
+TEST(fatfs_driver_test, fatfs_slow_card_full_speed)
+{
+    // 80 ms read access and 200 ms busy
+    sd_card_sim_set_timing(SLOW_CARD_ACCESS, SLOW_CARD_BUSY);
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_read(FATFS_PDRV, buff, BYTE_2, BYTE_2));
+    MEMCMP_EQUAL(&disk[BYTE_2*SD_CARD_SIM_SEC_SIZE], buff, BYTE_2*SD_CARD_SIM_SEC_SIZE);
+
+    memset((void *)buff, 0x66, sizeof(buff));
+
+    LONGS_EQUAL(FATFS_RES_OK, fatfs_write(FATFS_PDRV, buff, BYTE_6, BYTE_2));
+    MEMCMP_EQUAL(buff, &disk[BYTE_6*SD_CARD_SIM_SEC_SIZE], BYTE_2*SD_CARD_SIM_SEC_SIZE);
+
+    LONGS_EQUAL(CLEAR, sd_card_sim.busy_packets);
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud());
+}
+
+
+// A card still busy after the max busy time doesn't get the next data packet
+TEST(fatfs_driver_test, fatfs_busy_timeout)
+{
+    // 640 ms busy
+    sd_card_sim_set_timing(CLEAR, STUCK_CARD_BUSY);
+    memset((void *)buff, 0x66, sizeof(buff));
+
+    LONGS_EQUAL(FATFS_RES_ERROR, fatfs_write(FATFS_PDRV, buff, BYTE_6, BYTE_3));
+
+    // Only the first sector was written and a slower clock wasn't tried
+    LONGS_EQUAL(BYTE_1, sd_card_sim.sectors_written);
+    LONGS_EQUAL(CLEAR, sd_card_sim.busy_packets);
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_mock_get_baud());
+}
+
+//=======================================================================================
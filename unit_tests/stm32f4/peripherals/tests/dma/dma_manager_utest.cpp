@@ -0,0 +1,225 @@
+/**
+ * @file dma_manager_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief DMA stream allocator unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - Allocation and dispatch don't touch the DMA registers so the real port and stream 
+//   addresses are only compared, never accessed. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "dma_manager.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test data 
+
+// Callback record 
+static uint8_t event_log[BYTE_4]; 
+static uint8_t event_count; 
+static void *event_context; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Record each callback in the order it's called 
+static void dma_test_callback(
+    dma_mgr_stream_t *stream, 
+    uint8_t flags, 
+    void *context)
+{
+    if (event_count < BYTE_4)
+    {
+        event_log[event_count++] = flags; 
+    }
+
+    event_context = context; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test Group 
+
+TEST_GROUP(dma_manager)
+{
+    // Constructor 
+    void setup()
+    {
+        dma_mgr_reset(); 
+        memset((void *)event_log, CLEAR, sizeof(event_log)); 
+        event_count = CLEAR; 
+        event_context = NULL; 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Allocation - requests get the streams and channels from the mapping table 
+TEST(dma_manager, alloc_mapping)
+{
+    dma_mgr_stream_t *rx1 = dma_mgr_alloc(DMA_REQ_USART1_RX); 
+    dma_mgr_stream_t *rx2 = dma_mgr_alloc(DMA_REQ_USART1_RX); 
+    dma_mgr_stream_t *spi = dma_mgr_alloc(DMA_REQ_SPI2_TX); 
+
+    CHECK(rx1 != NULL); 
+    POINTERS_EQUAL(DMA2, rx1->dma); 
+    POINTERS_EQUAL(DMA2_Stream2, rx1->stream); 
+    LONGS_EQUAL(DMA_STREAM_2, rx1->stream_num); 
+    LONGS_EQUAL(DMA_CHNL_4, rx1->channel); 
+    LONGS_EQUAL(DMA2_Stream2_IRQn, dma_mgr_irqn(rx1)); 
+
+    // The second stream for the same request 
+    CHECK(rx2 != NULL); 
+    POINTERS_EQUAL(DMA2_Stream5, rx2->stream); 
+    LONGS_EQUAL(DMA_CHNL_4, rx2->channel); 
+
+    CHECK(spi != NULL); 
+    POINTERS_EQUAL(DMA1, spi->dma); 
+    POINTERS_EQUAL(DMA1_Stream4, spi->stream); 
+    LONGS_EQUAL(DMA_CHNL_0, spi->channel); 
+    LONGS_EQUAL(DMA1_Stream4_IRQn, dma_mgr_irqn(spi)); 
+
+    // No streams left for the request 
+    POINTERS_EQUAL(NULL, dma_mgr_alloc(DMA_REQ_USART1_RX)); 
+    POINTERS_EQUAL(NULL, dma_mgr_alloc(DMA_REQ_COUNT)); 
+
+    dma_mgr_stats_t stats; 
+    dma_mgr_stats(&stats); 
+    LONGS_EQUAL(BYTE_3, stats.streams_in_use); 
+    UNSIGNED_LONGS_EQUAL(BYTE_3, stats.allocs); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, stats.alloc_fails); 
+}
+
+
+// Allocation - streams already taken by another request are skipped 
+TEST(dma_manager, alloc_conflict)
+{
+    // SPI1 RX takes DMA2 stream 0 so SPI4 RX gets its other stream 
+    dma_mgr_stream_t *spi1 = dma_mgr_alloc(DMA_REQ_SPI1_RX); 
+    dma_mgr_stream_t *spi4 = dma_mgr_alloc(DMA_REQ_SPI4_RX); 
+
+    POINTERS_EQUAL(DMA2_Stream0, spi1->stream); 
+    POINTERS_EQUAL(DMA2_Stream3, spi4->stream); 
+    LONGS_EQUAL(DMA_CHNL_5, spi4->channel); 
+    CHECK_FALSE(dma_mgr_free_status(DMA2, DMA_STREAM_0)); 
+    CHECK_FALSE(dma_mgr_free_status(DMA2, DMA_STREAM_3)); 
+    CHECK(dma_mgr_free_status(DMA2, DMA_STREAM_1)); 
+
+    // Specific streams 
+    dma_mgr_stream_t *tx = dma_mgr_claim(DMA_REQ_USART6_TX, DMA2, DMA_STREAM_7); 
+    CHECK(tx != NULL); 
+    LONGS_EQUAL(DMA_CHNL_5, tx->channel); 
+    POINTERS_EQUAL(NULL, dma_mgr_claim(DMA_REQ_USART1_TX, DMA2, DMA_STREAM_7)); 
+    POINTERS_EQUAL(NULL, dma_mgr_claim(DMA_REQ_USART1_TX, DMA1, DMA_STREAM_7)); 
+    POINTERS_EQUAL(NULL, dma_mgr_claim(DMA_REQ_USART1_TX, NULL, DMA_STREAM_7)); 
+
+    // Freed streams can be used again 
+    dma_mgr_free(tx); 
+    CHECK(dma_mgr_free_status(DMA2, DMA_STREAM_7)); 
+    tx = dma_mgr_alloc(DMA_REQ_USART1_TX); 
+    POINTERS_EQUAL(DMA2_Stream7, tx->stream); 
+    LONGS_EQUAL(DMA_CHNL_4, tx->channel); 
+
+    dma_mgr_stats_t stats; 
+    dma_mgr_stats(&stats); 
+    LONGS_EQUAL(BYTE_3, stats.streams_in_use); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, stats.alloc_fails); 
+}
+
+
+// Allocation - memory to memory uses any free DMA2 stream 
+TEST(dma_manager, alloc_mem2mem)
+{
+    for (uint8_t i = CLEAR; i < DMA_MGR_STREAMS; i++)
+    {
+        dma_mgr_stream_t *stream = dma_mgr_alloc(DMA_REQ_MEM2MEM); 
+        CHECK(stream != NULL); 
+        POINTERS_EQUAL(DMA2, stream->dma); 
+        LONGS_EQUAL(i, stream->stream_num); 
+    }
+
+    POINTERS_EQUAL(NULL, dma_mgr_alloc(DMA_REQ_MEM2MEM)); 
+    POINTERS_EQUAL(NULL, dma_mgr_alloc(DMA_REQ_USART6_RX)); 
+    POINTERS_EQUAL(NULL, dma_mgr_claim(DMA_REQ_MEM2MEM, DMA1, DMA_STREAM_0)); 
+    CHECK(dma_mgr_alloc(DMA_REQ_USART2_RX) != NULL); 
+}
+
+
+// Dispatch - callbacks run for each event with errors first 
+TEST(dma_manager, dispatch)
+{
+    int context = 0; 
+    dma_mgr_stream_t *stream = dma_mgr_alloc(DMA_REQ_USART2_RX); 
+
+    dma_mgr_set_callbacks(stream, dma_test_callback, dma_test_callback, 
+                          dma_test_callback, (void *)&context); 
+
+    dma_mgr_dispatch(stream, DMA_MGR_FLAG_HT); 
+    dma_mgr_dispatch(stream, DMA_MGR_FLAG_TC | DMA_MGR_FLAG_TE | DMA_MGR_FLAG_FE); 
+
+    LONGS_EQUAL(BYTE_3, event_count); 
+    LONGS_EQUAL(DMA_MGR_FLAG_HT, event_log[0]); 
+    LONGS_EQUAL(DMA_MGR_FLAG_TE | DMA_MGR_FLAG_FE, event_log[1]); 
+    LONGS_EQUAL(DMA_MGR_FLAG_TC, event_log[2]); 
+    POINTERS_EQUAL(&context, event_context); 
+
+    UNSIGNED_LONGS_EQUAL(BYTE_1, stream->half_count); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, stream->complete_count); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, stream->error_count); 
+
+    // Events without a callback are still counted 
+    dma_mgr_set_callbacks(stream, NULL, dma_test_callback, NULL, NULL); 
+    dma_mgr_dispatch(stream, DMA_MGR_FLAG_HT | DMA_MGR_FLAG_DME); 
+    LONGS_EQUAL(BYTE_3, event_count); 
+
+    // Freed streams don't dispatch 
+    dma_mgr_free(stream); 
+    dma_mgr_dispatch(stream, DMA_MGR_FLAG_TC); 
+    LONGS_EQUAL(BYTE_3, event_count); 
+
+    dma_mgr_stats_t stats; 
+    dma_mgr_stats(&stats); 
+    UNSIGNED_LONGS_EQUAL(BYTE_2, stats.half); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, stats.complete); 
+    UNSIGNED_LONGS_EQUAL(BYTE_2, stats.errors); 
+    LONGS_EQUAL(BYTE_0, stats.streams_in_use); 
+}
+
+//=======================================================================================
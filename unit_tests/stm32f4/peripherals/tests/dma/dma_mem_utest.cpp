@@ -0,0 +1,314 @@
+/**
+ * @file dma_mem_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief DMA memory copy and fill unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - The engine gets a stream from the DMA manager with its registers swapped for plain 
+//   structures. dma_test_run does the memory-to-memory transfer described by the stream 
+//   registers and reports transfer complete through dma_mgr_dispatch like the stream 
+//   interrupt would. 
+// - Stream addresses are 32-bit so buffers are found by the low 32 bits of their host 
+//   address. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "dma_mem.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DMA_TEST_WORDS 17600          // Buffer size in words (more than one byte transfer) 
+#define DMA_TEST_SIZE (DMA_TEST_WORDS * BYTE_4) 
+
+// Register bits 
+#define DMA_EN_BIT    0x00000001 
+#define DMA_TEIE_BIT  0x00000004 
+#define DMA_TCIE_BIT  0x00000010 
+#define DMA_PINC_BIT  0x00000200 
+#define DMA_MINC_BIT  0x00000400 
+#define DMA_PSIZE_POS 11 
+#define DMA_DMDIS_BIT 0x00000004 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test data 
+
+static DMA_TypeDef dma_test_port; 
+static DMA_Stream_TypeDef dma_test_stream; 
+static dma_mgr_stream_t *mem_stream; 
+static dma_mem_t engine; 
+
+static uint32_t src_words[DMA_TEST_WORDS]; 
+static uint32_t dst_words[DMA_TEST_WORDS]; 
+static uint8_t *src_buff = (uint8_t *)src_words; 
+static uint8_t *dst_buff = (uint8_t *)dst_words; 
+
+// Done callback record 
+static uint8_t done_count; 
+static DMA_MEM_STATUS done_status; 
+static uint8_t dma_runs; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Find the host address of a stream address 
+static uint8_t *dma_test_mem(uint32_t address)
+{
+    uint8_t *buffs[] = { src_buff, dst_buff, (uint8_t *)&engine.fill }; 
+    uint32_t sizes[] = { DMA_TEST_SIZE, DMA_TEST_SIZE, sizeof(engine.fill) }; 
+
+    for (uint8_t i = CLEAR; i < BYTE_3; i++)
+    {
+        uint32_t base = (uint32_t)(uintptr_t)buffs[i]; 
+
+        if ((address >= base) && ((address - base) < sizes[i]))
+        {
+            return buffs[i] + (address - base); 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Do the enabled transfer like the DMA would 
+static void dma_test_run(void)
+{
+    if (!(dma_test_stream.CR & DMA_EN_BIT))
+    {
+        return; 
+    }
+
+    uint8_t *src = dma_test_mem(dma_test_stream.PAR); 
+    uint8_t *dst = dma_test_mem(dma_test_stream.M0AR); 
+    uint32_t item = SET_BIT << ((dma_test_stream.CR >> DMA_PSIZE_POS) & SET_3); 
+    uint32_t len = dma_test_stream.NDTR * item; 
+
+    CHECK(src != NULL); 
+    CHECK(dst != NULL); 
+    CHECK(dma_test_stream.CR & DMA_MINC_BIT); 
+
+    for (uint32_t i = CLEAR; i < len; i++)
+    {
+        dst[i] = (dma_test_stream.CR & DMA_PINC_BIT) ? src[i] : src[i % item]; 
+    }
+
+    dma_test_stream.NDTR = CLEAR; 
+    dma_test_stream.CR &= ~DMA_EN_BIT; 
+    dma_runs++; 
+
+    dma_mgr_dispatch(mem_stream, DMA_MGR_FLAG_TC); 
+}
+
+
+// Record the done callback 
+static void dma_test_done(
+    DMA_MEM_STATUS status, 
+    void *context)
+{
+    done_count++; 
+    done_status = status; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test Group 
+
+TEST_GROUP(dma_mem)
+{
+    // Constructor 
+    void setup()
+    {
+        memset((void *)&dma_test_port, CLEAR, sizeof(dma_test_port)); 
+        memset((void *)&dma_test_stream, CLEAR, sizeof(dma_test_stream)); 
+
+        dma_mgr_reset(); 
+        mem_stream = dma_mgr_alloc(DMA_REQ_MEM2MEM); 
+        mem_stream->dma = &dma_test_port; 
+        mem_stream->stream = &dma_test_stream; 
+        dma_mem_init(&engine, mem_stream); 
+
+        for (uint32_t i = CLEAR; i < DMA_TEST_SIZE; i++)
+        {
+            src_buff[i] = (uint8_t)(i * 7 + 1); 
+        }
+
+        memset((void *)dst_words, CLEAR, sizeof(dst_words)); 
+        done_count = CLEAR; 
+        done_status = DMA_MEM_ERROR; 
+        dma_runs = CLEAR; 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Initialization - the stream is set up for memory-to-memory transfers 
+TEST(dma_mem, init)
+{
+    LONGS_EQUAL(DMA_MEM_INVALID_PTR, dma_mem_init(NULL, mem_stream)); 
+    LONGS_EQUAL(DMA_MEM_INVALID_PTR, dma_mem_init(&engine, NULL)); 
+    LONGS_EQUAL(DMA_MEM_INVALID_PTR, dma_mem_init(&engine, 
+                                                  dma_mgr_alloc(DMA_REQ_USART1_RX))); 
+
+    CHECK(dma_test_stream.FCR & DMA_DMDIS_BIT); 
+    CHECK(dma_test_stream.CR & DMA_TCIE_BIT); 
+    CHECK(dma_test_stream.CR & DMA_TEIE_BIT); 
+    POINTERS_EQUAL(mem_stream, engine.stream); 
+}
+
+
+// Copy - short blocks are copied by the CPU before returning 
+TEST(dma_mem, memcpy_cpu)
+{
+    LONGS_EQUAL(DMA_MEM_OK, dma_memcpy(&engine, dst_buff, src_buff, DMA_MEM_MIN_LEN - BYTE_1, 
+                                       dma_test_done, NULL)); 
+
+    LONGS_EQUAL(BYTE_1, done_count); 
+    LONGS_EQUAL(DMA_MEM_OK, done_status); 
+    CHECK_FALSE(dma_test_stream.CR & DMA_EN_BIT); 
+    MEMCMP_EQUAL(src_buff, dst_buff, DMA_MEM_MIN_LEN - BYTE_1); 
+    LONGS_EQUAL(CLEAR, dst_buff[DMA_MEM_MIN_LEN - BYTE_1]); 
+    UNSIGNED_LONGS_EQUAL(DMA_MEM_MIN_LEN - BYTE_1, engine.cpu_bytes); 
+
+    // No engine - always the CPU 
+    LONGS_EQUAL(DMA_MEM_OK, dma_memcpy(NULL, dst_buff, src_buff, DMA_TEST_SIZE, NULL, NULL)); 
+    MEMCMP_EQUAL(src_buff, dst_buff, DMA_TEST_SIZE); 
+    LONGS_EQUAL(DMA_MEM_INVALID_PTR, dma_memcpy(&engine, NULL, src_buff, BYTE_1, NULL, NULL)); 
+}
+
+
+// Copy - aligned blocks are moved as words with the tail done by the CPU 
+TEST(dma_mem, memcpy_words)
+{
+    uint32_t len = 1002; 
+
+    LONGS_EQUAL(DMA_MEM_OK, dma_memcpy(&engine, dst_buff, src_buff, len, 
+                                       dma_test_done, NULL)); 
+
+    // Started and waiting on the DMA 
+    CHECK(dma_mem_busy(&engine)); 
+    LONGS_EQUAL(BYTE_0, done_count); 
+    UNSIGNED_LONGS_EQUAL(250, dma_test_stream.NDTR); 
+    LONGS_EQUAL(DMA_DATA_SIZE_WORD, (dma_test_stream.CR >> DMA_PSIZE_POS) & SET_3); 
+    CHECK(dma_test_stream.CR & DMA_PINC_BIT); 
+    LONGS_EQUAL(DMA_MEM_BUSY, dma_memcpy(&engine, dst_buff, src_buff, len, NULL, NULL)); 
+
+    dma_test_run(); 
+
+    LONGS_EQUAL(BYTE_1, done_count); 
+    LONGS_EQUAL(DMA_MEM_OK, done_status); 
+    CHECK_FALSE(dma_mem_busy(&engine)); 
+    MEMCMP_EQUAL(src_buff, dst_buff, len); 
+    LONGS_EQUAL(CLEAR, dst_buff[len]); 
+    UNSIGNED_LONGS_EQUAL(1000, engine.dma_bytes); 
+    UNSIGNED_LONGS_EQUAL(BYTE_2, engine.cpu_bytes); 
+}
+
+
+// Copy - unaligned blocks are moved as bytes split into transfers of up to 65535 items 
+TEST(dma_mem, memcpy_bytes)
+{
+    uint32_t len = DMA_TEST_SIZE - BYTE_1; 
+
+    dma_memcpy(&engine, dst_buff + BYTE_1, src_buff, len, dma_test_done, NULL); 
+
+    LONGS_EQUAL(DMA_DATA_SIZE_BYTE, (dma_test_stream.CR >> DMA_PSIZE_POS) & SET_3); 
+    UNSIGNED_LONGS_EQUAL(DMA_MEM_MAX_ITEMS, dma_test_stream.NDTR); 
+
+    dma_test_run(); 
+    LONGS_EQUAL(BYTE_0, done_count); 
+    UNSIGNED_LONGS_EQUAL(len - DMA_MEM_MAX_ITEMS, dma_test_stream.NDTR); 
+
+    dma_test_run(); 
+    LONGS_EQUAL(BYTE_1, done_count); 
+    LONGS_EQUAL(BYTE_2, dma_runs); 
+    MEMCMP_EQUAL(src_buff, dst_buff + BYTE_1, len); 
+    UNSIGNED_LONGS_EQUAL(len, engine.dma_bytes); 
+    UNSIGNED_LONGS_EQUAL(BYTE_2, engine.dma_transfers); 
+}
+
+
+// Fill - the fill value is read from a fixed address 
+TEST(dma_mem, memset)
+{
+    uint8_t expected[DMA_MEM_MIN_LEN * BYTE_4]; 
+    memset((void *)expected, 0xA5, sizeof(expected)); 
+
+    LONGS_EQUAL(DMA_MEM_OK, dma_memset(&engine, dst_buff, 0xA5, sizeof(expected), 
+                                       dma_test_done, NULL)); 
+
+    CHECK_FALSE(dma_test_stream.CR & DMA_PINC_BIT); 
+    LONGS_EQUAL(DMA_DATA_SIZE_WORD, (dma_test_stream.CR >> DMA_PSIZE_POS) & SET_3); 
+    UNSIGNED_LONGS_EQUAL(0xA5A5A5A5, engine.fill); 
+    LONGS_EQUAL(DMA_MEM_BUSY, dma_memset(&engine, dst_buff, 0x00, sizeof(expected), 
+                                         NULL, NULL)); 
+
+    dma_test_run(); 
+
+    LONGS_EQUAL(BYTE_1, done_count); 
+    MEMCMP_EQUAL(expected, dst_buff, sizeof(expected)); 
+    LONGS_EQUAL(CLEAR, dst_buff[sizeof(expected)]); 
+
+    // Short fills by the CPU 
+    dma_memset(&engine, dst_buff, 0x3C, BYTE_8, NULL, NULL); 
+    LONGS_EQUAL(0x3C, dst_buff[BYTE_7]); 
+    LONGS_EQUAL(0xA5, dst_buff[BYTE_8]); 
+}
+
+
+// Error - a transfer error ends the block with an error status 
+TEST(dma_mem, transfer_error)
+{
+    dma_memcpy(&engine, dst_buff + BYTE_1, src_buff, DMA_TEST_SIZE - BYTE_1, 
+               dma_test_done, NULL); 
+
+    dma_mgr_dispatch(mem_stream, DMA_MGR_FLAG_TE | DMA_MGR_FLAG_TC); 
+
+    LONGS_EQUAL(BYTE_1, done_count); 
+    LONGS_EQUAL(DMA_MEM_ERROR, done_status); 
+    LONGS_EQUAL(DMA_MEM_ERROR, dma_mem_wait(&engine)); 
+    CHECK_FALSE(dma_mem_busy(&engine)); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, engine.dma_transfers); 
+}
+
+//=======================================================================================
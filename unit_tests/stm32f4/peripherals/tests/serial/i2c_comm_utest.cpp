@@ -0,0 +1,512 @@
+/**
+ * @file i2c_comm_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C driver unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "i2c_comm.h" 
+    #include "i2c_sim.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Devices 
+#define MPU6050_ADDR 0xD0 
+#define LSM303AGR_ADDR 0x32 
+#define M8Q_ADDR 0x84 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test data 
+
+static i2c_txn_t *callback_order[I2C_SIM_LOG_SIZE]; 
+static uint8_t callback_count; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Record the order transactions finish in 
+static void i2c_test_callback(i2c_txn_t *txn)
+{
+    callback_order[callback_count++ % I2C_SIM_LOG_SIZE] = txn; 
+}
+
+
+// Set up a register read transaction 
+static void i2c_test_reg_read(
+    i2c_txn_t *txn, 
+    uint8_t address, 
+    const uint8_t *reg, 
+    uint8_t *data, 
+    uint16_t size)
+{
+    memset(txn, CLEAR, sizeof(i2c_txn_t)); 
+    txn->address = address; 
+    txn->tx_data = reg; 
+    txn->tx_len = BYTE_1; 
+    txn->rx_data = data; 
+    txn->rx_len = size; 
+    txn->callback = i2c_test_callback; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test Group 
+
+TEST_GROUP(i2c_comm)
+{
+    i2c_async_t engine; 
+
+    // Constructor 
+    void setup()
+    {
+        i2c_sim_init(&engine); 
+        i2c_sim_add_device(MPU6050_ADDR); 
+        i2c_dev_sim_device_t *lsm303agr = i2c_sim_add_device(LSM303AGR_ADDR); 
+
+        for (uint16_t i = CLEAR; i < 256; i++)
+        {
+            lsm303agr->regs[i] = (uint8_t)(0xFF - i); 
+        }
+
+        callback_count = CLEAR; 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Asynchronous - invalid transactions are rejected 
+TEST(i2c_comm, async_submit_invalid)
+{
+    i2c_txn_t txn; 
+    uint8_t reg = 0x3B; 
+    uint8_t data[BYTE_6]; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn, MPU6050_ADDR, &reg, data, BYTE_6); 
+
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_async_submit(NULL, &txn)); 
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_async_submit(&engine, NULL)); 
+
+    txn.rx_data = NULL; 
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_async_submit(&engine, &txn)); 
+
+    txn.rx_data = data; 
+    txn.tx_len = BYTE_0; 
+    txn.rx_len = BYTE_0; 
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_async_submit(&engine, &txn)); 
+
+    // Submitting a queued transaction again is refused 
+    txn.tx_len = BYTE_1; 
+    txn.rx_len = BYTE_6; 
+    LONGS_EQUAL(I2C_OK, i2c_async_submit(&engine, &txn)); 
+    LONGS_EQUAL(I2C_BUSY, i2c_async_submit(&engine, &txn)); 
+    LONGS_EQUAL(TRUE, i2c_async_busy(&engine)); 
+
+    i2c_sim_run(); 
+    LONGS_EQUAL(FALSE, i2c_async_busy(&engine)); 
+
+    // Only queue membership is checked - the status left in a transaction doesn't matter 
+    txn.status = I2C_BUSY; 
+    LONGS_EQUAL(I2C_OK, i2c_async_submit(&engine, &txn)); 
+    i2c_sim_run(); 
+    LONGS_EQUAL(I2C_OK, txn.status); 
+}
+
+
+// Asynchronous - register write then repeated start read using interrupts 
+TEST(i2c_comm, async_write_read_irq)
+{
+    i2c_txn_t txn; 
+    uint8_t reg = 0x3B; 
+    uint8_t data[BYTE_6]; 
+    const uint8_t expected[BYTE_6] = { 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0x40 };
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn, MPU6050_ADDR, &reg, data, BYTE_6); 
+
+    // Submitting only starts the transaction - nothing blocks 
+    LONGS_EQUAL(I2C_OK, i2c_async_submit(&engine, &txn)); 
+    LONGS_EQUAL(I2C_BUSY, txn.status); 
+    UNSIGNED_LONGS_EQUAL(CR1_START_BIT, i2c_sim.i2c.CR1 & CR1_START_BIT); 
+    UNSIGNED_LONGS_EQUAL(CR2_ITEVTEN_BIT | CR2_ITERREN_BIT, 
+                         i2c_sim.i2c.CR2 & (CR2_ITEVTEN_BIT | CR2_ITERREN_BIT)); 
+
+    i2c_sim_run(); 
+
+    // Write address, repeated start, read address, then one stop 
+    LONGS_EQUAL(BYTE_2, i2c_sim.addr_count); 
+    LONGS_EQUAL(MPU6050_ADDR, i2c_sim.addr_log[0]); 
+    LONGS_EQUAL(MPU6050_ADDR + I2C_R_OFFSET, i2c_sim.addr_log[1]); 
+    LONGS_EQUAL(BYTE_2, i2c_sim.starts); 
+    LONGS_EQUAL(BYTE_1, i2c_sim.stops); 
+
+    LONGS_EQUAL(BYTE_1, callback_count); 
+    POINTERS_EQUAL(&txn, callback_order[0]); 
+    LONGS_EQUAL(I2C_OK, txn.status); 
+    MEMCMP_EQUAL(expected, data, BYTE_6); 
+
+    // Interrupts are released once the queue is empty 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.i2c.CR2 & (CR2_ITEVTEN_BIT | CR2_ITERREN_BIT | 
+                                                CR2_ITBUFEN_BIT)); 
+    UNSIGNED_LONGS_EQUAL(1, engine.completed); 
+    UNSIGNED_LONGS_EQUAL(0, engine.errors); 
+}
+
+
+// Asynchronous - queued transactions run in order across devices 
+TEST(i2c_comm, async_queue_order)
+{
+    i2c_txn_t txn_imu, txn_mag, txn_cfg, txn_one; 
+    uint8_t imu_reg = 0x43, mag_reg = 0xE8; 
+    uint8_t imu_data[BYTE_6], mag_data[BYTE_6], one_data = CLEAR; 
+    const uint8_t cfg[BYTE_3] = { 0x1B, 0x08, 0x10 };
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn_imu, MPU6050_ADDR, &imu_reg, imu_data, BYTE_6); 
+    i2c_test_reg_read(&txn_mag, LSM303AGR_ADDR, &mag_reg, mag_data, BYTE_6); 
+    i2c_test_reg_read(&txn_one, MPU6050_ADDR, &cfg[0], &one_data, BYTE_1); 
+
+    // Write only transaction - register pointer then two registers 
+    memset(&txn_cfg, CLEAR, sizeof(txn_cfg)); 
+    txn_cfg.address = MPU6050_ADDR; 
+    txn_cfg.tx_data = cfg; 
+    txn_cfg.tx_len = BYTE_3; 
+    txn_cfg.callback = i2c_test_callback; 
+
+    i2c_async_submit(&engine, &txn_imu); 
+    i2c_async_submit(&engine, &txn_cfg); 
+    i2c_async_submit(&engine, &txn_mag); 
+    i2c_async_submit(&engine, &txn_one); 
+
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_4, callback_count); 
+    POINTERS_EQUAL(&txn_imu, callback_order[0]); 
+    POINTERS_EQUAL(&txn_cfg, callback_order[1]); 
+    POINTERS_EQUAL(&txn_mag, callback_order[2]); 
+    POINTERS_EQUAL(&txn_one, callback_order[3]); 
+
+    LONGS_EQUAL(I2C_OK, txn_imu.status); 
+    LONGS_EQUAL(I2C_OK, txn_cfg.status); 
+    LONGS_EQUAL(I2C_OK, txn_mag.status); 
+    LONGS_EQUAL(I2C_OK, txn_one.status); 
+
+    LONGS_EQUAL(0x43, imu_data[0]); 
+    LONGS_EQUAL(0x48, imu_data[5]); 
+    LONGS_EQUAL(0xFF - 0xE8, mag_data[0]); 
+    LONGS_EQUAL(0xFF - 0xED, mag_data[5]); 
+
+    // The write landed before the single byte read of the same register 
+    LONGS_EQUAL(0x08, i2c_dev_sim.devices[0].regs[0x1B]); 
+    LONGS_EQUAL(0x10, i2c_dev_sim.devices[0].regs[0x1C]); 
+    LONGS_EQUAL(0x08, one_data); 
+
+    LONGS_EQUAL(BYTE_4, i2c_sim.stops); 
+    LONGS_EQUAL(FALSE, i2c_async_busy(&engine)); 
+}
+
+
+// Asynchronous - a transaction submitted from a callback runs after the queue 
+TEST(i2c_comm, async_submit_from_callback)
+{
+    i2c_txn_t txn_a, txn_b; 
+    uint8_t reg = 0x75; 
+    uint8_t data_a = CLEAR, data_b = CLEAR; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn_a, MPU6050_ADDR, &reg, &data_a, BYTE_1); 
+    i2c_test_reg_read(&txn_b, MPU6050_ADDR, &reg, &data_b, BYTE_1); 
+
+    // Resubmit the first transaction once from its own callback 
+    txn_a.callback = [](i2c_txn_t *txn)
+    {
+        i2c_test_callback(txn); 
+        if (callback_count == BYTE_1)
+        {
+            i2c_async_submit((i2c_async_t *)txn->context, txn); 
+        }
+    };
+    txn_a.context = &engine; 
+
+    i2c_async_submit(&engine, &txn_a); 
+    i2c_async_submit(&engine, &txn_b); 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_3, callback_count); 
+    POINTERS_EQUAL(&txn_a, callback_order[0]); 
+    POINTERS_EQUAL(&txn_b, callback_order[1]); 
+    POINTERS_EQUAL(&txn_a, callback_order[2]); 
+    LONGS_EQUAL(0x75, data_a); 
+    LONGS_EQUAL(0x75, data_b); 
+}
+
+
+// Asynchronous - NACKs are retried then reported and the queue recovers 
+TEST(i2c_comm, async_nack_recovery)
+{
+    i2c_txn_t txn_retry, txn_fail, txn_next; 
+    uint8_t reg = 0x3B; 
+    uint8_t data_retry[BYTE_2], data_fail[BYTE_2], data_next[BYTE_2]; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn_retry, MPU6050_ADDR, &reg, data_retry, BYTE_2); 
+    i2c_test_reg_read(&txn_fail, LSM303AGR_ADDR, &reg, data_fail, BYTE_2); 
+    i2c_test_reg_read(&txn_next, MPU6050_ADDR, &reg, data_next, BYTE_2); 
+
+    // First device is busy for two attempts, second never answers without retries 
+    txn_retry.retries = BYTE_2; 
+    i2c_dev_sim.devices[0].nack_count = BYTE_2; 
+    i2c_dev_sim.devices[1].nack_count = BYTE_1; 
+
+    i2c_async_submit(&engine, &txn_retry); 
+    i2c_async_submit(&engine, &txn_fail); 
+    i2c_async_submit(&engine, &txn_next); 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_3, callback_count); 
+    LONGS_EQUAL(I2C_OK, txn_retry.status); 
+    LONGS_EQUAL(I2C_NACK, txn_fail.status); 
+    LONGS_EQUAL(I2C_OK, txn_next.status); 
+    LONGS_EQUAL(0x3B, data_retry[0]); 
+    LONGS_EQUAL(0x3C, data_next[1]); 
+
+    // Each NACK releases the bus with a stop 
+    LONGS_EQUAL(BYTE_5, i2c_sim.stops); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.i2c.SR1 & SR1_AF_BIT); 
+    UNSIGNED_LONGS_EQUAL(2, engine.completed); 
+    UNSIGNED_LONGS_EQUAL(1, engine.errors); 
+}
+
+
+// Asynchronous - a bus error mid read ends the transaction and the queue recovers 
+TEST(i2c_comm, async_bus_error_recovery)
+{
+    i2c_txn_t txn_err, txn_next; 
+    uint8_t reg = 0x10; 
+    uint8_t data_err[BYTE_6], data_next[BYTE_6]; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn_err, MPU6050_ADDR, &reg, data_err, BYTE_6); 
+    i2c_test_reg_read(&txn_next, MPU6050_ADDR, &reg, data_next, BYTE_6); 
+
+    i2c_async_submit(&engine, &txn_err); 
+    i2c_async_submit(&engine, &txn_next); 
+
+    // Run into the read phase then inject a misplaced stop 
+    while (i2c_sim.phase != I2C_SIM_RX)
+    {
+        CHECK_TRUE(i2c_sim_step());  
+    }
+    i2c_sim_step(); 
+    i2c_sim.phase = I2C_SIM_HOLD; 
+    i2c_sim.i2c.SR1 |= SR1_BERR_BIT; 
+    i2c_sim_er(); 
+
+    LONGS_EQUAL(I2C_BUS_ERROR, txn_err.status); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.i2c.SR1 & SR1_BERR_BIT); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.i2c.CR2 & CR2_ITBUFEN_BIT); 
+
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_2, callback_count); 
+    LONGS_EQUAL(I2C_OK, txn_next.status); 
+    LONGS_EQUAL(0x10, data_next[0]); 
+    LONGS_EQUAL(0x15, data_next[5]); 
+}
+
+
+// Asynchronous - abort ends a stuck transaction 
+TEST(i2c_comm, async_abort)
+{
+    i2c_txn_t txn_stuck, txn_next; 
+    uint8_t reg = 0x10; 
+    uint8_t data_stuck[BYTE_2], data_next[BYTE_2]; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+    i2c_test_reg_read(&txn_stuck, MPU6050_ADDR, &reg, data_stuck, BYTE_2); 
+    i2c_test_reg_read(&txn_next, MPU6050_ADDR, &reg, data_next, BYTE_2); 
+
+    i2c_async_submit(&engine, &txn_stuck); 
+    i2c_async_submit(&engine, &txn_next); 
+
+    // Start is requested but the bus never responds 
+    i2c_async_abort(&engine); 
+
+    LONGS_EQUAL(I2C_TIMEOUT, txn_stuck.status); 
+    LONGS_EQUAL(I2C_BUSY, txn_next.status); 
+    UNSIGNED_LONGS_EQUAL(CR1_STOP_BIT, i2c_sim.i2c.CR1 & CR1_STOP_BIT); 
+
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(I2C_OK, txn_next.status); 
+    LONGS_EQUAL(0x11, data_next[1]); 
+}
+
+
+// Asynchronous - write and read data moved by DMA 
+TEST(i2c_comm, async_write_read_dma)
+{
+    i2c_txn_t txn_cfg, txn_read; 
+    const uint8_t cfg[BYTE_4] = { 0x20, 0x57, 0x00, 0x81 };
+    uint8_t reg = 0xA0; 
+    uint8_t data[BYTE_6]; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, &i2c_sim.dma_tx, &i2c_sim.dma_rx); 
+    i2c_test_reg_read(&txn_read, LSM303AGR_ADDR, &reg, data, BYTE_6); 
+
+    memset(&txn_cfg, CLEAR, sizeof(txn_cfg)); 
+    txn_cfg.address = LSM303AGR_ADDR; 
+    txn_cfg.tx_data = cfg; 
+    txn_cfg.tx_len = BYTE_4; 
+    txn_cfg.callback = i2c_test_callback; 
+
+    i2c_async_submit(&engine, &txn_cfg); 
+    i2c_async_submit(&engine, &txn_read); 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_2, callback_count); 
+    LONGS_EQUAL(I2C_OK, txn_cfg.status); 
+    LONGS_EQUAL(I2C_OK, txn_read.status); 
+
+    // Write landed in the device and the read used LAST so the final byte was NACKed 
+    LONGS_EQUAL(0x57, i2c_dev_sim.devices[1].regs[0x20]); 
+    LONGS_EQUAL(0x81, i2c_dev_sim.devices[1].regs[0x22]); 
+    LONGS_EQUAL(TRUE, i2c_sim.last_set); 
+    LONGS_EQUAL(0xFF - 0xA0, data[0]); 
+    LONGS_EQUAL(0xFF - 0xA5, data[5]); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.dma_rx.NDTR); 
+
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.i2c.CR2 & (CR2_DMAEN_BIT | CR2_LAST_BIT)); 
+    LONGS_EQUAL(BYTE_2, i2c_sim.stops); 
+}
+
+
+// Asynchronous - device models shared with the device tests answer the engine (M8Q data 
+// stream size then data stream registers) 
+TEST(i2c_comm, async_dev_model_m8q)
+{
+    i2c_txn_t txn_size, txn_stream; 
+    uint8_t reg_size = 0xFD, reg_stream = 0xFF; 
+    uint8_t size[BYTE_2], data[BYTE_16]; 
+    const char stream[] = "$PUBX,00*33\r\n"; 
+
+    i2c_dev_sim_device_t *m8q = i2c_dev_sim_add(I2C_DEV_SIM_M8Q, M8Q_ADDR); 
+    i2c_dev_sim_stream_set(m8q, stream, sizeof(stream) - 1); 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, &i2c_sim.dma_tx, &i2c_sim.dma_rx); 
+    i2c_test_reg_read(&txn_size, M8Q_ADDR, &reg_size, size, BYTE_2); 
+    i2c_test_reg_read(&txn_stream, M8Q_ADDR, &reg_stream, data, sizeof(stream) - 1); 
+
+    i2c_async_submit(&engine, &txn_size); 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(I2C_OK, txn_size.status); 
+    LONGS_EQUAL(CLEAR, size[0]); 
+    LONGS_EQUAL(sizeof(stream) - 1, size[1]); 
+
+    i2c_async_submit(&engine, &txn_stream); 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(I2C_OK, txn_stream.status); 
+    MEMCMP_EQUAL(stream, data, sizeof(stream) - 1); 
+    LONGS_EQUAL(sizeof(stream) - 1, m8q->stream_pos); 
+
+    // Register address write and read of each transaction 
+    UNSIGNED_LONGS_EQUAL(BYTE_4, m8q->transfers); 
+}
+
+
+// Asynchronous - a DMA read that completes while submit is changing the queue 
+TEST(i2c_comm, async_submit_dma_complete)
+{
+    i2c_txn_t txn_first, txn_next; 
+    uint8_t reg_first = 0xA0, reg_next = 0x10; 
+    uint8_t data_first[BYTE_6], data_next[BYTE_2]; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, &i2c_sim.dma_tx, &i2c_sim.dma_rx); 
+    i2c_test_reg_read(&txn_first, LSM303AGR_ADDR, &reg_first, data_first, BYTE_6); 
+    i2c_test_reg_read(&txn_next, MPU6050_ADDR, &reg_next, data_next, BYTE_2); 
+
+    // Run the first read up to its DMA transfer 
+    i2c_async_submit(&engine, &txn_first); 
+
+    while (!(i2c_sim.dma_rx.CR & DMA_EN_BIT) && i2c_sim_step()); 
+
+    // Enter the same critical section submit uses and let the DMA finish inside it. The 
+    // transfer complete interrupt is masked so the queue can't change underneath. 
+    uint32_t irq_mask = i2c_async_lock(&engine); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.dma_rx.CR & DMA_TCIE_BIT); 
+
+    CHECK(i2c_sim_step()); 
+    LONGS_EQUAL(TRUE, i2c_sim.dma_rx_tc); 
+    LONGS_EQUAL(CLEAR, callback_count); 
+
+    LONGS_EQUAL(I2C_OK, i2c_async_submit(&engine, &txn_next)); 
+    POINTERS_EQUAL(&txn_first, engine.head); 
+    POINTERS_EQUAL(&txn_next, engine.tail); 
+    LONGS_EQUAL(CLEAR, callback_count); 
+
+    // The completion runs once the interrupts are restored and the queue carries on 
+    i2c_async_unlock(&engine, irq_mask); 
+    UNSIGNED_LONGS_EQUAL(DMA_TCIE_BIT, i2c_sim.dma_rx.CR & DMA_TCIE_BIT); 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_2, callback_count); 
+    POINTERS_EQUAL(&txn_first, callback_order[0]); 
+    POINTERS_EQUAL(&txn_next, callback_order[1]); 
+    LONGS_EQUAL(I2C_OK, txn_first.status); 
+    LONGS_EQUAL(I2C_OK, txn_next.status); 
+    LONGS_EQUAL(0xFF - 0xA0, data_first[0]); 
+    LONGS_EQUAL(0x10, data_next[0]); 
+    LONGS_EQUAL(0x11, data_next[1]); 
+
+    // Nothing left queued so the port interrupts are off again 
+    POINTERS_EQUAL(NULL, engine.head); 
+    POINTERS_EQUAL(NULL, engine.tail); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, i2c_sim.i2c.CR2 & (CR2_ITEVTEN_BIT | CR2_ITERREN_BIT)); 
+}
+
+//=======================================================================================
@@ -0,0 +1,391 @@
+/**
+ * @file i2c_sched_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C shared bus scheduler unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "i2c_sched.h" 
+    #include "i2c_sim.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define BUS_HZ 400000 
+#define IDLE_STEP_NS 10000       // Time passed when the bus has nothing to do 
+#define LCD_LINE_CHARS 20 
+
+// Devices 
+#define MPU6050_ADDR 0xD0 
+#define LSM303AGR_ADDR 0x32 
+#define HD44780U_ADDR 0x4E 
+
+// Statistics index of each device 
+#define MPU6050_DEV 0 
+#define LSM303AGR_DEV 1 
+#define HD44780U_DEV 2 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test data 
+
+static const uint8_t mpu6050_reg = 0x3B; 
+static const uint8_t lsm303agr_reg = 0xA8; 
+static uint8_t mpu6050_data[14]; 
+static uint8_t lsm303agr_data[BYTE_6]; 
+static uint8_t lcd_data[BYTE_4]; 
+static uint8_t lcd_chars; 
+
+static i2c_sched_slot_t *done_order[I2C_SIM_LOG_SIZE]; 
+static uint8_t done_count; 
+static uint8_t time_step;        // Step the bus the next time the scheduler reads the time 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Set up a slot 
+static void i2c_sched_test_slot(
+    i2c_sched_slot_t *slot, 
+    uint8_t address, 
+    const uint8_t *tx_data, 
+    uint8_t tx_len, 
+    uint8_t *rx_data, 
+    uint16_t rx_len, 
+    uint8_t device, 
+    uint8_t priority, 
+    uint32_t period)
+{
+    memset(slot, CLEAR, sizeof(i2c_sched_slot_t)); 
+    slot->txn.address = address; 
+    slot->txn.tx_data = tx_data; 
+    slot->txn.tx_len = tx_len; 
+    slot->txn.rx_data = rx_data; 
+    slot->txn.rx_len = rx_len; 
+    slot->device = device; 
+    slot->priority = priority; 
+    slot->period = period; 
+}
+
+
+// Record the order slots finish in 
+static void i2c_sched_test_done(i2c_sched_slot_t *slot)
+{
+    done_order[done_count++ % I2C_SIM_LOG_SIZE] = slot; 
+}
+
+
+// LCD line update - one character (4 expander bytes) per transfer like hd44780u_send 
+static void i2c_sched_test_lcd_char(i2c_sched_slot_t *slot)
+{
+    if (++lcd_chars < LCD_LINE_CHARS)
+    {
+        i2c_sched_request(slot); 
+    }
+}
+
+
+// Time source that moves the bus on once from inside the scheduler 
+static uint32_t i2c_sched_test_time_step(void)
+{
+    if (time_step)
+    {
+        time_step = FALSE; 
+        i2c_sim_step(); 
+    }
+
+    return i2c_sim_time_us(); 
+}
+
+
+// Run the scheduler and bus for a length of simulated time 
+static void i2c_sched_test_run(
+    i2c_sched_t *sched, 
+    uint32_t time_us)
+{
+    uint32_t end = i2c_sim_time_us() + time_us; 
+
+    while ((int32_t)(i2c_sim_time_us() - end) < 0)
+    {
+        i2c_sched_run(sched); 
+
+        if (!i2c_sim_step())
+        {
+            i2c_sim_wait(IDLE_STEP_NS); 
+        }
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test Group 
+
+TEST_GROUP(i2c_sched)
+{
+    i2c_async_t engine; 
+    i2c_sched_t sched; 
+
+    // Constructor 
+    void setup()
+    {
+        i2c_sim_init(&engine); 
+        i2c_sim_add_device(MPU6050_ADDR); 
+        i2c_sim_add_device(LSM303AGR_ADDR); 
+        i2c_sim_add_device(HD44780U_ADDR); 
+        i2c_async_init(&engine, &i2c_sim.i2c, NULL, NULL); 
+        i2c_sched_init(&sched, &engine, i2c_sim_time_us, BUS_HZ); 
+        done_count = CLEAR; 
+        lcd_chars = CLEAR; 
+        time_step = FALSE; 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Scheduler - invalid and repeated registrations and requests 
+TEST(i2c_sched, add_request_invalid)
+{
+    i2c_sched_slot_t slot; 
+
+    i2c_sched_test_slot(&slot, HD44780U_ADDR, lcd_data, BYTE_4, NULL, BYTE_0, 
+                        HD44780U_DEV, BYTE_3, CLEAR); 
+
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_sched_add(NULL, &slot)); 
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_sched_add(&sched, NULL)); 
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_sched_request(&slot)); 
+
+    slot.device = I2C_SCHED_MAX_DEVICES; 
+    LONGS_EQUAL(I2C_NULL_PTR, i2c_sched_add(&sched, &slot)); 
+    slot.device = HD44780U_DEV; 
+
+    // One-shot slots wait for a request 
+    LONGS_EQUAL(I2C_OK, i2c_sched_add(&sched, &slot)); 
+    LONGS_EQUAL(I2C_BUSY, i2c_sched_add(&sched, &slot)); 
+    LONGS_EQUAL(FALSE, i2c_async_busy(&engine)); 
+
+    LONGS_EQUAL(I2C_OK, i2c_sched_request(&slot)); 
+    LONGS_EQUAL(I2C_BUSY, i2c_sched_request(&slot)); 
+    LONGS_EQUAL(TRUE, i2c_async_busy(&engine)); 
+
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(FALSE, slot.pending); 
+    UNSIGNED_LONGS_EQUAL(1, sched.stats[HD44780U_DEV].transfers); 
+    LONGS_EQUAL(I2C_OK, i2c_sched_request(&slot)); 
+}
+
+
+// Scheduler - released transfers go by priority, back to back 
+TEST(i2c_sched, priority_order)
+{
+    i2c_sched_slot_t imu, mag, lcd; 
+
+    i2c_sched_test_slot(&imu, MPU6050_ADDR, &mpu6050_reg, BYTE_1, mpu6050_data, 14, 
+                        MPU6050_DEV, BYTE_0, CLEAR); 
+    i2c_sched_test_slot(&mag, LSM303AGR_ADDR, &lsm303agr_reg, BYTE_1, lsm303agr_data, 
+                        BYTE_6, LSM303AGR_DEV, BYTE_1, CLEAR); 
+    i2c_sched_test_slot(&lcd, HD44780U_ADDR, lcd_data, BYTE_4, NULL, BYTE_0, 
+                        HD44780U_DEV, BYTE_3, CLEAR); 
+    imu.callback = i2c_sched_test_done; 
+    mag.callback = i2c_sched_test_done; 
+    lcd.callback = i2c_sched_test_done; 
+
+    i2c_sched_add(&sched, &lcd); 
+    i2c_sched_add(&sched, &mag); 
+    i2c_sched_add(&sched, &imu); 
+
+    // The LCD gets the free bus, the others are released while it's busy 
+    i2c_sched_request(&lcd); 
+    i2c_sched_request(&mag); 
+    i2c_sched_request(&imu); 
+    POINTERS_EQUAL(&lcd, sched.active); 
+
+    uint32_t start_ns = i2c_sim.time_ns; 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_3, done_count); 
+    POINTERS_EQUAL(&lcd, done_order[0]); 
+    POINTERS_EQUAL(&imu, done_order[1]); 
+    POINTERS_EQUAL(&mag, done_order[2]); 
+    LONGS_EQUAL(mpu6050_reg, mpu6050_data[0]); 
+    LONGS_EQUAL(lsm303agr_reg, lsm303agr_data[0]); 
+
+    // No idle time between the transfers 
+    UNSIGNED_LONGS_EQUAL(i2c_sim.time_ns - start_ns, i2c_sim.busy_ns); 
+    LONGS_EQUAL(BYTE_3, i2c_sim.stops); 
+}
+
+
+// Scheduler - IMU reads aren't delayed by an LCD line update 
+TEST(i2c_sched, imu_not_delayed_by_lcd)
+{
+    i2c_sched_slot_t imu, mag, lcd; 
+
+    // MPU6050 at 1 kHz, LSM303AGR at 100 Hz, LCD line written one character at a time 
+    i2c_sched_test_slot(&imu, MPU6050_ADDR, &mpu6050_reg, BYTE_1, mpu6050_data, 14, 
+                        MPU6050_DEV, BYTE_0, 1000); 
+    i2c_sched_test_slot(&mag, LSM303AGR_ADDR, &lsm303agr_reg, BYTE_1, lsm303agr_data, 
+                        BYTE_6, LSM303AGR_DEV, BYTE_1, 10000); 
+    i2c_sched_test_slot(&lcd, HD44780U_ADDR, lcd_data, BYTE_4, NULL, BYTE_0, 
+                        HD44780U_DEV, BYTE_3, CLEAR); 
+    lcd.callback = i2c_sched_test_lcd_char; 
+
+    i2c_sched_add(&sched, &imu); 
+    i2c_sched_add(&sched, &mag); 
+    i2c_sched_add(&sched, &lcd); 
+    i2c_sched_request(&lcd); 
+
+    i2c_sched_test_run(&sched, 20000); 
+
+    // Every release made it with the IMU never waiting on another device 
+    UNSIGNED_LONGS_EQUAL(20, sched.stats[MPU6050_DEV].transfers); 
+    UNSIGNED_LONGS_EQUAL(0, sched.stats[MPU6050_DEV].missed); 
+    CHECK_TRUE(sched.stats[MPU6050_DEV].latency_max <= imu.cost + 10); 
+    UNSIGNED_LONGS_EQUAL(2, sched.stats[LSM303AGR_DEV].transfers); 
+    UNSIGNED_LONGS_EQUAL(0, sched.stats[LSM303AGR_DEV].missed); 
+    LONGS_EQUAL(LCD_LINE_CHARS, lcd_chars); 
+    UNSIGNED_LONGS_EQUAL(LCD_LINE_CHARS, sched.stats[HD44780U_DEV].transfers); 
+
+    // 14 byte IMU read is 156 bits (390 us) every 1 ms 
+    UNSIGNED_LONGS_EQUAL(390, imu.cost); 
+    DOUBLES_EQUAL(39.0, i2c_sched_utilization(&sched, MPU6050_DEV), 1.0); 
+    DOUBLES_EQUAL(2.0, i2c_sched_utilization(&sched, LSM303AGR_DEV), 0.5); 
+    CHECK_TRUE(i2c_sched_utilization(&sched, HD44780U_DEV) > 0.0f); 
+}
+
+
+// Scheduler - a transfer too long to fit between IMU reads waits and misses its deadline 
+TEST(i2c_sched, long_transfer_missed_deadline)
+{
+    i2c_sched_slot_t imu, lcd; 
+    uint8_t lcd_line[LCD_LINE_CHARS * BYTE_4]; 
+
+    memset(lcd_line, CLEAR, sizeof(lcd_line)); 
+    i2c_sched_test_slot(&imu, MPU6050_ADDR, &mpu6050_reg, BYTE_1, mpu6050_data, 14, 
+                        MPU6050_DEV, BYTE_0, 1000); 
+    i2c_sched_test_slot(&lcd, HD44780U_ADDR, lcd_line, sizeof(lcd_line), NULL, BYTE_0, 
+                        HD44780U_DEV, BYTE_3, CLEAR); 
+    lcd.deadline = 5000; 
+
+    i2c_sched_add(&sched, &imu); 
+    i2c_sched_add(&sched, &lcd); 
+    i2c_sched_request(&lcd); 
+
+    i2c_sched_test_run(&sched, 10000); 
+
+    UNSIGNED_LONGS_EQUAL(0, sched.stats[MPU6050_DEV].missed); 
+    CHECK_TRUE(sched.stats[MPU6050_DEV].latency_max <= imu.cost + 10); 
+    UNSIGNED_LONGS_EQUAL(0, sched.stats[HD44780U_DEV].transfers); 
+    UNSIGNED_LONGS_EQUAL(1, sched.stats[HD44780U_DEV].missed); 
+    LONGS_EQUAL(TRUE, lcd.pending); 
+}
+
+
+// Scheduler - periodic releases that overrun the period are counted as missed 
+TEST(i2c_sched, periodic_overrun)
+{
+    i2c_sched_slot_t imu; 
+
+    // 390 us read released every 300 us 
+    i2c_sched_test_slot(&imu, MPU6050_ADDR, &mpu6050_reg, BYTE_1, mpu6050_data, 14, 
+                        MPU6050_DEV, BYTE_0, 300); 
+    i2c_sched_add(&sched, &imu); 
+
+    i2c_sched_test_run(&sched, 3000); 
+
+    CHECK_TRUE(sched.stats[MPU6050_DEV].missed > 0); 
+    CHECK_TRUE(sched.stats[MPU6050_DEV].transfers > 0); 
+    CHECK_TRUE(i2c_sched_utilization(&sched, MPU6050_DEV) > 50.0f); 
+
+    i2c_sched_stats_reset(&sched); 
+    UNSIGNED_LONGS_EQUAL(0, sched.stats[MPU6050_DEV].missed); 
+    UNSIGNED_LONGS_EQUAL(0, sched.stats[MPU6050_DEV].bus_time); 
+}
+
+
+// Scheduler - a DMA read that finishes while a slot is being released waits until the 
+// slots are unlocked 
+TEST(i2c_sched, request_dma_complete)
+{
+    i2c_sched_slot_t imu, mag; 
+
+    i2c_async_init(&engine, &i2c_sim.i2c, &i2c_sim.dma_tx, &i2c_sim.dma_rx); 
+    i2c_sched_init(&sched, &engine, i2c_sched_test_time_step, BUS_HZ); 
+    i2c_sched_test_slot(&imu, MPU6050_ADDR, &mpu6050_reg, BYTE_1, mpu6050_data, 14, 
+                        MPU6050_DEV, BYTE_0, CLEAR); 
+    i2c_sched_test_slot(&mag, LSM303AGR_ADDR, &lsm303agr_reg, BYTE_1, lsm303agr_data, 
+                        BYTE_6, LSM303AGR_DEV, BYTE_1, CLEAR); 
+    imu.callback = i2c_sched_test_done; 
+    mag.callback = i2c_sched_test_done; 
+    i2c_sched_add(&sched, &imu); 
+    i2c_sched_add(&sched, &mag); 
+
+    // Run the IMU read up to its DMA transfer 
+    i2c_sched_request(&imu); 
+
+    while (!(i2c_sim.dma_rx.CR & DMA_EN_BIT) && i2c_sim_step()); 
+
+    // The DMA finishes when the request reads the time with the slots locked. The 
+    // transfer complete interrupt is held off so the slots don't change underneath. 
+    time_step = TRUE; 
+    LONGS_EQUAL(I2C_OK, i2c_sched_request(&mag)); 
+    LONGS_EQUAL(FALSE, time_step); 
+    LONGS_EQUAL(TRUE, i2c_sim.dma_rx_tc); 
+    LONGS_EQUAL(CLEAR, done_count); 
+    POINTERS_EQUAL(&imu, sched.active); 
+    LONGS_EQUAL(TRUE, mag.pending); 
+
+    // The completion runs after and the magnetometer read follows 
+    i2c_sim_run(); 
+
+    LONGS_EQUAL(BYTE_2, done_count); 
+    POINTERS_EQUAL(&imu, done_order[0]); 
+    POINTERS_EQUAL(&mag, done_order[1]); 
+    LONGS_EQUAL(mpu6050_reg, mpu6050_data[0]); 
+    LONGS_EQUAL(lsm303agr_reg, lsm303agr_data[0]); 
+    UNSIGNED_LONGS_EQUAL(1, sched.stats[MPU6050_DEV].transfers); 
+    UNSIGNED_LONGS_EQUAL(1, sched.stats[LSM303AGR_DEV].transfers); 
+    POINTERS_EQUAL(NULL, sched.active); 
+}
+
+//=======================================================================================
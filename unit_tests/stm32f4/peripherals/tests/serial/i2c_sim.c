@@ -0,0 +1,319 @@
+/**
+ * @file i2c_sim.c
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C register simulator implementation - for unit testing 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "i2c_sim.h" 
+#include <string.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define I2C_SIM_MAX_STEPS 10000 
+#define I2C_SIM_BYTE_BITS 9          // 8 data bits + ACK/NACK 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+i2c_sim_t i2c_sim; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+// Call the event handler if the engine has it enabled 
+static void i2c_sim_ev(void); 
+
+// Call the DMA complete handler if a read finished and its interrupt is enabled 
+static uint8_t i2c_sim_dma_rx_tc(void); 
+
+// End the addressed device's transfer phase 
+static void i2c_sim_dev_end(void); 
+
+// Count bus time for a number of bits 
+static void i2c_sim_bits(uint32_t bits); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator functions 
+
+// Reset the simulator 
+void i2c_sim_init(i2c_async_t *engine)
+{
+    memset(&i2c_sim, CLEAR, sizeof(i2c_sim)); 
+    i2c_dev_sim_init(I2C_SIM_BUS_HZ); 
+    i2c_sim.engine = engine; 
+    i2c_sim.bus_hz = I2C_SIM_BUS_HZ; 
+    i2c_sim.dma_rx.CR = DMA_TCIE_BIT; 
+}
+
+
+// Add a device 
+i2c_dev_sim_device_t *i2c_sim_add_device(uint8_t address)
+{
+    i2c_dev_sim_device_t *device = i2c_dev_sim_add(I2C_DEV_SIM_REG, address); 
+
+    if (device != NULL)
+    {
+        for (uint16_t i = CLEAR; i < sizeof(device->regs); i++)
+        {
+            device->regs[i] = (uint8_t)i; 
+        }
+    }
+
+    return device; 
+}
+
+
+// Advance the bus by one event 
+uint8_t i2c_sim_step(void)
+{
+    // A read that finished while its interrupt was masked 
+    if (i2c_sim_dma_rx_tc())
+    {
+        return TRUE; 
+    }
+
+    // Stop - only once the last byte of a read is out. A pending stop goes out before 
+    // a new start. 
+    if ((i2c_sim.i2c.CR1 & CR1_STOP_BIT) && (i2c_sim.phase != I2C_SIM_RX))
+    {
+        i2c_sim_dev_end(); 
+        i2c_sim.i2c.CR1 &= ~CR1_STOP_BIT; 
+        i2c_sim.phase = I2C_SIM_IDLE; 
+        i2c_sim.stops++; 
+        i2c_sim_bits(BYTE_1); 
+        return TRUE; 
+    }
+
+    // Start or repeated start 
+    if (i2c_sim.i2c.CR1 & CR1_START_BIT)
+    {
+        i2c_sim_dev_end(); 
+        i2c_sim.i2c.CR1 &= ~CR1_START_BIT; 
+        i2c_sim.phase = I2C_SIM_ADDR; 
+        i2c_sim.starts++; 
+        i2c_sim_bits(BYTE_1); 
+        i2c_sim.i2c.DR = I2C_SIM_DR_EMPTY; 
+        i2c_sim.i2c.SR1 |= SR1_SB_BIT; 
+        i2c_sim_ev(); 
+        return TRUE; 
+    }
+
+    switch (i2c_sim.phase)
+    {
+        case I2C_SIM_ADDR: 
+        {
+            if (i2c_sim.i2c.DR == I2C_SIM_DR_EMPTY)
+            {
+                return FALSE; 
+            }
+
+            uint8_t addr = (uint8_t)i2c_sim.i2c.DR; 
+            i2c_sim.i2c.SR1 &= ~SR1_SB_BIT; 
+            i2c_sim.addr_log[i2c_sim.addr_count++ % I2C_SIM_LOG_SIZE] = addr; 
+            i2c_sim_bits(I2C_SIM_BYTE_BITS); 
+            i2c_sim.device = i2c_dev_sim_dev_addr(addr); 
+
+            if (i2c_sim.device == NULL)
+            {
+                i2c_sim.phase = I2C_SIM_HOLD; 
+                i2c_sim.i2c.SR1 |= SR1_AF_BIT; 
+                i2c_sim_er(); 
+                return TRUE; 
+            }
+
+            i2c_sim.phase = (addr & I2C_R_OFFSET) ? I2C_SIM_RX : I2C_SIM_TX; 
+            i2c_sim.i2c.SR1 |= SR1_ADDR_BIT; 
+            i2c_sim_ev(); 
+            i2c_sim.i2c.SR1 &= ~SR1_ADDR_BIT;   // Cleared by the SR1/SR2 read 
+            return TRUE; 
+        }
+
+        case I2C_SIM_TX: 
+            if ((i2c_sim.i2c.CR2 & CR2_DMAEN_BIT) && (i2c_sim.dma_tx.CR & DMA_EN_BIT))
+            {
+                // DMA moves the whole write buffer 
+                const uint8_t *data = i2c_sim.engine->head->tx_data; 
+                for (uint16_t i = CLEAR; i < i2c_sim.dma_tx.NDTR; i++)
+                {
+                    i2c_dev_sim_dev_write(i2c_sim.device, data[i]); 
+                }
+                i2c_sim_bits(i2c_sim.dma_tx.NDTR * I2C_SIM_BYTE_BITS); 
+                i2c_sim.dma_tx.NDTR = CLEAR; 
+                i2c_sim.dma_tx.CR &= ~DMA_EN_BIT; 
+                return TRUE; 
+            }
+
+            if (i2c_sim.i2c.CR2 & CR2_ITBUFEN_BIT)
+            {
+                i2c_sim.i2c.DR = I2C_SIM_DR_EMPTY; 
+                i2c_sim.i2c.SR1 |= SR1_TXE_BIT; 
+                i2c_sim_ev(); 
+                i2c_sim.i2c.SR1 &= ~SR1_TXE_BIT; 
+
+                if (i2c_sim.i2c.DR == I2C_SIM_DR_EMPTY)
+                {
+                    return FALSE; 
+                }
+
+                i2c_dev_sim_dev_write(i2c_sim.device, (uint8_t)i2c_sim.i2c.DR); 
+                i2c_sim_bits(I2C_SIM_BYTE_BITS); 
+                return TRUE; 
+            }
+
+            // Nothing left to shift out 
+            i2c_sim.phase = I2C_SIM_HOLD; 
+            i2c_sim.i2c.SR1 |= SR1_TXE_BIT | SR1_BTF_BIT; 
+            i2c_sim_ev(); 
+            i2c_sim.i2c.SR1 &= ~(SR1_TXE_BIT | SR1_BTF_BIT); 
+            return TRUE; 
+
+        case I2C_SIM_RX: 
+            if ((i2c_sim.i2c.CR2 & CR2_DMAEN_BIT) && (i2c_sim.dma_rx.CR & DMA_EN_BIT))
+            {
+                // DMA fills the whole read buffer 
+                uint8_t *data = i2c_sim.engine->head->rx_data; 
+                i2c_sim.last_set = (i2c_sim.i2c.CR2 & CR2_LAST_BIT) ? TRUE : FALSE; 
+                for (uint16_t i = CLEAR; i < i2c_sim.dma_rx.NDTR; i++)
+                {
+                    data[i] = i2c_dev_sim_dev_read(i2c_sim.device); 
+                }
+                i2c_sim_bits(i2c_sim.dma_rx.NDTR * I2C_SIM_BYTE_BITS); 
+                i2c_sim.dma_rx.NDTR = CLEAR; 
+                i2c_sim.dma_rx.CR &= ~DMA_EN_BIT; 
+                i2c_sim.phase = I2C_SIM_HOLD; 
+                i2c_sim.dma_rx_tc = TRUE; 
+                i2c_sim_dma_rx_tc(); 
+                return TRUE; 
+            }
+
+            if (i2c_sim.i2c.CR2 & CR2_ITBUFEN_BIT)
+            {
+                // The byte is NACKed if ACK is clear when it's received 
+                uint8_t nack = (i2c_sim.i2c.CR1 & CR1_ACK_BIT) ? FALSE : TRUE; 
+                i2c_sim.i2c.DR = i2c_dev_sim_dev_read(i2c_sim.device); 
+                i2c_sim_bits(I2C_SIM_BYTE_BITS); 
+                i2c_sim.i2c.SR1 |= SR1_RXNE_BIT; 
+                i2c_sim_ev(); 
+                i2c_sim.i2c.SR1 &= ~SR1_RXNE_BIT; 
+
+                if (nack)
+                {
+                    i2c_sim.phase = I2C_SIM_HOLD; 
+                }
+                return TRUE; 
+            }
+
+            return FALSE; 
+
+        default: 
+            return FALSE; 
+    }
+}
+
+
+// Run the bus until nothing else happens 
+uint16_t i2c_sim_run(void)
+{
+    uint16_t steps = CLEAR; 
+
+    while ((steps < I2C_SIM_MAX_STEPS) && i2c_sim_step())
+    {
+        steps++; 
+    }
+
+    return steps; 
+}
+
+
+// Call the error handler if the engine has it enabled 
+void i2c_sim_er(void)
+{
+    if (i2c_sim.i2c.CR2 & CR2_ITERREN_BIT)
+    {
+        i2c_async_er_irq(i2c_sim.engine); 
+    }
+}
+
+
+// Advance simulated time without bus activity 
+void i2c_sim_wait(uint32_t time_ns)
+{
+    i2c_sim.time_ns += time_ns; 
+}
+
+
+// Simulated time in microseconds 
+uint32_t i2c_sim_time_us(void)
+{
+    return i2c_sim.time_ns / 1000; 
+}
+
+
+// Call the event handler if the engine has it enabled 
+static void i2c_sim_ev(void)
+{
+    if (i2c_sim.i2c.CR2 & CR2_ITEVTEN_BIT)
+    {
+        i2c_async_ev_irq(i2c_sim.engine); 
+    }
+}
+
+
+// Call the DMA complete handler if a read finished and its interrupt is enabled 
+static uint8_t i2c_sim_dma_rx_tc(void)
+{
+    if (i2c_sim.dma_rx_tc && (i2c_sim.dma_rx.CR & DMA_TCIE_BIT))
+    {
+        i2c_sim.dma_rx_tc = FALSE; 
+        i2c_async_dma_rx_irq(i2c_sim.engine); 
+        return TRUE; 
+    }
+
+    return FALSE; 
+}
+
+
+// End the addressed device's transfer phase 
+static void i2c_sim_dev_end(void)
+{
+    if (i2c_sim.device != NULL)
+    {
+        i2c_dev_sim_dev_end(i2c_sim.device); 
+        i2c_sim.device = NULL; 
+    }
+}
+
+
+// Count bus time for a number of bits 
+static void i2c_sim_bits(uint32_t bits)
+{
+    uint32_t time_ns = (uint32_t)(((uint64_t)bits * 1000000000) / i2c_sim.bus_hz); 
+    i2c_sim.time_ns += time_ns; 
+    i2c_sim.busy_ns += time_ns; 
+}
+
+//=======================================================================================
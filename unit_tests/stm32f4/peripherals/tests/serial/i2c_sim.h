@@ -0,0 +1,172 @@
+/**
+ * @file i2c_sim.h
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief I2C register simulator interface - for unit testing 
+ * 
+ * @details Plays the role of an I2C port and the devices on its bus for the
+ *          asynchronous I2C engine. The simulator sets the SR1 event/error flags the 
+ *          hardware would set, calls the engine's interrupt handlers and responds to the 
+ *          CR1/CR2 bits the engine sets. DMA transfers are emulated by copying the data 
+ *          the stream would move and calling the DMA complete handler. Bus time is 
+ *          counted per bit at the chosen bus speed. 
+ *          
+ *          The devices on the bus are the register level device models of the device 
+ *          tests (i2c_dev_sim) so the same register maps, pointer auto-increment rules 
+ *          and device behaviour are used by both simulators. 
+ * 
+ * @version 0.1
+ * @date 2026-10-15
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef _I2C_SIM_H_
+#define _I2C_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "i2c_comm.h" 
+#include "i2c_dev_sim.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define I2C_SIM_LOG_SIZE 32 
+#define I2C_SIM_DR_EMPTY 0x100       // DR value that can't be written by the driver 
+#define I2C_SIM_BUS_HZ 400000        // Default bus speed 
+
+//==================================================
+// Register bits 
+
+// CR1 
+#define CR1_START_BIT   0x00000100 
+#define CR1_STOP_BIT    0x00000200 
+#define CR1_ACK_BIT     0x00000400 
+
+// CR2 
+#define CR2_ITERREN_BIT 0x00000100 
+#define CR2_ITEVTEN_BIT 0x00000200 
+#define CR2_ITBUFEN_BIT 0x00000400 
+#define CR2_DMAEN_BIT   0x00000800 
+#define CR2_LAST_BIT    0x00001000 
+
+// SR1 
+#define SR1_SB_BIT      0x00000001 
+#define SR1_ADDR_BIT    0x00000002 
+#define SR1_BTF_BIT     0x00000004 
+#define SR1_RXNE_BIT    0x00000040 
+#define SR1_TXE_BIT     0x00000080 
+#define SR1_BERR_BIT    0x00000100 
+#define SR1_AF_BIT      0x00000400 
+
+// DMA stream CR 
+#define DMA_EN_BIT      0x00000001 
+#define DMA_TCIE_BIT    0x00000010 
+
+//==================================================
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Bus phase seen by the simulator 
+typedef enum {
+    I2C_SIM_IDLE,       // Bus free 
+    I2C_SIM_ADDR,       // Start sent, waiting for the address 
+    I2C_SIM_TX,         // Master writing 
+    I2C_SIM_RX,         // Master reading 
+    I2C_SIM_HOLD        // Transfer done or failed, waiting for a stop or restart 
+} i2c_sim_phase_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Datatypes 
+
+// Simulator state 
+typedef struct i2c_sim_s 
+{
+    I2C_TypeDef i2c; 
+    DMA_Stream_TypeDef dma_tx; 
+    DMA_Stream_TypeDef dma_rx; 
+    i2c_async_t *engine; 
+    i2c_dev_sim_device_t *device;    // Addressed device (devices are in i2c_dev_sim)
+    i2c_sim_phase_t phase; 
+
+    // Bus timing 
+    uint32_t bus_hz; 
+    uint32_t time_ns;        // Simulated time 
+    uint32_t busy_ns;        // Time the bus spent transferring bits 
+
+    // Bus log 
+    uint16_t addr_log[I2C_SIM_LOG_SIZE]; 
+    uint8_t addr_count; 
+    uint8_t starts; 
+    uint8_t stops; 
+    uint8_t last_set;        // CR2 LAST was set when a DMA read started 
+    uint8_t dma_rx_tc;       // Read stream transfer complete flag (TCIF) not handled yet 
+}
+i2c_sim_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator functions 
+
+extern i2c_sim_t i2c_sim; 
+
+
+// Reset the simulator and attach it to an engine. All devices are removed. Generic 
+// register devices are added with i2c_sim_add_device and start with each register 
+// holding its own address. Other device models are added with i2c_dev_sim_add. The read 
+// stream starts with its transfer complete interrupt enabled and the DMA complete handler 
+// is only called while it is (masked completions run once it's enabled again). 
+void i2c_sim_init(i2c_async_t *engine); 
+
+
+// Add a generic register device at an address (R/W bit clear) - returns NULL if there's 
+// no room 
+i2c_dev_sim_device_t *i2c_sim_add_device(uint8_t address); 
+
+
+// Advance the bus by one event - returns FALSE if nothing could happen 
+uint8_t i2c_sim_step(void); 
+
+
+// Run the bus until nothing else happens - returns the number of steps 
+uint16_t i2c_sim_run(void); 
+
+
+// Call the error handler (if enabled) - used to inject errors 
+void i2c_sim_er(void); 
+
+
+// Advance simulated time without bus activity 
+void i2c_sim_wait(uint32_t time_ns); 
+
+
+// Simulated time in microseconds 
+uint32_t i2c_sim_time_us(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _I2C_SIM_H_
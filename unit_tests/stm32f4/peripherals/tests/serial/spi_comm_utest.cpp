@@ -0,0 +1,447 @@
+/**
+ * @file spi_comm_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief SPI driver unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - The SPI port and DMA streams are plain structures. spi_test_dma_run plays the part 
+//   of the DMA: once both streams and both SPI DMA requests are enabled it moves the 
+//   data between the buffers and a simulated slave then clears the stream EN bits the 
+//   same way the hardware does at the end of a transfer. 
+// - Stream memory addresses are 32 bits so buffers are found by matching the address 
+//   against the buffers the test uses instead of being dereferenced. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "spi_comm.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SPI_TEST_SIZE 64 
+#define SPI_TEST_BUFFS 4 
+
+// Register bits 
+#define SR_RXNE_BIT     0x00000001 
+#define SR_TXE_BIT      0x00000002 
+#define CR2_RXDMAEN_BIT 0x00000001 
+#define CR2_TXDMAEN_BIT 0x00000002 
+#define DMA_EN_BIT      0x00000001 
+#define DMA_TCIE_BIT    0x00000010 
+#define DMA_MINC_BIT    0x00000400 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test data 
+
+static SPI_TypeDef spi_test_port; 
+static DMA_TypeDef spi_test_dma; 
+static DMA_Stream_TypeDef spi_test_dma_tx; 
+static DMA_Stream_TypeDef spi_test_dma_rx; 
+static spi_dma_t spi_test_engine; 
+
+// Buffers the DMA streams can point to 
+static uint8_t *spi_test_buffs[SPI_TEST_BUFFS]; 
+
+// Simulated slave 
+static uint8_t slave_mosi[SPI_TEST_SIZE];     // Bytes received by the slave 
+static uint8_t slave_miso[SPI_TEST_SIZE];     // Bytes sent by the slave 
+static uint16_t slave_count; 
+
+static uint16_t dma_runs; 
+static uint16_t yield_count; 
+static uint8_t callback_count; 
+static SPI_STATUS callback_status; 
+static void *callback_context; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Find the buffer a stream memory address points to 
+static uint8_t *spi_test_mem(uint32_t address)
+{
+    for (uint8_t i = CLEAR; i < SPI_TEST_BUFFS; i++)
+    {
+        if ((spi_test_buffs[i] != NULL) && 
+            ((uint32_t)(uintptr_t)spi_test_buffs[i] == address))
+        {
+            return spi_test_buffs[i]; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Move the data of an enabled transfer and finish it like the DMA would 
+static void spi_test_dma_run(void)
+{
+    uint32_t dma_requests = CR2_RXDMAEN_BIT | CR2_TXDMAEN_BIT; 
+
+    if (((spi_test_port.CR2 & dma_requests) != dma_requests) || 
+        !(spi_test_dma_tx.CR & DMA_EN_BIT) || !(spi_test_dma_rx.CR & DMA_EN_BIT))
+    {
+        return; 
+    }
+
+    uint8_t *tx = spi_test_mem(spi_test_dma_tx.M0AR); 
+    uint8_t *rx = spi_test_mem(spi_test_dma_rx.M0AR); 
+    uint8_t tx_inc = (spi_test_dma_tx.CR & DMA_MINC_BIT) ? TRUE : FALSE; 
+    uint8_t rx_inc = (spi_test_dma_rx.CR & DMA_MINC_BIT) ? TRUE : FALSE; 
+
+    CHECK(tx != NULL); 
+    CHECK(rx != NULL); 
+    UNSIGNED_LONGS_EQUAL(spi_test_dma_tx.NDTR, spi_test_dma_rx.NDTR); 
+
+    for (uint32_t i = CLEAR; i < spi_test_dma_rx.NDTR; i++)
+    {
+        slave_mosi[slave_count % SPI_TEST_SIZE] = tx[tx_inc ? i : CLEAR]; 
+        rx[rx_inc ? i : CLEAR] = slave_miso[slave_count % SPI_TEST_SIZE]; 
+        slave_count++; 
+    }
+
+    spi_test_dma_tx.NDTR = CLEAR; 
+    spi_test_dma_rx.NDTR = CLEAR; 
+    spi_test_dma_tx.CR &= ~DMA_EN_BIT; 
+    spi_test_dma_rx.CR &= ~DMA_EN_BIT; 
+    dma_runs++; 
+
+    if (spi_test_dma_rx.CR & DMA_TCIE_BIT)
+    {
+        spi_dma_rx_irq(&spi_test_engine); 
+    }
+}
+
+
+// Yield hook that lets the DMA run 
+static void spi_test_yield(void)
+{
+    yield_count++; 
+    spi_test_dma_run(); 
+}
+
+
+// Yield hook for a DMA that never finishes 
+static void spi_test_yield_stuck(void)
+{
+    yield_count++; 
+}
+
+
+// Record the transfer result 
+static void spi_test_callback(
+    spi_dma_t *engine, 
+    SPI_STATUS status, 
+    void *context)
+{
+    callback_count++; 
+    callback_status = status; 
+    callback_context = context; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test Group 
+
+TEST_GROUP(spi_comm)
+{
+    uint8_t tx_buff[SPI_TEST_SIZE]; 
+    uint8_t rx_buff[SPI_TEST_SIZE]; 
+
+    // Constructor 
+    void setup()
+    {
+        memset((void *)&spi_test_port, CLEAR, sizeof(spi_test_port)); 
+        memset((void *)&spi_test_dma, CLEAR, sizeof(spi_test_dma)); 
+        memset((void *)&spi_test_dma_tx, CLEAR, sizeof(spi_test_dma_tx)); 
+        memset((void *)&spi_test_dma_rx, CLEAR, sizeof(spi_test_dma_rx)); 
+
+        // TXE and RXNE always set and BSY clear so the polled waits pass straight through 
+        spi_test_port.SR = SR_TXE_BIT | SR_RXNE_BIT; 
+
+        // Streams as set up by dma_stream_init - memory increment and TC interrupt on 
+        spi_test_dma_tx.CR = DMA_MINC_BIT; 
+        spi_test_dma_rx.CR = DMA_MINC_BIT | DMA_TCIE_BIT; 
+
+        spi_dma_init(&spi_test_engine, &spi_test_port, &spi_test_dma, 
+                     &spi_test_dma_tx, &spi_test_dma_rx, spi_test_yield); 
+
+        for (uint8_t i = CLEAR; i < SPI_TEST_SIZE; i++)
+        {
+            tx_buff[i] = i; 
+            slave_miso[i] = (uint8_t)(0xA0 + i); 
+        }
+
+        memset((void *)rx_buff, CLEAR, sizeof(rx_buff)); 
+        memset((void *)slave_mosi, CLEAR, sizeof(slave_mosi)); 
+
+        spi_test_buffs[0] = tx_buff; 
+        spi_test_buffs[1] = rx_buff; 
+        spi_test_buffs[2] = &spi_test_engine.fill; 
+        spi_test_buffs[3] = &spi_test_engine.sink; 
+
+        slave_count = CLEAR; 
+        dma_runs = CLEAR; 
+        yield_count = CLEAR; 
+        callback_count = CLEAR; 
+        callback_status = SPI_TIMEOUT; 
+        callback_context = NULL; 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Clock - the smallest divider that keeps the clock at or under the limit is chosen 
+TEST(spi_comm, baud_select)
+{
+    // SD card identification (400 kHz) and data (25 MHz) clocks from 100 MHz and 50 MHz 
+    LONGS_EQUAL(SPI_BR_FPCLK_256, spi_baud_select(100000000, 400000)); 
+    LONGS_EQUAL(SPI_BR_FPCLK_128, spi_baud_select(50000000, 400000)); 
+    LONGS_EQUAL(SPI_BR_FPCLK_4, spi_baud_select(100000000, 25000000)); 
+    LONGS_EQUAL(SPI_BR_FPCLK_2, spi_baud_select(50000000, 25000000)); 
+    LONGS_EQUAL(SPI_BR_FPCLK_8, spi_baud_select(84000000, 20000000)); 
+
+    // Limits above F_PCLK/2 and below F_PCLK/256 
+    LONGS_EQUAL(SPI_BR_FPCLK_2, spi_baud_select(16000000, 100000000)); 
+    LONGS_EQUAL(SPI_BR_FPCLK_256, spi_baud_select(100000000, 100000)); 
+}
+
+
+// Clock - changing the baud rate leaves the rest of the configuration alone 
+TEST(spi_comm, set_baud)
+{
+    uint32_t br_mask = 0x07 << 3; 
+    uint32_t spe_bit = 0x01 << 6; 
+
+    spi_test_port.CR1 = 0x0304 | spe_bit | (SPI_BR_FPCLK_256 << 3); 
+
+    spi_set_baud(&spi_test_port, SPI_BR_FPCLK_4); 
+    UNSIGNED_LONGS_EQUAL(SPI_BR_FPCLK_4 << 3, spi_test_port.CR1 & br_mask); 
+    UNSIGNED_LONGS_EQUAL(0x0304 | spe_bit, spi_test_port.CR1 & ~br_mask); 
+
+    spi_set_baud(&spi_test_port, SPI_BR_FPCLK_128); 
+    UNSIGNED_LONGS_EQUAL(SPI_BR_FPCLK_128 << 3, spi_test_port.CR1 & br_mask); 
+    UNSIGNED_LONGS_EQUAL(0x0304 | spe_bit, spi_test_port.CR1 & ~br_mask); 
+}
+
+
+// DMA - invalid transfers are rejected and only one transfer runs at a time 
+TEST(spi_comm, transfer_dma_invalid)
+{
+    LONGS_EQUAL(SPI_NULL_PTR, spi_transfer_dma(NULL, tx_buff, rx_buff, SPI_DUMMY, 
+                                               SPI_TEST_SIZE, NULL, NULL)); 
+    LONGS_EQUAL(SPI_NULL_PTR, spi_transfer_dma(&spi_test_engine, tx_buff, rx_buff, 
+                                               SPI_DUMMY, BYTE_0, NULL, NULL)); 
+    LONGS_EQUAL(SPI_NULL_PTR, spi_transfer_dma(&spi_test_engine, tx_buff, rx_buff, 
+                                               SPI_DUMMY, 0x10000, NULL, NULL)); 
+    LONGS_EQUAL(FALSE, spi_dma_busy(&spi_test_engine)); 
+
+    LONGS_EQUAL(SPI_OK, spi_transfer_dma(&spi_test_engine, tx_buff, rx_buff, SPI_DUMMY, 
+                                         SPI_TEST_SIZE, spi_test_callback, NULL)); 
+    LONGS_EQUAL(TRUE, spi_dma_busy(&spi_test_engine)); 
+    LONGS_EQUAL(SPI_BUSY, spi_transfer_dma(&spi_test_engine, tx_buff, rx_buff, SPI_DUMMY, 
+                                           SPI_TEST_SIZE, spi_test_callback, NULL)); 
+
+    spi_test_dma_run(); 
+
+    LONGS_EQUAL(BYTE_1, callback_count); 
+    LONGS_EQUAL(FALSE, spi_dma_busy(&spi_test_engine)); 
+}
+
+
+// DMA - full-duplex transfer finished by the RX stream interrupt 
+TEST(spi_comm, transfer_dma_full_duplex)
+{
+    uint8_t context; 
+
+    LONGS_EQUAL(SPI_OK, spi_transfer_dma(&spi_test_engine, tx_buff, rx_buff, SPI_DUMMY, 
+                                         SPI_TEST_SIZE, spi_test_callback, &context)); 
+
+    // Receive side is enabled along with the transmit side and nothing is done yet 
+    UNSIGNED_LONGS_EQUAL(CR2_RXDMAEN_BIT | CR2_TXDMAEN_BIT, spi_test_port.CR2); 
+    UNSIGNED_LONGS_EQUAL(SPI_TEST_SIZE, spi_test_dma_rx.NDTR); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)(&spi_test_port.DR), spi_test_dma_tx.PAR); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)(&spi_test_port.DR), spi_test_dma_rx.PAR); 
+    LONGS_EQUAL(BYTE_0, callback_count); 
+
+    spi_test_dma_run(); 
+
+    LONGS_EQUAL(BYTE_1, callback_count); 
+    LONGS_EQUAL(SPI_OK, callback_status); 
+    POINTERS_EQUAL(&context, callback_context); 
+    MEMCMP_EQUAL(tx_buff, slave_mosi, SPI_TEST_SIZE); 
+    MEMCMP_EQUAL(slave_miso, rx_buff, SPI_TEST_SIZE); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_port.CR2); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, spi_test_engine.transfers); 
+}
+
+
+// DMA - reads send the fill byte and writes discard the received bytes 
+TEST(spi_comm, transfer_dma_fill_and_discard)
+{
+    // Read - the transmit memory address stays on the fill byte 
+    spi_transfer_dma(&spi_test_engine, NULL, rx_buff, SPI_DUMMY, SPI_TEST_SIZE, 
+                     spi_test_callback, NULL); 
+
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_dma_tx.CR & DMA_MINC_BIT); 
+    UNSIGNED_LONGS_EQUAL(DMA_MINC_BIT, spi_test_dma_rx.CR & DMA_MINC_BIT); 
+
+    spi_test_dma_run(); 
+
+    for (uint8_t i = CLEAR; i < SPI_TEST_SIZE; i++)
+    {
+        LONGS_EQUAL(SPI_DUMMY, slave_mosi[i]); 
+    }
+    MEMCMP_EQUAL(slave_miso, rx_buff, SPI_TEST_SIZE); 
+
+    // Write - the receive memory address stays on the sink byte 
+    memset((void *)rx_buff, CLEAR, sizeof(rx_buff)); 
+    slave_count = CLEAR; 
+
+    spi_transfer_dma(&spi_test_engine, tx_buff, NULL, SPI_DUMMY, SPI_TEST_SIZE, 
+                     spi_test_callback, NULL); 
+
+    UNSIGNED_LONGS_EQUAL(DMA_MINC_BIT, spi_test_dma_tx.CR & DMA_MINC_BIT); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_dma_rx.CR & DMA_MINC_BIT); 
+
+    spi_test_dma_run(); 
+
+    LONGS_EQUAL(BYTE_2, callback_count); 
+    MEMCMP_EQUAL(tx_buff, slave_mosi, SPI_TEST_SIZE); 
+    LONGS_EQUAL(slave_miso[SPI_TEST_SIZE - 1], spi_test_engine.sink); 
+    LONGS_EQUAL(CLEAR, rx_buff[0]); 
+}
+
+
+// Blocking - the yield hook runs while waiting and the RX interrupt finishes the transfer 
+TEST(spi_comm, transfer_blocking_irq)
+{
+    LONGS_EQUAL(SPI_OK, spi_transfer(&spi_test_port, NULL, rx_buff, SPI_DUMMY, 
+                                     SPI_TEST_SIZE)); 
+
+    LONGS_EQUAL(BYTE_1, dma_runs); 
+    LONGS_EQUAL(BYTE_1, yield_count); 
+    LONGS_EQUAL(FALSE, spi_dma_busy(&spi_test_engine)); 
+    MEMCMP_EQUAL(slave_miso, rx_buff, SPI_TEST_SIZE); 
+}
+
+
+// Blocking - without the RX interrupt the transfer is finished by polling the stream 
+TEST(spi_comm, transfer_blocking_poll)
+{
+    spi_test_dma_rx.CR &= ~DMA_TCIE_BIT; 
+
+    LONGS_EQUAL(SPI_OK, spi_transfer(&spi_test_port, tx_buff, rx_buff, SPI_DUMMY, 
+                                     SPI_TEST_SIZE)); 
+
+    LONGS_EQUAL(BYTE_1, dma_runs); 
+    LONGS_EQUAL(FALSE, spi_dma_busy(&spi_test_engine)); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_port.CR2); 
+    MEMCMP_EQUAL(tx_buff, slave_mosi, SPI_TEST_SIZE); 
+    MEMCMP_EQUAL(slave_miso, rx_buff, SPI_TEST_SIZE); 
+}
+
+
+// Blocking - a transfer that never finishes times out and stops the streams 
+TEST(spi_comm, transfer_blocking_timeout)
+{
+    spi_dma_init(&spi_test_engine, &spi_test_port, &spi_test_dma, 
+                 &spi_test_dma_tx, &spi_test_dma_rx, spi_test_yield_stuck); 
+
+    LONGS_EQUAL(SPI_TIMEOUT, spi_transfer(&spi_test_port, tx_buff, NULL, SPI_DUMMY, 
+                                          SPI_DMA_MIN_LEN)); 
+
+    CHECK(yield_count > BYTE_0); 
+    LONGS_EQUAL(BYTE_0, dma_runs); 
+    LONGS_EQUAL(FALSE, spi_dma_busy(&spi_test_engine)); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, spi_test_engine.errors); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_dma_tx.CR & DMA_EN_BIT); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_dma_rx.CR & DMA_EN_BIT); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_port.CR2); 
+}
+
+
+// DMA - waiting on a started transfer finishes it without the RX interrupt 
+TEST(spi_comm, transfer_dma_wait)
+{
+    LONGS_EQUAL(SPI_NULL_PTR, spi_dma_wait(NULL)); 
+    LONGS_EQUAL(SPI_OK, spi_dma_wait(&spi_test_engine)); 
+    LONGS_EQUAL(BYTE_0, yield_count); 
+
+    spi_test_dma_rx.CR &= ~DMA_TCIE_BIT; 
+
+    LONGS_EQUAL(SPI_OK, spi_transfer_dma(&spi_test_engine, NULL, rx_buff, SPI_DUMMY, 
+                                         SPI_TEST_SIZE, spi_test_callback, NULL)); 
+    LONGS_EQUAL(SPI_OK, spi_dma_wait(&spi_test_engine)); 
+
+    LONGS_EQUAL(BYTE_1, yield_count); 
+    LONGS_EQUAL(BYTE_1, callback_count); 
+    LONGS_EQUAL(SPI_OK, callback_status); 
+    LONGS_EQUAL(FALSE, spi_dma_busy(&spi_test_engine)); 
+    MEMCMP_EQUAL(slave_miso, rx_buff, SPI_TEST_SIZE); 
+}
+
+
+// Blocking - short transfers and ports without DMA are polled 
+TEST(spi_comm, transfer_polled)
+{
+    SPI_TypeDef spi_no_dma; 
+
+    memset((void *)&spi_no_dma, CLEAR, sizeof(spi_no_dma)); 
+    spi_no_dma.SR = SR_TXE_BIT | SR_RXNE_BIT; 
+
+    // The data register reads back the last byte written - the next byte is written 
+    // before each read so the read data is one byte ahead of the write data 
+    LONGS_EQUAL(SPI_OK, spi_transfer(&spi_test_port, tx_buff, rx_buff, SPI_DUMMY, 
+                                     SPI_DMA_MIN_LEN - BYTE_1)); 
+    LONGS_EQUAL(SPI_OK, spi_transfer(&spi_no_dma, NULL, &rx_buff[SPI_DMA_MIN_LEN], 
+                                     SPI_DUMMY, SPI_TEST_SIZE - SPI_DMA_MIN_LEN)); 
+
+    MEMCMP_EQUAL(&tx_buff[1], rx_buff, SPI_DMA_MIN_LEN - BYTE_2); 
+    LONGS_EQUAL(tx_buff[SPI_DMA_MIN_LEN - BYTE_2], rx_buff[SPI_DMA_MIN_LEN - BYTE_2]); 
+    LONGS_EQUAL(SPI_DUMMY, rx_buff[SPI_TEST_SIZE - 1]); 
+    LONGS_EQUAL(BYTE_0, yield_count); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_dma_rx.NDTR); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, spi_test_port.CR2); 
+}
+
+//=======================================================================================
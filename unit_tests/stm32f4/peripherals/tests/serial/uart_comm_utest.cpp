@@ -0,0 +1,584 @@
+/**
+ * @file uart_comm_utest.cpp
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com)
+ * 
+ * @brief UART driver unit tests 
+ * 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+//=======================================================================================
+// Notes 
+// - The UART port is a plain structure with TXE and TC always set. uart_test_wire runs 
+//   the transmit interrupt handler the way the hardware would while TXEIE is set and 
+//   records each byte written to the data register. 
+// - uart_test_rx plays the part of a circular mode DMA stream writing received bytes 
+//   into the receive stream buffer and counting NDTR down. 
+// - DMA transmits are finished by calling uart_dma_tx_irq directly or from the wait hook. 
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes 
+
+#include "CppUTest/TestHarness.h" 
+
+extern "C"
+{
+	// Add your C-only include files here 
+    #include "uart_comm.h" 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_TEST_BUFF_SIZE 8 
+#define UART_TEST_WIRE_SIZE 64 
+#define UART_TEST_RX_SIZE 16 
+#define UART_TEST_PCLK1 42000000 
+#define UART_TEST_PCLK2 84000000 
+
+// Register bits 
+#define SR_TC_BIT     0x00000040 
+#define SR_TXE_BIT    0x00000080 
+#define CR1_TXEIE_BIT 0x00000080 
+#define CR1_IDLEIE_BIT 0x00000010 
+#define CR3_DMAR_BIT  0x00000040 
+#define CR3_DMAT_BIT  0x00000080 
+#define DMA_EN_BIT    0x00000001 
+#define DMA_HTIE_BIT  0x00000008 
+#define DMA_TCIE_BIT  0x00000010 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test data 
+
+static USART_TypeDef uart_test_port; 
+static uart_tx_buff_t uart_test_tx; 
+static uint8_t uart_test_buff[UART_TEST_BUFF_SIZE]; 
+
+// Bytes sent by the transmit interrupt 
+static char wire[UART_TEST_WIRE_SIZE]; 
+static uint8_t wire_count; 
+
+// Receive stream 
+static DMA_TypeDef uart_test_dma; 
+static DMA_Stream_TypeDef uart_test_dma_stream; 
+static uart_rx_stream_t uart_test_rx_stream; 
+static uint8_t uart_test_rx_buff[UART_TEST_RX_SIZE]; 
+static uint8_t rx_callback_count; 
+
+// DMA transmit 
+static uart_dma_tx_t uart_test_dma_tx; 
+static uint8_t uart_test_tx_a[UART_TEST_BUFF_SIZE]; 
+static uint8_t uart_test_tx_b[UART_TEST_BUFF_SIZE]; 
+static uint8_t tx_yield_count; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helper functions 
+
+// Run the transmit interrupt until it disables itself 
+static void uart_test_wire(void)
+{
+    while ((uart_test_port.CR1 & CR1_TXEIE_BIT) && (wire_count < UART_TEST_WIRE_SIZE))
+    {
+        uint16_t tail = uart_test_tx.tail; 
+
+        uart_tx_buff_irq(&uart_test_tx); 
+
+        if (tail != uart_test_tx.tail)
+        {
+            wire[wire_count++] = (char)uart_test_port.DR; 
+        }
+    }
+}
+
+
+
+// Receive bytes the way the DMA would 
+static void uart_test_rx(const char *data)
+{
+    while (*data != NULL_CHAR)
+    {
+        uart_test_rx_buff[UART_TEST_RX_SIZE - uart_test_dma_stream.NDTR] = (uint8_t)*data++; 
+
+        if (--uart_test_dma_stream.NDTR == CLEAR)
+        {
+            uart_test_dma_stream.NDTR = UART_TEST_RX_SIZE; 
+        }
+    }
+}
+
+
+// Count the new data callbacks 
+static void uart_test_rx_callback(
+    uart_rx_stream_t *stream, 
+    void *context)
+{
+    rx_callback_count++; 
+}
+
+
+// Finish the DMA transmit while a write waits 
+static void uart_test_tx_yield(void)
+{
+    tx_yield_count++; 
+    uart_dma_tx_irq(&uart_test_dma_tx); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test Group 
+
+TEST_GROUP(uart_comm)
+{
+    // Constructor 
+    void setup()
+    {
+        memset((void *)&uart_test_port, CLEAR, sizeof(uart_test_port)); 
+        uart_test_port.SR = SR_TC_BIT | SR_TXE_BIT; 
+
+        memset((void *)wire, CLEAR, sizeof(wire)); 
+        wire_count = CLEAR; 
+
+        memset((void *)&uart_test_dma_stream, CLEAR, sizeof(uart_test_dma_stream)); 
+        memset((void *)uart_test_rx_buff, CLEAR, sizeof(uart_test_rx_buff)); 
+        rx_callback_count = CLEAR; 
+
+        memset((void *)uart_test_tx_a, CLEAR, sizeof(uart_test_tx_a)); 
+        memset((void *)uart_test_tx_b, CLEAR, sizeof(uart_test_tx_b)); 
+        tx_yield_count = CLEAR; 
+    }
+
+    // Destructor 
+    void teardown()
+    {
+        // 
+    }
+};
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Tests 
+
+// Transmit buffer - invalid setups are rejected 
+TEST(uart_comm, tx_buff_init_invalid)
+{
+    LONGS_EQUAL(UART_INVALID_PTR, uart_tx_buff_init(NULL, &uart_test_port, uart_test_buff, 
+                                                    UART_TEST_BUFF_SIZE, UART_TX_DROP)); 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_tx_buff_init(&uart_test_tx, NULL, uart_test_buff, 
+                                                    UART_TEST_BUFF_SIZE, UART_TX_DROP)); 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_tx_buff_init(&uart_test_tx, &uart_test_port, NULL, 
+                                                    UART_TEST_BUFF_SIZE, UART_TX_DROP)); 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_tx_buff_init(&uart_test_tx, &uart_test_port, 
+                                                    uart_test_buff, BYTE_1, UART_TX_DROP)); 
+}
+
+
+// Transmit buffer - send functions return before the data is sent 
+TEST(uart_comm, tx_buff_send)
+{
+    uart_tx_buff_init(&uart_test_tx, &uart_test_port, uart_test_buff, 
+                      UART_TEST_BUFF_SIZE, UART_TX_DROP); 
+
+    uart_send_str(&uart_test_port, "ab"); 
+    uart_send_char(&uart_test_port, 'c'); 
+
+    // Nothing written to the port yet but the interrupt is enabled 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_port.DR); 
+    UNSIGNED_LONGS_EQUAL(CR1_TXEIE_BIT, uart_test_port.CR1 & CR1_TXEIE_BIT); 
+
+    uart_test_wire(); 
+
+    STRCMP_EQUAL("abc", wire); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_port.CR1 & CR1_TXEIE_BIT); 
+
+    // Data that wraps around the end of the buffer 
+    uart_send_integer(&uart_test_port, -123); 
+    uart_test_wire(); 
+
+    STRCMP_EQUAL("abc-00123", wire); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_tx.dropped); 
+}
+
+
+// Transmit buffer - drop policy discards data that doesn't fit 
+TEST(uart_comm, tx_buff_drop)
+{
+    uart_tx_buff_init(&uart_test_tx, &uart_test_port, uart_test_buff, 
+                      UART_TEST_BUFF_SIZE, UART_TX_DROP); 
+
+    uart_send_str(&uart_test_port, "01234"); 
+    uart_send_str(&uart_test_port, "56789"); 
+    uart_send_str(&uart_test_port, "ab"); 
+    uart_test_wire(); 
+
+    STRCMP_EQUAL("01234ab", wire); 
+    UNSIGNED_LONGS_EQUAL(BYTE_5, uart_test_tx.dropped); 
+}
+
+
+// Transmit buffer - overwrite policy discards the oldest data 
+TEST(uart_comm, tx_buff_overwrite)
+{
+    uart_tx_buff_init(&uart_test_tx, &uart_test_port, uart_test_buff, 
+                      UART_TEST_BUFF_SIZE, UART_TX_OVERWRITE); 
+
+    uart_send_str(&uart_test_port, "01234"); 
+    uart_send_str(&uart_test_port, "56789"); 
+    uart_test_wire(); 
+
+    STRCMP_EQUAL("3456789", wire); 
+    UNSIGNED_LONGS_EQUAL(BYTE_3, uart_test_tx.dropped); 
+
+    // Data longer than the buffer keeps its end 
+    memset((void *)wire, CLEAR, sizeof(wire)); 
+    wire_count = CLEAR; 
+
+    uart_send_str(&uart_test_port, "abcdefghij"); 
+    uart_test_wire(); 
+
+    STRCMP_EQUAL("defghij", wire); 
+    UNSIGNED_LONGS_EQUAL(BYTE_6, uart_test_tx.dropped); 
+}
+
+
+// Transmit buffer - block policy sends bytes itself to make room 
+TEST(uart_comm, tx_buff_block)
+{
+    uart_tx_buff_init(&uart_test_tx, &uart_test_port, uart_test_buff, 
+                      UART_TEST_BUFF_SIZE, UART_TX_BLOCK); 
+
+    uart_send_str(&uart_test_port, "01234"); 
+    uart_send_str(&uart_test_port, "56789"); 
+
+    // Three bytes went out by polling, the rest is still buffered 
+    LONGS_EQUAL('2', uart_test_port.DR); 
+
+    uart_test_wire(); 
+
+    STRCMP_EQUAL("3456789", wire); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_tx.dropped); 
+}
+
+
+// Transmit buffer - flush sends everything without the interrupt 
+TEST(uart_comm, tx_buff_flush)
+{
+    uart_tx_buff_init(&uart_test_tx, &uart_test_port, uart_test_buff, 
+                      UART_TEST_BUFF_SIZE, UART_TX_DROP); 
+
+    uart_send_str(&uart_test_port, "xyz"); 
+    uart_tx_flush(&uart_test_port); 
+
+    LONGS_EQUAL('z', uart_test_port.DR); 
+    LONGS_EQUAL(uart_test_tx.head, uart_test_tx.tail); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_port.CR1 & CR1_TXEIE_BIT); 
+
+    // Nothing left for the interrupt 
+    uart_test_wire(); 
+    LONGS_EQUAL(BYTE_0, wire_count); 
+}
+
+
+// Ports without a transmit buffer write the data register directly 
+TEST(uart_comm, send_unbuffered)
+{
+    USART_TypeDef uart_no_buff; 
+
+    memset((void *)&uart_no_buff, CLEAR, sizeof(uart_no_buff)); 
+    uart_no_buff.SR = SR_TC_BIT | SR_TXE_BIT; 
+
+    uart_send_str(&uart_no_buff, "ok"); 
+
+    LONGS_EQUAL('k', uart_no_buff.DR); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_no_buff.CR1); 
+}
+
+
+
+// Receive stream - the DMA and interrupts are set up 
+TEST(uart_comm, rx_stream_init)
+{
+    LONGS_EQUAL(UART_INVALID_PTR, 
+                uart_rx_stream_init(&uart_test_rx_stream, &uart_test_port, &uart_test_dma, 
+                                    &uart_test_dma_stream, NULL, UART_TEST_RX_SIZE, 
+                                    NULL, NULL)); 
+    LONGS_EQUAL(UART_OK, 
+                uart_rx_stream_init(&uart_test_rx_stream, &uart_test_port, &uart_test_dma, 
+                                    &uart_test_dma_stream, uart_test_rx_buff, 
+                                    UART_TEST_RX_SIZE, NULL, NULL)); 
+
+    UNSIGNED_LONGS_EQUAL(UART_TEST_RX_SIZE, uart_test_dma_stream.NDTR); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)(&uart_test_port.DR), uart_test_dma_stream.PAR); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)uart_test_rx_buff, uart_test_dma_stream.M0AR); 
+    UNSIGNED_LONGS_EQUAL(DMA_EN_BIT | DMA_HTIE_BIT | DMA_TCIE_BIT, 
+                         uart_test_dma_stream.CR & (DMA_EN_BIT | DMA_HTIE_BIT | DMA_TCIE_BIT)); 
+    UNSIGNED_LONGS_EQUAL(CR3_DMAR_BIT, uart_test_port.CR3 & CR3_DMAR_BIT); 
+    UNSIGNED_LONGS_EQUAL(CR1_IDLEIE_BIT, uart_test_port.CR1 & CR1_IDLEIE_BIT); 
+}
+
+
+// Receive stream - data is read in place, including across the end of the buffer 
+TEST(uart_comm, rx_stream_spans)
+{
+    uart_rx_span_t spans[BYTE_2]; 
+
+    uart_rx_stream_init(&uart_test_rx_stream, &uart_test_port, &uart_test_dma, 
+                        &uart_test_dma_stream, uart_test_rx_buff, UART_TEST_RX_SIZE, 
+                        uart_test_rx_callback, NULL); 
+
+    // Nothing is available until the interrupt updates the stream 
+    uart_test_rx("hello"); 
+    LONGS_EQUAL(BYTE_0, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+
+    LONGS_EQUAL(BYTE_1, rx_callback_count); 
+    LONGS_EQUAL(BYTE_5, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+    POINTERS_EQUAL(uart_test_rx_buff, spans[0].data); 
+    LONGS_EQUAL(BYTE_5, spans[0].size); 
+    LONGS_EQUAL(BYTE_0, spans[1].size); 
+    MEMCMP_EQUAL("hello", spans[0].data, BYTE_5); 
+
+    // Commit part of the data 
+    uart_rx_stream_commit(&uart_test_rx_stream, BYTE_2); 
+    LONGS_EQUAL(BYTE_3, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+    MEMCMP_EQUAL("llo", spans[0].data, BYTE_3); 
+    uart_rx_stream_commit(&uart_test_rx_stream, BYTE_3); 
+
+    // A frame that wraps around the end of the buffer comes back as two spans 
+    uart_test_rx("abcdefghi"); 
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+    uart_rx_stream_commit(&uart_test_rx_stream, 
+                          uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+
+    uart_test_rx("0123456"); 
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+
+    LONGS_EQUAL(BYTE_7, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+    POINTERS_EQUAL(&uart_test_rx_buff[14], spans[0].data); 
+    LONGS_EQUAL(BYTE_2, spans[0].size); 
+    MEMCMP_EQUAL("01", spans[0].data, BYTE_2); 
+    POINTERS_EQUAL(uart_test_rx_buff, spans[1].data); 
+    LONGS_EQUAL(BYTE_5, spans[1].size); 
+    MEMCMP_EQUAL("23456", spans[1].data, BYTE_5); 
+
+    // Committing more than is available stops at the write position 
+    uart_rx_stream_commit(&uart_test_rx_stream, UART_TEST_RX_SIZE); 
+    LONGS_EQUAL(BYTE_0, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+    LONGS_EQUAL(BYTE_3, rx_callback_count); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_rx_stream.overruns); 
+}
+
+
+// Receive stream - unread data that gets overwritten is dropped 
+TEST(uart_comm, rx_stream_overrun)
+{
+    uart_rx_span_t spans[BYTE_2]; 
+
+    uart_rx_stream_init(&uart_test_rx_stream, &uart_test_port, &uart_test_dma, 
+                        &uart_test_dma_stream, uart_test_rx_buff, UART_TEST_RX_SIZE, 
+                        NULL, NULL); 
+
+    // Half transfer and transfer complete interrupts while nothing is consumed 
+    uart_test_rx("abcdefgh"); 
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+    uart_test_rx("ijklmnop"); 
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+    uart_test_rx("qrs"); 
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+
+    LONGS_EQUAL(BYTE_0, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+    UNSIGNED_LONGS_EQUAL(BYTE_1, uart_test_rx_stream.overruns); 
+
+    // Reception carries on from the write position 
+    uart_test_rx("tu"); 
+    uart_rx_stream_irq(&uart_test_rx_stream); 
+
+    LONGS_EQUAL(BYTE_2, uart_rx_stream_peek(&uart_test_rx_stream, spans)); 
+    MEMCMP_EQUAL("tu", spans[0].data, BYTE_2); 
+}
+
+
+
+// DMA transmit - initialization sets up the stream and DMAT 
+TEST(uart_comm, dma_tx_init)
+{
+    LONGS_EQUAL(UART_INVALID_PTR, uart_dma_tx_init(&uart_test_dma_tx, &uart_test_port, 
+                                                   &uart_test_dma, &uart_test_dma_stream, 
+                                                   uart_test_tx_a, NULL, 
+                                                   UART_TEST_BUFF_SIZE, NULL)); 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_dma_tx_init(&uart_test_dma_tx, &uart_test_port, 
+                                                   &uart_test_dma, &uart_test_dma_stream, 
+                                                   uart_test_tx_a, uart_test_tx_b, 
+                                                   CLEAR, NULL)); 
+    LONGS_EQUAL(UART_OK, uart_dma_tx_init(&uart_test_dma_tx, &uart_test_port, 
+                                          &uart_test_dma, &uart_test_dma_stream, 
+                                          uart_test_tx_a, uart_test_tx_b, 
+                                          UART_TEST_BUFF_SIZE, NULL)); 
+
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)(&uart_test_port.DR), uart_test_dma_stream.PAR); 
+    CHECK(uart_test_dma_stream.CR & DMA_TCIE_BIT); 
+    CHECK_FALSE(uart_test_dma_stream.CR & DMA_EN_BIT); 
+    CHECK(uart_test_port.CR3 & CR3_DMAT_BIT); 
+    CHECK_FALSE(uart_dma_tx_busy(&uart_test_dma_tx)); 
+}
+
+
+// DMA transmit - the application fills one buffer while the other is sent 
+TEST(uart_comm, dma_tx_double_buffer)
+{
+    uart_dma_tx_init(&uart_test_dma_tx, &uart_test_port, &uart_test_dma, 
+                     &uart_test_dma_stream, uart_test_tx_a, uart_test_tx_b, 
+                     UART_TEST_BUFF_SIZE, NULL); 
+
+    // Data is held until it's sent 
+    LONGS_EQUAL(UART_OK, uart_dma_tx_write(&uart_test_dma_tx, (uint8_t *)"abc", BYTE_3)); 
+    LONGS_EQUAL(UART_OK, uart_dma_tx_write(&uart_test_dma_tx, (uint8_t *)"de", BYTE_2)); 
+    CHECK_FALSE(uart_dma_tx_busy(&uart_test_dma_tx)); 
+
+    // The first buffer goes to the DMA and the second becomes the fill buffer 
+    uart_dma_tx_send(&uart_test_dma_tx); 
+    CHECK(uart_dma_tx_busy(&uart_test_dma_tx)); 
+    CHECK(uart_test_dma_stream.CR & DMA_EN_BIT); 
+    CHECK(uart_test_dma_stream.CR & DMA_TCIE_BIT); 
+    CHECK_FALSE(uart_test_port.SR & SR_TC_BIT); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)uart_test_tx_a, uart_test_dma_stream.M0AR); 
+    UNSIGNED_LONGS_EQUAL(BYTE_5, uart_test_dma_stream.NDTR); 
+    MEMCMP_EQUAL("abcde", uart_test_tx_a, BYTE_5); 
+
+    // The next frame is queued behind the transfer in progress 
+    uart_dma_tx_write(&uart_test_dma_tx, (uint8_t *)"fgh", BYTE_3); 
+    uart_dma_tx_send(&uart_test_dma_tx); 
+    MEMCMP_EQUAL("fgh", uart_test_tx_b, BYTE_3); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)uart_test_tx_a, uart_test_dma_stream.M0AR); 
+
+    // Transfer complete starts the queued buffer 
+    uart_dma_tx_irq(&uart_test_dma_tx); 
+    CHECK(uart_dma_tx_busy(&uart_test_dma_tx)); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)uart_test_tx_b, uart_test_dma_stream.M0AR); 
+    UNSIGNED_LONGS_EQUAL(BYTE_3, uart_test_dma_stream.NDTR); 
+
+    uart_dma_tx_irq(&uart_test_dma_tx); 
+    CHECK_FALSE(uart_dma_tx_busy(&uart_test_dma_tx)); 
+    UNSIGNED_LONGS_EQUAL(BYTE_8, uart_test_dma_tx.bytes); 
+
+    // Nothing to send 
+    uart_dma_tx_send(&uart_test_dma_tx); 
+    CHECK_FALSE(uart_dma_tx_busy(&uart_test_dma_tx)); 
+}
+
+
+// DMA transmit - a full fill buffer is sent and the write waits for a free buffer 
+TEST(uart_comm, dma_tx_full)
+{
+    uart_dma_tx_init(&uart_test_dma_tx, &uart_test_port, &uart_test_dma, 
+                     &uart_test_dma_stream, uart_test_tx_a, uart_test_tx_b, 
+                     UART_TEST_BUFF_SIZE, uart_test_tx_yield); 
+
+    LONGS_EQUAL(UART_BAD_DATA, uart_dma_tx_write(&uart_test_dma_tx, (uint8_t *)"012345678", 
+                                                 UART_TEST_BUFF_SIZE + BYTE_1)); 
+
+    // Frames are built in place 
+    uint8_t *space = uart_dma_tx_reserve(&uart_test_dma_tx, BYTE_6); 
+    POINTERS_EQUAL(uart_test_tx_a, space); 
+    memcpy((void *)space, (void *)"012345", BYTE_6); 
+    uart_dma_tx_commit(&uart_test_dma_tx, BYTE_6); 
+
+    // Doesn't fit - the first buffer is sent without waiting 
+    uart_dma_tx_write(&uart_test_dma_tx, (uint8_t *)"abcdef", BYTE_6); 
+    LONGS_EQUAL(BYTE_0, tx_yield_count); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)uart_test_tx_a, uart_test_dma_stream.M0AR); 
+    MEMCMP_EQUAL("abcdef", uart_test_tx_b, BYTE_6); 
+
+    // Doesn't fit and both buffers are in use - waits for the first transfer to finish 
+    uart_dma_tx_write(&uart_test_dma_tx, (uint8_t *)"ABCD", BYTE_4); 
+    LONGS_EQUAL(BYTE_1, tx_yield_count); 
+    UNSIGNED_LONGS_EQUAL((uint32_t)(uintptr_t)uart_test_tx_b, uart_test_dma_stream.M0AR); 
+    UNSIGNED_LONGS_EQUAL(BYTE_6, uart_test_dma_stream.NDTR); 
+    MEMCMP_EQUAL("ABCD", uart_test_tx_a, BYTE_4); 
+    UNSIGNED_LONGS_EQUAL(BYTE_4, uart_test_dma_tx.fill_len); 
+}
+
+
+
+// Baud rate - register settings for common and high rates 
+TEST(uart_comm, baud_calc)
+{
+    uart_baud_t setting; 
+
+    // 115200 - USARTDIV = 45.5625 
+    LONGS_EQUAL(UART_OK, uart_baud_calc(UART_TEST_PCLK2, 115200, &setting)); 
+    LONGS_EQUAL(FALSE, setting.over8); 
+    UNSIGNED_LONGS_EQUAL(0x2D9, setting.brr); 
+    UNSIGNED_LONGS_EQUAL(115226, setting.baud); 
+    LONGS_EQUAL(225, setting.error_ppm); 
+
+    // 921600 - nearest divider is slightly fast 
+    LONGS_EQUAL(UART_OK, uart_baud_calc(UART_TEST_PCLK2, 921600, &setting)); 
+    LONGS_EQUAL(FALSE, setting.over8); 
+    UNSIGNED_LONGS_EQUAL(0x05B, setting.brr); 
+    UNSIGNED_LONGS_EQUAL(923077, setting.baud); 
+    LONGS_EQUAL(1602, setting.error_ppm); 
+
+    // 1200 on APB1 - largest dividers still fit 
+    LONGS_EQUAL(UART_OK, uart_baud_calc(UART_TEST_PCLK1, 1200, &setting)); 
+    UNSIGNED_LONGS_EQUAL(0x88B8, setting.brr); 
+    LONGS_EQUAL(0, setting.error_ppm); 
+}
+
+
+// Baud rate - rates above pclk/16 use oversampling by 8 
+TEST(uart_comm, baud_calc_over8)
+{
+    uart_baud_t setting; 
+
+    // USARTDIV = 1.75 - fraction is 3 bits 
+    LONGS_EQUAL(UART_OK, uart_baud_calc(UART_TEST_PCLK2, 6000000, &setting)); 
+    LONGS_EQUAL(TRUE, setting.over8); 
+    UNSIGNED_LONGS_EQUAL(0x016, setting.brr); 
+    UNSIGNED_LONGS_EQUAL(6000000, setting.baud); 
+    LONGS_EQUAL(0, setting.error_ppm); 
+
+    // Fastest rate - pclk/8 
+    LONGS_EQUAL(UART_OK, uart_baud_calc(UART_TEST_PCLK2, 10500000, &setting)); 
+    LONGS_EQUAL(TRUE, setting.over8); 
+    UNSIGNED_LONGS_EQUAL(0x010, setting.brr); 
+}
+
+
+// Baud rate - rates the clock can't make and invalid arguments are rejected 
+TEST(uart_comm, baud_calc_invalid)
+{
+    uart_baud_t setting; 
+
+    LONGS_EQUAL(UART_BAD_DATA, uart_baud_calc(UART_TEST_PCLK2, 12000000, &setting)); 
+    LONGS_EQUAL(UART_BAD_DATA, uart_baud_calc(UART_TEST_PCLK1, 300, &setting)); 
+    LONGS_EQUAL(UART_BAD_DATA, uart_baud_calc(UART_TEST_PCLK1, CLEAR, &setting)); 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_baud_calc(UART_TEST_PCLK1, 115200, NULL)); 
+
+    // Only USART ports have a known clock 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_set_baud(NULL, 115200, &setting)); 
+    LONGS_EQUAL(UART_INVALID_PTR, uart_set_baud(&uart_test_port, 115200, &setting)); 
+    UNSIGNED_LONGS_EQUAL(CLEAR, uart_test_port.BRR); 
+}
+
+//=======================================================================================